@@ -0,0 +1,35 @@
+# Prefer an installed Google Benchmark, fetch it only when not found
+find_package(benchmark QUIET)
+
+if (NOT benchmark_FOUND)
+    include(FetchContent)
+
+    FetchContent_Declare(
+            benchmark
+            URL https://github.com/google/benchmark/archive/refs/tags/v1.8.3.zip
+            DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+    )
+
+    set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+    set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+
+    FetchContent_MakeAvailable(benchmark)
+endif ()
+
+# `run_benchmarks` runs every benchmark executable registered with servo_core_add_benchmark_run() and writes the
+# results as JSON into benchmark_results/ of the build directory. Results of two builds can be compared with
+# tools/compare.py of Google Benchmark.
+set(SERVO_CORE_BENCHMARK_RESULTS_DIR ${CMAKE_BINARY_DIR}/benchmark_results)
+file(MAKE_DIRECTORY ${SERVO_CORE_BENCHMARK_RESULTS_DIR})
+add_custom_target(run_benchmarks)
+
+function(servo_core_add_benchmark_run target)
+    add_custom_target(run_${target}
+            COMMAND ${target}
+            --benchmark_out=${SERVO_CORE_BENCHMARK_RESULTS_DIR}/${target}.json
+            --benchmark_out_format=json
+            DEPENDS ${target}
+            USES_TERMINAL
+    )
+    add_dependencies(run_benchmarks run_${target})
+endfunction()
@@ -0,0 +1,18 @@
+# Prefer an installed pybind11, e.g. from `pip install pybind11`, fetch it only when not found
+find_package(Python COMPONENTS Interpreter Development.Module REQUIRED)
+find_package(pybind11 CONFIG QUIET)
+
+if (NOT pybind11_FOUND)
+    include(FetchContent)
+
+    FetchContent_Declare(
+            pybind11
+            URL https://github.com/pybind/pybind11/archive/refs/tags/v2.13.6.zip
+            DOWNLOAD_EXTRACT_TIMESTAMP TRUE
+    )
+
+    FetchContent_MakeAvailable(pybind11)
+endif ()
+
+# The host libraries are static and linked into the module, which is a shared library
+set(CMAKE_POSITION_INDEPENDENT_CODE ON)
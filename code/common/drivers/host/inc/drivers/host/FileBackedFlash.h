@@ -0,0 +1,53 @@
+#ifndef COMMON_DRIVERS_HOST_FILEBACKEDFLASH_H
+#define COMMON_DRIVERS_HOST_FILEBACKEDFLASH_H
+
+#include <cstdio>
+#include <string>
+
+#include "drivers/interfaces/FlashInterface.h"
+
+namespace drivers::host {
+
+/**
+ * @brief Flash region emulated with a file, so that the stored data survives between the runs of a host program.
+ *
+ * Behaves like NOR flash: programming only clears bits and only erasing sets them back. A missing file is created
+ * as fully erased. Every operation is flushed to the file right away.
+ */
+class FileBackedFlash final : public interfaces::FlashInterface {
+public:
+    /**
+     * @param file_path    Path of the backing file.
+     * @param sector_size  Size of a sector in bytes.
+     * @param sector_count Amount of sectors.
+     */
+    FileBackedFlash(const std::string& file_path, size_t sector_size, size_t sector_count);
+    ~FileBackedFlash() override;
+
+    FileBackedFlash(const FileBackedFlash&)            = delete;
+    FileBackedFlash& operator=(const FileBackedFlash&) = delete;
+
+    /**
+     * @brief Check whether the backing file could be opened.
+     */
+    [[nodiscard]] bool isOpen() const;
+
+    [[nodiscard]] size_t getSectorSize() const override;
+    [[nodiscard]] size_t getSectorCount() const override;
+
+    [[nodiscard]] bool read(size_t address, std::span<uint8_t> target) override;
+    [[nodiscard]] bool program(size_t address, std::span<const uint8_t> data) override;
+    [[nodiscard]] bool eraseSector(size_t sector_index) override;
+
+private:
+    std::FILE* file_ = nullptr;
+    size_t     sector_size_;
+    size_t     sector_count_;
+
+private:
+    [[nodiscard]] bool isInRegion(size_t address, size_t size) const;
+};
+
+}  // namespace drivers::host
+
+#endif  // COMMON_DRIVERS_HOST_FILEBACKEDFLASH_H
@@ -0,0 +1,151 @@
+#ifndef COMMON_DRIVERS_HOST_LOOPBACKLINK_H
+#define COMMON_DRIVERS_HOST_LOOPBACKLINK_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <span>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/ClockInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
+
+namespace drivers::host {
+
+/**
+ * @brief Timing model of a LoopbackLink.
+ */
+struct LinkModel {
+    /// Rate both ends start with, 10 bits per byte like 8N1. 0 delivers the bytes without any transmission time.
+    uint32_t baud_rate      = 0;
+    /// Delay of every byte on top of its transmission time, e.g. of a USB serial adapter
+    uint32_t latency_us     = 0;
+    /// Arrived bytes an end holds before it drops the next ones, like a UART rx buffer. 0 for no limit.
+    size_t   rx_buffer_size = 0;
+};
+
+/**
+ * @brief Two serial ports connected to each other in memory, for running a master and a slave in one process.
+ *
+ * The bytes transmitted by one end arrive at the other after their transmission time at the end's baud rate and the
+ * latency of the link. A byte transmitted while the ends run at different baud rates arrives garbled, as it would on a
+ * wire. The ends can be used from different threads.
+ *
+ * To run both ends in one thread, the owner of one end can set a poll callback on the other end that runs the owner,
+ * e.g. the slave's main loop. It is invoked whenever the other end looks for received bytes, so a master that blocks
+ * waiting for a response keeps the slave running.
+ */
+class LoopbackLink {
+public:
+    using PollCallback = void (*)(void* user_data);
+
+    class End final : public interfaces::BufferedSerialCommunicationInterface,
+                      public interfaces::SerialPortConfigurationInterface {
+    public:
+        End(const End&)            = delete;
+        End& operator=(const End&) = delete;
+
+        void transmitByte(uint8_t byte) override;
+        void transmitBytes(std::span<uint8_t> bytes) override;
+
+        size_t  getReceivedBytesAvailableAmount() override;
+        uint8_t readReceivedByte() override;
+        size_t  readReceivedBytes(std::span<uint8_t> bytes) override;
+        /**
+         * @brief Get the amount of bytes dropped because the rx buffer of this end was full.
+         */
+        uint64_t getRxOverflowCount() override;
+        /**
+         * @brief Sleep until the peer's bytes arrive or the timeout has passed in real time.
+         *
+         * Returns right away with a poll callback set, the peer then runs in this thread. The link's clock must run
+         * in real time for the wait to end when the bytes in flight arrive, otherwise it ends with the timeout.
+         */
+        bool     waitForReceivedBytes(uint64_t timeout_us) override;
+        void     interruptWaitForReceivedBytes() override;
+
+        /**
+         * @brief Change the baud rate of this end. Any rate is supported.
+         */
+        [[nodiscard]] bool     setBaudRate(uint32_t baud_rate) override;
+        [[nodiscard]] uint32_t getBaudRate() override;
+        /**
+         * @brief Wait until the bytes transmitted so far have left this end. Needs a clock that advances on its own.
+         */
+        void                   flushTx() override;
+
+        /**
+         * @brief Set the callback invoked at the start of `getReceivedBytesAvailableAmount()`, see LoopbackLink.
+         *
+         * @param callback  Invoked before the received bytes are counted. Can be nullptr.
+         * @param user_data Opaque pointer passed to the callback.
+         */
+        void setPollCallback(PollCallback callback, void* user_data);
+
+        /**
+         * @brief Get the amount of bytes transmitted from and read from this end, e.g. for throughput measurements.
+         */
+        [[nodiscard]] uint64_t getTransmittedByteCount();
+        [[nodiscard]] uint64_t getReadByteCount();
+
+    private:
+        friend class LoopbackLink;
+
+        struct InFlightByte {
+            uint64_t arrival_time_ns;
+            uint8_t  byte;
+        };
+
+        LoopbackLink& link_;
+        End*          peer_ = nullptr;
+
+        uint32_t                 baud_rate_               = 0;
+        uint64_t                 tx_line_free_time_ns_    = 0;  // When the last transmitted byte has left this end
+        std::deque<InFlightByte> in_flight_bytes_;              // Transmitted by the peer, not yet arrived here
+        std::deque<uint8_t>      received_bytes_;
+        uint64_t                 dropped_byte_count_      = 0;
+        uint64_t                 transmitted_byte_count_  = 0;
+        uint64_t                 read_byte_count_         = 0;
+        PollCallback             poll_callback_           = nullptr;
+        void*                    poll_callback_user_data_ = nullptr;
+        bool                     wait_interrupted_        = false;
+
+        explicit End(LoopbackLink& link);
+
+        void transmitLocked(std::span<const uint8_t> bytes);
+        void receiveArrivedLocked();
+    };
+
+    /**
+     * @param clock Time base of the transmission times and the latency. Must be readable from every thread that uses
+     *              the ends.
+     * @param model Timing of the link.
+     */
+    explicit LoopbackLink(interfaces::ClockInterface& clock, LinkModel model = {});
+
+    LoopbackLink(const LoopbackLink&)            = delete;
+    LoopbackLink& operator=(const LoopbackLink&) = delete;
+
+    [[nodiscard]] End& getEndA();
+    [[nodiscard]] End& getEndB();
+
+    /**
+     * @brief Change the timing of the link. The bytes in flight are dropped and both ends return to the model's rate.
+     */
+    void setModel(LinkModel model);
+
+private:
+    interfaces::ClockInterface& clock_;
+    LinkModel                   model_;
+    std::mutex                  mutex_;  // Guards the state of both ends
+    std::condition_variable     bytes_transmitted_;  // Also notified when a wait is interrupted
+    End                         end_a_;
+    End                         end_b_;
+
+    [[nodiscard]] uint64_t nowNanoseconds();
+};
+
+}  // namespace drivers::host
+
+#endif  // COMMON_DRIVERS_HOST_LOOPBACKLINK_H
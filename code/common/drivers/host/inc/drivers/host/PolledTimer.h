@@ -0,0 +1,63 @@
+#ifndef COMMON_DRIVERS_HOST_POLLEDTIMER_H
+#define COMMON_DRIVERS_HOST_POLLEDTIMER_H
+
+#include <cstdint>
+
+#include "drivers/interfaces/ClockInterface.h"
+#include "drivers/interfaces/TimerInterface.h"
+
+namespace drivers::host {
+
+/**
+ * @brief Timer that fires from `run()` instead of an interrupt, for running firmware code on the host.
+ *
+ * The callback stands in for the alarm interrupt of the hardware timer. It is invoked from the first `run()` after
+ * the period has passed, so the firing is only as punctual as `run()` is called.
+ */
+class PolledTimer final : public interfaces::TimerInterface {
+public:
+    using FireCallback = void (*)(void* user_data);
+
+    /**
+     * @param clock     Time base of the timer.
+     * @param callback  Invoked when the timer fires.
+     * @param user_data Opaque pointer passed to the callback.
+     */
+     PolledTimer(interfaces::ClockInterface& clock, FireCallback callback, void* user_data);
+    ~PolledTimer() override = default;
+
+    void configureInMicroseconds(uint32_t period) override;
+    void configureInMilliseconds(uint32_t period) override;
+    void configureInSeconds(uint32_t period) override;
+
+    void start() override;
+    void stop() override;
+    void restart() override;
+
+    [[nodiscard]] bool isRunning() const override;
+
+    [[nodiscard]] uint64_t getElapsedMicroseconds() const override;
+    [[nodiscard]] uint64_t getElapsedMilliseconds() const override;
+    [[nodiscard]] uint64_t getElapsedSeconds() const override;
+
+    void forceFire() const override;
+
+    /**
+     * @brief Invoke the callback if the timer has fired. Call periodically, e.g. from the main loop.
+     */
+    void run();
+
+private:
+    interfaces::ClockInterface& clock_;
+    FireCallback                callback_;
+    void*                       user_data_;
+
+    uint32_t     period_us_          = 0;
+    uint64_t     start_time_us_      = 0;
+    bool         running_            = false;
+    mutable bool force_fire_pending_ = false;  // forceFire() is const in the interface
+};
+
+}  // namespace drivers::host
+
+#endif  // COMMON_DRIVERS_HOST_POLLEDTIMER_H
@@ -0,0 +1,49 @@
+#ifndef COMMON_DRIVERS_HOST_RAMFLASH_H
+#define COMMON_DRIVERS_HOST_RAMFLASH_H
+
+#include <cstdint>
+#include <vector>
+
+#include "drivers/interfaces/FlashInterface.h"
+
+namespace drivers::host {
+
+/**
+ * @brief Flash region emulated in RAM, for tests and benchmarks that do not need the data to survive the process.
+ *
+ * Behaves like NOR flash the same way as FileBackedFlash: programming only clears bits and only erasing sets them
+ * back. Starts fully erased.
+ */
+class RamFlash final : public interfaces::FlashInterface {
+public:
+    /**
+     * @param sector_size  Size of a sector in bytes.
+     * @param sector_count Amount of sectors.
+     */
+     RamFlash(size_t sector_size, size_t sector_count);
+    ~RamFlash() override = default;
+
+    [[nodiscard]] size_t getSectorSize() const override;
+    [[nodiscard]] size_t getSectorCount() const override;
+
+    [[nodiscard]] bool read(size_t address, std::span<uint8_t> target) override;
+    [[nodiscard]] bool program(size_t address, std::span<const uint8_t> data) override;
+    [[nodiscard]] bool eraseSector(size_t sector_index) override;
+
+    /**
+     * @brief Get the whole region, e.g. to compare it or to copy it to another RamFlash.
+     */
+    [[nodiscard]] std::vector<uint8_t>& getBytes();
+
+private:
+    size_t               sector_size_;
+    size_t               sector_count_;
+    std::vector<uint8_t> bytes_;
+
+private:
+    [[nodiscard]] bool isInRegion(size_t address, size_t size) const;
+};
+
+}  // namespace drivers::host
+
+#endif  // COMMON_DRIVERS_HOST_RAMFLASH_H
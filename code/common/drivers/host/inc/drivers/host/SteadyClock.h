@@ -0,0 +1,31 @@
+#ifndef COMMON_DRIVERS_HOST_STEADYCLOCK_H
+#define COMMON_DRIVERS_HOST_STEADYCLOCK_H
+
+#include <chrono>
+#include <cstdint>
+
+#include "drivers/interfaces/ClockInterface.h"
+
+namespace drivers::host {
+
+/**
+ * @brief Monotonic clock of the host, based on std::chrono::steady_clock. Starts at zero when constructed.
+ *
+ * Can be read from any thread.
+ */
+class SteadyClock final : public interfaces::ClockInterface {
+public:
+     SteadyClock();
+    ~SteadyClock() override = default;
+
+    uint64_t uptimeMicroseconds() override;
+    uint64_t uptimeMilliseconds() override;
+    uint64_t uptimeSeconds() override;
+
+private:
+    const std::chrono::steady_clock::time_point start_time_point_;
+};
+
+}  // namespace drivers::host
+
+#endif  // COMMON_DRIVERS_HOST_STEADYCLOCK_H
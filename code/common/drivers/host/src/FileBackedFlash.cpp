@@ -0,0 +1,72 @@
+#include "drivers/host/FileBackedFlash.h"
+
+#include <vector>
+
+namespace drivers::host {
+
+FileBackedFlash::FileBackedFlash(const std::string& file_path, size_t sector_size, size_t sector_count)
+    : sector_size_(sector_size), sector_count_(sector_count) {
+    file_ = std::fopen(file_path.c_str(), "r+b");
+    if (file_ == nullptr) {
+        file_ = std::fopen(file_path.c_str(), "w+b");
+    }
+    if (file_ == nullptr) return;
+
+    // Extend a new or truncated file with erased bytes
+    std::fseek(file_, 0, SEEK_END);
+    const long   current_size = std::ftell(file_);
+    const size_t region_size  = sector_size_ * sector_count_;
+    if (current_size >= 0 && static_cast<size_t>(current_size) < region_size) {
+        const std::vector<uint8_t> erased(region_size - static_cast<size_t>(current_size), K_ERASED_BYTE);
+        std::fwrite(erased.data(), 1, erased.size(), file_);
+        std::fflush(file_);
+    }
+}
+
+FileBackedFlash::~FileBackedFlash() {
+    if (file_ != nullptr) std::fclose(file_);
+}
+
+bool FileBackedFlash::isOpen() const { return file_ != nullptr; }
+
+size_t FileBackedFlash::getSectorSize() const { return sector_size_; }
+
+size_t FileBackedFlash::getSectorCount() const { return sector_count_; }
+
+bool FileBackedFlash::read(size_t address, std::span<uint8_t> target) {
+    if (file_ == nullptr || !isInRegion(address, target.size_bytes())) return false;
+
+    if (std::fseek(file_, static_cast<long>(address), SEEK_SET) != 0) return false;
+    return std::fread(target.data(), 1, target.size_bytes(), file_) == target.size_bytes();
+}
+
+bool FileBackedFlash::program(size_t address, std::span<const uint8_t> data) {
+    if (file_ == nullptr || !isInRegion(address, data.size_bytes())) return false;
+
+    // Programming can only clear bits
+    std::vector<uint8_t> programmed(data.size_bytes());
+    if (!read(address, programmed)) return false;
+    for (size_t i = 0; i < programmed.size(); i++) {
+        programmed[i] &= data[i];
+    }
+
+    if (std::fseek(file_, static_cast<long>(address), SEEK_SET) != 0) return false;
+    if (std::fwrite(programmed.data(), 1, programmed.size(), file_) != programmed.size()) return false;
+    return std::fflush(file_) == 0;
+}
+
+bool FileBackedFlash::eraseSector(size_t sector_index) {
+    if (file_ == nullptr || sector_index >= sector_count_) return false;
+
+    const std::vector<uint8_t> erased(sector_size_, K_ERASED_BYTE);
+    if (std::fseek(file_, static_cast<long>(sector_index * sector_size_), SEEK_SET) != 0) return false;
+    if (std::fwrite(erased.data(), 1, erased.size(), file_) != erased.size()) return false;
+    return std::fflush(file_) == 0;
+}
+
+bool FileBackedFlash::isInRegion(size_t address, size_t size) const {
+    const size_t region_size = sector_size_ * sector_count_;
+    return address <= region_size && size <= region_size - address;
+}
+
+}  // namespace drivers::host
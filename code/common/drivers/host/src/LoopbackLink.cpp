@@ -0,0 +1,212 @@
+#include "drivers/host/LoopbackLink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace drivers::host {
+
+namespace {
+
+constexpr uint64_t K_BITS_PER_BYTE = 10;  // Start bit, 8 data bits and stop bit
+
+uint64_t byteTimeNanoseconds(uint32_t baud_rate) {
+    if (baud_rate == 0) return 0;
+    return K_BITS_PER_BYTE * 1'000'000'000 / baud_rate;
+}
+
+// What the receiver makes of a byte sent at another rate, only needs to be wrong
+uint8_t garble(uint8_t byte) { return static_cast<uint8_t>(~byte); }
+
+}  // namespace
+
+LoopbackLink::LoopbackLink(interfaces::ClockInterface& clock, LinkModel model)
+    : clock_(clock), model_(model), end_a_(*this), end_b_(*this) {
+    end_a_.peer_ = &end_b_;
+    end_b_.peer_ = &end_a_;
+    setModel(model);
+}
+
+LoopbackLink::End& LoopbackLink::getEndA() { return end_a_; }
+
+LoopbackLink::End& LoopbackLink::getEndB() { return end_b_; }
+
+void LoopbackLink::setModel(LinkModel model) {
+    std::scoped_lock lock(mutex_);
+
+    model_ = model;
+    for (End* end : {&end_a_, &end_b_}) {
+        end->baud_rate_            = model.baud_rate;
+        end->tx_line_free_time_ns_ = 0;
+        end->in_flight_bytes_.clear();
+        end->received_bytes_.clear();
+    }
+    bytes_transmitted_.notify_all();
+}
+
+uint64_t LoopbackLink::nowNanoseconds() { return clock_.uptimeMicroseconds() * 1'000; }
+
+LoopbackLink::End::End(LoopbackLink& link) : link_(link) {}
+
+void LoopbackLink::End::transmitByte(uint8_t byte) {
+    std::scoped_lock lock(link_.mutex_);
+    transmitLocked({&byte, 1});
+    link_.bytes_transmitted_.notify_all();
+}
+
+void LoopbackLink::End::transmitBytes(std::span<uint8_t> bytes) {
+    std::scoped_lock lock(link_.mutex_);
+    transmitLocked(bytes);
+    link_.bytes_transmitted_.notify_all();
+}
+
+size_t LoopbackLink::End::getReceivedBytesAvailableAmount() {
+    PollCallback poll_callback           = nullptr;
+    void*        poll_callback_user_data = nullptr;
+    {
+        std::scoped_lock lock(link_.mutex_);
+        poll_callback           = poll_callback_;
+        poll_callback_user_data = poll_callback_user_data_;
+    }
+    // Outside the lock, the callback typically uses the other end
+    if (poll_callback != nullptr) poll_callback(poll_callback_user_data);
+
+    std::scoped_lock lock(link_.mutex_);
+    receiveArrivedLocked();
+    return received_bytes_.size();
+}
+
+uint8_t LoopbackLink::End::readReceivedByte() {
+    uint8_t byte = 0;
+    (void)readReceivedBytes({&byte, 1});
+    return byte;
+}
+
+size_t LoopbackLink::End::readReceivedBytes(std::span<uint8_t> bytes) {
+    std::scoped_lock lock(link_.mutex_);
+    receiveArrivedLocked();
+
+    const size_t read_byte_count = std::min(bytes.size(), received_bytes_.size());
+    std::copy_n(received_bytes_.begin(), read_byte_count, bytes.begin());
+    received_bytes_.erase(received_bytes_.begin(),
+                          received_bytes_.begin() + static_cast<std::ptrdiff_t>(read_byte_count));
+    read_byte_count_ += read_byte_count;
+    return read_byte_count;
+}
+
+bool LoopbackLink::End::setBaudRate(uint32_t baud_rate) {
+    std::scoped_lock lock(link_.mutex_);
+    baud_rate_ = baud_rate;
+    return true;
+}
+
+uint32_t LoopbackLink::End::getBaudRate() {
+    std::scoped_lock lock(link_.mutex_);
+    return baud_rate_;
+}
+
+void LoopbackLink::End::flushTx() {
+    uint64_t tx_line_free_time_ns = 0;
+    {
+        std::scoped_lock lock(link_.mutex_);
+        tx_line_free_time_ns = tx_line_free_time_ns_;
+    }
+    while (link_.nowNanoseconds() < tx_line_free_time_ns) std::this_thread::yield();
+}
+
+void LoopbackLink::End::setPollCallback(PollCallback callback, void* user_data) {
+    std::scoped_lock lock(link_.mutex_);
+    poll_callback_           = callback;
+    poll_callback_user_data_ = user_data;
+}
+
+uint64_t LoopbackLink::End::getRxOverflowCount() {
+    std::scoped_lock lock(link_.mutex_);
+    return dropped_byte_count_;
+}
+
+bool LoopbackLink::End::waitForReceivedBytes(uint64_t timeout_us) {
+    bool has_poll_callback = false;
+    {
+        std::scoped_lock lock(link_.mutex_);
+        has_poll_callback = poll_callback_ != nullptr;
+    }
+    // The peer only runs when polled, waiting for it would never end
+    if (timeout_us == 0 || has_poll_callback) return getReceivedBytesAvailableAmount() > 0;
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout_us);
+
+    std::unique_lock lock(link_.mutex_);
+    while (true) {
+        receiveArrivedLocked();
+        if (!received_bytes_.empty()) return true;
+        if (wait_interrupted_) {
+            wait_interrupted_ = false;
+            return false;
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline) return false;
+
+        // Until the next byte in flight arrives, or the peer transmits one
+        auto wake_up_time = deadline;
+        if (!in_flight_bytes_.empty()) {
+            const uint64_t now_ns           = link_.nowNanoseconds();
+            const uint64_t arrival_time_ns  = in_flight_bytes_.front().arrival_time_ns;
+            const uint64_t until_arrival_ns = arrival_time_ns > now_ns ? arrival_time_ns - now_ns : 0;
+            wake_up_time = std::min(wake_up_time, now + std::chrono::nanoseconds(until_arrival_ns));
+        }
+        link_.bytes_transmitted_.wait_until(lock, wake_up_time);
+    }
+}
+
+void LoopbackLink::End::interruptWaitForReceivedBytes() {
+    {
+        std::scoped_lock lock(link_.mutex_);
+        wait_interrupted_ = true;
+    }
+    link_.bytes_transmitted_.notify_all();
+}
+
+uint64_t LoopbackLink::End::getTransmittedByteCount() {
+    std::scoped_lock lock(link_.mutex_);
+    return transmitted_byte_count_;
+}
+
+uint64_t LoopbackLink::End::getReadByteCount() {
+    std::scoped_lock lock(link_.mutex_);
+    return read_byte_count_;
+}
+
+void LoopbackLink::End::transmitLocked(std::span<const uint8_t> bytes) {
+    // A byte starts when the previous one has left, back to back for a burst
+    const uint64_t byte_time_ns      = byteTimeNanoseconds(baud_rate_);
+    const uint64_t latency_ns        = static_cast<uint64_t>(link_.model_.latency_us) * 1'000;
+    const bool     rates_match       = baud_rate_ == peer_->baud_rate_;
+    uint64_t       line_free_time_ns = std::max(tx_line_free_time_ns_, link_.nowNanoseconds());
+
+    for (const uint8_t byte : bytes) {
+        line_free_time_ns += byte_time_ns;
+        peer_->in_flight_bytes_.push_back(
+            {.arrival_time_ns = line_free_time_ns + latency_ns, .byte = rates_match ? byte : garble(byte)});
+    }
+    tx_line_free_time_ns_ = line_free_time_ns;
+    transmitted_byte_count_ += bytes.size();
+}
+
+void LoopbackLink::End::receiveArrivedLocked() {
+    const uint64_t now_ns         = link_.nowNanoseconds();
+    const size_t   rx_buffer_size = link_.model_.rx_buffer_size;
+
+    // The buffer only empties by reading, so the bytes that arrived since the last read find it as it is now
+    while (!in_flight_bytes_.empty() && in_flight_bytes_.front().arrival_time_ns <= now_ns) {
+        if (rx_buffer_size != 0 && received_bytes_.size() >= rx_buffer_size) {
+            dropped_byte_count_++;
+        } else {
+            received_bytes_.push_back(in_flight_bytes_.front().byte);
+        }
+        in_flight_bytes_.pop_front();
+    }
+}
+
+}  // namespace drivers::host
@@ -0,0 +1,50 @@
+#include "drivers/host/PolledTimer.h"
+
+namespace drivers::host {
+
+PolledTimer::PolledTimer(interfaces::ClockInterface& clock, FireCallback callback, void* user_data)
+    : clock_(clock), callback_(callback), user_data_(user_data) {}
+
+void PolledTimer::configureInMicroseconds(uint32_t period) { period_us_ = period; }
+
+void PolledTimer::configureInMilliseconds(uint32_t period) { configureInMicroseconds(period * 1'000); }
+
+void PolledTimer::configureInSeconds(uint32_t period) { configureInMilliseconds(period * 1'000); }
+
+void PolledTimer::start() {
+    start_time_us_ = clock_.uptimeMicroseconds();
+    running_       = true;
+}
+
+void PolledTimer::stop() {
+    running_            = false;
+    force_fire_pending_ = false;
+}
+
+void PolledTimer::restart() {
+    // Move forward one period from the previous start time, like the hardware timer
+    start_time_us_ += period_us_;
+    running_ = true;
+}
+
+bool PolledTimer::isRunning() const { return running_; }
+
+uint64_t PolledTimer::getElapsedMicroseconds() const { return clock_.uptimeMicroseconds() - start_time_us_; }
+
+uint64_t PolledTimer::getElapsedMilliseconds() const { return getElapsedMicroseconds() / 1'000; }
+
+uint64_t PolledTimer::getElapsedSeconds() const { return getElapsedMilliseconds() / 1'000; }
+
+void PolledTimer::forceFire() const { force_fire_pending_ = true; }
+
+void PolledTimer::run() {
+    const bool period_has_passed = running_ && clock_.uptimeMicroseconds() - start_time_us_ >= period_us_;
+    if (!period_has_passed && !force_fire_pending_) return;
+
+    // Cancels the upcoming firing like the alarm does, the callback rearms the timer if it is periodic
+    running_            = false;
+    force_fire_pending_ = false;
+    if (callback_ != nullptr) callback_(user_data_);
+}
+
+}  // namespace drivers::host
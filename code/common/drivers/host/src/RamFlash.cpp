@@ -0,0 +1,45 @@
+#include "drivers/host/RamFlash.h"
+
+#include <algorithm>
+
+namespace drivers::host {
+
+RamFlash::RamFlash(size_t sector_size, size_t sector_count)
+    : sector_size_(sector_size), sector_count_(sector_count), bytes_(sector_size * sector_count, K_ERASED_BYTE) {}
+
+size_t RamFlash::getSectorSize() const { return sector_size_; }
+
+size_t RamFlash::getSectorCount() const { return sector_count_; }
+
+bool RamFlash::read(size_t address, std::span<uint8_t> target) {
+    if (!isInRegion(address, target.size_bytes())) return false;
+
+    std::copy_n(bytes_.begin() + static_cast<std::ptrdiff_t>(address), target.size_bytes(), target.begin());
+    return true;
+}
+
+bool RamFlash::program(size_t address, std::span<const uint8_t> data) {
+    if (!isInRegion(address, data.size_bytes())) return false;
+
+    // Programming can only clear bits
+    for (size_t i = 0; i < data.size_bytes(); i++) {
+        bytes_[address + i] &= data[i];
+    }
+    return true;
+}
+
+bool RamFlash::eraseSector(size_t sector_index) {
+    if (sector_index >= sector_count_) return false;
+
+    std::fill_n(bytes_.begin() + static_cast<std::ptrdiff_t>(sector_index * sector_size_), sector_size_,
+                K_ERASED_BYTE);
+    return true;
+}
+
+std::vector<uint8_t>& RamFlash::getBytes() { return bytes_; }
+
+bool RamFlash::isInRegion(size_t address, size_t size) const {
+    return address <= bytes_.size() && size <= bytes_.size() - address;
+}
+
+}  // namespace drivers::host
@@ -0,0 +1,16 @@
+#include "drivers/host/SteadyClock.h"
+
+namespace drivers::host {
+
+SteadyClock::SteadyClock() : start_time_point_(std::chrono::steady_clock::now()) {}
+
+uint64_t SteadyClock::uptimeMicroseconds() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time_point_)
+        .count();
+}
+
+uint64_t SteadyClock::uptimeMilliseconds() { return uptimeMicroseconds() / 1'000; }
+
+uint64_t SteadyClock::uptimeSeconds() { return uptimeMicroseconds() / 1'000'000; }
+
+}  // namespace drivers::host
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "drivers/host/LoopbackLink.h"
+#include "drivers/host/SteadyClock.h"
+
+using namespace drivers::host;
+
+namespace {
+
+class FakeClock final : public drivers::interfaces::ClockInterface {
+public:
+    uint64_t uptimeMicroseconds() override { return now_us; }
+    uint64_t uptimeMilliseconds() override { return now_us / 1'000; }
+    uint64_t uptimeSeconds() override { return now_us / 1'000'000; }
+
+    uint64_t now_us = 0;
+};
+
+std::vector<uint8_t> readAll(LoopbackLink::End& end) {
+    std::vector<uint8_t> bytes(end.getReceivedBytesAvailableAmount());
+    bytes.resize(end.readReceivedBytes(bytes));
+    return bytes;
+}
+
+void countPoll(void* user_data) { (*static_cast<int*>(user_data))++; }
+
+}  // namespace
+
+TEST(LoopbackLink, delivers_bytes_right_away_without_a_model) {
+    FakeClock    clock;
+    LoopbackLink link(clock);
+
+    std::vector<uint8_t> bytes = {1, 2, 3};
+    link.getEndA().transmitBytes(bytes);
+    link.getEndB().transmitByte(9);
+
+    EXPECT_EQ(readAll(link.getEndB()), bytes);
+    EXPECT_EQ(link.getEndA().readReceivedByte(), 9);
+    EXPECT_EQ(link.getEndA().getReceivedBytesAvailableAmount(), 0u);
+}
+
+TEST(LoopbackLink, delays_bytes_by_their_transmission_time_and_the_latency) {
+    FakeClock    clock;
+    LoopbackLink link(clock, {.baud_rate = 1'000'000, .latency_us = 100});  // 10 us per byte
+
+    std::vector<uint8_t> bytes(10, 0x55);
+    link.getEndA().transmitBytes(bytes);
+
+    clock.now_us = 109;
+    EXPECT_EQ(link.getEndB().getReceivedBytesAvailableAmount(), 0u);
+    clock.now_us = 110;
+    EXPECT_EQ(link.getEndB().getReceivedBytesAvailableAmount(), 1u);
+    clock.now_us = 200;
+    EXPECT_EQ(link.getEndB().getReceivedBytesAvailableAmount(), 10u);
+}
+
+TEST(LoopbackLink, queues_a_burst_behind_the_bytes_still_on_the_line) {
+    FakeClock    clock;
+    LoopbackLink link(clock, {.baud_rate = 1'000'000});
+
+    std::vector<uint8_t> bytes(10, 0x55);
+    link.getEndA().transmitBytes(bytes);
+    clock.now_us = 50;
+    link.getEndA().transmitBytes(bytes);
+
+    clock.now_us = 199;
+    EXPECT_EQ(link.getEndB().getReceivedBytesAvailableAmount(), 19u);
+    clock.now_us = 200;
+    EXPECT_EQ(link.getEndB().getReceivedBytesAvailableAmount(), 20u);
+}
+
+TEST(LoopbackLink, garbles_bytes_sent_at_another_baud_rate) {
+    FakeClock    clock;
+    LoopbackLink link(clock);
+
+    ASSERT_TRUE(link.getEndA().setBaudRate(115200));
+    link.getEndA().transmitByte(0x12);
+    clock.now_us = 1'000;
+    EXPECT_NE(link.getEndB().readReceivedByte(), 0x12);
+
+    ASSERT_TRUE(link.getEndB().setBaudRate(115200));
+    link.getEndA().transmitByte(0x12);
+    clock.now_us = 2'000;
+    EXPECT_EQ(link.getEndB().readReceivedByte(), 0x12);
+}
+
+TEST(LoopbackLink, drops_bytes_that_arrive_at_a_full_rx_buffer) {
+    FakeClock    clock;
+    LoopbackLink link(clock, {.rx_buffer_size = 4});
+
+    std::vector<uint8_t> bytes = {1, 2, 3, 4, 5, 6};
+    link.getEndA().transmitBytes(bytes);
+
+    EXPECT_EQ(readAll(link.getEndB()), std::vector<uint8_t>({1, 2, 3, 4}));
+    EXPECT_EQ(link.getEndB().getRxOverflowCount(), 2u);
+
+    link.getEndA().transmitBytes(bytes);
+    EXPECT_EQ(readAll(link.getEndB()).size(), 4u);
+    EXPECT_EQ(link.getEndB().getRxOverflowCount(), 4u);
+}
+
+TEST(LoopbackLink, counts_the_transmitted_and_the_read_bytes) {
+    FakeClock    clock;
+    LoopbackLink link(clock);
+
+    std::vector<uint8_t> bytes = {1, 2, 3};
+    link.getEndA().transmitBytes(bytes);
+    link.getEndA().transmitByte(4);
+    (void)link.getEndB().readReceivedByte();
+
+    EXPECT_EQ(link.getEndA().getTransmittedByteCount(), 4u);
+    EXPECT_EQ(link.getEndB().getReadByteCount(), 1u);
+    EXPECT_EQ(readAll(link.getEndB()).size(), 3u);
+    EXPECT_EQ(link.getEndB().getReadByteCount(), 4u);
+}
+
+TEST(LoopbackLink, invokes_the_poll_callback_before_counting_the_bytes) {
+    FakeClock    clock;
+    LoopbackLink link(clock);
+    int          poll_count = 0;
+
+    link.getEndA().setPollCallback(countPoll, &poll_count);
+    (void)link.getEndA().getReceivedBytesAvailableAmount();
+    (void)link.getEndB().getReceivedBytesAvailableAmount();
+
+    EXPECT_EQ(poll_count, 1);
+}
+
+TEST(LoopbackLink, carries_a_stream_between_threads) {
+    SteadyClock  clock;
+    LoopbackLink link(clock, {.baud_rate = 3'000'000, .latency_us = 20});
+
+    constexpr size_t  K_BYTE_COUNT = 20'000;
+    std::atomic<bool> sent{false};
+    std::thread       sender([&] {
+        for (size_t i = 0; i < K_BYTE_COUNT; i++) link.getEndA().transmitByte(static_cast<uint8_t>(i));
+        sent = true;
+    });
+
+    std::vector<uint8_t> received;
+    while (received.size() < K_BYTE_COUNT) {
+        const std::vector<uint8_t> bytes = readAll(link.getEndB());
+        received.insert(received.end(), bytes.begin(), bytes.end());
+    }
+    sender.join();
+
+    EXPECT_TRUE(sent);
+    for (size_t i = 0; i < K_BYTE_COUNT; i++) ASSERT_EQ(received[i], static_cast<uint8_t>(i));
+}
+
+TEST(LoopbackLink, wait_wakes_up_when_the_peer_transmits) {
+    SteadyClock  clock;
+    LoopbackLink link(clock);
+
+    std::thread sender([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        link.getEndA().transmitByte(7);
+    });
+    const bool     received  = link.getEndB().waitForReceivedBytes(10'000'000);
+    const uint64_t waited_us = clock.uptimeMicroseconds();
+    sender.join();
+
+    EXPECT_TRUE(received);
+    EXPECT_GE(waited_us, 10'000u);
+    EXPECT_LT(waited_us, 5'000'000u);
+    EXPECT_EQ(link.getEndB().readReceivedByte(), 7);
+}
+
+TEST(LoopbackLink, wait_ends_when_the_byte_in_flight_arrives_or_the_timeout_passes) {
+    SteadyClock  clock;
+    LoopbackLink link(clock, {.latency_us = 20'000});
+
+    EXPECT_FALSE(link.getEndB().waitForReceivedBytes(5'000));
+    EXPECT_GE(clock.uptimeMicroseconds(), 5'000u);
+
+    link.getEndA().transmitByte(7);
+    const uint64_t transmit_time_us = clock.uptimeMicroseconds();
+    EXPECT_FALSE(link.getEndB().waitForReceivedBytes(0));
+    EXPECT_TRUE(link.getEndB().waitForReceivedBytes(10'000'000));
+    EXPECT_GE(clock.uptimeMicroseconds() - transmit_time_us, 20'000u);
+}
+
+TEST(LoopbackLink, wait_wakes_up_when_interrupted) {
+    SteadyClock  clock;
+    LoopbackLink link(clock);
+
+    std::thread interrupter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        link.getEndB().interruptWaitForReceivedBytes();
+    });
+    const bool     received  = link.getEndB().waitForReceivedBytes(10'000'000);
+    const uint64_t waited_us = clock.uptimeMicroseconds();
+    interrupter.join();
+
+    EXPECT_FALSE(received);
+    EXPECT_LT(waited_us, 5'000'000u);
+
+    // Interrupted before it starts, the next wait returns right away
+    link.getEndB().interruptWaitForReceivedBytes();
+    EXPECT_FALSE(link.getEndB().waitForReceivedBytes(10'000'000));
+    EXPECT_LT(clock.uptimeMicroseconds(), 5'000'000u);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "drivers/host/PolledTimer.h"
+
+using namespace drivers::host;
+
+namespace {
+
+class FakeClock final : public drivers::interfaces::ClockInterface {
+public:
+    uint64_t uptimeMicroseconds() override { return now_us; }
+    uint64_t uptimeMilliseconds() override { return now_us / 1'000; }
+    uint64_t uptimeSeconds() override { return now_us / 1'000'000; }
+
+    uint64_t now_us = 0;
+};
+
+void countFiring(void* user_data) { (*static_cast<int*>(user_data))++; }
+
+}  // namespace
+
+TEST(PolledTimer, fires_once_from_run_after_the_period) {
+    FakeClock   clock;
+    int         fire_count = 0;
+    PolledTimer timer(clock, countFiring, &fire_count);
+
+    timer.configureInMicroseconds(100);
+    timer.start();
+    clock.now_us = 99;
+    timer.run();
+    EXPECT_EQ(fire_count, 0);
+
+    clock.now_us = 100;
+    timer.run();
+    timer.run();
+    EXPECT_EQ(fire_count, 1);
+    EXPECT_FALSE(timer.isRunning());
+}
+
+TEST(PolledTimer, restart_continues_from_the_previous_start_without_drift) {
+    FakeClock   clock;
+    int         fire_count = 0;
+    PolledTimer timer(clock, countFiring, &fire_count);
+
+    timer.configureInMicroseconds(100);
+    timer.start();
+    clock.now_us = 130;  // Fired late
+    timer.run();
+    timer.restart();
+
+    clock.now_us = 199;
+    timer.run();
+    EXPECT_EQ(fire_count, 1);
+    clock.now_us = 200;
+    timer.run();
+    EXPECT_EQ(fire_count, 2);
+}
+
+TEST(PolledTimer, stop_and_force_fire) {
+    FakeClock   clock;
+    int         fire_count = 0;
+    PolledTimer timer(clock, countFiring, &fire_count);
+
+    timer.configureInMicroseconds(100);
+    timer.start();
+    timer.stop();
+    clock.now_us = 1'000;
+    timer.run();
+    EXPECT_EQ(fire_count, 0);
+
+    timer.forceFire();
+    timer.run();
+    EXPECT_EQ(fire_count, 1);
+}
@@ -42,6 +42,29 @@ public:
      * @return The number of bytes successfully read from the rx buffer.
      */
     virtual size_t readReceivedBytes(std::span<uint8_t> bytes) = 0;
+    /**
+     * @brief Get the number of received bytes that were lost because the rx buffer was full.
+     * Drivers that can't tell how many bytes were lost count every overflow as one.
+     * @return The number of lost bytes since the interface was created.
+     */
+    virtual uint64_t getRxOverflowCount()                      = 0;
+
+    /**
+     * @brief Sleep until received bytes are available or the timeout has passed.
+     * Lets a caller that waits for a response leave the core idle instead of polling the rx buffer in a busy loop.
+     * Drivers that can't sleep return right away, the caller then polls as it would without this.
+     * @param timeout_us How long to wait at most, 0 to only check.
+     * @return true if received bytes are available.
+     */
+    virtual bool waitForReceivedBytes([[maybe_unused]] uint64_t timeout_us) {
+        return getReceivedBytesAvailableAmount() > 0;
+    }
+    /**
+     * @brief Make the `waitForReceivedBytes()` in progress return right away, or the next one if none is.
+     * Unlike the rest of the interface, this can be called from any thread, e.g. to wake up a thread that waits for
+     * the devices when it has other work. Drivers that can't sleep do nothing, their waits return right away anyway.
+     */
+    virtual void interruptWaitForReceivedBytes() {}
 };
 
 }  // namespace drivers::interfaces
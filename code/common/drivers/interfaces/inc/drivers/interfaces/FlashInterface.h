@@ -0,0 +1,64 @@
+#ifndef COMMON_DRIVERS_INTERFACES_FLASHINTERFACE_H
+#define COMMON_DRIVERS_INTERFACES_FLASHINTERFACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace drivers::interfaces {
+
+/**
+ * @brief Interface for a NOR flash like non-volatile memory region.
+ *
+ * The region is divided into equally sized sectors which are the smallest erasable units. Erased bytes read as 0xFF
+ * and programming can only clear bits, so a byte can be programmed again only to clear more of its bits. Programming
+ * is allowed at any address and length, an implementation has to handle the page alignment of the underlying memory.
+ *
+ * Addresses are relative to the beginning of the region.
+ */
+class FlashInterface {
+public:
+    static constexpr uint8_t K_ERASED_BYTE = 0xFF;
+
+    virtual ~FlashInterface() = default;
+
+    /**
+     * @brief Get the size of a sector, the smallest erasable unit, in bytes.
+     */
+    [[nodiscard]] virtual size_t getSectorSize() const = 0;
+
+    /**
+     * @brief Get the amount of sectors in the region.
+     */
+    [[nodiscard]] virtual size_t getSectorCount() const = 0;
+
+    /**
+     * @brief Read bytes from the region.
+     *
+     * @param address Address of the first byte to read.
+     * @param target  Where the bytes are read to, its size tells how many bytes are read.
+     * @return true on success, false if the read failed or was out of the region.
+     */
+    [[nodiscard]] virtual bool read(size_t address, std::span<uint8_t> target) = 0;
+
+    /**
+     * @brief Program bytes to the region. Only clears bits, the bytes should be erased beforehand.
+     *
+     * @param address Address of the first byte to program.
+     * @param data    The bytes to program.
+     * @return true on success, false if the programming failed or was out of the region.
+     */
+    [[nodiscard]] virtual bool program(size_t address, std::span<const uint8_t> data) = 0;
+
+    /**
+     * @brief Erase a sector, setting all of its bytes to K_ERASED_BYTE.
+     *
+     * @param sector_index Index of the sector within the region.
+     * @return true on success, false if the erase failed or the index was out of the region.
+     */
+    [[nodiscard]] virtual bool eraseSector(size_t sector_index) = 0;
+};
+
+}  // namespace drivers::interfaces
+
+#endif  // COMMON_DRIVERS_INTERFACES_FLASHINTERFACE_H
@@ -0,0 +1,41 @@
+#ifndef COMMON_DRIVERS_INTERFACES_SERIALPORTCONFIGURATIONINTERFACE_H
+#define COMMON_DRIVERS_INTERFACES_SERIALPORTCONFIGURATIONINTERFACE_H
+
+#include <cstdint>
+
+namespace drivers::interfaces {
+
+/**
+ * @brief Interface for changing the line settings of a serial port while it is in use.
+ *
+ * Implemented next to BufferedSerialCommunicationInterface by the drivers whose baud rate can be changed at runtime.
+ */
+class SerialPortConfigurationInterface {
+public:
+    virtual ~SerialPortConfigurationInterface() = default;
+
+    /**
+     * @brief Change the baud rate. The data format stays as it is.
+     *
+     * The bytes still being transmitted are sent with the new rate, `flushTx()` first if they must not be.
+     *
+     * @param baud_rate The target baud rate.
+     * @return true if the port runs at the target rate, within the tolerance of the receiver. false if the rate is
+     *         not supported, in which case the port keeps its previous rate.
+     */
+    [[nodiscard]] virtual bool setBaudRate(uint32_t baud_rate) = 0;
+
+    /**
+     * @brief Get the baud rate that was last set.
+     */
+    [[nodiscard]] virtual uint32_t getBaudRate() = 0;
+
+    /**
+     * @brief Wait until every buffered byte has been transmitted.
+     */
+    virtual void flushTx() = 0;
+};
+
+}  // namespace drivers::interfaces
+
+#endif  // COMMON_DRIVERS_INTERFACES_SERIALPORTCONFIGURATIONINTERFACE_H
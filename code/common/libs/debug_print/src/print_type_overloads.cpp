@@ -46,8 +46,9 @@ void printType(uint8_t value) { printType((uint64_t)value); }
 
 void printType(uint16_t value) { printType((uint64_t)value); }
 
-#ifdef __MINGW32__
-// Skip these overloads for MinGW to avoid redefinition when building tests
+#if defined(__MINGW32__) || defined(__linux__)
+// Skip these overloads for MinGW and Linux (uint32_t/int32_t are plain int there) to avoid redefinition when
+// building tests
 #else
 void printType(uint32_t value) { printType((uint64_t)value); }
 #endif
@@ -138,8 +139,9 @@ void printType(int8_t value) { printType((int64_t)value); }
 
 void printType(int16_t value) { printType((int64_t)value); }
 
-#ifdef __MINGW32__
-// Skip these overloads for MinGW to avoid redefinition when building tests
+#if defined(__MINGW32__) || defined(__linux__)
+// Skip these overloads for MinGW and Linux (uint32_t/int32_t are plain int there) to avoid redefinition when
+// building tests
 #else
 void printType(int32_t value) { printType((int64_t)value); }
 #endif
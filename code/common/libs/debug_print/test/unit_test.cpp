@@ -1,7 +1,6 @@
 #include <gtest/gtest.h>
 
 #include <climits>
-#include <format>
 #include <string>
 
 #include "debug_print/debug_print.h"
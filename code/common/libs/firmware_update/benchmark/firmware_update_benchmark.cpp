@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+#include "drivers/host/RamFlash.h"
+#include "firmware_update/FirmwareUpdater.h"
+#include "math/crc.h"
+#include "persistent_storage/RecordStore.h"
+
+using namespace firmware_update;
+
+/**
+ * Times the device side of a firmware update on the host: streaming the image into the slot, erasing ahead between
+ * the chunks the way the main loop does, and the verification and slot swap at the end. The flash is in RAM, so this
+ * is the CPU cost of the update path and not the time the flash chip needs. Reported as bytes per second of image.
+ */
+
+namespace {
+
+constexpr size_t K_SECTOR_SIZE       = 4096;  // RP2040 flash sector
+constexpr size_t K_SLOT_SECTOR_COUNT = 256;
+constexpr size_t K_CHUNK_SIZE        = 250;  // The size of a transfer segment
+
+void BM_streamingUpdate(benchmark::State& state) {
+    const auto image_size = static_cast<size_t>(state.range(0));
+
+    std::mt19937         random(1);
+    std::vector<uint8_t> image(image_size);
+    for (uint8_t& byte : image) byte = static_cast<uint8_t>(random());
+    const uint32_t image_crc = math::generateCrc32(image);
+
+    drivers::host::RamFlash         slot_a(K_SECTOR_SIZE, K_SLOT_SECTOR_COUNT);
+    drivers::host::RamFlash         slot_b(K_SECTOR_SIZE, K_SLOT_SECTOR_COUNT);
+    drivers::host::RamFlash         boot_record_flash(K_SECTOR_SIZE, 2);
+    persistent_storage::RecordStore boot_record_store(boot_record_flash);
+    FirmwareUpdater                 updater(slot_a, slot_b, boot_record_store);
+    if (updater.mount(FirmwareSlot::a) != UpdateResult::ok) state.SkipWithError("mount failed");
+
+    for (auto _ : state) {
+        bool succeeded = updater.beginUpdate(static_cast<uint32_t>(image_size), image_crc) == UpdateResult::ok;
+        for (size_t offset = 0; offset < image_size && succeeded; offset += K_CHUNK_SIZE) {
+            updater.run();
+            const size_t size = std::min(K_CHUNK_SIZE, image_size - offset);
+            succeeded         = updater.write(static_cast<uint32_t>(offset), {&image[offset], size}) == UpdateResult::ok;
+        }
+        succeeded = succeeded && updater.finishUpdate() == UpdateResult::ok;
+        if (!succeeded) state.SkipWithError("update failed");
+        benchmark::DoNotOptimize(succeeded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * image_size));
+}
+
+}  // namespace
+
+BENCHMARK(BM_streamingUpdate)->Arg(64 * 1024)->Arg(512 * 1024)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,137 @@
+#ifndef COMMON_LIBS_FIRMWARE_UPDATE_FIRMWAREUPDATER_H
+#define COMMON_LIBS_FIRMWARE_UPDATE_FIRMWAREUPDATER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/FlashInterface.h"
+#include "firmware_update/FlashStreamWriter.h"
+#include "firmware_update/common.h"
+#include "persistent_storage/RecordStore.h"
+
+namespace firmware_update {
+
+struct SlotInfo {
+    uint32_t image_size = 0;  ///< 0 if the slot has never been written by an update
+    uint32_t image_crc  = 0;
+};
+
+/**
+ * @brief Receives a new firmware image into the slot that is not running and switches the boot to it (A/B update).
+ *
+ * The image is streamed into the inactive slot as it arrives, see FlashStreamWriter. When it has been received
+ * completely its CRC-32 is checked against the one given at the start, and the slot is read back and checked again to
+ * catch programming failures. Only then is the boot record switched to the new slot.
+ *
+ * The boot record lives in a RecordStore of its own, so switching the slot is a single power loss tolerant write.
+ * An update that is interrupted at any point before that leaves the boot record, and the running slot, as they were.
+ *
+ * A device that can only start one of the slots takes the update into use at its next boot, see `prepareActivation()`.
+ */
+class FirmwareUpdater {
+public:
+    static constexpr persistent_storage::RecordKey K_BOOT_RECORD_KEY = 0;
+    // Active slot, then the size and the CRC of the image of both slots
+    static constexpr size_t K_BOOT_RECORD_SIZE = sizeof(uint8_t) + 2 * (sizeof(uint32_t) + sizeof(uint32_t));
+    // Programmed last when an image is copied over the running slot. A boot ROM refuses a slot that starts blank, e.g.
+    // the RP2040 checks the 256 byte second stage boot loader at the start of the image
+    static constexpr size_t K_BOOT_HEADER_SIZE = 256;
+
+    /**
+     * @param slot_a_flash      Region of slot A.
+     * @param slot_b_flash      Region of slot B, the same size as slot A.
+     * @param boot_record_store Store for the boot record only, mounted by this.
+     */
+    FirmwareUpdater(drivers::interfaces::FlashInterface& slot_a_flash,
+                    drivers::interfaces::FlashInterface& slot_b_flash,
+                    persistent_storage::RecordStore&     boot_record_store);
+
+    /**
+     * @brief Load the boot record. The updates are written to the slot other than the running one.
+     *
+     * @param running_slot The slot the firmware is executed from, which is never written to.
+     */
+    [[nodiscard]] UpdateResult mount(FirmwareSlot running_slot);
+
+    /**
+     * @brief Start receiving an image, abandoning an earlier update that has not finished.
+     *
+     * @param image_size Size of the image in bytes.
+     * @param image_crc  CRC-32 of the whole image, see math::generateCrc32.
+     */
+    [[nodiscard]] UpdateResult beginUpdate(uint32_t image_size, uint32_t image_crc);
+
+    /**
+     * @brief Write the next bytes of the image, in order. A write at offset 0 starts the image over.
+     */
+    [[nodiscard]] UpdateResult write(uint32_t offset, std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Erase the update slot ahead of the writing. Non-blocking apart from one sector erase, call from the main
+     *        loop.
+     */
+    void run();
+
+    /**
+     * @brief Verify the received image and make its slot the one booted next.
+     */
+    [[nodiscard]] UpdateResult finishUpdate();
+
+    /**
+     * @brief Take the image of the slot booted next into use on a device that can only start the running slot, e.g.
+     *        whose boot ROM always starts slot A.
+     *
+     * The image is verified and recorded as the image of the running slot, which is booted from then on. It must
+     * then be copied over the running slot before anything else runs from there, see `copyActivatedImage()`. An
+     * image that fails the verification is dropped and the running firmware stays.
+     *
+     * @return ok if the image must now be copied, not_started if no update is waiting to be taken into use.
+     */
+    [[nodiscard]] UpdateResult prepareActivation();
+
+    /**
+     * @brief Copy the image prepared by `prepareActivation()` over the running slot and verify it.
+     *
+     * Only for a slot that is not being executed from, e.g. the device simulator's. The start of the slot is erased
+     * first and its first K_BOOT_HEADER_SIZE bytes are programmed last, so an interrupted copy leaves a slot that the
+     * boot ROM refuses rather than a mix of two images. The firmware copies in the same order from RAM.
+     */
+    [[nodiscard]] UpdateResult copyActivatedImage();
+
+    /**
+     * @brief Check the image in the slot against the size and the CRC in the boot record.
+     */
+    [[nodiscard]] UpdateResult verifySlot(FirmwareSlot slot);
+
+    [[nodiscard]] FirmwareStatus getStatus() const;
+    [[nodiscard]] SlotInfo       getSlotInfo(FirmwareSlot slot) const;
+
+private:
+    drivers::interfaces::FlashInterface* slot_flashes_[2];
+    persistent_storage::RecordStore&     boot_record_store_;
+
+    bool         mounted_      = false;
+    FirmwareSlot running_slot_ = FirmwareSlot::a;
+    FirmwareSlot boot_slot_    = FirmwareSlot::a;
+    SlotInfo     slot_infos_[2];
+
+    FlashStreamWriter slot_a_writer_;
+    FlashStreamWriter slot_b_writer_;
+    UpdateState       update_state_       = UpdateState::idle;
+    uint32_t          expected_image_crc_ = 0;
+
+    uint8_t read_buffer_[256] = {};
+
+private:
+    [[nodiscard]] FirmwareSlot       getUpdateSlot() const;
+    [[nodiscard]] FlashStreamWriter& getUpdateWriter();
+    [[nodiscard]] UpdateResult       computeSlotCrc(FirmwareSlot slot, uint32_t size, uint32_t* crc_out);
+    [[nodiscard]] UpdateResult       copyRange(size_t start, size_t end);
+    [[nodiscard]] UpdateResult       writeBootRecord(FirmwareSlot boot_slot, const SlotInfo (&slot_infos)[2]);
+    UpdateResult                     failUpdate(UpdateResult result);
+};
+
+}  // namespace firmware_update
+
+#endif  // COMMON_LIBS_FIRMWARE_UPDATE_FIRMWAREUPDATER_H
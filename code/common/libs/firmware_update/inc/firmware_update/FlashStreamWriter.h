@@ -0,0 +1,73 @@
+#ifndef COMMON_LIBS_FIRMWARE_UPDATE_FLASHSTREAMWRITER_H
+#define COMMON_LIBS_FIRMWARE_UPDATE_FLASHSTREAMWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/FlashInterface.h"
+#include "firmware_update/common.h"
+
+namespace firmware_update {
+
+/**
+ * @brief Writes a stream of bytes of a known size to a flash region in order, without buffering it.
+ *
+ * Every chunk is programmed as soon as it arrives. The sectors are erased ahead of the writing, one at a time from
+ * `eraseAhead()`, which is meant to be called from the main loop so that the erases happen while the next chunk is
+ * still on its way. A chunk that reaches a sector that has not been erased yet erases it first.
+ *
+ * The CRC-32 of the written bytes is kept along the way.
+ */
+class FlashStreamWriter {
+public:
+    explicit FlashStreamWriter(drivers::interfaces::FlashInterface& flash);
+
+    /**
+     * @brief Start a new stream, abandoning the earlier one.
+     *
+     * @return UpdateResult::image_too_large if the stream does not fit into the region.
+     */
+    [[nodiscard]] UpdateResult begin(uint32_t total_size);
+
+    /**
+     * @brief Program the next bytes of the stream.
+     *
+     * A write at offset 0 starts the stream over, the sectors written by then are erased again.
+     *
+     * @return UpdateResult::out_of_order if the bytes do not continue the stream.
+     */
+    [[nodiscard]] UpdateResult write(uint32_t offset, std::span<const uint8_t> bytes);
+
+    /**
+     * @brief Erase the next sector of the stream that has not been erased yet, if any.
+     */
+    [[nodiscard]] UpdateResult eraseAhead();
+
+    [[nodiscard]] bool     isStarted() const;
+    [[nodiscard]] bool     isComplete() const;
+    [[nodiscard]] uint32_t getWrittenSize() const;
+    [[nodiscard]] uint32_t getTotalSize() const;
+
+    /**
+     * @brief Get the CRC-32 of the bytes written so far.
+     */
+    [[nodiscard]] uint32_t getCrc32() const;
+
+private:
+    drivers::interfaces::FlashInterface& flash_;
+
+    bool     started_             = false;
+    uint32_t total_size_          = 0;
+    uint32_t written_size_        = 0;
+    uint32_t crc_                 = 0;
+    size_t   erased_sector_count_ = 0;  // From the start of the region
+    size_t   stream_sector_count_ = 0;
+
+private:
+    [[nodiscard]] UpdateResult eraseNextSector();
+};
+
+}  // namespace firmware_update
+
+#endif  // COMMON_LIBS_FIRMWARE_UPDATE_FLASHSTREAMWRITER_H
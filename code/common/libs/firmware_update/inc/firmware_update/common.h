@@ -0,0 +1,41 @@
+#ifndef COMMON_LIBS_FIRMWARE_UPDATE_COMMON_H
+#define COMMON_LIBS_FIRMWARE_UPDATE_COMMON_H
+
+#include <cstdint>
+
+namespace firmware_update {
+
+enum class UpdateResult : uint8_t {
+    ok,
+    not_mounted,      ///< mount() has not succeeded yet
+    not_started,      ///< No update is being received
+    image_too_large,  ///< The image does not fit into a slot
+    out_of_order,     ///< The bytes do not continue from where the earlier ones ended
+    incomplete,       ///< Finished before every byte of the image was received
+    crc_mismatch,     ///< The received or the programmed image does not match the CRC given at the start
+    flash_error,      ///< The flash reported a failure
+    storage_error,    ///< The boot record could not be read or written
+};
+
+enum class FirmwareSlot : uint8_t {
+    a = 0,
+    b = 1,
+};
+
+enum class UpdateState : uint8_t {
+    idle,       ///< No update since boot
+    receiving,  ///< The image is being written to the inactive slot
+    complete,   ///< The image was verified and the slot is booted next
+    failed,     ///< The update was rejected, the boot slot is unchanged
+};
+
+struct FirmwareStatus {
+    FirmwareSlot running_slot  = FirmwareSlot::a;
+    FirmwareSlot boot_slot     = FirmwareSlot::a;  ///< The slot started on the next boot
+    UpdateState  update_state  = UpdateState::idle;
+    uint32_t     received_size = 0;  ///< Bytes of the image written in order so far
+};
+
+}  // namespace firmware_update
+
+#endif  // COMMON_LIBS_FIRMWARE_UPDATE_COMMON_H
@@ -0,0 +1,247 @@
+#include "firmware_update/FirmwareUpdater.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "math/crc.h"
+
+namespace firmware_update {
+
+namespace {
+
+size_t slotIndex(FirmwareSlot slot) { return static_cast<size_t>(slot); }
+
+}  // namespace
+
+FirmwareUpdater::FirmwareUpdater(drivers::interfaces::FlashInterface& slot_a_flash,
+                                 drivers::interfaces::FlashInterface& slot_b_flash,
+                                 persistent_storage::RecordStore&     boot_record_store)
+    : slot_flashes_{&slot_a_flash, &slot_b_flash},
+      boot_record_store_(boot_record_store),
+      slot_a_writer_(slot_a_flash),
+      slot_b_writer_(slot_b_flash) {}
+
+UpdateResult FirmwareUpdater::mount(FirmwareSlot running_slot) {
+    mounted_       = false;
+    running_slot_  = running_slot;
+    boot_slot_     = running_slot;
+    slot_infos_[0] = {};
+    slot_infos_[1] = {};
+
+    if (boot_record_store_.mount() != persistent_storage::StorageResult::ok) return UpdateResult::storage_error;
+
+    // Without a readable record the running slot stays the booted one, the record is replaced on the next update
+    uint8_t                                 record[K_BOOT_RECORD_SIZE] = {};
+    size_t                                  record_size                = 0;
+    const persistent_storage::StorageResult read_result =
+        boot_record_store_.read(K_BOOT_RECORD_KEY, record, &record_size);
+    if (read_result == persistent_storage::StorageResult::ok && record_size == K_BOOT_RECORD_SIZE &&
+        record[0] <= static_cast<uint8_t>(FirmwareSlot::b)) {
+        size_t idx = 0;
+        boot_slot_ = static_cast<FirmwareSlot>(record[idx]);
+        idx += sizeof(uint8_t);
+        for (SlotInfo& slot_info : slot_infos_) {
+            std::memcpy(&slot_info.image_size, &record[idx], sizeof(slot_info.image_size));
+            idx += sizeof(slot_info.image_size);
+            std::memcpy(&slot_info.image_crc, &record[idx], sizeof(slot_info.image_crc));
+            idx += sizeof(slot_info.image_crc);
+        }
+    }
+
+    update_state_ = UpdateState::idle;
+    mounted_      = true;
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::beginUpdate(uint32_t image_size, uint32_t image_crc) {
+    if (!mounted_) return UpdateResult::not_mounted;
+
+    // The slot is about to be overwritten, so it must not be booted if this update is interrupted
+    if (boot_slot_ != running_slot_ || slot_infos_[slotIndex(getUpdateSlot())].image_size != 0) {
+        SlotInfo slot_infos[2]                 = {slot_infos_[0], slot_infos_[1]};
+        slot_infos[slotIndex(getUpdateSlot())] = {};
+        const UpdateResult record_result       = writeBootRecord(running_slot_, slot_infos);
+        if (record_result != UpdateResult::ok) return failUpdate(record_result);
+
+        boot_slot_                              = running_slot_;
+        slot_infos_[slotIndex(getUpdateSlot())] = {};
+    }
+
+    const UpdateResult begin_result = getUpdateWriter().begin(image_size);
+    if (begin_result != UpdateResult::ok) return failUpdate(begin_result);
+
+    expected_image_crc_ = image_crc;
+    update_state_       = UpdateState::receiving;
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::write(uint32_t offset, std::span<const uint8_t> bytes) {
+    if (update_state_ != UpdateState::receiving) return UpdateResult::not_started;
+
+    const UpdateResult write_result = getUpdateWriter().write(offset, bytes);
+    // A chunk in the wrong place is the sender's problem and may be followed by the right one
+    if (write_result == UpdateResult::flash_error) return failUpdate(write_result);
+    return write_result;
+}
+
+void FirmwareUpdater::run() {
+    if (update_state_ != UpdateState::receiving) return;
+    if (getUpdateWriter().eraseAhead() != UpdateResult::ok) (void)failUpdate(UpdateResult::flash_error);
+}
+
+UpdateResult FirmwareUpdater::finishUpdate() {
+    if (update_state_ != UpdateState::receiving) return UpdateResult::not_started;
+
+    FlashStreamWriter& writer = getUpdateWriter();
+    if (!writer.isComplete()) return UpdateResult::incomplete;
+    if (writer.getCrc32() != expected_image_crc_) return failUpdate(UpdateResult::crc_mismatch);
+
+    // What was received is right, check that it was also programmed right
+    uint32_t           programmed_crc = 0;
+    const UpdateResult crc_result     = computeSlotCrc(getUpdateSlot(), writer.getTotalSize(), &programmed_crc);
+    if (crc_result != UpdateResult::ok) return failUpdate(crc_result);
+    if (programmed_crc != expected_image_crc_) return failUpdate(UpdateResult::crc_mismatch);
+
+    SlotInfo slot_infos[2]                 = {slot_infos_[0], slot_infos_[1]};
+    slot_infos[slotIndex(getUpdateSlot())] = {.image_size = writer.getTotalSize(), .image_crc = expected_image_crc_};
+    const UpdateResult record_result       = writeBootRecord(getUpdateSlot(), slot_infos);
+    if (record_result != UpdateResult::ok) return failUpdate(record_result);
+
+    boot_slot_     = getUpdateSlot();
+    slot_infos_[0] = slot_infos[0];
+    slot_infos_[1] = slot_infos[1];
+    update_state_  = UpdateState::complete;
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::prepareActivation() {
+    if (!mounted_) return UpdateResult::not_mounted;
+    if (boot_slot_ == running_slot_) return UpdateResult::not_started;
+
+    SlotInfo           slot_infos[2] = {slot_infos_[0], slot_infos_[1]};
+    const UpdateResult verify_result = verifySlot(boot_slot_);
+    if (verify_result == UpdateResult::ok) {
+        slot_infos[slotIndex(running_slot_)] = slot_infos[slotIndex(boot_slot_)];
+    } else {
+        slot_infos[slotIndex(boot_slot_)] = {};
+    }
+
+    // Before the copy, so that it is not done again once the running slot holds the image
+    const UpdateResult record_result = writeBootRecord(running_slot_, slot_infos);
+    if (record_result != UpdateResult::ok) return record_result;
+
+    boot_slot_     = running_slot_;
+    slot_infos_[0] = slot_infos[0];
+    slot_infos_[1] = slot_infos[1];
+    return verify_result;
+}
+
+UpdateResult FirmwareUpdater::copyActivatedImage() {
+    if (!mounted_) return UpdateResult::not_mounted;
+
+    const uint32_t image_size = slot_infos_[slotIndex(running_slot_)].image_size;
+    if (image_size == 0) return UpdateResult::not_started;
+
+    drivers::interfaces::FlashInterface& flash = *slot_flashes_[slotIndex(running_slot_)];
+    if (image_size > flash.getSectorSize() * flash.getSectorCount()) return UpdateResult::image_too_large;
+
+    // The start last, so that the slot is refused by the boot ROM until the rest is in place
+    const size_t sector_size  = flash.getSectorSize();
+    const size_t header_size  = std::min<size_t>(K_BOOT_HEADER_SIZE, image_size);
+    const size_t sector_count = (image_size + sector_size - 1) / sector_size;
+    for (size_t sector_index = 0; sector_index < sector_count; sector_index++) {
+        if (!flash.eraseSector(sector_index)) return UpdateResult::flash_error;
+        const size_t       start       = std::max(sector_index * sector_size, header_size);
+        const size_t       end         = std::min<size_t>((sector_index + 1) * sector_size, image_size);
+        const UpdateResult copy_result = copyRange(start, end);
+        if (copy_result != UpdateResult::ok) return copy_result;
+    }
+    const UpdateResult copy_result = copyRange(0, header_size);
+    if (copy_result != UpdateResult::ok) return copy_result;
+
+    return verifySlot(running_slot_);
+}
+
+UpdateResult FirmwareUpdater::verifySlot(FirmwareSlot slot) {
+    if (!mounted_) return UpdateResult::not_mounted;
+
+    const SlotInfo& slot_info = slot_infos_[slotIndex(slot)];
+    if (slot_info.image_size == 0) return UpdateResult::incomplete;
+
+    uint32_t           crc        = 0;
+    const UpdateResult crc_result = computeSlotCrc(slot, slot_info.image_size, &crc);
+    if (crc_result != UpdateResult::ok) return crc_result;
+    return crc == slot_info.image_crc ? UpdateResult::ok : UpdateResult::crc_mismatch;
+}
+
+FirmwareStatus FirmwareUpdater::getStatus() const {
+    const FlashStreamWriter& writer = getUpdateSlot() == FirmwareSlot::a ? slot_a_writer_ : slot_b_writer_;
+    return {.running_slot  = running_slot_,
+            .boot_slot     = boot_slot_,
+            .update_state  = update_state_,
+            .received_size = update_state_ == UpdateState::idle ? 0 : writer.getWrittenSize()};
+}
+
+SlotInfo FirmwareUpdater::getSlotInfo(FirmwareSlot slot) const { return slot_infos_[slotIndex(slot)]; }
+
+FirmwareSlot FirmwareUpdater::getUpdateSlot() const {
+    return running_slot_ == FirmwareSlot::a ? FirmwareSlot::b : FirmwareSlot::a;
+}
+
+FlashStreamWriter& FirmwareUpdater::getUpdateWriter() {
+    return getUpdateSlot() == FirmwareSlot::a ? slot_a_writer_ : slot_b_writer_;
+}
+
+UpdateResult FirmwareUpdater::computeSlotCrc(FirmwareSlot slot, uint32_t size, uint32_t* crc_out) {
+    drivers::interfaces::FlashInterface& flash = *slot_flashes_[slotIndex(slot)];
+    if (size > flash.getSectorSize() * flash.getSectorCount()) return UpdateResult::image_too_large;
+
+    uint32_t crc = 0;
+    for (uint32_t offset = 0; offset < size;) {
+        const size_t chunk_size = std::min<size_t>(sizeof(read_buffer_), size - offset);
+        if (!flash.read(offset, std::span(read_buffer_).first(chunk_size))) return UpdateResult::flash_error;
+        crc = math::generateCrc32(std::span(read_buffer_).first(chunk_size), crc);
+        offset += static_cast<uint32_t>(chunk_size);
+    }
+    *crc_out = crc;
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::copyRange(size_t start, size_t end) {
+    drivers::interfaces::FlashInterface& source = *slot_flashes_[slotIndex(getUpdateSlot())];
+    drivers::interfaces::FlashInterface& target = *slot_flashes_[slotIndex(running_slot_)];
+
+    for (size_t offset = start; offset < end;) {
+        const size_t chunk_size = std::min<size_t>(sizeof(read_buffer_), end - offset);
+        const auto   chunk      = std::span(read_buffer_).first(chunk_size);
+        if (!source.read(offset, chunk) || !target.program(offset, chunk)) return UpdateResult::flash_error;
+        offset += chunk_size;
+    }
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::writeBootRecord(FirmwareSlot boot_slot, const SlotInfo (&slot_infos)[2]) {
+    uint8_t record[K_BOOT_RECORD_SIZE] = {};
+    size_t  idx                        = 0;
+
+    record[idx] = static_cast<uint8_t>(boot_slot);
+    idx += sizeof(uint8_t);
+    for (const SlotInfo& slot_info : slot_infos) {
+        std::memcpy(&record[idx], &slot_info.image_size, sizeof(slot_info.image_size));
+        idx += sizeof(slot_info.image_size);
+        std::memcpy(&record[idx], &slot_info.image_crc, sizeof(slot_info.image_crc));
+        idx += sizeof(slot_info.image_crc);
+    }
+
+    if (boot_record_store_.write(K_BOOT_RECORD_KEY, record) != persistent_storage::StorageResult::ok) {
+        return UpdateResult::storage_error;
+    }
+    return UpdateResult::ok;
+}
+
+UpdateResult FirmwareUpdater::failUpdate(UpdateResult result) {
+    update_state_ = UpdateState::failed;
+    return result;
+}
+
+}  // namespace firmware_update
@@ -0,0 +1,68 @@
+#include "firmware_update/FlashStreamWriter.h"
+
+#include "math/crc.h"
+
+namespace firmware_update {
+
+FlashStreamWriter::FlashStreamWriter(drivers::interfaces::FlashInterface& flash) : flash_(flash) {}
+
+UpdateResult FlashStreamWriter::begin(uint32_t total_size) {
+    started_ = false;
+    if (total_size > flash_.getSectorSize() * flash_.getSectorCount()) return UpdateResult::image_too_large;
+
+    total_size_          = total_size;
+    written_size_        = 0;
+    crc_                 = 0;
+    erased_sector_count_ = 0;
+    stream_sector_count_ = (total_size + flash_.getSectorSize() - 1) / flash_.getSectorSize();
+    started_             = true;
+    return UpdateResult::ok;
+}
+
+UpdateResult FlashStreamWriter::write(uint32_t offset, std::span<const uint8_t> bytes) {
+    if (!started_) return UpdateResult::not_started;
+
+    // The sender started over, the programmed bytes can only be cleared by erasing
+    if (offset == 0 && written_size_ > 0) {
+        written_size_        = 0;
+        crc_                 = 0;
+        erased_sector_count_ = 0;
+    }
+    if (offset != written_size_) return UpdateResult::out_of_order;
+    if (bytes.size_bytes() > total_size_ - written_size_) return UpdateResult::image_too_large;
+
+    const size_t end = offset + bytes.size_bytes();
+    while (erased_sector_count_ * flash_.getSectorSize() < end) {
+        const UpdateResult erase_result = eraseNextSector();
+        if (erase_result != UpdateResult::ok) return erase_result;
+    }
+
+    if (!flash_.program(offset, bytes)) return UpdateResult::flash_error;
+
+    crc_ = math::generateCrc32(bytes, crc_);
+    written_size_ += static_cast<uint32_t>(bytes.size_bytes());
+    return UpdateResult::ok;
+}
+
+UpdateResult FlashStreamWriter::eraseAhead() {
+    if (!started_ || erased_sector_count_ >= stream_sector_count_) return UpdateResult::ok;
+    return eraseNextSector();
+}
+
+bool FlashStreamWriter::isStarted() const { return started_; }
+
+bool FlashStreamWriter::isComplete() const { return started_ && written_size_ == total_size_; }
+
+uint32_t FlashStreamWriter::getWrittenSize() const { return written_size_; }
+
+uint32_t FlashStreamWriter::getTotalSize() const { return total_size_; }
+
+uint32_t FlashStreamWriter::getCrc32() const { return crc_; }
+
+UpdateResult FlashStreamWriter::eraseNextSector() {
+    if (!flash_.eraseSector(erased_sector_count_)) return UpdateResult::flash_error;
+    erased_sector_count_++;
+    return UpdateResult::ok;
+}
+
+}  // namespace firmware_update
@@ -0,0 +1,396 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "drivers/host/RamFlash.h"
+#include "firmware_update/FirmwareUpdater.h"
+#include "firmware_update/FlashStreamWriter.h"
+#include "math/crc.h"
+#include "persistent_storage/RecordStore.h"
+
+using namespace firmware_update;
+
+namespace {
+
+constexpr size_t K_SECTOR_SIZE              = 512;
+constexpr size_t K_SLOT_SECTOR_COUNT        = 16;
+constexpr size_t K_BOOT_RECORD_SECTOR_COUNT = 2;
+constexpr size_t K_CHUNK_SIZE               = 250;  // The size of a transfer segment
+
+// Shared by the flash regions of a device, the power is cut once the operations run out
+struct PowerSupply {
+    size_t operation_budget = std::numeric_limits<size_t>::max();
+};
+
+/**
+ * @brief Counts the flash operations and can cut the power after a budget of them.
+ *
+ * Once the budget runs out every operation fails, as if the device had lost its power. The RAM flash behind it keeps
+ * what was done before that, like the flash chip would.
+ */
+class InstrumentedFlash final : public drivers::interfaces::FlashInterface {
+public:
+    explicit InstrumentedFlash(drivers::interfaces::FlashInterface& flash, PowerSupply* power = nullptr)
+        : flash_(flash), power_(power) {}
+
+    size_t getSectorSize() const override { return flash_.getSectorSize(); }
+    size_t getSectorCount() const override { return flash_.getSectorCount(); }
+
+    bool read(size_t address, std::span<uint8_t> target) override {
+        if (!consumeBudget()) return false;
+        return flash_.read(address, target);
+    }
+
+    bool program(size_t address, std::span<const uint8_t> data) override {
+        if (!consumeBudget()) return false;
+        program_count++;
+        return flash_.program(address, data);
+    }
+
+    bool eraseSector(size_t sector_index) override {
+        if (!consumeBudget()) return false;
+        erase_count++;
+        return flash_.eraseSector(sector_index);
+    }
+
+    size_t program_count = 0;
+    size_t erase_count   = 0;
+
+private:
+    drivers::interfaces::FlashInterface& flash_;
+    PowerSupply*                         power_;
+
+    bool consumeBudget() {
+        if (power_ == nullptr) return true;
+        if (power_->operation_budget == 0) return false;
+        power_->operation_budget--;
+        return true;
+    }
+};
+
+std::vector<uint8_t> makeImage(size_t size, uint32_t seed) {
+    std::mt19937         random(seed);
+    std::vector<uint8_t> image(size);
+    for (uint8_t& byte : image) byte = static_cast<uint8_t>(random());
+    return image;
+}
+
+uint32_t crcOf(const std::vector<uint8_t>& image) { return math::generateCrc32(image); }
+
+// The flash chip survives the reboots, the objects in RAM do not
+class FirmwareUpdaterTest : public ::testing::Test {
+protected:
+    void SetUp() override { reboot(); }
+
+    void reboot() {
+        updater_.reset();
+        store_.reset();
+        boot_record_.reset();
+        slot_a_.reset();
+        slot_b_.reset();
+
+        power_       = {};
+        slot_a_      = std::make_unique<InstrumentedFlash>(slot_a_flash_, &power_);
+        slot_b_      = std::make_unique<InstrumentedFlash>(slot_b_flash_, &power_);
+        boot_record_ = std::make_unique<InstrumentedFlash>(boot_record_flash_, &power_);
+        store_       = std::make_unique<persistent_storage::RecordStore>(*boot_record_);
+        updater_     = std::make_unique<FirmwareUpdater>(*slot_a_, *slot_b_, *store_);
+    }
+
+    void rebootAndMount(FirmwareSlot running_slot = FirmwareSlot::a) {
+        reboot();
+        ASSERT_EQ(updater_->mount(running_slot), UpdateResult::ok);
+    }
+
+    // Writes the image in transfer sized chunks, running the main loop between them
+    UpdateResult streamImage(const std::vector<uint8_t>& image) {
+        for (size_t offset = 0; offset < image.size(); offset += K_CHUNK_SIZE) {
+            updater_->run();
+            const size_t       size   = std::min(K_CHUNK_SIZE, image.size() - offset);
+            const UpdateResult result = updater_->write(static_cast<uint32_t>(offset), {&image[offset], size});
+            if (result != UpdateResult::ok) return result;
+        }
+        return UpdateResult::ok;
+    }
+
+    UpdateResult update(const std::vector<uint8_t>& image) {
+        UpdateResult result = updater_->beginUpdate(static_cast<uint32_t>(image.size()), crcOf(image));
+        if (result != UpdateResult::ok) return result;
+        result = streamImage(image);
+        if (result != UpdateResult::ok) return result;
+        return updater_->finishUpdate();
+    }
+
+    drivers::host::RamFlash slot_a_flash_{K_SECTOR_SIZE, K_SLOT_SECTOR_COUNT};
+    drivers::host::RamFlash slot_b_flash_{K_SECTOR_SIZE, K_SLOT_SECTOR_COUNT};
+    drivers::host::RamFlash boot_record_flash_{K_SECTOR_SIZE, K_BOOT_RECORD_SECTOR_COUNT};
+
+    PowerSupply                                      power_;
+    std::unique_ptr<InstrumentedFlash>               slot_a_;
+    std::unique_ptr<InstrumentedFlash>               slot_b_;
+    std::unique_ptr<InstrumentedFlash>               boot_record_;
+    std::unique_ptr<persistent_storage::RecordStore> store_;
+    std::unique_ptr<FirmwareUpdater>                 updater_;
+};
+
+}  // namespace
+
+TEST(FlashStreamWriter, erases_ahead_and_programs_in_order) {
+    drivers::host::RamFlash flash(K_SECTOR_SIZE, 4);
+    std::fill(flash.getBytes().begin(), flash.getBytes().end(), 0x00);  // Left over from earlier contents
+    InstrumentedFlash instrumented_flash(flash);
+    FlashStreamWriter writer(instrumented_flash);
+    const auto        image = makeImage(3 * K_SECTOR_SIZE + 10, 1);
+
+    ASSERT_EQ(writer.begin(static_cast<uint32_t>(image.size())), UpdateResult::ok);
+    for (size_t i = 0; i < 10; i++) ASSERT_EQ(writer.eraseAhead(), UpdateResult::ok);
+    // Only the sectors of the image are erased
+    EXPECT_EQ(instrumented_flash.erase_count, 4u);
+
+    ASSERT_EQ(writer.write(0, {image.data(), 100}), UpdateResult::ok);
+    EXPECT_EQ(writer.write(200, {image.data() + 200, 100}), UpdateResult::out_of_order);
+    ASSERT_EQ(writer.write(100, {image.data() + 100, image.size() - 100}), UpdateResult::ok);
+
+    EXPECT_TRUE(writer.isComplete());
+    EXPECT_EQ(writer.getCrc32(), crcOf(image));
+    EXPECT_EQ(instrumented_flash.erase_count, 4u);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), flash.getBytes().begin()));
+}
+
+TEST(FlashStreamWriter, erases_on_demand_without_erase_ahead) {
+    drivers::host::RamFlash flash(K_SECTOR_SIZE, 4);
+    std::fill(flash.getBytes().begin(), flash.getBytes().end(), 0x00);
+    FlashStreamWriter writer(flash);
+    const auto        image = makeImage(2 * K_SECTOR_SIZE, 2);
+
+    ASSERT_EQ(writer.begin(static_cast<uint32_t>(image.size())), UpdateResult::ok);
+    ASSERT_EQ(writer.write(0, image), UpdateResult::ok);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), flash.getBytes().begin()));
+}
+
+TEST(FlashStreamWriter, restarting_from_zero_erases_again) {
+    drivers::host::RamFlash flash(K_SECTOR_SIZE, 4);
+    FlashStreamWriter       writer(flash);
+    const auto              first  = makeImage(K_SECTOR_SIZE, 3);
+    const auto              second = makeImage(K_SECTOR_SIZE, 4);
+
+    ASSERT_EQ(writer.begin(K_SECTOR_SIZE), UpdateResult::ok);
+    ASSERT_EQ(writer.write(0, {first.data(), 300}), UpdateResult::ok);
+    ASSERT_EQ(writer.write(0, second), UpdateResult::ok);
+
+    EXPECT_EQ(writer.getCrc32(), crcOf(second));
+    EXPECT_TRUE(std::equal(second.begin(), second.end(), flash.getBytes().begin()));
+}
+
+TEST(FlashStreamWriter, rejects_streams_larger_than_the_region) {
+    drivers::host::RamFlash flash(K_SECTOR_SIZE, 2);
+    FlashStreamWriter       writer(flash);
+    const uint8_t           byte = 0;
+
+    EXPECT_EQ(writer.write(0, {&byte, 1}), UpdateResult::not_started);
+    EXPECT_EQ(writer.begin(2 * K_SECTOR_SIZE + 1), UpdateResult::image_too_large);
+    ASSERT_EQ(writer.begin(1), UpdateResult::ok);
+    const uint8_t two_bytes[2] = {};
+    EXPECT_EQ(writer.write(0, two_bytes), UpdateResult::image_too_large);
+}
+
+TEST_F(FirmwareUpdaterTest, blank_boot_record_boots_the_running_slot) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+
+    const FirmwareStatus status = updater_->getStatus();
+    EXPECT_EQ(status.running_slot, FirmwareSlot::a);
+    EXPECT_EQ(status.boot_slot, FirmwareSlot::a);
+    EXPECT_EQ(status.update_state, UpdateState::idle);
+}
+
+TEST_F(FirmwareUpdaterTest, operations_fail_before_mount) {
+    EXPECT_EQ(updater_->beginUpdate(10, 0), UpdateResult::not_mounted);
+    EXPECT_EQ(updater_->finishUpdate(), UpdateResult::not_started);
+}
+
+TEST_F(FirmwareUpdaterTest, update_writes_the_other_slot_and_swaps_the_boot_slot) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const std::vector<uint8_t> slot_a_before = slot_a_flash_.getBytes();
+    const auto                 image         = makeImage(5'000, 5);
+
+    ASSERT_EQ(update(image), UpdateResult::ok);
+
+    EXPECT_EQ(updater_->getStatus().update_state, UpdateState::complete);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::b);
+    EXPECT_EQ(slot_a_flash_.getBytes(), slot_a_before);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), slot_b_flash_.getBytes().begin()));
+
+    rebootAndMount(FirmwareSlot::b);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::b);
+    EXPECT_EQ(updater_->getSlotInfo(FirmwareSlot::b).image_size, image.size());
+    EXPECT_EQ(updater_->verifySlot(FirmwareSlot::b), UpdateResult::ok);
+
+    // Running from B the next update goes to A
+    const auto next_image = makeImage(3'000, 6);
+    ASSERT_EQ(update(next_image), UpdateResult::ok);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+    EXPECT_TRUE(std::equal(next_image.begin(), next_image.end(), slot_a_flash_.getBytes().begin()));
+}
+
+TEST_F(FirmwareUpdaterTest, activation_copies_the_update_over_the_running_slot) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    EXPECT_EQ(updater_->prepareActivation(), UpdateResult::not_started);
+    const auto image = makeImage(5'000, 12);
+    ASSERT_EQ(update(image), UpdateResult::ok);
+
+    rebootAndMount();
+    ASSERT_EQ(updater_->prepareActivation(), UpdateResult::ok);
+    ASSERT_EQ(updater_->copyActivatedImage(), UpdateResult::ok);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), slot_a_flash_.getBytes().begin()));
+
+    rebootAndMount();
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+    EXPECT_EQ(updater_->getSlotInfo(FirmwareSlot::a).image_size, image.size());
+    EXPECT_EQ(updater_->verifySlot(FirmwareSlot::a), UpdateResult::ok);
+    EXPECT_EQ(updater_->prepareActivation(), UpdateResult::not_started);
+
+    // The next update goes to B again
+    const auto next_image = makeImage(3'000, 13);
+    ASSERT_EQ(update(next_image), UpdateResult::ok);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::b);
+}
+
+TEST_F(FirmwareUpdaterTest, activation_drops_an_image_that_got_corrupted) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    ASSERT_EQ(update(makeImage(2'000, 14)), UpdateResult::ok);
+    slot_b_flash_.getBytes()[100] ^= 0x01;
+    const std::vector<uint8_t> slot_a_before = slot_a_flash_.getBytes();
+
+    rebootAndMount();
+    EXPECT_EQ(updater_->prepareActivation(), UpdateResult::crc_mismatch);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+    EXPECT_EQ(slot_a_flash_.getBytes(), slot_a_before);
+
+    rebootAndMount();
+    EXPECT_EQ(updater_->prepareActivation(), UpdateResult::not_started);
+}
+
+TEST_F(FirmwareUpdaterTest, wrong_crc_keeps_the_boot_slot) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const auto image = makeImage(2'000, 7);
+
+    ASSERT_EQ(updater_->beginUpdate(static_cast<uint32_t>(image.size()), crcOf(image) ^ 1), UpdateResult::ok);
+    ASSERT_EQ(streamImage(image), UpdateResult::ok);
+    EXPECT_EQ(updater_->finishUpdate(), UpdateResult::crc_mismatch);
+
+    EXPECT_EQ(updater_->getStatus().update_state, UpdateState::failed);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+    rebootAndMount();
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+}
+
+TEST_F(FirmwareUpdaterTest, badly_programmed_image_is_caught_by_the_read_back) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const auto image = makeImage(2'000, 8);
+
+    ASSERT_EQ(updater_->beginUpdate(static_cast<uint32_t>(image.size()), crcOf(image)), UpdateResult::ok);
+    ASSERT_EQ(streamImage(image), UpdateResult::ok);
+    slot_b_flash_.getBytes()[1234] ^= 0x10;  // A bit that did not stick
+
+    EXPECT_EQ(updater_->finishUpdate(), UpdateResult::crc_mismatch);
+    EXPECT_EQ(updater_->getStatus().boot_slot, FirmwareSlot::a);
+}
+
+TEST_F(FirmwareUpdaterTest, incomplete_image_is_not_finished) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const auto image = makeImage(2'000, 9);
+
+    ASSERT_EQ(updater_->beginUpdate(static_cast<uint32_t>(image.size()), crcOf(image)), UpdateResult::ok);
+    ASSERT_EQ(updater_->write(0, {image.data(), 1'000}), UpdateResult::ok);
+    EXPECT_EQ(updater_->finishUpdate(), UpdateResult::incomplete);
+    EXPECT_EQ(updater_->getStatus().received_size, 1'000u);
+
+    // Can still be completed
+    ASSERT_EQ(updater_->write(1'000, {image.data() + 1'000, 1'000}), UpdateResult::ok);
+    EXPECT_EQ(updater_->finishUpdate(), UpdateResult::ok);
+}
+
+TEST_F(FirmwareUpdaterTest, too_large_image_is_refused) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    EXPECT_EQ(updater_->beginUpdate(K_SECTOR_SIZE * K_SLOT_SECTOR_COUNT + 1, 0), UpdateResult::image_too_large);
+    EXPECT_EQ(updater_->getStatus().update_state, UpdateState::failed);
+}
+
+TEST_F(FirmwareUpdaterTest, power_loss_at_any_point_of_an_update_leaves_a_bootable_slot) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const auto old_image = makeImage(3'000, 10);
+    ASSERT_EQ(update(old_image), UpdateResult::ok);
+    rebootAndMount(FirmwareSlot::b);
+
+    // Count the flash operations of a whole update, then cut the power after every amount of them
+    const auto new_image = makeImage(4'000, 11);
+    const auto flash_a   = slot_a_flash_.getBytes();
+    const auto flash_b   = slot_b_flash_.getBytes();
+    const auto records   = boot_record_flash_.getBytes();
+    power_               = {};
+    ASSERT_EQ(update(new_image), UpdateResult::ok);
+    const size_t operation_count = std::numeric_limits<size_t>::max() - power_.operation_budget;
+
+    size_t interrupted_updates = 0;
+    for (size_t budget = 0; budget < operation_count; budget++) {
+        slot_a_flash_.getBytes()      = flash_a;
+        slot_b_flash_.getBytes()      = flash_b;
+        boot_record_flash_.getBytes() = records;
+        rebootAndMount(FirmwareSlot::b);
+
+        power_.operation_budget = budget;
+        if (update(new_image) != UpdateResult::ok) interrupted_updates++;
+
+        // After the power comes back the booted slot always holds a whole image
+        rebootAndMount(FirmwareSlot::b);
+        const FirmwareSlot boot_slot = updater_->getStatus().boot_slot;
+        if (boot_slot == FirmwareSlot::a) {
+            EXPECT_EQ(updater_->verifySlot(FirmwareSlot::a), UpdateResult::ok) << budget;
+        } else {
+            EXPECT_EQ(updater_->verifySlot(FirmwareSlot::b), UpdateResult::ok) << budget;
+        }
+
+        // And the update can be done again
+        ASSERT_EQ(update(new_image), UpdateResult::ok) << budget;
+    }
+    EXPECT_EQ(interrupted_updates, operation_count);
+}
+
+TEST_F(FirmwareUpdaterTest, power_loss_during_the_activation_never_leaves_a_mix_of_two_images) {
+    ASSERT_EQ(updater_->mount(FirmwareSlot::a), UpdateResult::ok);
+    const auto old_image = makeImage(3 * K_SECTOR_SIZE, 15);
+    std::copy(old_image.begin(), old_image.end(), slot_a_flash_.getBytes().begin());
+    const auto new_image = makeImage(4'000, 16);
+    ASSERT_EQ(update(new_image), UpdateResult::ok);
+
+    const auto flash_a = slot_a_flash_.getBytes();
+    const auto flash_b = slot_b_flash_.getBytes();
+    const auto records = boot_record_flash_.getBytes();
+    rebootAndMount();
+    ASSERT_EQ(updater_->prepareActivation(), UpdateResult::ok);
+    ASSERT_EQ(updater_->copyActivatedImage(), UpdateResult::ok);
+    const size_t operation_count = std::numeric_limits<size_t>::max() - power_.operation_budget;
+
+    for (size_t budget = 0; budget < operation_count; budget++) {
+        slot_a_flash_.getBytes()      = flash_a;
+        slot_b_flash_.getBytes()      = flash_b;
+        boot_record_flash_.getBytes() = records;
+        rebootAndMount();
+
+        power_.operation_budget = budget;
+        if (updater_->prepareActivation() == UpdateResult::ok) (void)updater_->copyActivatedImage();
+
+        // The slot either holds the old image or the new one, or starts blank so that the boot ROM refuses it
+        const auto is_erased = [](uint8_t byte) { return byte == drivers::interfaces::FlashInterface::K_ERASED_BYTE; };
+        const std::vector<uint8_t>& slot_a   = slot_a_flash_.getBytes();
+        const bool                  is_old   = std::equal(old_image.begin(), old_image.end(), slot_a.begin());
+        const bool                  is_blank =
+            std::all_of(slot_a.begin(), slot_a.begin() + FirmwareUpdater::K_BOOT_HEADER_SIZE, is_erased);
+        const bool                  is_new   = std::equal(new_image.begin(), new_image.end(), slot_a.begin());
+        EXPECT_TRUE(is_old || is_blank || is_new) << budget;
+    }
+}
@@ -0,0 +1,43 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "math/crc.h"
+
+/**
+ * Throughput of the CRCs over the sizes they are used with: packet headers, payloads and firmware image chunks.
+ */
+
+namespace {
+
+std::vector<uint8_t> makeData(size_t size) {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++) data[i] = static_cast<uint8_t>(i * 31);
+    return data;
+}
+
+void BM_generateCrc8(benchmark::State& state) {
+    const std::vector<uint8_t> data = makeData(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(math::generateCrc8(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+void BM_generateCrc32(benchmark::State& state) {
+    const std::vector<uint8_t> data = makeData(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(math::generateCrc32(data));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * data.size()));
+}
+
+}  // namespace
+
+BENCHMARK(BM_generateCrc8)->Arg(4)->Arg(64)->Arg(255)->Arg(4096);
+BENCHMARK(BM_generateCrc32)->Arg(64)->Arg(4096)->Arg(64 * 1024);
+
+BENCHMARK_MAIN();
@@ -9,12 +9,25 @@ namespace math {
 /**
  * @brief Computes CRC-8-CCITT (ATM) over a span of bytes using a lookup table.
  *
- * This implementation uses a precomputed 256-byte lookup table for fast CRC calculation.
+ * This implementation uses a precomputed 256-byte lookup table for fast CRC calculation. Can be computed in pieces
+ * by passing the CRC of the earlier bytes as @p crc.
  *
  * @param data A span of bytes to compute the CRC for.
+ * @param crc  CRC of the preceding data, 0 when starting.
  * @return Computed 8-bit CRC value.
  */
-uint8_t generateCrc8(std::span<uint8_t> data);
+uint8_t generateCrc8(std::span<const uint8_t> data, uint8_t crc = 0);
+
+/**
+ * @brief Computes CRC-32 (IEEE 802.3, same as zlib) over a span of bytes using a lookup table.
+ *
+ * Can be computed in pieces by passing the CRC of the earlier bytes as @p crc.
+ *
+ * @param data A span of bytes to compute the CRC for.
+ * @param crc  CRC of the preceding data, 0 when starting.
+ * @return Computed 32-bit CRC value.
+ */
+uint32_t generateCrc32(std::span<const uint8_t> data, uint32_t crc = 0);
 
 }  // namespace math
 
@@ -1,5 +1,7 @@
 #include "math/crc.h"
 
+#include <array>
+
 namespace math {
 
 /**
@@ -30,12 +32,44 @@ constexpr uint8_t crc8_ccitt_table[256] = {
     0xB2, 0xB5, 0xBC, 0xBB, 0x96, 0x91, 0x98, 0x9F, 0x8A, 0x8D, 0x84, 0x83, 0xDE, 0xD9, 0xD0, 0xD7, 0xC2, 0xC5, 0xCC,
     0xCB, 0xE6, 0xE1, 0xE8, 0xEF, 0xFA, 0xFD, 0xF4, 0xF3};
 
-uint8_t generateCrc8(std::span<uint8_t> data) {
-    uint8_t crc = 0x00;
+uint8_t generateCrc8(std::span<const uint8_t> data, uint8_t crc) {
     for (const uint8_t byte : data) {
         crc = crc8_ccitt_table[crc ^ byte];
     }
     return crc;
 }
 
+namespace {
+
+/**
+ * @brief Lookup table for CRC-32 (IEEE 802.3), generated at compile time
+ *
+ * Polynomial:    0x04C11DB7, 0xEDB88320 reflected
+ * Initial value: 0xFFFFFFFF
+ * Input reflected:  true
+ * Output reflected: true
+ * Final XOR value:  0xFFFFFFFF
+ */
+constexpr auto crc32_table = [] {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1u) != 0 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}();
+
+}  // namespace
+
+uint32_t generateCrc32(std::span<const uint8_t> data, uint32_t crc) {
+    crc = ~crc;
+    for (const uint8_t byte : data) {
+        crc = crc32_table[(crc ^ byte) & 0xFFu] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
 }  // namespace math
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterRegistry.h"
+#include "parameter_system/definition_helpers.h"
+
+using namespace parameter_system;
+
+namespace {
+
+constexpr size_t K_MAX_PARAMETER_COUNT = static_cast<size_t>(K_MAX_PARAMETER_ID) + 1;
+
+uint32_t values[K_MAX_PARAMETER_COUNT] = {};
+
+// Ids are spread evenly over the whole id range
+template <size_t N>
+constexpr ParameterID idOf(size_t index) {
+    return static_cast<ParameterID>(index * K_MAX_PARAMETER_COUNT / N);
+}
+
+template <size_t N, size_t... I>
+constexpr ParameterRegistry<N> makeRegistry(std::index_sequence<I...>) {
+    return ParameterRegistry<N>{
+        RuntimeParameter(ParameterDeclaration<ParameterValueType::uint32>{idOf<N>(I)}, "Benchmark", values[I])...};
+}
+
+template <size_t N>
+constexpr ParameterRegistry<N> K_REGISTRY = makeRegistry<N>(std::make_index_sequence<N>{});
+
+// The lookup that ParameterDatabase used before the id index, kept as the reference point
+const ParameterDefinition* findByLinearScan(std::span<const ParameterDefinition> definitions, ParameterID id) {
+    for (const ParameterDefinition& definition : definitions) {
+        if (definition.getId() == id) return &definition;
+    }
+    return nullptr;
+}
+
+template <size_t N>
+void BM_getParameterDefinitionById(benchmark::State& state) {
+    const ParameterDatabase database(K_REGISTRY<N>);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(database.getParameterDefinitionById(idOf<N>(i++ % N)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <size_t N>
+void BM_linearScanReference(benchmark::State& state) {
+    const ParameterDatabase database(K_REGISTRY<N>);
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(findByLinearScan(database.getParameterDefinitions(), idOf<N>(i++ % N)));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_getParameterDefinitionById, 1);
+BENCHMARK_TEMPLATE(BM_getParameterDefinitionById, 8);
+BENCHMARK_TEMPLATE(BM_getParameterDefinitionById, 32);
+BENCHMARK_TEMPLATE(BM_getParameterDefinitionById, 128);
+BENCHMARK_TEMPLATE(BM_getParameterDefinitionById, K_MAX_PARAMETER_COUNT);
+
+BENCHMARK_TEMPLATE(BM_linearScanReference, 1);
+BENCHMARK_TEMPLATE(BM_linearScanReference, 8);
+BENCHMARK_TEMPLATE(BM_linearScanReference, 32);
+BENCHMARK_TEMPLATE(BM_linearScanReference, 128);
+BENCHMARK_TEMPLATE(BM_linearScanReference, K_MAX_PARAMETER_COUNT);
+
+BENCHMARK_MAIN();
@@ -4,37 +4,34 @@
 #include <span>
 
 #include "parameter_system/ParameterDefinition.h"
+#include "parameter_system/ParameterRegistry.h"
 #include "parameter_system/common.h"
 #include "parameter_system/parameter_type_mappings.h"
 
 namespace parameter_system {
 
+/**
+ * @brief Lookup of the parameters in a ParameterRegistry. Only refers to the registry, which must outlive it.
+ */
 class ParameterDatabase {
 public:
-    explicit ParameterDatabase(std::span<ParameterDefinition*> buffer);
-    ~        ParameterDatabase() = default;
-
-    void saveParameters() {
-        // TODO implement
-    }
-    void loadParameters() {
-        // TODO implement
-    }
-
-    void registerParameter(ParameterDefinition* parameter_definition);
+    template <size_t N>
+    constexpr explicit ParameterDatabase(const ParameterRegistry<N>& registry)
+        : definitions_(registry.getDefinitions()), index_by_id_(registry.getIndexById()) {}
+    ~ParameterDatabase() = default;
 
     [[nodiscard]] size_t getAmountOfRegisteredParameters() const;
 
-    [[nodiscard]] ParameterDefinition* getParameterDefinitionById(ParameterID id) const;
-    [[nodiscard]] ParameterDefinition* getParameterDefinitionByIndex(size_t index) const;
+    [[nodiscard]] const ParameterDefinition* getParameterDefinitionById(ParameterID id) const;
+    [[nodiscard]] const ParameterDefinition* getParameterDefinitionByIndex(size_t index) const;
 
-    [[nodiscard]] std::span<ParameterDefinition*> getParameterDefinitions() const;
+    [[nodiscard]] std::span<const ParameterDefinition> getParameterDefinitions() const;
 
 private:
-    size_t                                  param_registering_index_ = 0;
-    std::span<ParameterDefinition*> buffer_;
+    std::span<const ParameterDefinition>                                   definitions_;  // < Registration order
+    std::span<const uint16_t, static_cast<size_t>(K_MAX_PARAMETER_ID) + 1> index_by_id_;
 };
 
 }  // namespace parameter_system
 
-#endif
\ No newline at end of file
+#endif
@@ -13,6 +13,9 @@ namespace parameter_system {
 
 /**
  * @brief A Parameter definiton used to define and register a parameter on a firmware level.
+ *
+ * Constructible at compile time so that the definitions, including the names, can be placed in flash with
+ * ParameterRegistry. Only the variable the definition points to lives in RAM.
  */
 class ParameterDefinition {
 public:
@@ -22,22 +25,31 @@ public:
      * @tparam T_ValueType  The declared parameter value type.
      * @param declaration   The corresponding parameter declaration.
      * @param read_write_access Read/write access mode.
-     * @param name          Null-terminated parameter name.
+     * @param name          Null-terminated parameter name. Not copied, must have static storage duration.
      * @param category      Logical parameter category (Saved/Runtime/Signal).
      * @param data_ref      Reference to the parameter’s underlying variable.
      * @param on_change_cb  Optional callback invoked when the value changes.
      */
     template <ParameterValueType T_ValueType>
-    ParameterDefinition(const ParameterDeclaration<T_ValueType>& declaration, ReadWriteAccess read_write_access,
-                        const char name[], ParameterCategory category,
-                        typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
-                        ParameterOnChangeCallback                                   on_change_cb) {
+    constexpr ParameterDefinition(const ParameterDeclaration<T_ValueType>& declaration,
+                                  ReadWriteAccess read_write_access, const char name[], ParameterCategory category,
+                                  typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
+                                  ParameterOnChangeCallback                                   on_change_cb)
+        : id_(declaration.id),
+          category_(category),
+          value_type_(declaration.param_value_type),
+          read_write_access_(read_write_access),
+          pointed_data_size_(sizeof(typename MapParameterValueTypeToCppType<T_ValueType>::type)),
+          name_(name),
+          on_change_callback_(on_change_cb),
+          data_ptr_(&data_ref) {
         // Category drives the access design:
         //   Signal               — only the device sets, master can only read.
         //   Saved / Runtime      — master writes, device reads. Always read_write.
         // The helper constructors (SignalParameter / SavedParameter / RuntimeParameter)
         // pin the right access automatically; this guard catches anyone constructing
         // ParameterDefinition directly with a mismatched pair.
+        // When constructed at compile time a failing assertion is a compile error.
         switch (category) {
             case ParameterCategory::signal:
                 ASSERT_WITH_MESSAGE(read_write_access == ReadWriteAccess::read_only,
@@ -50,39 +62,31 @@ public:
                 break;
         }
 
-        meta_data_.id                = declaration.id;
-        meta_data_.read_write_access = read_write_access;
-        meta_data_.category          = category;
-        meta_data_.value_type        = declaration.param_value_type;
-        // copy the name to the metadata
         for (size_t i = 0; i < ParameterMetaData::K_PARAMETER_NAME_MAX_LENGTH; i++) {
-            meta_data_.name[i] = name[i];
-
             if (name[i] == '\0') break;
             if (i == ParameterMetaData::K_PARAMETER_NAME_MAX_LENGTH - 1)
                 ASSERT_WITH_MESSAGE(name[i] == '\0', "Parameter name is too long");
         }
-
-        on_change_callback_ = on_change_cb;
-        data_ptr_           = &data_ref;
-        pointed_data_size_  = sizeOfCppTypeByParameterValueType(declaration.param_value_type);
     }
 
-    virtual ~ParameterDefinition() = default;
-
     /**
      * @brief Retrieves metadata describing this parameter.
      *
-     * @return A copy of the parameter's metadata structure.
+     * @return A copy of the parameter's metadata structure, including the name.
      */
-    [[nodiscard]] ParameterMetaData getMetaData() const { return meta_data_; }
+    [[nodiscard]] ParameterMetaData getMetaData() const;
+
+    [[nodiscard]] constexpr ParameterID        getId() const { return id_; }
+    [[nodiscard]] constexpr ParameterCategory  getCategory() const { return category_; }
+    [[nodiscard]] constexpr ParameterValueType getValueType() const { return value_type_; }
+    [[nodiscard]] constexpr const char*        getName() const { return name_; }
 
     /**
      * @brief Checks whether the parameter can be written to.
      *
      * @return True if writable, false if read-only.
      */
-    [[nodiscard]] bool valueIsWritable() const { return meta_data_.read_write_access == ReadWriteAccess::read_write; }
+    [[nodiscard]] constexpr bool valueIsWritable() const { return read_write_access_ == ReadWriteAccess::read_write; }
 
     /**
      * @brief Sets the parameter’s value from a raw byte buffer.
@@ -94,7 +98,22 @@ public:
      * @return ReadWriteResult::ok if the value was successfully written,
      *         otherwise ReadWriteResult::not_allowed or ReadWriteResult::buffer_size_mismatch.
      */
-    [[nodiscard]] ReadWriteResult setValueRaw(std::span<uint8_t> buff);
+    [[nodiscard]] ReadWriteResult setValueRaw(std::span<uint8_t> buff) const;
+
+    /**
+     * @brief Same as setValueRaw but does not invoke the on change callback.
+     *
+     * Used when multiple parameters are written together, so that the callbacks can be invoked only after all the
+     * values have been written.
+     */
+    [[nodiscard]] ReadWriteResult setValueRawWithoutNotifying(std::span<const uint8_t> buff) const;
+
+    /**
+     * @brief Retrieves the callback invoked when the value changes.
+     *
+     * @return The callback, nullptr if the parameter has none.
+     */
+    [[nodiscard]] constexpr ParameterOnChangeCallback getOnChangeCallback() const { return on_change_callback_; }
 
     /**
      * @brief Serializes the parameter’s current value into a raw byte buffer.
@@ -106,13 +125,18 @@ public:
      * @param written_bytes_out Optional output. If non-null, set to the number of bytes written into @p target_buff.
      * @return ReadWriteResult::ok if successful, otherwise ReadWriteResult::error.
      */
-    [[nodiscard]] ReadWriteResult getValueRaw(std::span<uint8_t> target_buff, size_t* written_bytes_out = nullptr);
+    [[nodiscard]] ReadWriteResult getValueRaw(std::span<uint8_t> target_buff,
+                                              size_t*            written_bytes_out = nullptr) const;
 
 protected:
-    ParameterMetaData         meta_data_{};
-    ParameterOnChangeCallback on_change_callback_ = nullptr;
-    void*                     data_ptr_ = nullptr;  // < points to a stack allocated object, no any kind of ownership
-    size_t                    pointed_data_size_ = 0;
+    ParameterID               id_;
+    ParameterCategory         category_;
+    ParameterValueType        value_type_;
+    ReadWriteAccess           read_write_access_;
+    uint8_t                   pointed_data_size_;
+    const char*               name_;                // < Not owned, usually a string literal in flash
+    ParameterOnChangeCallback on_change_callback_;
+    void*                     data_ptr_;  // < points to a statically allocated object, no any kind of ownership
 };
 
 }  // namespace parameter_system
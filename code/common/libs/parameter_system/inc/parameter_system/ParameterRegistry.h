@@ -0,0 +1,80 @@
+#ifndef COMMON_LIBS_PARAMETERSYSTEM_PARAMETERREGISTRY_H
+#define COMMON_LIBS_PARAMETERSYSTEM_PARAMETERREGISTRY_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "assert/assert.h"
+#include "parameter_system/ParameterDefinition.h"
+#include "parameter_system/common.h"
+
+namespace parameter_system {
+
+/**
+ * @brief The parameters of the device, built at compile time.
+ *
+ * Holds the definitions in the order they are given together with a table that maps every possible id to the
+ * index of its definition. Declared `constexpr` the whole registry ends up in flash and nothing needs to be registered
+ * at startup:
+ *
+ * @code
+ * constexpr parameter_system::ParameterRegistry parameter_registry{
+ *     parameter_system::SignalParameter(protocol::motor_params::speed, "Speed", speed),
+ *     parameter_system::SavedParameter(protocol::motor_params::max_current, "Max current", max_current),
+ * };
+ * static_assert(parameter_registry.hasUniqueIds(), "Duplicate ParameterID detected");
+ * @endcode
+ *
+ * The variables the definitions point to must have static storage duration for the registry to be constexpr.
+ */
+template <size_t N>
+class ParameterRegistry {
+public:
+    static constexpr uint16_t K_NO_INDEX = std::numeric_limits<uint16_t>::max();
+
+    template <typename... T_Definitions>
+    constexpr explicit ParameterRegistry(const T_Definitions&... definitions)
+        : definitions_{static_cast<const ParameterDefinition&>(definitions)...} {
+        static_assert(N > 0, "Registry must contain at least one parameter");
+
+        index_by_id_.fill(K_NO_INDEX);
+        for (size_t i = 0; i < N; i++) {
+            const ParameterID id = definitions_[i].getId();
+            // Fails the compilation when the registry is constexpr
+            ASSERT_WITH_MESSAGE(index_by_id_[id] == K_NO_INDEX, "Duplicate ParameterID detected");
+            index_by_id_[id] = static_cast<uint16_t>(i);
+        }
+    }
+
+    /**
+     * @brief Checks that no two definitions share an id. Meant for a `static_assert` next to the registry.
+     */
+    [[nodiscard]] constexpr bool hasUniqueIds() const {
+        for (size_t i = 0; i < N; i++) {
+            for (size_t j = i + 1; j < N; j++) {
+                if (definitions_[i].getId() == definitions_[j].getId()) return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] constexpr std::span<const ParameterDefinition> getDefinitions() const { return definitions_; }
+
+    [[nodiscard]] constexpr std::span<const uint16_t, static_cast<size_t>(K_MAX_PARAMETER_ID) + 1> getIndexById()
+        const {
+        return index_by_id_;
+    }
+
+private:
+    std::array<ParameterDefinition, N>                                definitions_;
+    std::array<uint16_t, static_cast<size_t>(K_MAX_PARAMETER_ID) + 1> index_by_id_{};
+};
+
+template <typename... T_Definitions>
+ParameterRegistry(const T_Definitions&...) -> ParameterRegistry<sizeof...(T_Definitions)>;
+
+}  // namespace parameter_system
+
+#endif  // COMMON_LIBS_PARAMETERSYSTEM_PARAMETERREGISTRY_H
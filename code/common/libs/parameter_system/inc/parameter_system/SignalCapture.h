@@ -0,0 +1,149 @@
+#ifndef COMMON_LIBS_PARAMETERSYSTEM_SIGNALCAPTURE_H
+#define COMMON_LIBS_PARAMETERSYSTEM_SIGNALCAPTURE_H
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/ClockInterface.h"
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterDefinition.h"
+#include "parameter_system/common.h"
+
+namespace parameter_system {
+
+enum class CaptureTriggerMode : uint8_t {
+    manual,             ///< Triggered with SignalCapture::trigger()
+    rising_threshold,   ///< Source value crosses the threshold from below
+    falling_threshold,  ///< Source value crosses the threshold from above
+};
+
+enum class CaptureState : uint8_t {
+    idle,       ///< Not armed, nothing captured
+    armed,      ///< Recording pre-trigger samples and waiting for the trigger
+    triggered,  ///< Recording the post-trigger samples
+    complete,   ///< Buffer is ready to be read
+};
+
+enum class CaptureConfigureResult : uint8_t {
+    ok,
+    invalid_id,           ///< Some of the ids is not registered, or no ids were given
+    not_a_signal,         ///< Only signal parameters can be captured
+    invalid_trigger,      ///< Trigger source is not a numeric signal or the mode is unknown
+    too_many_signals,     ///< More ids than K_MAX_SIGNALS
+    buffer_too_small,     ///< Not even two samples fit into the buffer
+    invalid_pre_trigger,  ///< Pre-trigger samples leave no room for samples after the trigger
+    invalid_decimation,   ///< Decimation must be at least 1
+};
+
+struct CaptureConfig {
+    uint16_t           decimation          = 1;  ///< Record every Nth sample() call
+    CaptureTriggerMode trigger_mode        = CaptureTriggerMode::manual;
+    ParameterID        trigger_source_id   = 0;  ///< Signal compared against the threshold, unused for manual
+    float              trigger_threshold   = 0.0f;
+    uint32_t           pre_trigger_samples = 0;  ///< How many samples from before the trigger are kept
+};
+
+struct CaptureStatus {
+    CaptureState state                = CaptureState::idle;
+    uint16_t     sample_size          = 0;  ///< Bytes per sample, values back to back in the configured order
+    uint32_t     sample_count         = 0;  ///< Samples in the buffer, valid when complete
+    uint32_t     trigger_sample_index = 0;  ///< Index of the first sample recorded after the trigger
+    uint32_t     sample_interval_ns   = 0;  ///< Measured mean time between the recorded samples
+};
+
+/**
+ * @brief Records signal parameters at the control loop rate into a RAM buffer, like an oscilloscope.
+ *
+ * Once armed, every `decimation`:th call of `sample()` records the values of the configured signals into a ring
+ * buffer. After the trigger fires the capture continues until the buffer holds `pre_trigger_samples` samples from
+ * before the trigger and fills the rest with samples from after it, and then stops so that the master can download
+ * the buffer at the link's own pace with `readCapturedBytes()`.
+ *
+ * `sample()` is meant to be called from the control loop or a timer interrupt at a fixed rate. `trigger()`,
+ * `getStatus()` and `readCapturedBytes()` can be called while it can run, `arm()` and `disarm()` must not.
+ */
+class SignalCapture {
+public:
+    static constexpr size_t K_MAX_SIGNALS = 16;
+
+    /**
+     * @param parameter_database Database the signals are looked up from.
+     * @param clock              Used to measure the sample interval.
+     * @param buffer             Storage for the samples, no any kind of ownership.
+     */
+    SignalCapture(const ParameterDatabase& parameter_database, drivers::interfaces::ClockInterface& clock,
+                  std::span<uint8_t> buffer);
+    ~SignalCapture() = default;
+
+    /**
+     * @brief Configure the captured signals and the trigger, and start recording.
+     *
+     * Discards an earlier capture. Nothing is changed if the configuration is not valid.
+     *
+     * @param parameter_ids Ids of the signal parameters, in the order their values are placed in a sample.
+     */
+    [[nodiscard]] CaptureConfigureResult arm(std::span<const ParameterID> parameter_ids, const CaptureConfig& config);
+
+    /**
+     * @brief Fire the trigger on the next recorded sample, regardless of the trigger mode.
+     */
+    void trigger();
+
+    /**
+     * @brief Stop recording and discard the capture.
+     */
+    void disarm();
+
+    /**
+     * @brief Record a sample if armed. Call at the rate the signals should be observed.
+     */
+    void sample();
+
+    [[nodiscard]] CaptureStatus getStatus() const;
+
+    /**
+     * @brief Copy captured bytes in chronological order. Only valid when the capture is complete.
+     *
+     * @param byte_offset   Offset from the beginning of the oldest sample.
+     * @param target_buffer Where to copy the bytes.
+     * @return Amount of bytes copied, less than the size of the target buffer at the end of the capture.
+     */
+    [[nodiscard]] size_t readCapturedBytes(size_t byte_offset, std::span<uint8_t> target_buffer) const;
+
+private:
+    const ParameterDatabase&             parameter_database_;
+    drivers::interfaces::ClockInterface& clock_;
+    std::span<uint8_t>                   buffer_;  // < Not owned
+
+    const ParameterDefinition* signals_[K_MAX_SIGNALS] = {};
+    size_t                     signal_count_           = 0;
+    size_t                     sample_size_            = 0;
+    size_t                     capacity_samples_       = 0;
+
+    CaptureConfig              config_{};
+    const ParameterDefinition* trigger_source_ = nullptr;
+
+    // Written by sample() last, so once complete the rest of the capture can be read while sample() can run
+    std::atomic<CaptureState> state_                  = CaptureState::idle;
+    std::atomic<bool>         manual_trigger_pending_ = false;
+
+    bool         has_previous_value_        = false;
+    float        previous_trigger_value_    = 0.0f;
+    uint32_t     decimation_counter_        = 0;
+    size_t       write_index_               = 0;  // < Sample slot written next
+    size_t       recorded_samples_          = 0;  // < Samples in the buffer, at most capacity_samples_
+    size_t       pre_trigger_sample_count_  = 0;
+    size_t       post_trigger_sample_count_ = 0;
+    size_t       post_trigger_remaining_    = 0;
+    uint64_t     trigger_timestamp_us_      = 0;
+    uint64_t     last_timestamp_us_         = 0;
+
+private:
+    [[nodiscard]] bool triggerFires();
+    void               recordSample();
+};
+
+}  // namespace parameter_system
+
+#endif  // COMMON_LIBS_PARAMETERSYSTEM_SIGNALCAPTURE_H
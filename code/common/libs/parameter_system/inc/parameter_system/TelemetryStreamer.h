@@ -0,0 +1,93 @@
+#ifndef COMMON_LIBS_PARAMETERSYSTEM_TELEMETRYSTREAMER_H
+#define COMMON_LIBS_PARAMETERSYSTEM_TELEMETRYSTREAMER_H
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterDefinition.h"
+#include "parameter_system/common.h"
+
+namespace parameter_system {
+
+enum class TelemetrySubscribeResult : uint8_t {
+    ok,
+    invalid_id,        ///< Some of the ids is not registered
+    not_a_signal,      ///< Only signal parameters can be streamed
+    too_many_signals,  ///< More ids than K_MAX_SIGNALS
+    frame_too_large,   ///< Values of the signals do not fit into one frame
+};
+
+/**
+ * @brief Samples a set of signal parameters periodically into compact, sequence numbered telemetry frames.
+ *
+ * `sample()` is meant to be called from a timer interrupt so that the samples are taken at a deterministic rate,
+ * while the frames are taken and transmitted from the main loop with `takeFrame()`.
+ *
+ * Frame layout: [sequence_number (uint16_t)][values back to back in the subscription order]. The sequence number is
+ * incremented on every sample. If a frame has not been taken by the time the next sample is taken, it is replaced by
+ * the newer one, which the receiver sees as a gap in the sequence numbers.
+ */
+class TelemetryStreamer {
+public:
+    static constexpr size_t K_MAX_SIGNALS       = 16;
+    static constexpr size_t K_FRAME_MAX_SIZE    = 128;
+    static constexpr size_t K_FRAME_HEADER_SIZE = sizeof(uint16_t);
+
+    explicit TelemetryStreamer(const ParameterDatabase& parameter_database);
+    ~        TelemetryStreamer() = default;
+
+    /**
+     * @brief Replace the streamed signals.
+     *
+     * Must not be called while `sample()` can run (stop the sampling timer first). Resets the sequence numbering.
+     * The current subscription is kept if the new one is not valid.
+     *
+     * @param parameter_ids Ids of the signal parameters, in the order their values are placed in the frames.
+     */
+    [[nodiscard]] TelemetrySubscribeResult subscribe(std::span<const ParameterID> parameter_ids);
+
+    /**
+     * @brief Stop streaming. Must not be called while `sample()` can run.
+     */
+    void unsubscribe();
+
+    [[nodiscard]] bool   isSubscribed() const;
+    [[nodiscard]] size_t getFrameSize() const;
+
+    /**
+     * @brief Sample the subscribed signals into a new frame. Safe to call from an interrupt.
+     */
+    void sample();
+
+    /**
+     * @brief Copy the latest frame that has not been taken yet.
+     *
+     * @param target_buffer Buffer for the frame, must fit getFrameSize() bytes.
+     * @return Size of the copied frame, 0 if there is no new frame.
+     */
+    [[nodiscard]] size_t takeFrame(std::span<uint8_t> target_buffer);
+
+private:
+    const ParameterDatabase& parameter_database_;
+
+    const ParameterDefinition* signals_[K_MAX_SIGNALS] = {};
+    size_t                     signal_count_           = 0;
+    size_t                     frame_size_             = 0;
+    uint16_t                   sequence_number_        = 0;
+
+    // Triple buffering: sample() writes into a buffer which is neither the latest ready one nor the one being taken,
+    // so the frame being copied in the main loop is never overwritten by the interrupt
+    static constexpr uint8_t K_FRAME_BUFFER_COUNT = 3;
+    static constexpr uint8_t K_NO_BUFFER          = K_FRAME_BUFFER_COUNT;
+
+    uint8_t              frame_buffers_[K_FRAME_BUFFER_COUNT][K_FRAME_MAX_SIZE] = {};
+    std::atomic<uint8_t> ready_buffer_index_                                    = K_NO_BUFFER;
+    std::atomic<uint8_t> taking_buffer_index_                                   = K_NO_BUFFER;
+    std::atomic<bool>    frame_ready_                                           = false;
+};
+
+}  // namespace parameter_system
+
+#endif  // COMMON_LIBS_PARAMETERSYSTEM_TELEMETRYSTREAMER_H
@@ -10,6 +10,7 @@ namespace parameter_system {
 using ParameterID                        = uint8_t;
 using ParameterOnChangeCallback          = void (*)();
 constexpr ParameterID K_MAX_PARAMETER_ID = std::numeric_limits<ParameterID>::max();
+constexpr size_t      K_MAX_VALUE_SIZE   = sizeof(uint64_t);  // Size of the largest parameter value type
 
 enum class ParameterCategory : uint8_t {
     saved_parameter,    ///< Device won't change by itself, value saved between the reboots
@@ -9,8 +9,8 @@ namespace parameter_system {
 class SignalParameter final : public ParameterDefinition {
 public:
     template <ParameterValueType T_ValueType>
-    SignalParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
-                    typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref)
+    constexpr SignalParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
+                              typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref)
         : ParameterDefinition(declaration, ReadWriteAccess::read_only, name, ParameterCategory::signal, data_ref,
                               nullptr) {}
 };
@@ -18,9 +18,9 @@ public:
 class SavedParameter final : public ParameterDefinition {
 public:
     template <ParameterValueType T_ValueType>
-    SavedParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
-                   typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
-                   ParameterOnChangeCallback                                   on_change_callback = nullptr)
+    constexpr SavedParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
+                             typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
+                             ParameterOnChangeCallback                                   on_change_callback = nullptr)
         : ParameterDefinition(declaration, ReadWriteAccess::read_write, name, ParameterCategory::saved_parameter,
                               data_ref, on_change_callback) {}
 };
@@ -28,9 +28,9 @@ public:
 class RuntimeParameter : public ParameterDefinition {
 public:
     template <ParameterValueType T_ValueType>
-    RuntimeParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
-                     typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
-                     ParameterOnChangeCallback                                   on_change_callback = nullptr)
+    constexpr RuntimeParameter(const ParameterDeclaration<T_ValueType>& declaration, const char name[],
+                               typename MapParameterValueTypeToCppType<T_ValueType>::type& data_ref,
+                               ParameterOnChangeCallback                                   on_change_callback = nullptr)
         : ParameterDefinition(declaration, ReadWriteAccess::read_write, name, ParameterCategory::runtime_parameter,
                               data_ref, on_change_callback) {}
 };
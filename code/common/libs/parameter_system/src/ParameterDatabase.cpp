@@ -1,43 +1,24 @@
 #include "parameter_system/ParameterDatabase.h"
 
-#include "assert/assert.h"
-
 namespace parameter_system {
-ParameterDatabase::ParameterDatabase(std::span<ParameterDefinition*> buffer) : buffer_(buffer) {}
-
-void ParameterDatabase::registerParameter(ParameterDefinition* parameter_definition) {
-    ASSERT(parameter_definition != nullptr);
-    ASSERT_WITH_MESSAGE(param_registering_index_ < buffer_.size(),
-                        "Parameter registering index out of bounds. Buffer too small");
-    ASSERT_WITH_MESSAGE(getParameterDefinitionById(parameter_definition->getMetaData().id) == nullptr,
-                        "Parameter already registered with the same id");
-    buffer_[param_registering_index_] = parameter_definition;
-    param_registering_index_++;
-}
-
-size_t ParameterDatabase::getAmountOfRegisteredParameters() const { return param_registering_index_; }
 
-ParameterDefinition* ParameterDatabase::getParameterDefinitionById(ParameterID id) const {
-    for (ParameterDefinition* definition : buffer_) {
-        if (definition == nullptr) continue;
+size_t ParameterDatabase::getAmountOfRegisteredParameters() const { return definitions_.size(); }
 
-        if (definition->getMetaData().id == id) {
-            return definition;
-        }
-    }
+const ParameterDefinition* ParameterDatabase::getParameterDefinitionById(ParameterID id) const {
+    const uint16_t index = index_by_id_[id];
+    if (index >= definitions_.size()) return nullptr;
 
-    return nullptr;
+    return &definitions_[index];
 }
 
-ParameterDefinition* ParameterDatabase::getParameterDefinitionByIndex(size_t index) const {
-    if (index >= param_registering_index_) {
+const ParameterDefinition* ParameterDatabase::getParameterDefinitionByIndex(size_t index) const {
+    if (index >= definitions_.size()) {
         return nullptr;
     }
 
-    return buffer_[index];
-}
-std::span<ParameterDefinition*> ParameterDatabase::getParameterDefinitions() const {
-    return buffer_.subspan(0, param_registering_index_);
+    return &definitions_[index];
 }
 
-}  // namespace parameter_system
\ No newline at end of file
+std::span<const ParameterDefinition> ParameterDatabase::getParameterDefinitions() const { return definitions_; }
+
+}  // namespace parameter_system
@@ -2,11 +2,21 @@
 
 namespace parameter_system {
 
-ReadWriteResult ParameterDefinition::setValueRaw(std::span<uint8_t> buff) {
-    if (!valueIsWritable()) return ReadWriteResult::not_allowed;
-    if (buff.size_bytes() < pointed_data_size_) return ReadWriteResult::buffer_size_mismatch;
+ParameterMetaData ParameterDefinition::getMetaData() const {
+    ParameterMetaData meta_data{};
+    meta_data.id                = id_;
+    meta_data.read_write_access = read_write_access_;
+    meta_data.category          = category_;
+    meta_data.value_type        = value_type_;
+    // The length was checked on construction
+    std::strncpy(meta_data.name, name_, ParameterMetaData::K_PARAMETER_NAME_MAX_LENGTH);
+
+    return meta_data;
+}
 
-    std::memcpy(data_ptr_, buff.data(), pointed_data_size_);
+ReadWriteResult ParameterDefinition::setValueRaw(std::span<uint8_t> buff) const {
+    ReadWriteResult result = setValueRawWithoutNotifying(buff);
+    if (result != ReadWriteResult::ok) return result;
 
     if (on_change_callback_ != nullptr) {
         on_change_callback_();
@@ -15,7 +25,16 @@ ReadWriteResult ParameterDefinition::setValueRaw(std::span<uint8_t> buff) {
     return ReadWriteResult::ok;
 }
 
-ReadWriteResult ParameterDefinition::getValueRaw(std::span<uint8_t> target_buff, size_t* written_bytes_out) {
+ReadWriteResult ParameterDefinition::setValueRawWithoutNotifying(std::span<const uint8_t> buff) const {
+    if (!valueIsWritable()) return ReadWriteResult::not_allowed;
+    if (buff.size_bytes() < pointed_data_size_) return ReadWriteResult::buffer_size_mismatch;
+
+    std::memcpy(data_ptr_, buff.data(), pointed_data_size_);
+
+    return ReadWriteResult::ok;
+}
+
+ReadWriteResult ParameterDefinition::getValueRaw(std::span<uint8_t> target_buff, size_t* written_bytes_out) const {
     if (target_buff.size_bytes() < pointed_data_size_) return ReadWriteResult::buffer_size_mismatch;
 
     std::memcpy(target_buff.data(), data_ptr_, pointed_data_size_);
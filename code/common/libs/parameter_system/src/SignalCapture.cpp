@@ -0,0 +1,234 @@
+#include "parameter_system/SignalCapture.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace parameter_system {
+
+namespace {
+
+template <ParameterValueType T_ValueType>
+float rawToFloat(const uint8_t* raw_value) {
+    typename MapParameterValueTypeToCppType<T_ValueType>::type value;
+    std::memcpy(&value, raw_value, sizeof(value));
+    return static_cast<float>(value);
+}
+
+float readNumericValue(const ParameterDefinition& definition) {
+    uint8_t raw_value[sizeof(uint64_t)] = {};
+    (void)definition.getValueRaw(raw_value);
+
+    switch (definition.getValueType()) {
+        case ParameterValueType::uint8:
+            return rawToFloat<ParameterValueType::uint8>(raw_value);
+        case ParameterValueType::uint16:
+            return rawToFloat<ParameterValueType::uint16>(raw_value);
+        case ParameterValueType::uint32:
+            return rawToFloat<ParameterValueType::uint32>(raw_value);
+        case ParameterValueType::uint64:
+            return rawToFloat<ParameterValueType::uint64>(raw_value);
+        case ParameterValueType::int8:
+            return rawToFloat<ParameterValueType::int8>(raw_value);
+        case ParameterValueType::int16:
+            return rawToFloat<ParameterValueType::int16>(raw_value);
+        case ParameterValueType::int32:
+            return rawToFloat<ParameterValueType::int32>(raw_value);
+        case ParameterValueType::int64:
+            return rawToFloat<ParameterValueType::int64>(raw_value);
+        case ParameterValueType::floating_point:
+            return rawToFloat<ParameterValueType::floating_point>(raw_value);
+        case ParameterValueType::double_float:
+            return rawToFloat<ParameterValueType::double_float>(raw_value);
+        case ParameterValueType::boolean:
+        case ParameterValueType::none:
+            break;
+    }
+    ASSERT_WITH_MESSAGE(false, "Trigger source is not numeric");
+    return 0.0f;
+}
+
+}  // namespace
+
+SignalCapture::SignalCapture(const ParameterDatabase& parameter_database, drivers::interfaces::ClockInterface& clock,
+                             std::span<uint8_t> buffer)
+    : parameter_database_(parameter_database), clock_(clock), buffer_(buffer) {}
+
+CaptureConfigureResult SignalCapture::arm(std::span<const ParameterID> parameter_ids, const CaptureConfig& config) {
+    if (config.decimation == 0) return CaptureConfigureResult::invalid_decimation;
+    if (parameter_ids.empty()) return CaptureConfigureResult::invalid_id;
+    if (parameter_ids.size() > K_MAX_SIGNALS) return CaptureConfigureResult::too_many_signals;
+
+    const ParameterDefinition* new_signals[K_MAX_SIGNALS] = {};
+    size_t                     new_sample_size            = 0;
+    for (size_t i = 0; i < parameter_ids.size(); i++) {
+        const ParameterDefinition* definition = parameter_database_.getParameterDefinitionById(parameter_ids[i]);
+        if (definition == nullptr) return CaptureConfigureResult::invalid_id;
+        if (definition->getCategory() != ParameterCategory::signal) {
+            return CaptureConfigureResult::not_a_signal;
+        }
+
+        new_sample_size += sizeOfCppTypeByParameterValueType(definition->getValueType());
+        new_signals[i]   = definition;
+    }
+
+    const ParameterDefinition* new_trigger_source = nullptr;
+    switch (config.trigger_mode) {
+        case CaptureTriggerMode::manual:
+            break;
+        case CaptureTriggerMode::rising_threshold:
+        case CaptureTriggerMode::falling_threshold:
+            new_trigger_source = parameter_database_.getParameterDefinitionById(config.trigger_source_id);
+            if (new_trigger_source == nullptr ||
+                new_trigger_source->getCategory() != ParameterCategory::signal ||
+                !paramTypeIsNumeric(new_trigger_source->getValueType())) {
+                return CaptureConfigureResult::invalid_trigger;
+            }
+            break;
+        default:
+            return CaptureConfigureResult::invalid_trigger;
+    }
+
+    const size_t new_capacity_samples = buffer_.size_bytes() / new_sample_size;
+    if (new_capacity_samples < 2) return CaptureConfigureResult::buffer_too_small;
+    if (config.pre_trigger_samples >= new_capacity_samples) return CaptureConfigureResult::invalid_pre_trigger;
+
+    std::memcpy(signals_, new_signals, sizeof(signals_));
+    signal_count_     = parameter_ids.size();
+    sample_size_      = new_sample_size;
+    capacity_samples_ = new_capacity_samples;
+    config_           = config;
+    trigger_source_   = new_trigger_source;
+
+    manual_trigger_pending_    = false;
+    has_previous_value_        = false;
+    decimation_counter_        = 0;
+    write_index_               = 0;
+    recorded_samples_          = 0;
+    pre_trigger_sample_count_  = 0;
+    post_trigger_sample_count_ = 0;
+    post_trigger_remaining_    = 0;
+    state_                     = CaptureState::armed;
+
+    return CaptureConfigureResult::ok;
+}
+
+void SignalCapture::trigger() { manual_trigger_pending_ = true; }
+
+void SignalCapture::disarm() {
+    state_                  = CaptureState::idle;
+    manual_trigger_pending_ = false;
+}
+
+void SignalCapture::sample() {
+    if (state_ != CaptureState::armed && state_ != CaptureState::triggered) return;
+
+    decimation_counter_++;
+    if (decimation_counter_ < config_.decimation) return;
+    decimation_counter_ = 0;
+
+    const uint64_t now_us = clock_.uptimeMicroseconds();
+
+    if (state_ == CaptureState::armed) {
+        const bool fires = triggerFires();
+        if (!fires) {
+            recordSample();
+            return;
+        }
+
+        // Keep only the requested amount of history from before the trigger, the rest of the buffer is for the
+        // samples from after it
+        pre_trigger_sample_count_  = std::min<size_t>(recorded_samples_, config_.pre_trigger_samples);
+        post_trigger_remaining_    = capacity_samples_ - pre_trigger_sample_count_;
+        post_trigger_sample_count_ = 0;
+        trigger_timestamp_us_      = now_us;
+        state_                     = CaptureState::triggered;
+    }
+
+    recordSample();
+    post_trigger_sample_count_++;
+    post_trigger_remaining_--;
+    last_timestamp_us_ = now_us;
+
+    if (post_trigger_remaining_ == 0) {
+        state_ = CaptureState::complete;
+    }
+}
+
+CaptureStatus SignalCapture::getStatus() const {
+    CaptureStatus status;
+    status.state       = state_;
+    status.sample_size = static_cast<uint16_t>(sample_size_);
+
+    if (status.state == CaptureState::complete) {
+        status.sample_count         = static_cast<uint32_t>(pre_trigger_sample_count_ + post_trigger_sample_count_);
+        status.trigger_sample_index = static_cast<uint32_t>(pre_trigger_sample_count_);
+        if (post_trigger_sample_count_ > 1) {
+            status.sample_interval_ns = static_cast<uint32_t>((last_timestamp_us_ - trigger_timestamp_us_) * 1'000 /
+                                                              (post_trigger_sample_count_ - 1));
+        }
+    }
+
+    return status;
+}
+
+size_t SignalCapture::readCapturedBytes(size_t byte_offset, std::span<uint8_t> target_buffer) const {
+    if (state_ != CaptureState::complete) return 0;
+
+    const size_t captured_byte_count = (pre_trigger_sample_count_ + post_trigger_sample_count_) * sample_size_;
+    if (byte_offset >= captured_byte_count) return 0;
+
+    const size_t ring_byte_count = capacity_samples_ * sample_size_;
+    // The oldest kept sample is right before the pre-trigger and post-trigger samples in the ring
+    const size_t oldest_sample_slot =
+        (write_index_ + capacity_samples_ - pre_trigger_sample_count_ - post_trigger_sample_count_) % capacity_samples_;
+
+    const size_t copy_byte_count = std::min(target_buffer.size_bytes(), captured_byte_count - byte_offset);
+    size_t       ring_byte_index = (oldest_sample_slot * sample_size_ + byte_offset) % ring_byte_count;
+    size_t       copied          = 0;
+    while (copied < copy_byte_count) {
+        // Copy up to the end of the ring at a time
+        const size_t chunk_size = std::min(copy_byte_count - copied, ring_byte_count - ring_byte_index);
+        std::memcpy(&target_buffer[copied], &buffer_[ring_byte_index], chunk_size);
+        copied          += chunk_size;
+        ring_byte_index  = (ring_byte_index + chunk_size) % ring_byte_count;
+    }
+
+    return copied;
+}
+
+bool SignalCapture::triggerFires() {
+    if (manual_trigger_pending_) {
+        manual_trigger_pending_ = false;
+        return true;
+    }
+    if (trigger_source_ == nullptr) return false;
+
+    const float value              = readNumericValue(*trigger_source_);
+    const bool  had_previous_value = has_previous_value_;
+    const float previous_value     = previous_trigger_value_;
+    previous_trigger_value_        = value;
+    has_previous_value_            = true;
+    if (!had_previous_value) return false;
+
+    if (config_.trigger_mode == CaptureTriggerMode::rising_threshold) {
+        return previous_value < config_.trigger_threshold && value >= config_.trigger_threshold;
+    }
+    return previous_value > config_.trigger_threshold && value <= config_.trigger_threshold;
+}
+
+void SignalCapture::recordSample() {
+    size_t byte_index = write_index_ * sample_size_;
+    for (size_t i = 0; i < signal_count_; i++) {
+        size_t                written_bytes = 0;
+        const ReadWriteResult result = signals_[i]->getValueRaw(buffer_.subspan(byte_index), &written_bytes);
+        ASSERT_WITH_MESSAGE(result == ReadWriteResult::ok, "Captured signal does not fit into the buffer");
+        byte_index += written_bytes;
+    }
+
+    write_index_      = (write_index_ + 1) % capacity_samples_;
+    recorded_samples_ = std::min(recorded_samples_ + 1, capacity_samples_);
+}
+
+}  // namespace parameter_system
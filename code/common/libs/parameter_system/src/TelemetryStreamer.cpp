@@ -0,0 +1,91 @@
+#include "parameter_system/TelemetryStreamer.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace parameter_system {
+
+TelemetryStreamer::TelemetryStreamer(const ParameterDatabase& parameter_database)
+    : parameter_database_(parameter_database) {}
+
+TelemetrySubscribeResult TelemetryStreamer::subscribe(std::span<const ParameterID> parameter_ids) {
+    if (parameter_ids.size() > K_MAX_SIGNALS) return TelemetrySubscribeResult::too_many_signals;
+
+    const ParameterDefinition* new_signals[K_MAX_SIGNALS] = {};
+    size_t                     new_frame_size             = K_FRAME_HEADER_SIZE;
+    for (size_t i = 0; i < parameter_ids.size(); i++) {
+        const ParameterDefinition* definition = parameter_database_.getParameterDefinitionById(parameter_ids[i]);
+        if (definition == nullptr) return TelemetrySubscribeResult::invalid_id;
+
+        if (definition->getCategory() != ParameterCategory::signal) return TelemetrySubscribeResult::not_a_signal;
+
+        new_frame_size += sizeOfCppTypeByParameterValueType(definition->getValueType());
+        if (new_frame_size > K_FRAME_MAX_SIZE) return TelemetrySubscribeResult::frame_too_large;
+
+        new_signals[i] = definition;
+    }
+
+    std::memcpy(signals_, new_signals, sizeof(signals_));
+    signal_count_    = parameter_ids.size();
+    frame_size_      = new_frame_size;
+    sequence_number_ = 0;
+    frame_ready_     = false;
+
+    return TelemetrySubscribeResult::ok;
+}
+
+void TelemetryStreamer::unsubscribe() {
+    signal_count_ = 0;
+    frame_size_   = 0;
+    frame_ready_  = false;
+}
+
+bool TelemetryStreamer::isSubscribed() const { return signal_count_ > 0; }
+
+size_t TelemetryStreamer::getFrameSize() const { return frame_size_; }
+
+void TelemetryStreamer::sample() {
+    if (!isSubscribed()) return;
+
+    // Pick the buffer that is neither ready to be taken nor being taken at the moment
+    const uint8_t ready_index  = ready_buffer_index_;
+    const uint8_t taking_index = taking_buffer_index_;
+    uint8_t       write_index  = 0;
+    while (write_index == ready_index || write_index == taking_index) {
+        write_index++;
+    }
+    uint8_t* frame = frame_buffers_[write_index];
+
+    std::memcpy(frame, &sequence_number_, sizeof(sequence_number_));
+    sequence_number_++;
+
+    size_t frame_index = K_FRAME_HEADER_SIZE;
+    for (size_t i = 0; i < signal_count_; i++) {
+        size_t                written_bytes = 0;
+        const ReadWriteResult result =
+            signals_[i]->getValueRaw({&frame[frame_index], K_FRAME_MAX_SIZE - frame_index}, &written_bytes);
+        ASSERT_WITH_MESSAGE(result == ReadWriteResult::ok, "Subscribed signal does not fit into the frame");
+        frame_index += written_bytes;
+    }
+
+    ready_buffer_index_ = write_index;
+    frame_ready_        = true;
+}
+
+size_t TelemetryStreamer::takeFrame(std::span<uint8_t> target_buffer) {
+    if (!frame_ready_) return 0;
+    ASSERT_WITH_MESSAGE(target_buffer.size_bytes() >= frame_size_, "Target buffer is too small");
+
+    // Mark the buffer as being taken before clearing the flag, a sample taken in between goes to another buffer
+    const uint8_t taking_index = ready_buffer_index_;
+    taking_buffer_index_       = taking_index;
+    frame_ready_               = false;
+
+    std::memcpy(target_buffer.data(), frame_buffers_[taking_index], frame_size_);
+    taking_buffer_index_ = K_NO_BUFFER;
+
+    return frame_size_;
+}
+
+}  // namespace parameter_system
@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterRegistry.h"
+#include "parameter_system/definition_helpers.h"
+
+using namespace parameter_system;
+
+namespace {
+
+constexpr ParameterDeclaration<ParameterValueType::uint16> K_FIRST{200};
+constexpr ParameterDeclaration<ParameterValueType::uint8>  K_SECOND{0};
+constexpr ParameterDeclaration<ParameterValueType::int32>  K_THIRD{K_MAX_PARAMETER_ID};
+
+uint16_t first  = 0;
+uint8_t  second = 0;
+int32_t  third  = 0;
+
+int  on_change_count = 0;
+void onChange() { on_change_count++; }
+
+// Built entirely at compile time, as in the firmware
+constexpr ParameterRegistry registry{
+    SignalParameter(K_FIRST, "First", first),
+    SavedParameter(K_SECOND, "Second", second, onChange),
+    RuntimeParameter(K_THIRD, "Third", third),
+};
+static_assert(registry.hasUniqueIds(), "Duplicate ParameterID detected");
+static_assert(registry.getIndexById()[K_THIRD.id] == 2);
+static_assert(registry.getIndexById()[1] == decltype(registry)::K_NO_INDEX);
+
+constexpr ParameterDatabase database{registry};
+
+}  // namespace
+
+TEST(ParameterDatabase, finds_parameters_by_id) {
+    ASSERT_NE(database.getParameterDefinitionById(K_FIRST.id), nullptr);
+    EXPECT_EQ(database.getParameterDefinitionById(K_FIRST.id)->getId(), K_FIRST.id);
+    EXPECT_EQ(database.getParameterDefinitionById(K_SECOND.id)->getId(), K_SECOND.id);
+    EXPECT_EQ(database.getParameterDefinitionById(K_THIRD.id)->getId(), K_THIRD.id);
+}
+
+TEST(ParameterDatabase, unregistered_ids_are_not_found) {
+    EXPECT_EQ(database.getParameterDefinitionById(1), nullptr);
+    EXPECT_EQ(database.getParameterDefinitionById(K_MAX_PARAMETER_ID - 1), nullptr);
+}
+
+TEST(ParameterDatabase, keeps_registration_order) {
+    ASSERT_EQ(database.getAmountOfRegisteredParameters(), 3u);
+    EXPECT_EQ(database.getParameterDefinitionByIndex(0)->getId(), K_FIRST.id);
+    EXPECT_EQ(database.getParameterDefinitionByIndex(1)->getId(), K_SECOND.id);
+    EXPECT_EQ(database.getParameterDefinitionByIndex(2)->getId(), K_THIRD.id);
+    EXPECT_EQ(database.getParameterDefinitionByIndex(3), nullptr);
+
+    const std::span<const ParameterDefinition> definitions = database.getParameterDefinitions();
+    ASSERT_EQ(definitions.size(), 3u);
+    EXPECT_EQ(&definitions[2], database.getParameterDefinitionById(K_THIRD.id));
+}
+
+TEST(ParameterDatabase, definitions_access_the_variables) {
+    const ParameterDefinition* definition = database.getParameterDefinitionById(K_SECOND.id);
+    ASSERT_NE(definition, nullptr);
+
+    uint8_t new_value = 42;
+    on_change_count   = 0;
+    EXPECT_EQ(definition->setValueRaw({&new_value, 1}), ReadWriteResult::ok);
+    EXPECT_EQ(second, 42);
+    EXPECT_EQ(on_change_count, 1);
+
+    first              = 1337;
+    uint8_t  raw[8]    = {};
+    size_t   written   = 0;
+    uint16_t read_back = 0;
+    EXPECT_EQ(database.getParameterDefinitionById(K_FIRST.id)->getValueRaw(raw, &written), ReadWriteResult::ok);
+    ASSERT_EQ(written, sizeof(uint16_t));
+    std::memcpy(&read_back, raw, sizeof(read_back));
+    EXPECT_EQ(read_back, 1337);
+
+    // Signals are read only for the master
+    EXPECT_EQ(database.getParameterDefinitionById(K_FIRST.id)->setValueRaw(raw), ReadWriteResult::not_allowed);
+}
+
+TEST(ParameterDatabase, metadata_contains_the_name) {
+    const ParameterMetaData meta_data = database.getParameterDefinitionById(K_THIRD.id)->getMetaData();
+
+    EXPECT_EQ(meta_data.id, K_THIRD.id);
+    EXPECT_EQ(meta_data.category, ParameterCategory::runtime_parameter);
+    EXPECT_EQ(meta_data.value_type, ParameterValueType::int32);
+    EXPECT_EQ(meta_data.read_write_access, ReadWriteAccess::read_write);
+    EXPECT_STREQ(meta_data.name, "Third");
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "drivers/interfaces/ClockInterface.h"
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/definition_helpers.h"
+
+using namespace parameter_system;
+
+namespace {
+
+constexpr ParameterDeclaration<ParameterValueType::int16>          K_POSITION{1};
+constexpr ParameterDeclaration<ParameterValueType::floating_point> K_CURRENT{2};
+constexpr ParameterDeclaration<ParameterValueType::uint8>          K_MODE{3};
+
+class FakeClock final : public drivers::interfaces::ClockInterface {
+public:
+    uint64_t uptimeMicroseconds() override { return now_us; }
+    uint64_t uptimeMilliseconds() override { return now_us / 1'000; }
+    uint64_t uptimeSeconds() override { return now_us / 1'000'000; }
+
+    uint64_t now_us = 0;
+};
+
+struct Fixture {
+    int16_t position = 0;
+    float   current  = 0.0f;
+    uint8_t mode     = 0;
+
+    ParameterRegistry<3> registry{SignalParameter{K_POSITION, "Position", position},
+                                  SignalParameter{K_CURRENT, "Current", current}, SavedParameter{K_MODE, "Mode", mode}};
+    ParameterDatabase    database{registry};
+    FakeClock            clock;
+
+    // Emulates one control loop iteration at 10 kHz
+    void step(SignalCapture& capture, int16_t new_position) {
+        position = new_position;
+        current  = static_cast<float>(new_position) / 2.0f;
+        capture.sample();
+        clock.now_us += 100;
+    }
+};
+
+std::vector<int16_t> downloadPositions(const SignalCapture& capture, size_t chunk_size) {
+    const CaptureStatus  status = capture.getStatus();
+    std::vector<uint8_t> bytes(status.sample_count * status.sample_size);
+    for (size_t offset = 0; offset < bytes.size(); offset += chunk_size) {
+        const size_t chunk = std::min(chunk_size, bytes.size() - offset);
+        EXPECT_EQ(capture.readCapturedBytes(offset, {&bytes[offset], chunk}), chunk);
+    }
+
+    std::vector<int16_t> positions;
+    for (size_t i = 0; i < status.sample_count; i++) {
+        int16_t position;
+        std::memcpy(&position, &bytes[i * status.sample_size], sizeof(position));
+        positions.push_back(position);
+    }
+    return positions;
+}
+
+}  // namespace
+
+TEST(SignalCapture, manual_trigger_fills_buffer_after_trigger) {
+    Fixture       fixture;
+    uint8_t       buffer[6 * 4] = {};  // 4 samples of int16 + float
+    SignalCapture capture(fixture.database, fixture.clock, buffer);
+
+    const ParameterID ids[] = {K_POSITION.id, K_CURRENT.id};
+    ASSERT_EQ(capture.arm(ids, {}), CaptureConfigureResult::ok);
+
+    fixture.step(capture, 1);
+    capture.trigger();
+    for (int16_t i = 2; i < 10; i++) fixture.step(capture, i);
+
+    const CaptureStatus status = capture.getStatus();
+    EXPECT_EQ(status.state, CaptureState::complete);
+    EXPECT_EQ(status.sample_size, 6);
+    EXPECT_EQ(status.sample_count, 4);
+    EXPECT_EQ(status.trigger_sample_index, 0);
+    EXPECT_EQ(status.sample_interval_ns, 100'000);
+    EXPECT_EQ(downloadPositions(capture, 5), (std::vector<int16_t>{2, 3, 4, 5}));
+
+    // Current is placed after the position in every sample
+    float current;
+    ASSERT_EQ(capture.readCapturedBytes(sizeof(int16_t), {reinterpret_cast<uint8_t*>(&current), sizeof(current)}),
+              sizeof(current));
+    EXPECT_EQ(current, 1.0f);
+}
+
+TEST(SignalCapture, rising_threshold_keeps_pre_trigger_history) {
+    Fixture       fixture;
+    uint8_t       buffer[sizeof(int16_t) * 8] = {};
+    SignalCapture capture(fixture.database, fixture.clock, buffer);
+
+    const ParameterID ids[] = {K_POSITION.id};
+    CaptureConfig     config;
+    config.trigger_mode        = CaptureTriggerMode::rising_threshold;
+    config.trigger_source_id   = K_CURRENT.id;
+    config.trigger_threshold   = 10.0f;  // current = position / 2
+    config.pre_trigger_samples = 3;
+    ASSERT_EQ(capture.arm(ids, config), CaptureConfigureResult::ok);
+
+    // Wraps the ring multiple times before the trigger
+    for (int16_t i = 0; i < 40; i++) fixture.step(capture, i);
+
+    const CaptureStatus status = capture.getStatus();
+    ASSERT_EQ(status.state, CaptureState::complete);
+    EXPECT_EQ(status.sample_count, 8);
+    EXPECT_EQ(status.trigger_sample_index, 3);
+    EXPECT_EQ(downloadPositions(capture, 3), (std::vector<int16_t>{17, 18, 19, 20, 21, 22, 23, 24}));
+}
+
+TEST(SignalCapture, falling_threshold_and_decimation) {
+    Fixture       fixture;
+    uint8_t       buffer[sizeof(int16_t) * 4] = {};
+    SignalCapture capture(fixture.database, fixture.clock, buffer);
+
+    const ParameterID ids[] = {K_POSITION.id};
+    CaptureConfig     config;
+    config.decimation        = 2;
+    config.trigger_mode      = CaptureTriggerMode::falling_threshold;
+    config.trigger_source_id = K_POSITION.id;
+    config.trigger_threshold = 0.0f;
+    ASSERT_EQ(capture.arm(ids, config), CaptureConfigureResult::ok);
+
+    // Every second step is recorded: 9, 7, ..., 1, -1, ...
+    for (int16_t i = 10; i > -20; i--) fixture.step(capture, i);
+
+    const CaptureStatus status = capture.getStatus();
+    ASSERT_EQ(status.state, CaptureState::complete);
+    EXPECT_EQ(status.sample_interval_ns, 200'000);
+    EXPECT_EQ(downloadPositions(capture, 64), (std::vector<int16_t>{-1, -3, -5, -7}));
+}
+
+TEST(SignalCapture, nothing_is_readable_before_complete) {
+    Fixture       fixture;
+    uint8_t       buffer[sizeof(int16_t) * 4] = {};
+    SignalCapture capture(fixture.database, fixture.clock, buffer);
+
+    const ParameterID ids[] = {K_POSITION.id};
+    ASSERT_EQ(capture.arm(ids, {}), CaptureConfigureResult::ok);
+    for (int16_t i = 0; i < 10; i++) fixture.step(capture, i);
+
+    uint8_t bytes[8];
+    EXPECT_EQ(capture.getStatus().state, CaptureState::armed);
+    EXPECT_EQ(capture.readCapturedBytes(0, bytes), 0);
+}
+
+TEST(SignalCapture, invalid_configurations_are_rejected) {
+    Fixture       fixture;
+    uint8_t       buffer[sizeof(int16_t) * 4] = {};
+    SignalCapture capture(fixture.database, fixture.clock, buffer);
+
+    const ParameterID position[] = {K_POSITION.id};
+    const ParameterID mode[]     = {K_MODE.id};
+    const ParameterID unknown[]  = {42};
+
+    EXPECT_EQ(capture.arm(unknown, {}), CaptureConfigureResult::invalid_id);
+    EXPECT_EQ(capture.arm(mode, {}), CaptureConfigureResult::not_a_signal);
+    EXPECT_EQ(capture.arm(position, {.decimation = 0}), CaptureConfigureResult::invalid_decimation);
+    EXPECT_EQ(capture.arm(position, {.pre_trigger_samples = 4}), CaptureConfigureResult::invalid_pre_trigger);
+
+    CaptureConfig bad_trigger;
+    bad_trigger.trigger_mode      = CaptureTriggerMode::rising_threshold;
+    bad_trigger.trigger_source_id = K_MODE.id;
+    EXPECT_EQ(capture.arm(position, bad_trigger), CaptureConfigureResult::invalid_trigger);
+
+    uint8_t       tiny_buffer[3] = {};
+    SignalCapture tiny_capture(fixture.database, fixture.clock, tiny_buffer);
+    EXPECT_EQ(tiny_capture.arm(position, {}), CaptureConfigureResult::buffer_too_small);
+
+    EXPECT_EQ(capture.getStatus().state, CaptureState::idle);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/TelemetryStreamer.h"
+#include "parameter_system/definition_helpers.h"
+
+using namespace parameter_system;
+
+namespace {
+
+constexpr ParameterDeclaration<ParameterValueType::uint16>         K_SPEED{1};
+constexpr ParameterDeclaration<ParameterValueType::floating_point> K_CURRENT{2};
+constexpr ParameterDeclaration<ParameterValueType::uint8>          K_MODE{3};
+
+struct Fixture {
+    uint16_t speed   = 0;
+    float    current = 0.0f;
+    uint8_t  mode    = 0;
+
+    ParameterRegistry<3> registry{SignalParameter{K_SPEED, "Speed", speed},
+                                  SignalParameter{K_CURRENT, "Current", current}, SavedParameter{K_MODE, "Mode", mode}};
+    ParameterDatabase    database{registry};
+};
+
+template <typename T>
+T readAt(const std::vector<uint8_t>& frame, size_t offset) {
+    T value;
+    std::memcpy(&value, &frame[offset], sizeof(T));
+    return value;
+}
+
+std::vector<uint8_t> takeFrame(TelemetryStreamer& streamer) {
+    std::vector<uint8_t> frame(TelemetryStreamer::K_FRAME_MAX_SIZE);
+    frame.resize(streamer.takeFrame(frame));
+    return frame;
+}
+
+}  // namespace
+
+TEST(TelemetryStreamer, frame_contains_sequence_number_and_values_in_subscription_order) {
+    Fixture           fixture;
+    TelemetryStreamer streamer(fixture.database);
+
+    const ParameterID ids[] = {K_CURRENT.id, K_SPEED.id};
+    ASSERT_EQ(streamer.subscribe(ids), TelemetrySubscribeResult::ok);
+    EXPECT_EQ(streamer.getFrameSize(), TelemetryStreamer::K_FRAME_HEADER_SIZE + sizeof(float) + sizeof(uint16_t));
+
+    fixture.current = 1.5f;
+    fixture.speed   = 1200;
+    streamer.sample();
+
+    std::vector<uint8_t> frame = takeFrame(streamer);
+    ASSERT_EQ(frame.size(), streamer.getFrameSize());
+    EXPECT_EQ(readAt<uint16_t>(frame, 0), 0);
+    EXPECT_EQ(readAt<float>(frame, 2), 1.5f);
+    EXPECT_EQ(readAt<uint16_t>(frame, 6), 1200);
+}
+
+TEST(TelemetryStreamer, no_frame_before_sampling_and_frame_is_taken_only_once) {
+    Fixture           fixture;
+    TelemetryStreamer streamer(fixture.database);
+
+    const ParameterID ids[] = {K_SPEED.id};
+    ASSERT_EQ(streamer.subscribe(ids), TelemetrySubscribeResult::ok);
+
+    EXPECT_TRUE(takeFrame(streamer).empty());
+    streamer.sample();
+    EXPECT_FALSE(takeFrame(streamer).empty());
+    EXPECT_TRUE(takeFrame(streamer).empty());
+}
+
+TEST(TelemetryStreamer, frames_not_taken_in_time_show_up_as_sequence_gaps) {
+    Fixture           fixture;
+    TelemetryStreamer streamer(fixture.database);
+
+    const ParameterID ids[] = {K_SPEED.id};
+    ASSERT_EQ(streamer.subscribe(ids), TelemetrySubscribeResult::ok);
+
+    for (uint16_t i = 0; i < 3; i++) {
+        fixture.speed = i;
+        streamer.sample();
+    }
+
+    std::vector<uint8_t> frame = takeFrame(streamer);
+    EXPECT_EQ(readAt<uint16_t>(frame, 0), 2);
+    EXPECT_EQ(readAt<uint16_t>(frame, 2), 2);
+}
+
+TEST(TelemetryStreamer, invalid_subscriptions_are_rejected) {
+    Fixture           fixture;
+    TelemetryStreamer streamer(fixture.database);
+
+    const ParameterID unknown[] = {42};
+    EXPECT_EQ(streamer.subscribe(unknown), TelemetrySubscribeResult::invalid_id);
+
+    const ParameterID not_signal[] = {K_SPEED.id, K_MODE.id};
+    EXPECT_EQ(streamer.subscribe(not_signal), TelemetrySubscribeResult::not_a_signal);
+
+    std::vector<ParameterID> too_many(TelemetryStreamer::K_MAX_SIGNALS + 1, K_SPEED.id);
+    EXPECT_EQ(streamer.subscribe(too_many), TelemetrySubscribeResult::too_many_signals);
+
+    EXPECT_FALSE(streamer.isSubscribed());
+}
+
+TEST(TelemetryStreamer, unsubscribing_stops_sampling) {
+    Fixture           fixture;
+    TelemetryStreamer streamer(fixture.database);
+
+    const ParameterID ids[] = {K_SPEED.id};
+    ASSERT_EQ(streamer.subscribe(ids), TelemetrySubscribeResult::ok);
+    streamer.unsubscribe();
+    streamer.sample();
+
+    EXPECT_FALSE(streamer.isSubscribed());
+    EXPECT_TRUE(takeFrame(streamer).empty());
+}
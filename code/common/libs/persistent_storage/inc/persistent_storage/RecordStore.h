@@ -0,0 +1,120 @@
+#ifndef COMMON_LIBS_PERSISTENTSTORAGE_RECORDSTORE_H
+#define COMMON_LIBS_PERSISTENTSTORAGE_RECORDSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/FlashInterface.h"
+
+namespace persistent_storage {
+
+using RecordKey = uint8_t;
+
+enum class StorageResult : uint8_t {
+    ok,
+    not_mounted,       ///< mount() has not succeeded yet
+    not_found,         ///< No record with the key
+    buffer_too_small,  ///< The value does not fit into the given buffer
+    value_too_large,   ///< Larger than K_MAX_VALUE_SIZE
+    storage_full,      ///< The latest values of all the keys do not fit into a sector
+    flash_error,       ///< The flash reported a failure
+    invalid_geometry,  ///< The flash region is not usable, e.g. has less than two sectors
+};
+
+/**
+ * @brief Key-value store for small values on flash, with a log-structured and power loss tolerant format.
+ *
+ * Writes are appended as CRC protected records into the active sector and a write of an unchanged value is skipped
+ * entirely. When the active sector is full the latest record of every key is copied into the next sector of the
+ * region, which becomes the active one. The sectors are used in turns so the erases are spread evenly over the region.
+ *
+ * Format of a sector:
+ *   [sector header: magic u32, generation u32, crc32 u32] [record] [record] ... [erased]
+ * Format of a record:
+ *   [key u8, value size u8, reserved u16, crc32 u32 over key, size and value] [value]
+ *
+ * A sector becomes valid only once its header is programmed, which is done last when the records are moved into it.
+ * The valid sector with the highest generation is the active one. A record interrupted by a power loss fails its CRC
+ * check and is ignored, and the next write moves the intact records into a fresh sector.
+ *
+ * Mounting reads only the sector headers and the active sector, so it takes the same time regardless of how many
+ * writes the store has seen.
+ */
+class RecordStore {
+public:
+    static constexpr size_t   K_MAX_VALUE_SIZE     = 64;
+    static constexpr size_t   K_RECORD_HEADER_SIZE = 8;
+    static constexpr size_t   K_SECTOR_HEADER_SIZE = 12;
+    static constexpr uint32_t K_SECTOR_MAGIC       = 0x53435253;  // "SRCS"
+
+    explicit RecordStore(drivers::interfaces::FlashInterface& flash);
+    ~RecordStore() = default;
+
+    /**
+     * @brief Find the active sector and index its records. Formats the region if it has no valid sector.
+     */
+    [[nodiscard]] StorageResult mount();
+
+    /**
+     * @brief Read the latest value of a key.
+     *
+     * @param key             Key of the record.
+     * @param target_buffer   Where the value is copied to.
+     * @param value_size_out  Optional output, set to the size of the stored value.
+     */
+    [[nodiscard]] StorageResult read(RecordKey key, std::span<uint8_t> target_buffer,
+                                     size_t* value_size_out = nullptr);
+
+    /**
+     * @brief Store a value for a key. Nothing is written if the stored value is already the same.
+     */
+    [[nodiscard]] StorageResult write(RecordKey key, std::span<const uint8_t> value);
+
+    [[nodiscard]] bool contains(RecordKey key) const;
+
+    /**
+     * @brief Get the generation of the active sector. Grows by one every time the records are moved to a new sector.
+     */
+    [[nodiscard]] uint32_t getGeneration() const;
+
+private:
+    static constexpr size_t   K_KEY_COUNT = static_cast<size_t>(UINT8_MAX) + 1;
+    static constexpr uint16_t K_NO_RECORD = 0;  // Offset 0 is always the sector header
+
+    drivers::interfaces::FlashInterface& flash_;
+
+    bool     mounted_       = false;
+    size_t   active_sector_ = 0;
+    uint32_t generation_    = 0;
+    size_t   write_offset_  = 0;  // < Offset within the active sector where the next record goes
+
+    // Offset of the latest record of each key within the active sector
+    uint16_t record_offsets_[K_KEY_COUNT] = {};
+
+    uint8_t record_buffer_[K_RECORD_HEADER_SIZE + K_MAX_VALUE_SIZE] = {};
+
+private:
+    [[nodiscard]] size_t getSectorAddress(size_t sector_index) const;
+
+    [[nodiscard]] bool readSectorGeneration(size_t sector_index, uint32_t* generation_out);
+    static void        serializeSectorHeader(uint32_t generation, std::span<uint8_t, K_SECTOR_HEADER_SIZE> target);
+
+    [[nodiscard]] StorageResult startSector(size_t sector_index, uint32_t generation);
+    [[nodiscard]] StorageResult indexActiveSector();
+    [[nodiscard]] bool          isErased(size_t address, size_t size);
+
+    /**
+     * @brief Read and validate the record at the offset within the active sector into record_buffer_.
+     *
+     * @return Size of the whole record, 0 if the record is not valid.
+     */
+    [[nodiscard]] size_t readRecord(size_t offset);
+
+    [[nodiscard]] size_t        serializeRecord(RecordKey key, std::span<const uint8_t> value);
+    [[nodiscard]] StorageResult moveToNextSector(RecordKey pending_key, std::span<const uint8_t> pending_value);
+};
+
+}  // namespace persistent_storage
+
+#endif  // COMMON_LIBS_PERSISTENTSTORAGE_RECORDSTORE_H
@@ -0,0 +1,27 @@
+#ifndef COMMON_LIBS_PERSISTENTSTORAGE_PARAMETER_STORAGE_H
+#define COMMON_LIBS_PERSISTENTSTORAGE_PARAMETER_STORAGE_H
+
+#include "parameter_system/ParameterDatabase.h"
+#include "persistent_storage/RecordStore.h"
+
+namespace persistent_storage {
+
+/**
+ * @brief Store the values of the saved parameters of the database, keyed by their ids. Only the values that have
+ *        changed are written to the flash.
+ */
+[[nodiscard]] StorageResult saveParameters(const parameter_system::ParameterDatabase& parameter_database,
+                                           RecordStore&                               record_store);
+
+/**
+ * @brief Restore the values of the saved parameters of the database.
+ *
+ * Parameters without a stored value, or with a value stored with a different type, keep their current value. The on
+ * change callbacks are not invoked, this is meant to be called at startup before the values are used.
+ */
+[[nodiscard]] StorageResult loadParameters(const parameter_system::ParameterDatabase& parameter_database,
+                                           RecordStore&                               record_store);
+
+}  // namespace persistent_storage
+
+#endif  // COMMON_LIBS_PERSISTENTSTORAGE_PARAMETER_STORAGE_H
@@ -0,0 +1,270 @@
+#include "persistent_storage/RecordStore.h"
+
+#include <cstring>
+
+#include "math/crc.h"
+
+namespace persistent_storage {
+
+namespace {
+
+constexpr size_t K_SECTOR_HEADER_CRC_OFFSET = 8;
+
+uint32_t computeRecordCrc(RecordKey key, std::span<const uint8_t> value) {
+    const uint8_t key_and_size[] = {key, static_cast<uint8_t>(value.size_bytes())};
+    return math::generateCrc32(value, math::generateCrc32(key_and_size));
+}
+
+}  // namespace
+
+RecordStore::RecordStore(drivers::interfaces::FlashInterface& flash) : flash_(flash) {}
+
+StorageResult RecordStore::mount() {
+    mounted_ = false;
+
+    const size_t sector_size = flash_.getSectorSize();
+    if (flash_.getSectorCount() < 2 || sector_size > UINT16_MAX ||
+        sector_size < K_SECTOR_HEADER_SIZE + K_RECORD_HEADER_SIZE + K_MAX_VALUE_SIZE) {
+        return StorageResult::invalid_geometry;
+    }
+
+    bool     found_valid_sector = false;
+    size_t   newest_sector      = 0;
+    uint32_t newest_generation  = 0;
+    for (size_t sector_index = 0; sector_index < flash_.getSectorCount(); sector_index++) {
+        uint32_t generation = 0;
+        if (!readSectorGeneration(sector_index, &generation)) continue;
+
+        if (!found_valid_sector || generation > newest_generation) {
+            found_valid_sector = true;
+            newest_sector      = sector_index;
+            newest_generation  = generation;
+        }
+    }
+
+    StorageResult result = StorageResult::ok;
+    if (found_valid_sector) {
+        active_sector_ = newest_sector;
+        generation_    = newest_generation;
+        result         = indexActiveSector();
+    } else {
+        // Blank or unrecognized region
+        result = startSector(0, 1);
+    }
+
+    mounted_ = result == StorageResult::ok;
+    return result;
+}
+
+StorageResult RecordStore::read(RecordKey key, std::span<uint8_t> target_buffer, size_t* value_size_out) {
+    if (!mounted_) return StorageResult::not_mounted;
+    if (record_offsets_[key] == K_NO_RECORD) return StorageResult::not_found;
+
+    const size_t record_size = readRecord(record_offsets_[key]);
+    if (record_size == 0) return StorageResult::flash_error;  // Was valid when indexed
+
+    const size_t value_size = record_size - K_RECORD_HEADER_SIZE;
+    if (value_size > target_buffer.size_bytes()) return StorageResult::buffer_too_small;
+
+    std::memcpy(target_buffer.data(), &record_buffer_[K_RECORD_HEADER_SIZE], value_size);
+    if (value_size_out != nullptr) *value_size_out = value_size;
+
+    return StorageResult::ok;
+}
+
+StorageResult RecordStore::write(RecordKey key, std::span<const uint8_t> value) {
+    if (!mounted_) return StorageResult::not_mounted;
+    if (value.size_bytes() > K_MAX_VALUE_SIZE) return StorageResult::value_too_large;
+
+    // Unchanged values are not written again to save the flash
+    if (record_offsets_[key] != K_NO_RECORD) {
+        const size_t record_size = readRecord(record_offsets_[key]);
+        if (record_size == K_RECORD_HEADER_SIZE + value.size_bytes() &&
+            std::memcmp(&record_buffer_[K_RECORD_HEADER_SIZE], value.data(), value.size_bytes()) == 0) {
+            return StorageResult::ok;
+        }
+    }
+
+    const size_t record_size = serializeRecord(key, value);
+    if (write_offset_ + record_size > flash_.getSectorSize()) {
+        return moveToNextSector(key, value);
+    }
+
+    if (!flash_.program(getSectorAddress(active_sector_) + write_offset_, {record_buffer_, record_size})) {
+        // The record may be partially programmed, the next write starts a fresh sector
+        write_offset_ = flash_.getSectorSize();
+        return StorageResult::flash_error;
+    }
+
+    record_offsets_[key]  = static_cast<uint16_t>(write_offset_);
+    write_offset_        += record_size;
+
+    return StorageResult::ok;
+}
+
+bool RecordStore::contains(RecordKey key) const { return mounted_ && record_offsets_[key] != K_NO_RECORD; }
+
+uint32_t RecordStore::getGeneration() const { return generation_; }
+
+size_t RecordStore::getSectorAddress(size_t sector_index) const { return sector_index * flash_.getSectorSize(); }
+
+bool RecordStore::readSectorGeneration(size_t sector_index, uint32_t* generation_out) {
+    uint8_t header[K_SECTOR_HEADER_SIZE];
+    if (!flash_.read(getSectorAddress(sector_index), header)) return false;
+
+    uint32_t magic = 0;
+    uint32_t crc   = 0;
+    std::memcpy(&magic, &header[0], sizeof(magic));
+    std::memcpy(generation_out, &header[4], sizeof(*generation_out));
+    std::memcpy(&crc, &header[K_SECTOR_HEADER_CRC_OFFSET], sizeof(crc));
+
+    return magic == K_SECTOR_MAGIC && crc == math::generateCrc32({header, K_SECTOR_HEADER_CRC_OFFSET});
+}
+
+void RecordStore::serializeSectorHeader(uint32_t generation, std::span<uint8_t, K_SECTOR_HEADER_SIZE> target) {
+    std::memcpy(&target[0], &K_SECTOR_MAGIC, sizeof(K_SECTOR_MAGIC));
+    std::memcpy(&target[4], &generation, sizeof(generation));
+    const uint32_t crc = math::generateCrc32(target.first(K_SECTOR_HEADER_CRC_OFFSET));
+    std::memcpy(&target[K_SECTOR_HEADER_CRC_OFFSET], &crc, sizeof(crc));
+}
+
+StorageResult RecordStore::startSector(size_t sector_index, uint32_t generation) {
+    if (!flash_.eraseSector(sector_index)) return StorageResult::flash_error;
+
+    uint8_t header[K_SECTOR_HEADER_SIZE];
+    serializeSectorHeader(generation, header);
+    if (!flash_.program(getSectorAddress(sector_index), header)) return StorageResult::flash_error;
+
+    active_sector_ = sector_index;
+    generation_    = generation;
+    write_offset_  = K_SECTOR_HEADER_SIZE;
+    std::memset(record_offsets_, 0, sizeof(record_offsets_));
+
+    return StorageResult::ok;
+}
+
+StorageResult RecordStore::indexActiveSector() {
+    std::memset(record_offsets_, 0, sizeof(record_offsets_));
+
+    const size_t sector_size = flash_.getSectorSize();
+    size_t       offset      = K_SECTOR_HEADER_SIZE;
+    while (offset + K_RECORD_HEADER_SIZE <= sector_size) {
+        // The log ends at the first erased record header. The rest of the sector must be erased too, otherwise a
+        // record was being programmed when the power was lost.
+        if (isErased(getSectorAddress(active_sector_) + offset, K_RECORD_HEADER_SIZE)) {
+            if (isErased(getSectorAddress(active_sector_) + offset, sector_size - offset)) {
+                write_offset_ = offset;
+                return StorageResult::ok;
+            }
+            break;
+        }
+
+        const size_t record_size = readRecord(offset);
+        if (record_size == 0) break;
+
+        record_offsets_[record_buffer_[0]]  = static_cast<uint16_t>(offset);
+        offset                             += record_size;
+    }
+
+    // Full or damaged tail, the next write moves the valid records into a fresh sector
+    write_offset_ = sector_size;
+    return StorageResult::ok;
+}
+
+bool RecordStore::isErased(size_t address, size_t size) {
+    uint8_t chunk[32];
+    while (size > 0) {
+        const size_t chunk_size = size < sizeof(chunk) ? size : sizeof(chunk);
+        if (!flash_.read(address, {chunk, chunk_size})) return false;
+
+        for (size_t i = 0; i < chunk_size; i++) {
+            if (chunk[i] != drivers::interfaces::FlashInterface::K_ERASED_BYTE) return false;
+        }
+
+        address += chunk_size;
+        size    -= chunk_size;
+    }
+    return true;
+}
+
+size_t RecordStore::readRecord(size_t offset) {
+    const size_t sector_size = flash_.getSectorSize();
+    const size_t address     = getSectorAddress(active_sector_) + offset;
+    if (offset + K_RECORD_HEADER_SIZE > sector_size) return 0;
+    if (!flash_.read(address, {record_buffer_, K_RECORD_HEADER_SIZE})) return 0;
+
+    const size_t value_size = record_buffer_[1];
+    if (value_size > K_MAX_VALUE_SIZE || offset + K_RECORD_HEADER_SIZE + value_size > sector_size) return 0;
+    if (!flash_.read(address + K_RECORD_HEADER_SIZE, {&record_buffer_[K_RECORD_HEADER_SIZE], value_size})) return 0;
+
+    uint32_t stored_crc = 0;
+    std::memcpy(&stored_crc, &record_buffer_[4], sizeof(stored_crc));
+    if (stored_crc != computeRecordCrc(record_buffer_[0], {&record_buffer_[K_RECORD_HEADER_SIZE], value_size})) {
+        return 0;
+    }
+
+    return K_RECORD_HEADER_SIZE + value_size;
+}
+
+size_t RecordStore::serializeRecord(RecordKey key, std::span<const uint8_t> value) {
+    const uint32_t crc = computeRecordCrc(key, value);
+
+    record_buffer_[0] = key;
+    record_buffer_[1] = static_cast<uint8_t>(value.size_bytes());
+    record_buffer_[2] = 0;  // Reserved, never erased so that a record header can't look erased
+    record_buffer_[3] = 0;
+    std::memcpy(&record_buffer_[4], &crc, sizeof(crc));
+    std::memcpy(&record_buffer_[K_RECORD_HEADER_SIZE], value.data(), value.size_bytes());
+
+    return K_RECORD_HEADER_SIZE + value.size_bytes();
+}
+
+StorageResult RecordStore::moveToNextSector(RecordKey pending_key, std::span<const uint8_t> pending_value) {
+    const size_t sector_size  = flash_.getSectorSize();
+    const size_t next_sector  = (active_sector_ + 1) % flash_.getSectorCount();
+    const size_t next_address = getSectorAddress(next_sector);
+    size_t       next_offset  = K_SECTOR_HEADER_SIZE;
+
+    // The offsets are updated in place while copying, so on failure they are rebuilt from the still active sector
+    auto fail = [this](StorageResult result) {
+        (void)indexActiveSector();
+        return result;
+    };
+
+    if (!flash_.eraseSector(next_sector)) return StorageResult::flash_error;
+
+    for (size_t key = 0; key < K_KEY_COUNT; key++) {
+        if (key == pending_key || record_offsets_[key] == K_NO_RECORD) continue;
+
+        const size_t record_size = readRecord(record_offsets_[key]);
+        if (record_size == 0) return fail(StorageResult::flash_error);
+        if (next_offset + record_size > sector_size) return fail(StorageResult::storage_full);
+        if (!flash_.program(next_address + next_offset, {record_buffer_, record_size})) {
+            return fail(StorageResult::flash_error);
+        }
+
+        record_offsets_[key]  = static_cast<uint16_t>(next_offset);
+        next_offset          += record_size;
+    }
+
+    const size_t pending_record_size = serializeRecord(pending_key, pending_value);
+    if (next_offset + pending_record_size > sector_size) return fail(StorageResult::storage_full);
+    if (!flash_.program(next_address + next_offset, {record_buffer_, pending_record_size})) {
+        return fail(StorageResult::flash_error);
+    }
+    record_offsets_[pending_key]  = static_cast<uint16_t>(next_offset);
+    next_offset                  += pending_record_size;
+
+    // Programming the header commits the new sector, until then the old one stays active after a power loss
+    uint8_t header[K_SECTOR_HEADER_SIZE];
+    serializeSectorHeader(generation_ + 1, header);
+    if (!flash_.program(next_address, header)) return fail(StorageResult::flash_error);
+
+    active_sector_  = next_sector;
+    generation_    += 1;
+    write_offset_   = next_offset;
+
+    return StorageResult::ok;
+}
+
+}  // namespace persistent_storage
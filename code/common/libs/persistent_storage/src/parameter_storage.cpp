@@ -0,0 +1,67 @@
+#include "persistent_storage/parameter_storage.h"
+
+#include "assert/assert.h"
+
+namespace persistent_storage {
+
+namespace {
+
+// The value type is stored in front of the value so that a value stored by a firmware where the parameter had a
+// different type is not loaded
+constexpr size_t K_STORED_TYPE_SIZE = sizeof(parameter_system::ParameterValueType);
+
+}  // namespace
+
+StorageResult saveParameters(const parameter_system::ParameterDatabase& parameter_database,
+                             RecordStore&                               record_store) {
+    using parameter_system::ParameterCategory;
+    using parameter_system::ReadWriteResult;
+
+    uint8_t stored_value[K_STORED_TYPE_SIZE + sizeof(uint64_t)];
+    for (const parameter_system::ParameterDefinition& definition : parameter_database.getParameterDefinitions()) {
+        if (definition.getCategory() != ParameterCategory::saved_parameter) continue;
+
+        stored_value[0] = static_cast<uint8_t>(definition.getValueType());
+
+        size_t                value_size  = 0;
+        const ReadWriteResult read_result = definition.getValueRaw(
+            std::span<uint8_t>(stored_value).subspan(K_STORED_TYPE_SIZE), &value_size);
+        ASSERT_WITH_MESSAGE(read_result == ReadWriteResult::ok, "Parameter value does not fit the storage buffer");
+
+        const StorageResult result =
+            record_store.write(definition.getId(), {stored_value, K_STORED_TYPE_SIZE + value_size});
+        if (result != StorageResult::ok) return result;
+    }
+
+    return StorageResult::ok;
+}
+
+StorageResult loadParameters(const parameter_system::ParameterDatabase& parameter_database,
+                             RecordStore&                               record_store) {
+    using parameter_system::ParameterCategory;
+    using parameter_system::ReadWriteResult;
+
+    uint8_t stored_value[K_STORED_TYPE_SIZE + sizeof(uint64_t)];
+    for (const parameter_system::ParameterDefinition& definition : parameter_database.getParameterDefinitions()) {
+        if (definition.getCategory() != ParameterCategory::saved_parameter) continue;
+
+        size_t              stored_size = 0;
+        const StorageResult result      = record_store.read(definition.getId(), stored_value, &stored_size);
+        if (result == StorageResult::not_found || result == StorageResult::buffer_too_small) continue;
+        if (result != StorageResult::ok) return result;
+
+        const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(definition.getValueType());
+        if (stored_size != K_STORED_TYPE_SIZE + value_size ||
+            stored_value[0] != static_cast<uint8_t>(definition.getValueType())) {
+            continue;
+        }
+
+        const ReadWriteResult write_result = definition.setValueRawWithoutNotifying(
+            std::span<uint8_t>(stored_value).subspan(K_STORED_TYPE_SIZE, value_size));
+        ASSERT_WITH_MESSAGE(write_result == ReadWriteResult::ok, "Saved parameter could not be restored");
+    }
+
+    return StorageResult::ok;
+}
+
+}  // namespace persistent_storage
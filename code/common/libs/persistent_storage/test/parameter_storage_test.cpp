@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+#include "drivers/host/FileBackedFlash.h"
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterRegistry.h"
+#include "parameter_system/definition_helpers.h"
+#include "persistent_storage/parameter_storage.h"
+
+using namespace persistent_storage;
+using namespace parameter_system;
+
+namespace {
+
+constexpr ParameterDeclaration<ParameterValueType::uint16> K_SIGNAL{200};
+constexpr ParameterDeclaration<ParameterValueType::uint8>  K_SAVED{0};
+constexpr ParameterDeclaration<ParameterValueType::int32>  K_RUNTIME{K_MAX_PARAMETER_ID};
+
+uint16_t signal_value  = 0;
+uint8_t  saved_value   = 0;
+int32_t  runtime_value = 0;
+
+int  on_change_count = 0;
+void onChange() { on_change_count++; }
+
+constexpr ParameterRegistry registry{
+    SignalParameter(K_SIGNAL, "Signal", signal_value),
+    SavedParameter(K_SAVED, "Saved", saved_value, onChange),
+    RuntimeParameter(K_RUNTIME, "Runtime", runtime_value),
+};
+
+constexpr ParameterDatabase database{registry};
+
+}  // namespace
+
+TEST(ParameterStorage, saved_parameters_survive_a_reboot) {
+    const std::string file_path = (std::filesystem::temp_directory_path() / "parameter_storage_save.bin").string();
+    std::filesystem::remove(file_path);
+
+    {
+        drivers::host::FileBackedFlash flash(file_path, 4096, 4);
+        RecordStore                    record_store(flash);
+        ASSERT_EQ(record_store.mount(), StorageResult::ok);
+
+        saved_value   = 77;
+        runtime_value = -5;
+        EXPECT_EQ(saveParameters(database, record_store), StorageResult::ok);
+
+        // Only saved parameters are stored
+        EXPECT_TRUE(record_store.contains(K_SAVED.id));
+        EXPECT_FALSE(record_store.contains(K_RUNTIME.id));
+    }
+
+    saved_value     = 0;
+    runtime_value   = 0;
+    on_change_count = 0;
+    {
+        drivers::host::FileBackedFlash flash(file_path, 4096, 4);
+        RecordStore                    record_store(flash);
+        ASSERT_EQ(record_store.mount(), StorageResult::ok);
+        EXPECT_EQ(loadParameters(database, record_store), StorageResult::ok);
+    }
+
+    EXPECT_EQ(saved_value, 77);
+    EXPECT_EQ(runtime_value, 0);
+    EXPECT_EQ(on_change_count, 0);
+
+    std::filesystem::remove(file_path);
+}
+
+TEST(ParameterStorage, values_stored_with_another_type_are_not_loaded) {
+    const std::string file_path = (std::filesystem::temp_directory_path() / "parameter_storage_type.bin").string();
+    std::filesystem::remove(file_path);
+
+    drivers::host::FileBackedFlash flash(file_path, 4096, 4);
+    RecordStore                    record_store(flash);
+    ASSERT_EQ(record_store.mount(), StorageResult::ok);
+
+    // As if an older firmware had K_SAVED as an int16
+    const uint8_t stored_value[] = {static_cast<uint8_t>(ParameterValueType::int16), 0x12, 0x34};
+    ASSERT_EQ(record_store.write(K_SAVED.id, stored_value), StorageResult::ok);
+
+    saved_value = 9;
+    EXPECT_EQ(loadParameters(database, record_store), StorageResult::ok);
+    EXPECT_EQ(saved_value, 9);
+
+    std::filesystem::remove(file_path);
+}
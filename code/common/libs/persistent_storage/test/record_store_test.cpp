@@ -0,0 +1,274 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "drivers/host/FileBackedFlash.h"
+#include "persistent_storage/RecordStore.h"
+
+using namespace persistent_storage;
+
+namespace {
+
+constexpr size_t K_SECTOR_SIZE  = 512;
+constexpr size_t K_SECTOR_COUNT = 4;
+
+/**
+ * @brief Counts the flash operations and can cut the power in the middle of programming.
+ *
+ * After the programmed byte budget runs out the rest of the bytes are not programmed and every later operation fails,
+ * as if the device had lost its power. The backing file keeps what was programmed before that.
+ */
+class InstrumentedFlash final : public drivers::interfaces::FlashInterface {
+public:
+    explicit InstrumentedFlash(drivers::interfaces::FlashInterface& flash) : flash_(flash) {}
+
+    size_t getSectorSize() const override { return flash_.getSectorSize(); }
+    size_t getSectorCount() const override { return flash_.getSectorCount(); }
+
+    bool read(size_t address, std::span<uint8_t> target) override {
+        if (power_lost) return false;
+        bytes_read += target.size_bytes();
+        return flash_.read(address, target);
+    }
+
+    bool program(size_t address, std::span<const uint8_t> data) override {
+        if (power_lost) return false;
+        program_count++;
+
+        if (data.size_bytes() > program_budget) {
+            (void)flash_.program(address, data.first(program_budget));
+            program_budget = 0;
+            power_lost     = true;
+            return false;
+        }
+        program_budget -= data.size_bytes();
+        return flash_.program(address, data);
+    }
+
+    bool eraseSector(size_t sector_index) override {
+        if (power_lost) return false;
+        erase_counts.resize(getSectorCount());
+        erase_counts[sector_index]++;
+        return flash_.eraseSector(sector_index);
+    }
+
+    size_t              program_budget = std::numeric_limits<size_t>::max();
+    bool                power_lost     = false;
+    size_t              program_count  = 0;
+    size_t              bytes_read     = 0;
+    std::vector<size_t> erase_counts;
+
+private:
+    drivers::interfaces::FlashInterface& flash_;
+};
+
+class RecordStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+        file_path_            = (std::filesystem::temp_directory_path() /
+                      (std::string("record_store_") + test_info->name() + ".bin"))
+                         .string();
+        std::filesystem::remove(file_path_);
+        reboot();
+    }
+
+    void TearDown() override {
+        store_.reset();
+        instrumented_flash_.reset();
+        file_flash_.reset();
+        std::filesystem::remove(file_path_);
+    }
+
+    // Drops all the state in RAM and opens the backing file again
+    void reboot() {
+        store_.reset();
+        instrumented_flash_.reset();
+        file_flash_.reset();
+
+        file_flash_ = std::make_unique<drivers::host::FileBackedFlash>(file_path_, K_SECTOR_SIZE, K_SECTOR_COUNT);
+        ASSERT_TRUE(file_flash_->isOpen());
+        instrumented_flash_ = std::make_unique<InstrumentedFlash>(*file_flash_);
+        store_              = std::make_unique<RecordStore>(*instrumented_flash_);
+    }
+
+    void rebootAndMount() {
+        reboot();
+        ASSERT_EQ(store_->mount(), StorageResult::ok);
+    }
+
+    uint32_t readU32(RecordKey key) {
+        uint32_t value      = 0;
+        size_t   value_size = 0;
+        EXPECT_EQ(store_->read(key, {reinterpret_cast<uint8_t*>(&value), sizeof(value)}, &value_size),
+                  StorageResult::ok);
+        EXPECT_EQ(value_size, sizeof(value));
+        return value;
+    }
+
+    StorageResult writeU32(RecordKey key, uint32_t value) {
+        return store_->write(key, {reinterpret_cast<const uint8_t*>(&value), sizeof(value)});
+    }
+
+    std::string                                     file_path_;
+    std::unique_ptr<drivers::host::FileBackedFlash> file_flash_;
+    std::unique_ptr<InstrumentedFlash>              instrumented_flash_;
+    std::unique_ptr<RecordStore>                    store_;
+};
+
+}  // namespace
+
+TEST_F(RecordStoreTest, blank_region_mounts_empty) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+
+    uint8_t buffer[4];
+    EXPECT_EQ(store_->read(1, buffer), StorageResult::not_found);
+    EXPECT_FALSE(store_->contains(1));
+}
+
+TEST_F(RecordStoreTest, operations_fail_before_mount) {
+    uint8_t buffer[4] = {};
+    EXPECT_EQ(store_->read(1, buffer), StorageResult::not_mounted);
+    EXPECT_EQ(store_->write(1, buffer), StorageResult::not_mounted);
+}
+
+TEST_F(RecordStoreTest, values_persist_over_reboot) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+    ASSERT_EQ(writeU32(1, 111), StorageResult::ok);
+    ASSERT_EQ(writeU32(255, 222), StorageResult::ok);
+    ASSERT_EQ(writeU32(1, 333), StorageResult::ok);
+
+    rebootAndMount();
+
+    EXPECT_EQ(readU32(1), 333u);
+    EXPECT_EQ(readU32(255), 222u);
+    EXPECT_FALSE(store_->contains(2));
+}
+
+TEST_F(RecordStoreTest, unchanged_value_is_not_written) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+    ASSERT_EQ(writeU32(7, 42), StorageResult::ok);
+
+    const size_t program_count = instrumented_flash_->program_count;
+    ASSERT_EQ(writeU32(7, 42), StorageResult::ok);
+    EXPECT_EQ(instrumented_flash_->program_count, program_count);
+}
+
+TEST_F(RecordStoreTest, rejects_invalid_sizes) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+
+    uint8_t too_large[RecordStore::K_MAX_VALUE_SIZE + 1] = {};
+    EXPECT_EQ(store_->write(1, too_large), StorageResult::value_too_large);
+
+    ASSERT_EQ(writeU32(1, 5), StorageResult::ok);
+    uint8_t too_small[2];
+    EXPECT_EQ(store_->read(1, too_small), StorageResult::buffer_too_small);
+}
+
+TEST_F(RecordStoreTest, thousands_of_writes_level_the_wear_and_keep_mount_fast) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+
+    for (uint32_t i = 0; i < 5'000; i++) {
+        ASSERT_EQ(writeU32(static_cast<RecordKey>(i % 10), i), StorageResult::ok) << i;
+    }
+    EXPECT_GT(store_->getGeneration(), 100u);
+
+    const std::vector<size_t> erase_counts = instrumented_flash_->erase_counts;
+    ASSERT_EQ(erase_counts.size(), K_SECTOR_COUNT);
+    const auto [min_erases, max_erases] = std::minmax_element(erase_counts.begin(), erase_counts.end());
+    EXPECT_LE(*max_erases - *min_erases, 1u);
+
+    rebootAndMount();
+
+    // Only the sector headers and the active sector are read
+    EXPECT_LE(instrumented_flash_->bytes_read, K_SECTOR_COUNT * RecordStore::K_SECTOR_HEADER_SIZE + 2 * K_SECTOR_SIZE);
+    for (uint32_t key = 0; key < 10; key++) {
+        EXPECT_EQ(readU32(static_cast<RecordKey>(key)), 4'990u + key);
+    }
+}
+
+TEST_F(RecordStoreTest, too_many_keys_for_a_sector_is_reported) {
+    ASSERT_EQ(store_->mount(), StorageResult::ok);
+
+    uint8_t value[RecordStore::K_MAX_VALUE_SIZE] = {};
+    size_t  key                                  = 0;
+    for (; key < 256; key++) {
+        value[0]                   = static_cast<uint8_t>(key);
+        const StorageResult result = store_->write(static_cast<RecordKey>(key), value);
+        if (result != StorageResult::ok) {
+            EXPECT_EQ(result, StorageResult::storage_full);
+            break;
+        }
+    }
+    ASSERT_LT(key, 256u);
+
+    // The values stored before are kept
+    rebootAndMount();
+    uint8_t read_value[RecordStore::K_MAX_VALUE_SIZE];
+    for (size_t stored_key = 0; stored_key < key; stored_key++) {
+        ASSERT_EQ(store_->read(static_cast<RecordKey>(stored_key), read_value), StorageResult::ok);
+        EXPECT_EQ(read_value[0], stored_key);
+    }
+    EXPECT_FALSE(store_->contains(static_cast<RecordKey>(key)));
+}
+
+TEST_F(RecordStoreTest, power_loss_during_any_write_keeps_a_consistent_state) {
+    // Enough writes to move the records between the sectors a few times
+    constexpr uint32_t K_WRITE_COUNT = 120;
+
+    for (size_t cut_at_byte = 0;; cut_at_byte += 3) {
+        SCOPED_TRACE(cut_at_byte);
+        std::filesystem::remove(file_path_);
+        rebootAndMount();
+
+        // Reference of what is committed, the key being written when the power is lost may have either value
+        uint32_t committed[4] = {};
+        instrumented_flash_->program_budget = cut_at_byte;
+
+        uint32_t interrupted_key   = 0;
+        uint32_t interrupted_value = 0;
+        bool     interrupted       = false;
+        for (uint32_t i = 1; i <= K_WRITE_COUNT; i++) {
+            const auto key = static_cast<RecordKey>(i % 4);
+            if (writeU32(key, i) != StorageResult::ok) {
+                ASSERT_TRUE(instrumented_flash_->power_lost);
+                interrupted_key   = key;
+                interrupted_value = i;
+                interrupted       = true;
+                break;
+            }
+            committed[key] = i;
+        }
+        if (!interrupted) break;  // Every cut point has been tested
+
+        rebootAndMount();
+        for (RecordKey key = 0; key < 4; key++) {
+            if (committed[key] == 0 && !(interrupted && key == interrupted_key)) {
+                EXPECT_FALSE(store_->contains(key));
+                continue;
+            }
+            if (key == interrupted_key && !store_->contains(key)) {
+                EXPECT_EQ(committed[key], 0u);
+                continue;
+            }
+
+            const uint32_t value = readU32(key);
+            if (key == interrupted_key) {
+                EXPECT_TRUE(value == committed[key] || value == interrupted_value) << value;
+            } else {
+                EXPECT_EQ(value, committed[key]);
+            }
+        }
+
+        // The store keeps working after the recovery
+        ASSERT_EQ(writeU32(3, 0xABCD), StorageResult::ok);
+        rebootAndMount();
+        EXPECT_EQ(readU32(3), 0xABCDu);
+    }
+}
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+/**
+ * The master's half of a transaction without the link: serializing a request and deserializing and validating the
+ * response that comes back. Throughput is reported as packets and bytes per second.
+ */
+
+namespace {
+
+uint8_t payload_values[RequestPacket::K_PAYLOAD_MAX_SIZE] = {};
+
+void BM_serializeRequest(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    uint8_t tx_buffer[RequestPacket::K_PACKET_MAX_SIZE] = {};
+    size_t  packet_size                                 = 0;
+
+    for (auto _ : state) {
+        RequestPacket            request(1, 0x21, {payload_values, payload_size});
+        const std::span<uint8_t> serialized = serializeRequest(request, tx_buffer);
+        packet_size                         = serialized.size_bytes();
+        benchmark::DoNotOptimize(serialized);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * packet_size));
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_deSerializeResponse(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    uint8_t                  rx_buffer[ResponsePacket::K_PACKET_MAX_SIZE] = {};
+    ResponsePacket           sent(static_cast<uint8_t>(ResponseCode::ok), {payload_values, payload_size});
+    const std::span<uint8_t> serialized = serializeResponse(sent, rx_buffer);
+
+    for (auto _ : state) {
+        // Both CRCs are checked as the master does before handing the payload over
+        ResponsePacket packet = deSerializeResponse(serialized);
+        if (!responseHeaderHasValidCrc(packet.header) || !responsePayloadHasValidCrc(packet)) {
+            state.SkipWithError("Corrupted packet");
+        }
+        benchmark::DoNotOptimize(packet);
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * serialized.size_bytes()));
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_serializeRequest)->Arg(0)->Arg(8)->Arg(64)->Arg(RequestPacket::K_PAYLOAD_MAX_SIZE);
+BENCHMARK(BM_deSerializeResponse)->Arg(0)->Arg(8)->Arg(64)->Arg(ResponsePacket::K_PAYLOAD_MAX_SIZE);
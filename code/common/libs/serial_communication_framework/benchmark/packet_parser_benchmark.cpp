@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "serial_communication_framework/PacketParser.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+/**
+ * Parses a stream of back to back requests the way `SlaveHandler::run()` receives them.
+ *
+ * The chunk size is the amount of bytes handed over per read, 1 being the byte per call reception the slave used to
+ * do. Throughput is reported as bytes and packets per second.
+ */
+
+namespace {
+
+constexpr size_t K_PACKETS_IN_STREAM = 64;
+
+std::vector<uint8_t> makeRequestStream(size_t payload_size) {
+    std::vector<uint8_t> payload(payload_size);
+    for (size_t i = 0; i < payload_size; i++) payload[i] = static_cast<uint8_t>(i);
+
+    std::vector<uint8_t> stream;
+    uint8_t              buffer[RequestPacket::K_PACKET_MAX_SIZE];
+    for (size_t i = 0; i < K_PACKETS_IN_STREAM; i++) {
+        RequestPacket            request(1, 0x21, payload);
+        const std::span<uint8_t> serialized = serializeRequest(request, buffer);
+        stream.insert(stream.end(), serialized.begin(), serialized.end());
+    }
+    return stream;
+}
+
+void BM_parseStream(benchmark::State& state) {
+    const auto                 payload_size = static_cast<size_t>(state.range(0));
+    const auto                 chunk_size   = static_cast<size_t>(state.range(1));
+    const std::vector<uint8_t> stream       = makeRequestStream(payload_size);
+
+    PacketParser<RequestPacket> parser;
+    for (auto _ : state) {
+        size_t index          = 0;
+        size_t packets_parsed = 0;
+        while (index < stream.size()) {
+            const std::span<uint8_t> receive_buffer = parser.getReceiveBuffer();
+            const size_t count = std::min({receive_buffer.size(), chunk_size, stream.size() - index});
+            std::copy_n(&stream[index], count, receive_buffer.begin());
+            index += count;
+
+            if (parser.commitReceivedBytes(count) == ParseResult::packet_complete) {
+                benchmark::DoNotOptimize(parser.getPacketBytes());
+                packets_parsed++;
+                parser.reset();
+            }
+        }
+        if (packets_parsed != K_PACKETS_IN_STREAM) state.SkipWithError("Packet lost");
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stream.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * K_PACKETS_IN_STREAM));
+}
+
+}  // namespace
+
+BENCHMARK(BM_parseStream)->ArgNames({"payload", "chunk"})->ArgsProduct({{8, 64, 255}, {1, 16, 512}});
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <type_traits>
+
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+/**
+ * Compares the packet paths before and after serializing in place and deserializing as views.
+ *
+ * The "staged" cases are the reference for how the handlers used to do it: the payload was serialized into a staging
+ * buffer and copied into the packet, and responses copied their payload into a buffer of their own. The amount of
+ * payload bytes copied per packet is reported as the `bytes_copied` counter, the time per packet as usual.
+ */
+
+namespace {
+
+uint8_t source_values[ResponsePacket::K_PAYLOAD_MAX_SIZE] = {};
+
+// Bulk response the way the commands were before, owning a buffer for the largest possible payload
+struct OwningBulkResponse : commands::ResponseBase {
+    uint8_t raw_bytes[ResponsePacket::K_PAYLOAD_MAX_SIZE] = {};
+    size_t  valid_byte_count                              = 0;
+
+    ParsingError deserialize(std::span<uint8_t> bytes) {
+        valid_byte_count = bytes.size_bytes();
+        std::memcpy(raw_bytes, bytes.data(), valid_byte_count);
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        std::memcpy(target_buffer.data(), raw_bytes, valid_byte_count);
+        return target_buffer.subspan(0, valid_byte_count);
+    }
+};
+
+// Bulk response the way the commands are now, a view over the bytes it was deserialized from
+struct ViewBulkResponse : commands::ResponseBase {
+    std::span<const uint8_t> raw_bytes = {};
+
+    ParsingError deserialize(std::span<uint8_t> bytes) {
+        raw_bytes = bytes;
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        std::memcpy(target_buffer.data(), raw_bytes.data(), raw_bytes.size_bytes());
+        return target_buffer.subspan(0, raw_bytes.size_bytes());
+    }
+};
+
+// Slave side: the handler produces the values, the response is serialized and the packet finalized
+void BM_respondStaged(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    uint8_t staging_buffer[ResponsePacket::K_PAYLOAD_MAX_SIZE] = {};
+    uint8_t tx_buffer[ResponsePacket::K_PACKET_MAX_SIZE]       = {};
+
+    for (auto _ : state) {
+        OwningBulkResponse response;
+        std::memcpy(response.raw_bytes, source_values, payload_size);
+        response.valid_byte_count = payload_size;
+
+        ResponsePacket packet(static_cast<uint8_t>(ResponseCode::ok), response.serialize(staging_buffer));
+        benchmark::DoNotOptimize(serializeResponse(packet, tx_buffer));
+        benchmark::ClobberMemory();
+    }
+
+    // Into the response, into the staging buffer and into the packet
+    state.counters["bytes_copied"] = static_cast<double>(3 * payload_size);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_respondInPlace(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    uint8_t handler_buffer[ResponsePacket::K_PAYLOAD_MAX_SIZE] = {};
+    uint8_t tx_buffer[ResponsePacket::K_PACKET_MAX_SIZE]       = {};
+
+    for (auto _ : state) {
+        ViewBulkResponse response;
+        std::memcpy(handler_buffer, source_values, payload_size);
+        response.raw_bytes = {handler_buffer, payload_size};
+
+        std::span<uint8_t> payload = response.serialize(getResponsePayloadBuffer(tx_buffer));
+        benchmark::DoNotOptimize(
+            finalizeResponseInPlace(static_cast<uint8_t>(ResponseCode::ok), 1, payload.size_bytes(), tx_buffer));
+        benchmark::ClobberMemory();
+    }
+
+    // Into the handler's buffer and into the packet
+    state.counters["bytes_copied"] = static_cast<double>(2 * payload_size);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Master side: the received packet is validated, the response deserialized and handed over by value like a blocking
+// command does
+template <typename T_Response>
+void BM_receive(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    uint8_t        rx_buffer[ResponsePacket::K_PACKET_MAX_SIZE] = {};
+    ResponsePacket sent(static_cast<uint8_t>(ResponseCode::ok), {source_values, payload_size});
+    (void)serializeResponse(sent, rx_buffer);
+
+    for (auto _ : state) {
+        ResponsePacket packet = deSerializeResponse(rx_buffer);
+        if (!responsePayloadHasValidCrc(packet)) state.SkipWithError("Corrupted packet");
+
+        T_Response response;
+        (void)response.deserialize(packet.payload);
+        T_Response handed_over = response;
+        benchmark::DoNotOptimize(handed_over);
+    }
+
+    const size_t payload_copies    = std::is_same_v<T_Response, OwningBulkResponse> ? payload_size : 0;
+    state.counters["bytes_copied"] = static_cast<double>(payload_copies + sizeof(T_Response));
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_respondStaged)->Arg(8)->Arg(64)->Arg(ResponsePacket::K_PAYLOAD_MAX_SIZE);
+BENCHMARK(BM_respondInPlace)->Arg(8)->Arg(64)->Arg(ResponsePacket::K_PAYLOAD_MAX_SIZE);
+BENCHMARK_TEMPLATE(BM_receive, OwningBulkResponse)->Arg(8)->Arg(64)->Arg(ResponsePacket::K_PAYLOAD_MAX_SIZE);
+BENCHMARK_TEMPLATE(BM_receive, ViewBulkResponse)->Arg(8)->Arg(64)->Arg(ResponsePacket::K_PAYLOAD_MAX_SIZE);
+
+BENCHMARK_MAIN();
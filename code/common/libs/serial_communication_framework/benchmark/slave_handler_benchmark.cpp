@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/ClockInterface.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+/**
+ * The slave's whole request path per `SlaveHandler::run()`: receiving a burst of back to back requests, validating
+ * them, dispatching to the handler and sending the responses. Throughput is reported as requests and received bytes
+ * per second.
+ */
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID         = 1;
+constexpr size_t  K_PACKETS_IN_STREAM = 64;
+
+// Replays the same received bytes every iteration and drops what is transmitted
+class ReplaySerial final : public drivers::interfaces::BufferedSerialCommunicationInterface {
+public:
+    void transmitByte(uint8_t) override { transmitted_byte_count++; }
+    void transmitBytes(std::span<uint8_t> bytes) override { transmitted_byte_count += bytes.size_bytes(); }
+
+    size_t  getReceivedBytesAvailableAmount() override { return stream.size() - read_index; }
+    uint8_t readReceivedByte() override { return stream[read_index++]; }
+    size_t  readReceivedBytes(std::span<uint8_t> bytes) override {
+        const size_t count = std::min(bytes.size(), stream.size() - read_index);
+        std::memcpy(bytes.data(), &stream[read_index], count);
+        read_index += count;
+        return count;
+    }
+    uint64_t getRxOverflowCount() override { return 0; }
+
+    std::vector<uint8_t> stream;
+    size_t               read_index             = 0;
+    size_t               transmitted_byte_count = 0;
+};
+
+class FrozenClock final : public drivers::interfaces::ClockInterface {
+public:
+    uint64_t uptimeMicroseconds() override { return 0; }
+    uint64_t uptimeMilliseconds() override { return 0; }
+    uint64_t uptimeSeconds() override { return 0; }
+};
+
+struct EchoRequest : commands::RequestBase {
+    std::span<uint8_t> bytes = {};
+
+    ParsingError deserialize(std::span<uint8_t> data) {
+        bytes = data;
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        std::memcpy(target_buffer.data(), bytes.data(), bytes.size_bytes());
+        return target_buffer.subspan(0, bytes.size_bytes());
+    }
+};
+
+struct EchoResponse : commands::ResponseBase {
+    std::span<const uint8_t> bytes = {};
+
+    ParsingError deserialize(std::span<uint8_t> data) {
+        bytes = data;
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        std::memcpy(target_buffer.data(), bytes.data(), bytes.size_bytes());
+        return target_buffer.subspan(0, bytes.size_bytes());
+    }
+};
+
+using EchoCommand = commands::Command<EchoRequest, EchoResponse, 0x21>;
+
+EchoResponse echo(const EchoRequest& request) {
+    EchoResponse response;
+    response.bytes         = request.bytes;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+void BM_slaveDispatch(benchmark::State& state) {
+    const auto payload_size = static_cast<size_t>(state.range(0));
+
+    ReplaySerial serial;
+    FrozenClock  clock;
+    SlaveHandler slave(serial, clock, K_DEVICE_ID);
+    slave.registerCommandHandler<EchoCommand, echo>();
+
+    std::vector<uint8_t> payload(payload_size);
+    for (size_t i = 0; i < payload_size; i++) payload[i] = static_cast<uint8_t>(i);
+    uint8_t buffer[RequestPacket::K_PACKET_MAX_SIZE];
+    for (size_t i = 0; i < K_PACKETS_IN_STREAM; i++) {
+        RequestPacket            request(K_DEVICE_ID, EchoCommand::K_OP_CODE, payload);
+        const std::span<uint8_t> serialized = serializeRequest(request, buffer);
+        serial.stream.insert(serial.stream.end(), serialized.begin(), serialized.end());
+    }
+
+    for (auto _ : state) {
+        serial.read_index = 0;
+        slave.run();
+        if (serial.read_index != serial.stream.size()) state.SkipWithError("Stream not drained");
+    }
+
+    const CommunicationStatistics& statistics = slave.getCommunicationStatistics();
+    if (statistics.valid_packets_received != static_cast<uint64_t>(state.iterations()) * K_PACKETS_IN_STREAM) {
+        state.SkipWithError("Request lost");
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * serial.stream.size()));
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * K_PACKETS_IN_STREAM));
+    state.counters["tx_bytes_per_request"] =
+        static_cast<double>(serial.transmitted_byte_count) / static_cast<double>(statistics.valid_packets_received);
+}
+
+}  // namespace
+
+BENCHMARK(BM_slaveDispatch)->Arg(0)->Arg(8)->Arg(64)->Arg(RequestPacket::K_PAYLOAD_MAX_SIZE);
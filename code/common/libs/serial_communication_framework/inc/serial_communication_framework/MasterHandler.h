@@ -8,12 +8,40 @@
 #include "debug_print/debug_print.h"
 #include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
 #include "drivers/interfaces/ClockInterface.h"
+#include "serial_communication_framework/PacketReceiver.h"
+#include "serial_communication_framework/cobs.h"
 #include "serial_communication_framework/common.h"
 #include "serial_communication_framework/packets.h"
 #include "serial_communication_framework/serialize_deserialize.h"
+#include "serial_communication_framework/timeouts.h"
+#include "utils/StaticList.h"
 
 namespace serial_communication_framework {
 
+/**
+ * @brief Callback invoked when an asynchronously submitted command has completed.
+ *
+ * Called from inside `MasterHandler::run()`. The response is only valid for the duration of the call.
+ *
+ * @param response  The received response. `response_code` tells whether the command succeeded or not.
+ * @param user_data The opaque pointer that was given when the command was submitted.
+ */
+template <commands::CommandType T_Command>
+using AsyncResponseCallback = void (*)(const typename T_Command::Response& response, void* user_data);
+
+/**
+ * @brief Callback invoked when the slave has sent a frame on its own, not as a response to a request.
+ *
+ * Called from inside `MasterHandler::run()`. The payload is only valid for the duration of the call.
+ *
+ * @param stream_id The id of the stream the frame belongs to.
+ * @param sender_id The id of the slave that sent the frame.
+ * @param payload   The stream's data, without the stream id and the sender id.
+ * @param user_data The opaque pointer that was given when the callback was set.
+ */
+using UnsolicitedFrameCallback = void (*)(uint8_t stream_id, uint8_t sender_id, std::span<uint8_t> payload,
+                                          void* user_data);
+
 class MasterHandler {
 public:
      MasterHandler(drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface,
@@ -22,98 +50,283 @@ public:
 
     void init();
 
+    /**
+     * @brief Send a command and wait until its response has been received (or the command has failed).
+     *
+     * Commands that were already submitted asynchronously complete in the meantime, as their responses arrive.
+     *
+     * @note Responses are deserialized as views over the receive buffer, so the payload views of the returned
+     *       response (e.g. `ReadParamValuesResponse::raw_bytes`) are only valid until `run()` is called again.
+     */
     template <commands::CommandType T_Command>
     [[nodiscard]] typename T_Command::Response sendCommandAndReceiveResponseBlocking(
         uint8_t receiver_id, typename T_Command::Request command_request) {
-        RequestPacket request(receiver_id, T_Command::K_OP_CODE, command_request.serialize(command_staging_buffer));
-        std::span<uint8_t> serialized_request = serializeRequest(request, tx_buffer_);
-        communication_interface_.transmitBytes(serialized_request);
+        // Wait until there is room in the pipeline
+        while (in_flight_requests_.full()) {
+            waitForResponse();
+            run();
+        }
 
-        startResponseTimeout();
+        BlockingCompletion<T_Command> completion;
+        const bool submitted = submitCommand<T_Command>(receiver_id, command_request,
+                                                        &MasterHandler::onBlockingCommandCompleted<T_Command>,
+                                                        &completion);
+        ASSERT_WITH_MESSAGE(submitted, "Could not submit blocking command");
 
-        size_t rx_index             = 0;
-        size_t expected_packet_size = ResponsePacket::K_PACKET_MAX_SIZE;
+        while (!completion.completed) {
+            waitForResponse();
+            run();
+        }
 
-        while (rx_index < expected_packet_size) {
-            if (responseHasTimedout()) {
-                communication_statistics_.timed_out_packets++;
+        return completion.response;
+    }
 
-                typename T_Command::Response command_response;
-                command_response.response_code = ResponseCode::timed_out;
-                return command_response;
+    /**
+     * @brief Send a command without waiting for the response.
+     *
+     * The request is transmitted immediately so multiple commands can be in flight at the same time, keeping the
+     * serial link busy instead of idling for every response turnaround. Every request carries a sequence number that
+     * the slave echoes in its response, and the given callback is invoked from `run()` once the matching response has
+     * been received, or the command has failed (timed out, corrupted, etc.). A slave handles its requests in order,
+     * so the requests to the same receiver that were sent before the answered one fail as timed out, their responses
+     * got lost. Responses that match nothing in flight are dropped.
+     *
+     * @param receiver_id     Id of the device the command is sent to.
+     * @param command_request The request payload.
+     * @param callback        Invoked with the response once the command completes. Can be nullptr.
+     * @param user_data       Opaque pointer passed to the callback.
+     * @return true if the command was submitted, false if there already are K_MAX_IN_FLIGHT_REQUESTS in flight.
+     */
+    template <commands::CommandType T_Command>
+    [[nodiscard]] bool submitCommand(uint8_t receiver_id, typename T_Command::Request command_request,
+                                     AsyncResponseCallback<T_Command> callback, void* user_data) {
+        if (in_flight_requests_.full()) return false;
+
+        // Adapter — static lambda (no captures, convertible to function pointer)
+        auto completion_adapter = +[](const InFlightRequest& in_flight_request, ResponseCode response_code,
+                                      std::span<uint8_t> response_payload) -> ResponseCode {
+            typename T_Command::Response command_response;
+            command_response.response_code = response_code;
+
+            // Error responses never carry a payload so only successful ones are deserialized
+            if (response_code == ResponseCode::ok) {
+                const commands::ParsingError parse_result = command_response.deserialize(response_payload);
+                if (parse_result != commands::ParsingError::no_error) {
+                    DEBUG_PRINT("[MasterHandler] deserialize failed: op_code=%h payload_size=% parse_error=%\n",
+                                T_Command::K_OP_CODE, response_payload.size_bytes(),
+                                static_cast<uint8_t>(parse_result));
+                    command_response.response_code = ResponseCode::malformed_response;
+                }
             }
 
-            if (communication_interface_.getReceivedBytesAvailableAmount() > 0) {
-                rx_buffer_[rx_index] = communication_interface_.readReceivedByte();
-                rx_index++;
+            if (in_flight_request.callback != nullptr) {
+                reinterpret_cast<AsyncResponseCallback<T_Command>>(in_flight_request.callback)(
+                    command_response, in_flight_request.user_data);
             }
+            return command_response.response_code;
+        };
 
-            if (rx_index == ResponsePacket::K_HEADER_SIZE) {
-                ResponsePacket::Header header = deSerializeResponseHeader(rx_buffer_);
-                expected_packet_size          = header.payload_size + ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE;
+        // Serialized straight into the packet, only the header and the CRCs are added around it. The packet stays in
+        // its slot until the command completes, so that it can be sent again
+        const uint8_t            packet_slot     = findFreePacketSlot();
+        const std::span<uint8_t> packet_buffer   = request_packets_[packet_slot];
+        const std::span<uint8_t> payload_buffer  = getRequestPayloadBuffer(packet_buffer);
+        const std::span<uint8_t> request_payload = command_request.serialize(payload_buffer);
+        ASSERT_WITH_MESSAGE(request_payload.data() == payload_buffer.data(), "Request was not serialized in place");
 
-                if (!responseHeaderHasValidCrc(header)) {
-                    communication_statistics_.corrupted_packets_received++;
+        const uint8_t      sequence_number    = takeSequenceNumber();
+        std::span<uint8_t> serialized_request = finalizeRequestInPlace(
+            receiver_id, T_Command::K_OP_CODE, sequence_number, request_payload.size_bytes(), packet_buffer);
+        const uint64_t transmit_time_us = timeout_clock_.uptimeMicroseconds();
+        transmitPacket(serialized_request);
+        communication_statistics_.operations[T_Command::K_OP_CODE].requests++;
 
-                    typename T_Command::Response command_response;
-                    command_response.response_code = ResponseCode::corrupted;
-                    return command_response;
-                }
-            }
+        in_flight_requests_.pushBack({.receiver_id         = receiver_id,
+                                      .operation_code      = T_Command::K_OP_CODE,
+                                      .sequence_number     = sequence_number,
+                                      .idempotency         = T_Command::K_IDEMPOTENCY,
+                                      .packet_slot         = packet_slot,
+                                      .request_packet_size = serialized_request.size_bytes(),
+                                      .handler_timeout_us  = handlerTimeoutUs<T_Command>(),
+                                      .transmit_time_us    = transmit_time_us,
+                                      .completion_adapter  = completion_adapter,
+                                      .callback            = reinterpret_cast<GenericCallback>(callback),
+                                      .user_data           = user_data});
+
+        // The timeout always runs for the oldest in-flight request only
+        if (in_flight_requests_.size() == 1) {
+            startResponseTimeout();
         }
+        return true;
+    }
 
-        ResponsePacket response = deSerializeResponse(rx_buffer_);
-        communication_statistics_.total_packets_received++;
+    /**
+     * @brief Receive responses for the in-flight commands and invoke their completion callbacks.
+     *
+     * Non-blocking. Must be called periodically when commands are submitted with `submitCommand` or when unsolicited
+     * frames are expected.
+     */
+    void run();
 
-        if (!responsePayloadHasValidCrc(response)) {
-            communication_statistics_.corrupted_packets_received++;
+    /**
+     * @brief Sleep until a response may have been received or the oldest in-flight command times out.
+     *
+     * For the loops that call `run()` until their commands complete, so that they leave the core idle while the
+     * device answers. Returns right away when nothing is in flight or the interface can't sleep, see
+     * `BufferedSerialCommunicationInterface::waitForReceivedBytes()`.
+     */
+    void waitForResponse();
 
-            typename T_Command::Response command_response;
-            command_response.response_code = ResponseCode::corrupted;
-            return command_response;
-        }
+    /**
+     * @brief Set the callback that receives the unsolicited frames (e.g. telemetry) sent by the slave.
+     *
+     * Unsolicited frames are separated from the command responses in `run()`, so they can arrive at any time, also
+     * in between the responses of pipelined commands. Frames are dropped while no callback is set.
+     *
+     * @param callback  Invoked for every received unsolicited frame. Can be nullptr.
+     * @param user_data Opaque pointer passed to the callback.
+     */
+    void setUnsolicitedFrameCallback(UnsolicitedFrameCallback callback, void* user_data);
 
-        communication_statistics_.valid_packets_received++;
+    /**
+     * @brief Get the number of submitted commands that are still waiting for a response.
+     */
+    [[nodiscard]] size_t getInFlightCommandCount() const;
 
-        // TODO Resetting tx buffer and rx buffer
+    [[nodiscard]] const CommunicationStatistics& getStatistics() const;
 
-        typename T_Command::Response command_response;
-        const commands::ParsingError parse_result = command_response.deserialize(response.payload);
-        if (parse_result != commands::ParsingError::no_error) {
-            DEBUG_PRINT("[MasterHandler] deserialize failed: op_code=%h payload_size=% parse_error=%\n",
-                        T_Command::K_OP_CODE, response.payload.size_bytes(), static_cast<uint8_t>(parse_result));
-            command_response.response_code = ResponseCode::malformed_response;
-            return command_response;
-        }
-        command_response.response_code = static_cast<ResponseCode>(response.header.response_code);
+    /**
+     * @brief Get the distribution of the round trip times of the op code, from the request being sent to its response
+     *        being received. Includes the time the request waited behind the earlier in-flight ones.
+     *
+     * Only the commands that got a response are counted, the timed out ones are in the op code's error count.
+     */
+    [[nodiscard]] const LatencyHistogram& getRoundTripLatencyHistogram(uint8_t op_code) const;
 
-        return command_response;
-    }
+    /**
+     * @brief Get the distribution of the round trip times of all the op codes together.
+     */
+    [[nodiscard]] const LatencyHistogram& getRoundTripLatencyHistogram() const;
 
-    /*void sendCommandAndReceiveResponseASync(uint8_t receiver_id, uint8_t operation_code, std::span<uint8_t> payload,
-                                            void(*cb));*/
+    /**
+     * @brief Set how the packets are framed on the wire. Must match the slave's framing.
+     *
+     * Should only be changed while no commands are in flight. Drops whatever has been received of the current
+     * response.
+     */
+    void setFraming(Framing framing);
 
-    void run();
+    [[nodiscard]] Framing getFraming() const;
 
-    [[nodiscard]] const CommunicationStatistics& getStatistics() const;
+    /**
+     * @brief Set how the commands that failed on the way (timed out, corrupted) are retried. No retries by default.
+     *
+     * A retry is sent right after the failure has been detected, behind the requests already in flight, and completes
+     * the command the same way the first attempt would have. The callback only sees the final result.
+     */
+    void setRetryPolicy(RetryPolicy retry_policy);
+
+    [[nodiscard]] RetryPolicy getRetryPolicy() const;
+
+    /**
+     * @brief Set the baud rate the port is used with, the response timeouts are calculated from it.
+     *
+     * Does not change the port's baud rate, only tells the handler about it.
+     */
+    void setBaudRate(uint32_t baud_rate);
+
+    [[nodiscard]] uint32_t getBaudRate() const;
+
+    /**
+     * @brief Get how long the responses to the op code have been measured to take, see `masterResponseTimeoutUs()`.
+     *
+     * @return The estimate in microseconds, 0 if the op code has not been answered yet.
+     */
+    [[nodiscard]] uint32_t getHandlerTimeEstimateUs(uint8_t op_code) const;
 
 private:
-    uint8_t tx_buffer_[RequestPacket::K_PACKET_MAX_SIZE]              = {};
-    uint8_t rx_buffer_[ResponsePacket::K_PACKET_MAX_SIZE]             = {};
-    uint8_t command_staging_buffer[RequestPacket::K_PAYLOAD_MAX_SIZE] = {};
+    uint8_t request_packets_[K_MAX_IN_FLIGHT_REQUESTS][RequestPacket::K_PACKET_MAX_SIZE] = {};
+    uint8_t tx_frame_buffer_[cobsFrameMaxSize(RequestPacket::K_PACKET_MAX_SIZE)] = {};
 
     drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface_;
     CommunicationStatistics                                    communication_statistics_;
+    PacketReceiver<ResponsePacket>                             response_receiver_;
 
     drivers::interfaces::ClockInterface& timeout_clock_;
-    uint64_t                             response_timout_start_time_point_;
+    uint64_t                             response_timout_start_time_point_ = 0;
+    uint64_t                             response_timeout_us_              = 0;
+    uint32_t                             baud_rate_                        = K_DEFAULT_LINK_SETTINGS.baud_rate;
+    HandlerTimeEstimator                 handler_time_estimator_;
+
+    RetryPolicy retry_policy_;
+    uint8_t     next_sequence_number_   = K_NO_SEQUENCE_NUMBER;
+    bool        sequence_number_seeded_ = false;
+
+    OperationStatisticsTable<LatencyHistogram> round_trip_latencies_;
+    LatencyHistogram                           all_round_trip_latencies_;
+
+    // Type erased callback, cast back to the AsyncResponseCallback<T_Command> by the completion adapter
+    using GenericCallback = void (*)();
+
+    struct InFlightRequest;
+    // Returns the response code the command completed with, which can differ from the received one
+    using CompletionAdapterFunc = ResponseCode (*)(const InFlightRequest&, ResponseCode, std::span<uint8_t>);
+
+    struct InFlightRequest {
+        uint8_t               receiver_id         = 0;
+        uint8_t               operation_code      = 0;
+        uint8_t               sequence_number     = K_NO_SEQUENCE_NUMBER;
+        commands::Idempotency idempotency         = commands::Idempotency::non_idempotent;
+        uint8_t               packet_slot         = 0;  // Index into request_packets_
+        uint8_t               retry_count         = 0;
+        size_t                request_packet_size = 0;
+        uint32_t              handler_timeout_us  = 0;
+        uint64_t              transmit_time_us    = 0;
+        CompletionAdapterFunc completion_adapter  = nullptr;
+        GenericCallback       callback            = nullptr;
+        void*                 user_data           = nullptr;
+    };
 
-    // TODO: queue for requests and callbacks
-    // AsyncCallBack next_response_cb_ = nullptr;
+    utils::StaticList<InFlightRequest, K_MAX_IN_FLIGHT_REQUESTS> in_flight_requests_;
+
+    UnsolicitedFrameCallback unsolicited_frame_callback_           = nullptr;
+    void*                    unsolicited_frame_callback_user_data_ = nullptr;
+
+    template <commands::CommandType T_Command>
+    struct BlockingCompletion {
+        typename T_Command::Response response;
+        bool                         completed = false;
+    };
+
+    template <commands::CommandType T_Command>
+    static void onBlockingCommandCompleted(const typename T_Command::Response& response, void* user_data) {
+        auto* completion      = static_cast<BlockingCompletion<T_Command>*>(user_data);
+        completion->response  = response;
+        completion->completed = true;
+    }
 
 private:
     void startResponseTimeout();
     bool responseHasTimedout();
+    void addHandlerTimeSample(size_t response_packet_size);
+    void addRoundTripSample(const InFlightRequest& answered_request);
+
+    void transmitPacket(std::span<uint8_t> packet_bytes);
+    void handleCorruptedFrame();
+
+    [[nodiscard]] uint8_t findFreePacketSlot() const;
+    [[nodiscard]] uint8_t takeSequenceNumber();
+    [[nodiscard]] bool    shouldRetry(const InFlightRequest& failed_request, ResponseCode response_code) const;
+    void                  retry(InFlightRequest failed_request);
+
+    void handleResponse(const ResponsePacket& response, ResponseCode response_code, size_t response_packet_size);
+    [[nodiscard]] size_t findInFlightRequest(uint8_t sequence_number) const;
+    [[nodiscard]] size_t failSkippedInFlightRequests(uint8_t sequence_number);
+
+    void completeInFlightRequest(size_t index, ResponseCode response_code, std::span<uint8_t> response_payload);
+    void completeOldestInFlightRequest(ResponseCode response_code, std::span<uint8_t> response_payload);
+    void failAllInFlightRequests(ResponseCode response_code);
+    void dispatchUnsolicitedFrame(std::span<uint8_t> frame_payload);
 };
 
 }  // namespace serial_communication_framework
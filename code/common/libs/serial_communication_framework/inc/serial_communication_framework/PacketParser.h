@@ -0,0 +1,121 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETPARSER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETPARSER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "math/crc.h"
+#include "serial_communication_framework/packets.h"
+
+namespace serial_communication_framework {
+
+enum class ParseResult {
+    incomplete,         ///< More bytes are needed
+    packet_complete,    ///< A whole packet with valid CRCs has been received
+    header_corrupted,   ///< Header CRC did not match, the payload size and the packet boundaries can't be trusted
+    payload_corrupted,  ///< Header was valid but the payload CRC did not match
+    frame_corrupted,    ///< The frame did not hold exactly one packet, bytes were lost. Only reported with framing
+};
+
+/**
+ * @brief Incremental parser that assembles packets from a byte stream.
+ *
+ * The bytes are received straight into the parser's buffer: `getReceiveBuffer()` tells where the next bytes go and
+ * `commitReceivedBytes()` processes them. The receive buffer never reaches past the end of the current packet, so
+ * back to back packets are parsed by repeating the two calls and no bytes of the next packet have to be carried over.
+ *
+ * The header CRC is checked as soon as the header is complete and the payload CRC is calculated as the payload
+ * arrives, so a completed packet has been validated without going over its bytes again.
+ *
+ * @tparam T_Packet RequestPacket or ResponsePacket.
+ */
+template <typename T_Packet>
+class PacketParser {
+public:
+    /**
+     * @brief Get the buffer the next received bytes should be written to.
+     *
+     * Its size is the amount of bytes still missing from the current stage (header or the rest of the packet). Empty
+     * once the packet has finished, until `reset()` is called.
+     */
+    [[nodiscard]] std::span<uint8_t> getReceiveBuffer() {
+        if (finished_) return {};
+        return std::span<uint8_t>(buffer_).subspan(received_size_, expected_size_ - received_size_);
+    }
+
+    /**
+     * @brief Process the bytes that were written to the start of `getReceiveBuffer()`.
+     *
+     * @param byte_count Amount of bytes written, at most the size of the receive buffer.
+     * @return What the bytes completed. Anything else than `incomplete` finishes the packet, the parser has to be
+     *         reset before the next one.
+     */
+    ParseResult commitReceivedBytes(size_t byte_count) {
+        if (finished_ || byte_count == 0) return ParseResult::incomplete;
+
+        const size_t first_new_byte = received_size_;
+        received_size_ += byte_count;
+
+        if (first_new_byte < T_Packet::K_HEADER_SIZE) {
+            if (received_size_ < T_Packet::K_HEADER_SIZE) return ParseResult::incomplete;
+
+            const uint8_t header_crc =
+                math::generateCrc8(std::span<const uint8_t>(buffer_, T_Packet::K_HEADER_CRC_INDEX));
+            if (header_crc != buffer_[T_Packet::K_HEADER_CRC_INDEX]) {
+                finished_ = true;
+                return ParseResult::header_corrupted;
+            }
+
+            // The header is followed by the payload CRC and the payload
+            expected_size_ = T_Packet::K_HEADER_WITH_PAYLOAD_CRC_SIZE + buffer_[T_Packet::K_PAYLOAD_SIZE_INDEX];
+        }
+
+        // Fold the payload bytes into the CRC as they arrive
+        const size_t first_payload_byte = std::max(first_new_byte, T_Packet::K_PAYLOAD_START_OFFSET);
+        if (received_size_ > first_payload_byte) {
+            const std::span<const uint8_t> new_payload_bytes(&buffer_[first_payload_byte],
+                                                             received_size_ - first_payload_byte);
+            payload_crc_ = math::generateCrc8(new_payload_bytes, payload_crc_);
+        }
+
+        if (received_size_ < expected_size_) return ParseResult::incomplete;
+
+        finished_ = true;
+        if (payload_crc_ != buffer_[T_Packet::K_PAYLOAD_CRC_INDEX]) return ParseResult::payload_corrupted;
+        return ParseResult::packet_complete;
+    }
+
+    /**
+     * @brief Get the bytes of the finished packet, e.g. for `deSerializeRequest`. Valid until `reset()`.
+     */
+    [[nodiscard]] std::span<uint8_t> getPacketBytes() { return std::span<uint8_t>(buffer_).first(received_size_); }
+
+    /**
+     * @brief Get the amount of bytes received of the current packet.
+     */
+    [[nodiscard]] size_t getReceivedSize() const { return received_size_; }
+
+    /**
+     * @brief Start parsing a new packet, dropping what has been received of the current one.
+     */
+    void reset() {
+        received_size_ = 0;
+        expected_size_ = T_Packet::K_HEADER_SIZE;
+        payload_crc_   = 0;
+        finished_      = false;
+    }
+
+private:
+    uint8_t buffer_[T_Packet::K_PACKET_MAX_SIZE] = {};
+
+    size_t  received_size_                       = 0;
+    size_t  expected_size_                       = T_Packet::K_HEADER_SIZE;
+    uint8_t payload_crc_                         = 0;
+    bool    finished_                            = false;
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETPARSER_H
@@ -0,0 +1,202 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETRECEIVER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETRECEIVER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "serial_communication_framework/PacketParser.h"
+#include "serial_communication_framework/cobs.h"
+#include "serial_communication_framework/common.h"
+
+namespace serial_communication_framework {
+
+/**
+ * @brief Receives packets from a serial interface, removing the framing if there is any.
+ *
+ * Without framing the bytes are read straight into the parser. With COBS framing the bytes are read in chunks and
+ * decoded into the parser. After a broken frame (corrupted header, too many bytes) the rest of the frame is skipped
+ * up to the delimiter, so the next frame is received correctly. Every frame finishes as exactly one packet or one
+ * error, so the receiver can answer every frame it got even when the sender's packets were merged or cut.
+ *
+ * @tparam T_Packet RequestPacket or ResponsePacket.
+ */
+template <typename T_Packet>
+class PacketReceiver {
+public:
+    explicit PacketReceiver(CommunicationStatistics& statistics) : statistics_(statistics) {}
+
+    void setFraming(Framing framing) {
+        framing_ = framing;
+        parser_.reset();
+        decoder_.reset();
+        encoded_index_        = 0;
+        encoded_size_         = 0;
+        last_result_          = ParseResult::incomplete;
+        skip_frame_           = false;
+        skipped_any_byte_     = false;
+        report_skipped_bytes_ = false;
+    }
+
+    [[nodiscard]] Framing getFraming() const { return framing_; }
+
+    /**
+     * @brief Receive bytes until a packet finishes or the byte budget runs out.
+     *
+     * @param communication_interface Where the bytes are read from.
+     * @param byte_budget             Amount of bytes that may still be read from the interface. Decreased by the
+     *                                amount read. Bytes read earlier but not yet processed are not counted.
+     * @return Anything else than `incomplete` finishes the packet, `finishPacket()` must be called before the next.
+     */
+    ParseResult receive(drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface,
+                        size_t&                                                    byte_budget) {
+        if (framing_ == Framing::cobs) return receiveFramed(communication_interface, byte_budget);
+
+        while (byte_budget > 0) {
+            // Read straight into the parser, never past the end of the current packet
+            std::span<uint8_t> receive_buffer = parser_.getReceiveBuffer();
+            receive_buffer                    = receive_buffer.first(std::min(receive_buffer.size(), byte_budget));
+
+            const size_t read_byte_count = communication_interface.readReceivedBytes(receive_buffer);
+            if (read_byte_count == 0) break;
+            byte_budget -= read_byte_count;
+            statistics_.bytes_received += read_byte_count;
+
+            const ParseResult parse_result = parser_.commitReceivedBytes(read_byte_count);
+            if (parse_result != ParseResult::incomplete) return parse_result;
+        }
+        return ParseResult::incomplete;
+    }
+
+    /**
+     * @brief Get the bytes of the finished packet. Valid until `finishPacket()`.
+     */
+    [[nodiscard]] std::span<uint8_t> getPacketBytes() { return parser_.getPacketBytes(); }
+
+    /**
+     * @brief Get the amount of packet bytes received of the current packet, without the framing.
+     */
+    [[nodiscard]] size_t getReceivedSize() const { return parser_.getReceivedSize(); }
+
+    /**
+     * @brief Start receiving the next packet after the previous one has been handled.
+     */
+    void finishPacket() {
+        // Whatever is left of the frame after the packet is not part of any packet. If the packet itself was whole,
+        // bytes after it mean that its delimiter was lost and the next frame is being skipped, which is reported too
+        if (framing_ == Framing::cobs && last_result_ != ParseResult::frame_corrupted) {
+            skip_frame_           = true;
+            report_skipped_bytes_ = last_result_ != ParseResult::header_corrupted;
+        }
+        last_result_ = ParseResult::incomplete;
+        parser_.reset();
+    }
+
+    /**
+     * @brief Drop what has been received of the current packet, e.g. after a timeout.
+     */
+    void dropPartialPacket() {
+        if (framing_ == Framing::cobs && parser_.getReceivedSize() > 0) {
+            skip_frame_           = true;
+            report_skipped_bytes_ = false;
+        }
+        parser_.reset();
+    }
+
+    /**
+     * @brief Check if bytes have been read from the interface that the next `receive()` handles before reading more.
+     */
+    [[nodiscard]] bool hasBufferedBytes() const { return encoded_index_ < encoded_size_; }
+
+private:
+    static constexpr size_t K_ENCODED_CHUNK_SIZE = 64;
+
+    CommunicationStatistics& statistics_;
+    Framing                  framing_ = Framing::none;
+    PacketParser<T_Packet>   parser_;
+    CobsDecoder              decoder_;
+
+    // Read but not yet decoded bytes, a packet can finish in the middle of a chunk
+    uint8_t encoded_buffer_[K_ENCODED_CHUNK_SIZE] = {};
+    size_t  encoded_index_                        = 0;
+    size_t  encoded_size_                         = 0;
+
+    ParseResult last_result_          = ParseResult::incomplete;
+    bool        skip_frame_           = false;  // Drop the bytes up to the next delimiter
+    bool        skipped_any_byte_     = false;
+    bool        report_skipped_bytes_ = false;
+
+    ParseResult receiveFramed(drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface,
+                              size_t&                                                    byte_budget) {
+        std::span<uint8_t> receive_buffer = parser_.getReceiveBuffer();
+        size_t             decoded_count  = 0;
+
+        while (true) {
+            if (encoded_index_ == encoded_size_) {
+                const size_t read_byte_count = communication_interface.readReceivedBytes(
+                    std::span<uint8_t>(encoded_buffer_).first(std::min(K_ENCODED_CHUNK_SIZE, byte_budget)));
+                if (read_byte_count == 0) break;
+                byte_budget -= read_byte_count;
+                statistics_.bytes_received += read_byte_count;
+                encoded_index_ = 0;
+                encoded_size_  = read_byte_count;
+            }
+
+            const uint8_t             encoded_byte = encoded_buffer_[encoded_index_++];
+            uint8_t                   decoded_byte = 0;
+            const CobsDecoder::Result result       = decoder_.decode(encoded_byte, decoded_byte);
+
+            if (result == CobsDecoder::Result::frame_ended) {
+                last_result_ = onFrameEnded(decoded_count);
+                if (last_result_ != ParseResult::incomplete) return last_result_;
+
+                receive_buffer = parser_.getReceiveBuffer();
+                decoded_count  = 0;
+                continue;
+            }
+            if (result == CobsDecoder::Result::no_data) continue;
+
+            if (skip_frame_) {
+                skipped_any_byte_ = true;
+                continue;
+            }
+
+            receive_buffer[decoded_count++] = decoded_byte;
+            if (decoded_count < receive_buffer.size()) continue;
+
+            // The parser's current stage is full
+            last_result_ = parser_.commitReceivedBytes(decoded_count);
+            if (last_result_ != ParseResult::incomplete) return last_result_;
+
+            receive_buffer = parser_.getReceiveBuffer();
+            decoded_count  = 0;
+        }
+
+        (void)parser_.commitReceivedBytes(decoded_count);
+        return ParseResult::incomplete;
+    }
+
+    ParseResult onFrameEnded(size_t decoded_count) {
+        if (skip_frame_) {
+            const bool report = skipped_any_byte_ && report_skipped_bytes_;
+            if (skipped_any_byte_) statistics_.resynchronizations++;
+            skip_frame_       = false;
+            skipped_any_byte_ = false;
+            return report ? ParseResult::frame_corrupted : ParseResult::incomplete;
+        }
+
+        // Empty frame, e.g. a delimiter sent to flush out a broken frame
+        if (parser_.getReceivedSize() + decoded_count == 0) return ParseResult::incomplete;
+
+        // A whole packet would have been returned before its delimiter, so bytes were lost in the middle of the frame
+        parser_.reset();
+        statistics_.resynchronizations++;
+        return ParseResult::frame_corrupted;
+    }
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_PACKETRECEIVER_H
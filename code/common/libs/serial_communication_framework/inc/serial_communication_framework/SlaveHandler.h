@@ -9,9 +9,13 @@
 #include "debug_print/debug_print.h"
 #include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
 #include "drivers/interfaces/ClockInterface.h"
+#include "serial_communication_framework/PacketReceiver.h"
+#include "serial_communication_framework/cobs.h"
 #include "serial_communication_framework/command_interface.h"
 #include "serial_communication_framework/common.h"
 #include "serial_communication_framework/packets.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+#include "serial_communication_framework/timeouts.h"
 
 namespace serial_communication_framework {
 
@@ -26,16 +30,17 @@ public:
     template <commands::CommandType T_Command,
               typename T_Command::Response (*T_HandlerFunc)(const typename T_Command::Request&)>
     void registerCommandHandler() {
-        ASSERT_WITH_MESSAGE(command_handlers_[T_Command::K_OP_CODE] == nullptr, "Op code already registered");
+        ASSERT_WITH_MESSAGE(command_handlers_[T_Command::K_OP_CODE].adapter == nullptr, "Op code already registered");
 
         // Adapter — static lambda (no captures, convertible to function pointer)
         auto adapter_func = +[](SlaveHandler* self, std::span<std::uint8_t> request_data) -> AdapterFuncResponse {
+            // Views in the request point to the parser's buffer, which stays untouched until the handler has returned
             typename T_Command::Request  command_req{};
             const commands::ParsingError parse_result = command_req.deserialize(request_data);
             if (parse_result != commands::ParsingError::no_error) {
                 DEBUG_PRINT("[SlaveHandler] deserialize failed: op_code=%h payload_size=% parse_error=%\n",
                             T_Command::K_OP_CODE, request_data.size_bytes(), static_cast<uint8_t>(parse_result));
-                return {ResponseCode::malformed_request, {}};
+                return {ResponseCode::malformed_request, 0};
             }
 
             typename T_Command::Response response = T_HandlerFunc(command_req);
@@ -44,44 +49,120 @@ public:
             ASSERT_WITH_MESSAGE(response.response_code < ResponseCode::FIRST_INTERNAL ||
                                     response.response_code > ResponseCode::LAST_INTERNAL,
                                 "Command handler returned internal error code");
+            ASSERT_WITH_MESSAGE(response.response_code != ResponseCode::unsolicited_frame,
+                                "Command handler returned unsolicited frame code");
 
-            return {response.response_code, response.serialize(self->command_staging_buffer_)};
+            // Serialized straight into the response packet, run() only adds the header and the CRCs around it
+            const std::span<uint8_t> payload_buffer   = getResponsePayloadBuffer(self->tx_buffer_);
+            const std::span<uint8_t> response_payload = response.serialize(payload_buffer);
+            ASSERT_WITH_MESSAGE(response_payload.data() == payload_buffer.data(),
+                                "Response was not serialized in place");
+
+            return {response.response_code, response_payload.size_bytes()};
         };
 
-        command_handlers_[T_Command::K_OP_CODE] = adapter_func;
+        // The registered op codes get their statistics first, the unknown ones received share the rest
+        const bool tracked = communication_statistics_.operations.track(T_Command::K_OP_CODE) &&
+                             handler_time_statistics_.track(T_Command::K_OP_CODE);
+        ASSERT_WITH_MESSAGE(tracked, "More op codes registered than K_MAX_TRACKED_OPERATION_CODES");
+
+        command_handlers_[T_Command::K_OP_CODE] = {.adapter     = adapter_func,
+                                                   .timeout_us  = handlerTimeoutUs<T_Command>(),
+                                                   .idempotency = T_Command::K_IDEMPOTENCY};
     }
 
+    /**
+     * @brief Receive and handle the requests.
+     *
+     * Non-blocking. Drains all the bytes that have been received by the time of the call, handling every request
+     * that gets completed, so a burst of back to back requests is handled with a single call.
+     */
     void run();
 
+    /**
+     * @brief Send a frame to the master without it being requested (e.g. telemetry).
+     *
+     * Must be called from the same context as `run()` so that the frame is never placed in the middle of a response.
+     * The frame carries the id of this slave so that the master can tell the slaves sharing a bus apart.
+     *
+     * @param stream_id Identifies what kind of data the frame carries, so that the master can dispatch it.
+     * @param payload   The stream's data. At most K_UNSOLICITED_FRAME_PAYLOAD_MAX_SIZE bytes.
+     */
+    void transmitUnsolicitedFrame(uint8_t stream_id, std::span<const uint8_t> payload);
+
     [[nodiscard]] const CommunicationStatistics& getCommunicationStatistics() const;
 
+    /**
+     * @brief Get how long the handler of the op code has taken, from deserializing the request to serializing the
+     *        response.
+     */
+    [[nodiscard]] const DurationStatistics& getHandlerTimeStatistics(uint8_t op_code) const;
+
+    /**
+     * @brief Set how the packets are framed on the wire. Must match the master's framing.
+     *
+     * Drops whatever has been received of the current request.
+     */
+    void setFraming(Framing framing);
+
+    [[nodiscard]] Framing getFraming() const;
+
 private:
-    uint8_t tx_buffer_[ResponsePacket::K_PACKET_MAX_SIZE]              = {};
-    uint8_t rx_buffer_[RequestPacket::K_PACKET_MAX_SIZE]               = {};
-    uint8_t command_staging_buffer_[RequestPacket::K_PAYLOAD_MAX_SIZE] = {};
+    uint8_t tx_buffer_[ResponsePacket::K_PACKET_MAX_SIZE]                         = {};
+    uint8_t tx_frame_buffer_[cobsFrameMaxSize(ResponsePacket::K_PACKET_MAX_SIZE)] = {};
 
     drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface_;
     CommunicationStatistics                                    communication_statistics_;
+    PacketReceiver<RequestPacket>                              request_receiver_;
     uint8_t                                                    device_id_;
 
     drivers::interfaces::ClockInterface& timeout_clock_;
-    uint64_t                             response_timout_start_time_point_;
+    uint64_t                             response_timout_start_time_point_ = 0;
+    uint32_t                             response_timeout_us_              = 0;
 
     struct AdapterFuncResponse {
-        ResponseCode            response_code;
-        std::span<std::uint8_t> response_data;
+        ResponseCode response_code;
+        size_t       response_payload_size;  // The payload has been serialized in place into tx_buffer_
     };
 
     using AdapterFunc = AdapterFuncResponse (*)(SlaveHandler*, std::span<uint8_t>);
 
+    struct CommandHandler {
+        AdapterFunc           adapter     = nullptr;
+        uint32_t              timeout_us  = 0;  // How long the handler may take before its response is dropped
+        commands::Idempotency idempotency = commands::Idempotency::non_idempotent;
+    };
+
     static constexpr size_t K_COMMAND_HANDLER_TABLE_SIZE =
         static_cast<size_t>(std::numeric_limits<decltype(RequestPacket::Header::operation_code)>::max()) + 1;
 
-    std::array<AdapterFunc, K_COMMAND_HANDLER_TABLE_SIZE> command_handlers_ = {};
+    std::array<CommandHandler, K_COMMAND_HANDLER_TABLE_SIZE> command_handlers_ = {};
+
+    OperationStatisticsTable<DurationStatistics> handler_time_statistics_;
+
+    // The last non-idempotent request. Its retries are answered with the response it got instead of being handled
+    // again, see commands::Idempotency
+    struct SequencedRequest {
+        uint8_t operation_code  = 0;
+        uint8_t sequence_number = K_NO_SEQUENCE_NUMBER;
+        uint8_t payload_crc     = 0;
+        size_t  response_size   = 0;
+    };
+
+    SequencedRequest last_sequenced_request_;
+    uint8_t          last_sequenced_response_[ResponsePacket::K_PACKET_MAX_SIZE] = {};
 
 private:
-    void startResponseTimeout();
+    void startResponseTimeout(uint32_t timeout_us);
     bool responseHasTimedout();
+
+    void transmitPacket(std::span<uint8_t> packet_bytes);
+
+    void handleCorruptedHeader();
+    void handleRequest(std::span<uint8_t> packet_bytes, bool payload_is_valid);
+
+    [[nodiscard]] bool isRetryOfLastSequencedRequest(const RequestPacket& packet) const;
+    void               rememberSequencedRequest(const RequestPacket& packet, std::span<uint8_t> serialized_response);
 };
 
 }  // namespace serial_communication_framework
@@ -0,0 +1,66 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_SLAVELINKSWITCHER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_SLAVELINKSWITCHER_H
+
+#include <cstdint>
+
+#include "drivers/interfaces/ClockInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/common.h"
+
+namespace serial_communication_framework {
+
+/**
+ * @brief Switches the slave's link settings when the master asks for it, falling back if the switch fails.
+ *
+ * The switch is requested from the command handler, but done only in `run()` after the response has been sent with
+ * the current settings. Then the new settings must be verified by the master: if no valid packet is received with
+ * them within K_LINK_VERIFY_TIMEOUT_MS, the previous settings are restored, so a rate the cable can't carry never
+ * leaves the device unreachable.
+ */
+class SlaveLinkSwitcher {
+public:
+    SlaveLinkSwitcher(SlaveHandler& slave_handler, drivers::interfaces::SerialPortConfigurationInterface& port,
+                      drivers::interfaces::ClockInterface& clock_interface);
+
+    /**
+     * @brief Request the settings to be switched once the current response has been sent.
+     *
+     * @return false if a switch is already in progress.
+     */
+    [[nodiscard]] bool requestSwitch(LinkSettings settings);
+
+    /**
+     * @brief Do the requested switch and verify it. Must be called after `SlaveHandler::run()`.
+     */
+    void run();
+
+    [[nodiscard]] LinkSettings getLinkSettings() const;
+
+    [[nodiscard]] bool isSwitchInProgress() const;
+
+private:
+    enum class State {
+        idle,
+        switch_requested,
+        verifying,
+    };
+
+    SlaveHandler&                                          slave_handler_;
+    drivers::interfaces::SerialPortConfigurationInterface& port_;
+    drivers::interfaces::ClockInterface&                   clock_;
+
+    State        state_              = State::idle;
+    LinkSettings current_settings_   = K_DEFAULT_LINK_SETTINGS;
+    LinkSettings previous_settings_  = K_DEFAULT_LINK_SETTINGS;
+    LinkSettings requested_settings_ = K_DEFAULT_LINK_SETTINGS;
+
+    uint64_t verify_start_time_point_     = 0;
+    uint64_t valid_packets_before_switch_ = 0;
+
+    bool apply(LinkSettings settings);
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_SLAVELINKSWITCHER_H
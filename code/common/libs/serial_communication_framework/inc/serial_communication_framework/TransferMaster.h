@@ -0,0 +1,374 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERMASTER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERMASTER_H
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "assert/assert.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/TransferReceiver.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/transfer.h"
+
+namespace serial_communication_framework {
+
+/**
+ * @brief The commands the protocol carries the transfers with. The framework defines the payloads, the protocol the
+ *        op codes.
+ */
+template <typename T>
+concept TransferCommandSet =
+    commands::CommandType<typename T::Start> && commands::CommandType<typename T::Segment> &&
+    commands::CommandType<typename T::Finish> && commands::CommandType<typename T::Read> &&
+    std::same_as<typename T::Start::Request, TransferStartRequest> &&
+    std::same_as<typename T::Segment::Request, TransferSegmentRequest> &&
+    std::same_as<typename T::Finish::Request, TransferFinishRequest> &&
+    std::same_as<typename T::Read::Request, TransferReadRequest> &&
+    std::same_as<typename T::Read::Response, TransferReadResponse>;
+
+struct TransferOptions {
+    size_t  window_size  = K_TRANSFER_MAX_WINDOW_SIZE;  // Segments in flight at once, 1 is stop and wait
+    size_t  segment_size = K_TRANSFER_SEGMENT_MAX_SIZE;
+    uint8_t max_attempts = 5;  // Per segment, the transfer fails when a segment has failed this many times
+};
+
+struct TransferStatistics {
+    uint32_t segments_sent   = 0;  // Including the retransmissions
+    uint32_t retransmissions = 0;
+};
+
+/**
+ * @brief Master side of the segmented transfers.
+ *
+ * Keeps a window of segments in flight through the master handler. The segments are completed in order, a segment
+ * that failed on the way (timed out, corrupted) is sent again on its own while the window keeps moving. The window
+ * can't move past a missing segment by more than its size, which is what the receiver can hold out of order.
+ *
+ * Non-blocking. `run()` submits the segments, the master handler's `run()` receives their responses, so both must be
+ * called until `isFinished()`.
+ *
+ * @tparam T_Commands The protocol's transfer commands, see TransferCommandSet.
+ */
+template <TransferCommandSet T_Commands>
+class TransferMaster {
+public:
+    explicit TransferMaster(MasterHandler& master_handler) : master_handler_(master_handler) {}
+
+    // The in-flight commands point to this
+    TransferMaster(const TransferMaster&)            = delete;
+    TransferMaster& operator=(const TransferMaster&) = delete;
+
+    /**
+     * @brief Start sending the data to the slave's upload with the id.
+     *
+     * @param data Must stay valid until the transfer has finished.
+     * @return false if the previous transfer has not finished yet.
+     */
+    bool startUpload(uint8_t receiver_id, uint8_t transfer_id, std::span<const uint8_t> data,
+                     TransferOptions options = {}) {
+        if (!begin(receiver_id, transfer_id, static_cast<uint32_t>(data.size_bytes()), options)) return false;
+        upload_data_ = data;
+        is_upload_   = true;
+        phase_       = Phase::starting;
+        return true;
+    }
+
+    /**
+     * @brief Start receiving the slave's download with the id into the buffer, the size of the buffer is the size of
+     *        the download.
+     *
+     * @param target_buffer Must stay valid until the transfer has finished.
+     * @return false if the previous transfer has not finished yet.
+     */
+    bool startDownload(uint8_t receiver_id, uint8_t transfer_id, std::span<uint8_t> target_buffer,
+                       TransferOptions options = {}) {
+        if (!begin(receiver_id, transfer_id, static_cast<uint32_t>(target_buffer.size_bytes()), options)) return false;
+        receiver_.start(target_buffer);
+        phase_ = Phase::segments;
+        return true;
+    }
+
+    /**
+     * @brief Start receiving the slave's download with the id into the sink, which gets the bytes in order.
+     *
+     * @return false if the previous transfer has not finished yet.
+     */
+    bool startDownload(uint8_t receiver_id, uint8_t transfer_id, uint32_t total_size, TransferSink sink,
+                       void* user_data, TransferOptions options = {}) {
+        if (!begin(receiver_id, transfer_id, total_size, options)) return false;
+        receiver_.start(total_size, sink, user_data);
+        phase_ = Phase::segments;
+        return true;
+    }
+
+    /**
+     * @brief Submit the commands the transfer needs next, as far as the window and the master handler allow.
+     */
+    void run() {
+        switch (phase_) {
+            case Phase::starting:
+                if (!control_command_in_flight_) submitStart();
+                return;
+
+            case Phase::segments:
+                submitSegments();
+                if (window_start_ == segment_count_) {
+                    if (is_upload_) {
+                        phase_            = Phase::finishing;
+                        control_attempts_ = 0;
+                    } else {
+                        phase_ = Phase::done;
+                    }
+                }
+                return;
+
+            case Phase::finishing:
+                if (!control_command_in_flight_) submitFinish();
+                return;
+
+            case Phase::idle:
+            case Phase::done:
+            case Phase::failed:
+                return;
+        }
+    }
+
+    /**
+     * @brief Whether the transfer has succeeded or failed and none of its commands are in flight anymore.
+     */
+    [[nodiscard]] bool isFinished() const {
+        return (phase_ == Phase::idle || phase_ == Phase::done || phase_ == Phase::failed) && in_flight_count_ == 0;
+    }
+
+    /**
+     * @brief ResponseCode::ok if the transfer succeeded, otherwise the code of the command that failed it.
+     */
+    [[nodiscard]] ResponseCode getResult() const { return result_; }
+
+    [[nodiscard]] const TransferStatistics& getStatistics() const { return statistics_; }
+
+private:
+    enum class Phase : uint8_t {
+        idle,
+        starting,   // Upload only, the slave prepares the receiving
+        segments,
+        finishing,  // Upload only, the slave checks and takes the data
+        done,
+        failed,
+    };
+
+    enum class SegmentState : uint8_t {
+        unused,
+        waiting,  // To be sent, for the first time or again
+        in_flight,
+        done,
+    };
+
+    struct SegmentSlot {
+        TransferMaster* owner    = nullptr;
+        uint32_t        offset   = 0;
+        uint32_t        size     = 0;
+        uint8_t         attempts = 0;
+        SegmentState    state    = SegmentState::unused;
+    };
+
+    MasterHandler& master_handler_;
+
+    uint8_t         receiver_id_ = 0;
+    uint8_t         transfer_id_ = 0;
+    uint32_t        total_size_  = 0;
+    TransferOptions options_;
+
+    bool                     is_upload_   = false;
+    std::span<const uint8_t> upload_data_ = {};
+    TransferReceiver         receiver_;  // Downloads only
+
+    Phase        phase_  = Phase::idle;
+    ResponseCode result_ = ResponseCode::ok;
+
+    // Segment i uses the slot i % window size, the window covers the segments window_start_ .. next_segment_ - 1
+    std::array<SegmentSlot, K_TRANSFER_MAX_WINDOW_SIZE> window_;
+    uint32_t                                            segment_count_ = 0;
+    uint32_t                                            window_start_  = 0;
+    uint32_t                                            next_segment_  = 0;
+
+    bool    control_command_in_flight_ = false;
+    uint8_t control_attempts_          = 0;
+    size_t  in_flight_count_           = 0;
+
+    TransferStatistics statistics_;
+
+private:
+    bool begin(uint8_t receiver_id, uint8_t transfer_id, uint32_t total_size, TransferOptions options) {
+        if (!isFinished()) return false;
+        ASSERT_WITH_MESSAGE(options.window_size >= 1 && options.window_size <= K_TRANSFER_MAX_WINDOW_SIZE,
+                            "Transfer window size out of range");
+        ASSERT_WITH_MESSAGE(options.segment_size >= 1 && options.segment_size <= K_TRANSFER_SEGMENT_MAX_SIZE,
+                            "Transfer segment size out of range");
+
+        receiver_id_   = receiver_id;
+        transfer_id_   = transfer_id;
+        total_size_    = total_size;
+        options_       = options;
+        is_upload_     = false;
+        upload_data_   = {};
+        result_        = ResponseCode::ok;
+        segment_count_ = static_cast<uint32_t>((total_size + options.segment_size - 1) / options.segment_size);
+        window_start_  = 0;
+        next_segment_  = 0;
+        window_.fill({});
+        control_command_in_flight_ = false;
+        control_attempts_          = 0;
+        statistics_                = {};
+        return true;
+    }
+
+    void fail(ResponseCode response_code) {
+        if (phase_ == Phase::failed) return;
+        phase_  = Phase::failed;
+        result_ = response_code;
+    }
+
+    // Whether a command that failed with the code is sent again
+    bool retry(ResponseCode response_code, uint8_t attempts) {
+        if (isTransientFailure(response_code) && attempts < options_.max_attempts) return true;
+        fail(response_code);
+        return false;
+    }
+
+    void submitSegments() {
+        // The segments that failed first, they hold the window back
+        for (uint32_t segment = window_start_; segment < next_segment_; segment++) {
+            SegmentSlot& slot = window_[segment % options_.window_size];
+            if (slot.state == SegmentState::waiting && !submitSegment(slot)) return;
+        }
+
+        while (next_segment_ < segment_count_ && next_segment_ < window_start_ + options_.window_size) {
+            SegmentSlot& slot = window_[next_segment_ % options_.window_size];
+            slot              = {.owner  = this,
+                                 .offset = static_cast<uint32_t>(next_segment_ * options_.segment_size),
+                                 .size   = static_cast<uint32_t>(std::min<size_t>(
+                                     options_.segment_size, total_size_ - next_segment_ * options_.segment_size)),
+                                 .state  = SegmentState::waiting};
+            next_segment_++;
+            if (!submitSegment(slot)) return;
+        }
+    }
+
+    bool submitSegment(SegmentSlot& slot) {
+        bool submitted = false;
+        if (is_upload_) {
+            TransferSegmentRequest request;
+            request.transfer_id = transfer_id_;
+            request.offset      = slot.offset;
+            request.raw_bytes   = upload_data_.subspan(slot.offset, slot.size);
+            submitted           = master_handler_.submitCommand<typename T_Commands::Segment>(
+                receiver_id_, request, &TransferMaster::onSegmentWritten, &slot);
+        } else {
+            TransferReadRequest request;
+            request.transfer_id = transfer_id_;
+            request.offset      = slot.offset;
+            request.size        = static_cast<uint8_t>(slot.size);
+            submitted           = master_handler_.submitCommand<typename T_Commands::Read>(
+                receiver_id_, request, &TransferMaster::onSegmentRead, &slot);
+        }
+        // The master handler's pipeline is full, tried again on the next run
+        if (!submitted) return false;
+
+        if (slot.attempts > 0) statistics_.retransmissions++;
+        statistics_.segments_sent++;
+        slot.attempts++;
+        slot.state = SegmentState::in_flight;
+        in_flight_count_++;
+        return true;
+    }
+
+    void completeSegment(SegmentSlot& slot, ResponseCode response_code) {
+        in_flight_count_--;
+        if (phase_ != Phase::segments) return;
+
+        if (response_code != ResponseCode::ok) {
+            if (retry(response_code, slot.attempts)) slot.state = SegmentState::waiting;
+            return;
+        }
+
+        slot.state = SegmentState::done;
+        // Slide over the completed segments at the start of the window
+        while (window_start_ < next_segment_) {
+            SegmentSlot& first_slot = window_[window_start_ % options_.window_size];
+            if (first_slot.state != SegmentState::done) break;
+            first_slot.state = SegmentState::unused;
+            window_start_++;
+        }
+    }
+
+    static void onSegmentWritten(const typename T_Commands::Segment::Response& response, void* user_data) {
+        auto* slot = static_cast<SegmentSlot*>(user_data);
+        slot->owner->completeSegment(*slot, response.response_code);
+    }
+
+    static void onSegmentRead(const TransferReadResponse& response, void* user_data) {
+        auto*           slot          = static_cast<SegmentSlot*>(user_data);
+        TransferMaster* self          = slot->owner;
+        ResponseCode    response_code = response.response_code;
+
+        if (response_code == ResponseCode::ok && self->phase_ == Phase::segments) {
+            if (response.offset != slot->offset || response.raw_bytes.size_bytes() != slot->size) {
+                response_code = ResponseCode::malformed_response;
+            } else {
+                response_code = self->receiver_.receiveSegment(response.offset, response.raw_bytes);
+            }
+        }
+        self->completeSegment(*slot, response_code);
+    }
+
+    void submitStart() {
+        TransferStartRequest request;
+        request.transfer_id = transfer_id_;
+        request.total_size  = total_size_;
+        submitControlCommand<typename T_Commands::Start>(request, &TransferMaster::onStarted);
+    }
+
+    void submitFinish() {
+        TransferFinishRequest request;
+        request.transfer_id = transfer_id_;
+        submitControlCommand<typename T_Commands::Finish>(request, &TransferMaster::onFinished);
+    }
+
+    template <commands::CommandType T_Command>
+    void submitControlCommand(typename T_Command::Request request, AsyncResponseCallback<T_Command> callback) {
+        if (!master_handler_.submitCommand<T_Command>(receiver_id_, request, callback, this)) return;
+        control_command_in_flight_ = true;
+        control_attempts_++;
+        in_flight_count_++;
+    }
+
+    // Whether the phase the control command was sent for can go on
+    bool completeControlCommand(ResponseCode response_code, Phase expected_phase) {
+        in_flight_count_--;
+        control_command_in_flight_ = false;
+        if (phase_ != expected_phase) return false;
+        if (response_code == ResponseCode::ok) return true;
+        (void)retry(response_code, control_attempts_);
+        return false;
+    }
+
+    static void onStarted(const typename T_Commands::Start::Response& response, void* user_data) {
+        auto* self = static_cast<TransferMaster*>(user_data);
+        if (self->completeControlCommand(response.response_code, Phase::starting)) self->phase_ = Phase::segments;
+    }
+
+    static void onFinished(const typename T_Commands::Finish::Response& response, void* user_data) {
+        auto* self = static_cast<TransferMaster*>(user_data);
+        if (self->completeControlCommand(response.response_code, Phase::finishing)) self->phase_ = Phase::done;
+    }
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERMASTER_H
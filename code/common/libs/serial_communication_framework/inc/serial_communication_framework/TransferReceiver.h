@@ -0,0 +1,83 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERRECEIVER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERRECEIVER_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/transfer.h"
+
+namespace serial_communication_framework {
+
+/**
+ * @brief Reassembles the segments of a transfer, on whichever end receives the data.
+ *
+ * The segments arrive in order unless one of them is lost, then the ones after it arrive before the lost one is sent
+ * again. Those are held until the gap has been filled, at most one window's worth of them. With a buffer they are
+ * written to their place right away, with a sink they are copied aside and passed to the sink in order.
+ *
+ * Segments that have already been received are accepted again without effect, so a segment whose acknowledgement
+ * was lost can be sent again.
+ */
+class TransferReceiver {
+public:
+    /**
+     * @brief Start receiving into the buffer, the size of the buffer is the size of the transfer.
+     */
+    void start(std::span<uint8_t> target_buffer);
+
+    /**
+     * @brief Start receiving into the sink, which gets the bytes in order.
+     */
+    void start(uint32_t total_size, TransferSink sink, void* user_data);
+
+    /**
+     * @brief Take a received segment.
+     *
+     * @return ResponseCode::ok if the segment was taken or had already been received.
+     *         ResponseCode::forbidden if no transfer has been started or the sink has failed.
+     *         ResponseCode::out_of_bounds if the segment is outside the data or too far ahead of the missing bytes.
+     *         Otherwise the code the sink failed with, every later segment fails with the same code.
+     */
+    ResponseCode receiveSegment(uint32_t offset, std::span<const uint8_t> bytes);
+
+    [[nodiscard]] bool isComplete() const;
+
+    /**
+     * @brief Get the amount of bytes received in order from the start of the data.
+     */
+    [[nodiscard]] uint32_t getCompletedSize() const;
+
+    [[nodiscard]] uint32_t getTotalSize() const;
+
+private:
+    struct PendingSegment {
+        bool     used                               = false;
+        uint32_t offset                             = 0;
+        size_t   size                               = 0;
+        uint8_t  bytes[K_TRANSFER_SEGMENT_MAX_SIZE] = {};  // Only used with a sink
+    };
+
+    // The segment before these is the missing one
+    std::array<PendingSegment, K_TRANSFER_MAX_WINDOW_SIZE - 1> pending_segments_;
+
+    std::span<uint8_t> target_buffer_;
+    TransferSink       sink_           = nullptr;
+    void*              sink_user_data_ = nullptr;
+
+    uint32_t     total_size_     = 0;
+    uint32_t     completed_size_ = 0;
+    bool         started_        = false;
+    ResponseCode failure_code_   = ResponseCode::ok;
+
+private:
+    void         reset();
+    ResponseCode deliver(uint32_t offset, std::span<const uint8_t> bytes);
+    ResponseCode deliverPendingSegments();
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERRECEIVER_H
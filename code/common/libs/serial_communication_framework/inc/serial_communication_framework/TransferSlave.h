@@ -0,0 +1,94 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERSLAVE_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERSLAVE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "serial_communication_framework/TransferReceiver.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/transfer.h"
+#include "utils/StaticList.h"
+
+namespace serial_communication_framework {
+
+// How many uploads and downloads can be registered in total
+constexpr size_t K_MAX_TRANSFER_ENDPOINTS = 8;
+
+/**
+ * @brief Slave side of the segmented transfers.
+ *
+ * The data that can be transferred is registered by transfer id. The command handlers pass the transfer requests to
+ * this, the same way as the other command handlers pass theirs to the objects they control. Only one upload can be
+ * received at a time, starting another one abandons the previous.
+ */
+class TransferSlave {
+public:
+    /**
+     * @brief Uploads with the id are reassembled into the buffer.
+     *
+     * @param on_finish Called when the master finishes the upload. Can be nullptr.
+     */
+    void registerUploadBuffer(uint8_t transfer_id, std::span<uint8_t> buffer, TransferFinishCallback on_finish,
+                              void* user_data);
+
+    /**
+     * @brief Uploads with the id are streamed to the sink in order, e.g. straight to flash.
+     *
+     * @param max_size  Largest upload accepted.
+     * @param on_finish Called when the master finishes the upload. Can be nullptr.
+     */
+    void registerUploadSink(uint8_t transfer_id, uint32_t max_size, TransferSink sink, TransferFinishCallback on_finish,
+                            void* user_data);
+
+    /**
+     * @brief Downloads with the id are read from the source.
+     */
+    void registerDownloadSource(uint8_t transfer_id, TransferSource source, void* user_data);
+
+    [[nodiscard]] ResponseCode startUpload(const TransferStartRequest& request);
+    [[nodiscard]] ResponseCode receiveSegment(const TransferSegmentRequest& request);
+    [[nodiscard]] ResponseCode finishUpload(const TransferFinishRequest& request);
+
+    /**
+     * @brief Read a segment of a download.
+     *
+     * @note The bytes of the response point to a buffer of this object, valid until the next read.
+     */
+    [[nodiscard]] TransferReadResponse readSegment(const TransferReadRequest& request);
+
+private:
+    enum class EndpointType : uint8_t {
+        upload_buffer,
+        upload_sink,
+        download_source,
+    };
+
+    struct Endpoint {
+        uint8_t                transfer_id   = 0;
+        EndpointType           type          = EndpointType::upload_buffer;
+        std::span<uint8_t>     upload_buffer = {};
+        uint32_t               max_size      = 0;
+        TransferSink           sink          = nullptr;
+        TransferSource         source        = nullptr;
+        TransferFinishCallback on_finish     = nullptr;
+        void*                  user_data     = nullptr;
+    };
+
+    utils::StaticList<Endpoint, K_MAX_TRANSFER_ENDPOINTS> endpoints_;
+
+    TransferReceiver receiver_;
+    const Endpoint*  active_upload_ = nullptr;
+    bool             finished_      = false;
+    ResponseCode     finish_result_ = ResponseCode::ok;
+
+    uint8_t read_buffer_[K_TRANSFER_SEGMENT_MAX_SIZE] = {};
+
+private:
+    void                          registerEndpoint(const Endpoint& endpoint);
+    [[nodiscard]] const Endpoint* findEndpoint(uint8_t transfer_id, bool upload) const;
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFERSLAVE_H
@@ -0,0 +1,59 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_COBS_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_COBS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Consistent Overhead Byte Stuffing. The encoded frame contains no zero bytes, so a zero can delimit the frames and
+// a receiver that has lost track of the byte stream finds the next frame boundary at the next zero.
+namespace serial_communication_framework {
+
+constexpr uint8_t K_COBS_DELIMITER      = 0x00;
+
+// A code byte can be followed by at most this many data bytes
+constexpr size_t  K_COBS_MAX_BLOCK_SIZE = 254;
+
+/**
+ * @brief Size of the framed data: the encoded bytes followed by the delimiter.
+ */
+constexpr size_t cobsFrameMaxSize(size_t data_size) { return data_size + data_size / K_COBS_MAX_BLOCK_SIZE + 2; }
+
+/**
+ * @brief Encode the data and append the delimiter.
+ *
+ * @param data         Bytes to encode.
+ * @param frame_buffer At least `cobsFrameMaxSize(data.size_bytes())` bytes. Must not overlap with the data.
+ * @return The frame, ready to be transmitted.
+ */
+std::span<uint8_t> encodeCobsFrame(std::span<const uint8_t> data, std::span<uint8_t> frame_buffer);
+
+/**
+ * @brief Decodes a COBS encoded byte stream one byte at a time.
+ *
+ * Every received byte decodes to at most one data byte, so the decoded bytes can be written straight to where they
+ * are needed without buffering the whole frame first.
+ */
+class CobsDecoder {
+public:
+    enum class Result {
+        no_data,      ///< The byte was a code byte that did not stand for a zero
+        data_byte,    ///< A data byte was decoded
+        frame_ended,  ///< The byte was the delimiter
+    };
+
+    Result decode(uint8_t encoded_byte, uint8_t& decoded_byte);
+
+    /**
+     * @brief Start decoding from a frame boundary, e.g. after the framing has been switched on.
+     */
+    void reset();
+
+private:
+    uint8_t block_bytes_left_ = 0;
+    bool    zero_pending_     = false;
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_COBS_H
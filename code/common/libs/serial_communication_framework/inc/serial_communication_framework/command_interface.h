@@ -2,8 +2,10 @@
 #ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_REQUESTPAYLOADBASE_H
 #define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_REQUESTPAYLOADBASE_H
 
+#include <concepts>
 #include <cstdint>
 #include <span>
+#include <type_traits>
 
 #include "serial_communication_framework/common.h"
 #include "serial_communication_framework/packets.h"
@@ -24,23 +26,23 @@ enum class ParsingError {
 //
 //
 
+/**
+ * Requests and responses are plain structs with a static interface, checked by the RequestType and ResponseType
+ * concepts below instead of virtual functions. The handlers are templates over the command type, so the calls to
+ * `serialize`/`deserialize` are resolved at compile time and the objects don't carry a vtable pointer.
+ *
+ * Both have to provide:
+ *   ParsingError       deserialize(std::span<uint8_t> bytes);
+ *   std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+ */
 struct RequestBase {
-    using ParsingError                                                     = ParsingError;
-
-    virtual ~RequestBase()                                                 = default;
-
-    virtual ParsingError       deserialize(std::span<uint8_t> bytes)       = 0;
-    virtual std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) = 0;
+    using ParsingError = commands::ParsingError;
 };
 
 struct ResponseBase {
-    using ParsingError                                                     = ParsingError;
+    using ParsingError = commands::ParsingError;
 
-    virtual ~ResponseBase()                                                = default;
-
-    virtual ParsingError       deserialize(std::span<uint8_t> bytes)       = 0;
-    virtual std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) = 0;
-    explicit                   operator bool() const { return response_code == ResponseCode::ok; }
+    explicit operator bool() const { return response_code == ResponseCode::ok; }
 
     ResponseCode response_code = ResponseCode::unset_default_value;
 };
@@ -52,14 +54,14 @@ struct ResponseBase {
 //
 
 struct EmptyResponse final : ResponseBase {
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override { return target_buffer.subspan(0, 0); }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) { return target_buffer.subspan(0, 0); }
 
-    ParsingError deserialize(std::span<uint8_t> bytes) override { return ParsingError::no_error; }
+    ParsingError deserialize([[maybe_unused]] std::span<uint8_t> bytes) { return ParsingError::no_error; }
 };
 
 struct EmptyRequest final : RequestBase {
-    ParsingError       deserialize(std::span<uint8_t> bytes) override { return ParsingError::no_error; }
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override { return target_buffer.subspan(0, 0); }
+    ParsingError       deserialize([[maybe_unused]] std::span<uint8_t> bytes) { return ParsingError::no_error; }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) { return target_buffer.subspan(0, 0); }
 };
 
 //
@@ -69,32 +71,61 @@ struct EmptyRequest final : RequestBase {
 //
 
 template <typename T>
-concept DerivedRequestType = std::derived_from<T, RequestBase>;
+concept SerializablePayload = requires(T payload, std::span<uint8_t> bytes) {
+    { payload.deserialize(bytes) } -> std::same_as<ParsingError>;
+    { payload.serialize(bytes) } -> std::same_as<std::span<uint8_t>>;
+};
+
+// Not polymorphic so that nothing reintroduces the vtable the static interface got rid of
+template <typename T>
+concept RequestType = std::derived_from<T, RequestBase> && SerializablePayload<T> && std::default_initializable<T> &&
+                      (!std::is_polymorphic_v<T>);
 
 template <typename T>
-concept DerivedResponseType = std::derived_from<T, ResponseBase>;
+concept ResponseType = std::derived_from<T, ResponseBase> && SerializablePayload<T> &&
+                       std::default_initializable<T> && (!std::is_polymorphic_v<T>);
+
+// Whether the slave handling a request twice has the same effect as handling it once. Decides how the master retries
+// a command whose response got lost, see RetryPolicy
+enum class Idempotency : uint8_t {
+    // Sent again as it is, e.g. reads and pings
+    idempotent,
+    // The slave answers a repeated sequence number with the response it already sent instead of handling the request
+    // again. Never retried past other in-flight requests
+    non_idempotent,
+};
 
-template <DerivedRequestType T_Request, DerivedResponseType T_Response, uint8_t OpCode>
+// HandlerTimeoutMs is how long the slave's handler may take, only long running commands should need to override it.
+// Commands that only read something should be declared with IdempotentCommand instead
+template <RequestType T_Request, ResponseType T_Response, uint8_t OpCode,
+          uint32_t HandlerTimeoutMs = K_DEFAULT_HANDLER_TIMEOUT_MS,
+          Idempotency T_Idempotency = Idempotency::non_idempotent>
 struct Command {
-    using Request                      = T_Request;
-    using Response                     = T_Response;
+    using Request                                     = T_Request;
+    using Response                                    = T_Response;
 
-    static constexpr uint8_t K_OP_CODE = OpCode;
+    static constexpr uint8_t     K_OP_CODE            = OpCode;
+    static constexpr uint32_t    K_HANDLER_TIMEOUT_MS = HandlerTimeoutMs;
+    static constexpr Idempotency K_IDEMPOTENCY        = T_Idempotency;
 
     // THIS STRUCT IS NOT MEANT TO BE INSTANTIATED
     // AND INSTEAD JUST SERVES AS A META TYPE FOR OPCODE, REQUEST AND RESPONSE TYPE
-    Command()                          = delete;
+    Command()                                         = delete;
 };
 
+// A command that only reads something, so that it can be retried freely
+template <RequestType T_Request, ResponseType T_Response, uint8_t OpCode,
+          uint32_t HandlerTimeoutMs = K_DEFAULT_HANDLER_TIMEOUT_MS>
+using IdempotentCommand = Command<T_Request, T_Response, OpCode, HandlerTimeoutMs, Idempotency::idempotent>;
+
 template <typename T>
-concept CommandType =
-    requires {
-        typename T::Request;
-        typename T::Response;
-        { T::K_OP_CODE } -> std::convertible_to<uint8_t>;
-    } && DerivedRequestType<typename T::Request> && DerivedResponseType<typename T::Response> &&
-    (!std::is_abstract_v<typename T::Request>) && (!std::is_abstract_v<typename T::Response>);
-;
+concept CommandType = requires {
+    typename T::Request;
+    typename T::Response;
+    { T::K_OP_CODE } -> std::convertible_to<uint8_t>;
+    { T::K_HANDLER_TIMEOUT_MS } -> std::convertible_to<uint32_t>;
+    { T::K_IDEMPOTENCY } -> std::convertible_to<Idempotency>;
+} && RequestType<typename T::Request> && ResponseType<typename T::Response>;
 
 }  // namespace serial_communication_framework::commands
 
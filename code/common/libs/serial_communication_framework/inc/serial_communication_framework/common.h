@@ -2,6 +2,7 @@
 #define MASTER_SLAVE_COMMON_H
 
 #include "packets.h"
+#include "serial_communication_framework/statistics.h"
 #include "utils/StaticList.h"
 
 namespace serial_communication_framework {
@@ -29,22 +30,63 @@ enum class ResponseCode : uint8_t {
     type_mismatch          = LAST_INTERNAL + 4,
     forbidden              = LAST_INTERNAL + 5,
 
+    // Not a response to any request. A frame the slave sends on its own (e.g. telemetry). The first payload byte is
+    // the id of the stream the frame belongs to, the second one the id of the sending slave and the rest is the
+    // stream's own data
+    unsolicited_frame      = 0xFE,
+
     unset_default_value    = 0xFF,
 };
 
-struct CommunicationStatistics {
-    uint64_t total_packets_received     = 0;
-    uint64_t corrupted_packets_received = 0;
-    uint64_t valid_packets_received     = 0;
-    uint64_t timed_out_packets          = 0;
+// How the packets are delimited on the wire. Both ends must use the same framing
+enum class Framing : uint8_t {
+    // Packets are sent back to back. The packet boundaries are only known from the headers, so after a lost or a
+    // spurious byte the receiver stays misaligned until the timeouts clear it
+    none = 0,
+    // Every packet is COBS encoded and followed by a zero byte. The receiver finds the next packet boundary at the
+    // next zero, at the cost of one extra byte per 254 bytes and the delimiter
+    cobs = 1,
+};
+
+// Settings both ends of the link have to agree on
+struct LinkSettings {
+    uint32_t baud_rate = 115200;
+    Framing  framing   = Framing::none;
 };
 
-// TODO if band with estimation is added calculate the timeouts based on how long message should take to send + handling
-// time
-// Slave's timeout must always be less than masters timeout, otherwise there is a possibility that master timeouts
-// and slave answers after the master has timeout which messes up whole communication
-constexpr size_t K_MASTER_TIMEOUT_MS = 100;
-constexpr size_t K_SLAVE_TIMEOUT_MS  = K_MASTER_TIMEOUT_MS / 2;
+// What the devices start with, so that a master that knows nothing about the device can always connect
+constexpr LinkSettings K_DEFAULT_LINK_SETTINGS = {};
+
+// How long the new link settings are tried before going back to the previous ones, if nothing is received with them
+constexpr size_t K_LINK_VERIFY_TIMEOUT_MS = 500;
+
+// How long the slave's handler of a command may take, unless the command overrides it. Long running commands
+// (e.g. the ones writing to flash) override it, see timeouts.h for how the timeouts of both ends are derived from it
+constexpr uint32_t K_DEFAULT_HANDLER_TIMEOUT_MS = 10;
+
+// An unsolicited frame's payload starts with the stream id and the id of the slave that sent it. The responses don't
+// carry the slave's id as the master knows whom it asked, but the unsolicited frames of slaves sharing a bus would be
+// indistinguishable without it
+constexpr size_t K_UNSOLICITED_FRAME_HEADER_SIZE      = 2;
+constexpr size_t K_UNSOLICITED_FRAME_PAYLOAD_MAX_SIZE = ResponsePacket::K_PAYLOAD_MAX_SIZE -
+                                                        K_UNSOLICITED_FRAME_HEADER_SIZE;
+
+// How many commands the master can have sent without receiving their responses yet. The slave handles the requests
+// one at a time, so the pipelined requests must fit into the slave's receive buffer while it is busy with the first
+constexpr size_t K_MAX_IN_FLIGHT_REQUESTS = 4;
+
+// The master numbers every request and the slave echoes the number in the response. This one is never given to a
+// request, a response carrying it is one the slave could not tie to a request (e.g. to a corrupted header)
+constexpr uint8_t K_NO_SEQUENCE_NUMBER = 0;
+
+// How the master handles the commands whose request or response got lost or corrupted on the way
+struct RetryPolicy {
+    // How many times such a command is sent again before it fails with the error, 0 disables the retries
+    uint8_t max_retries     = 0;
+    // The response timeout of every retry is this many times the one of the attempt before it. The first attempt
+    // waits for the timeout derived from the link, see timeouts.h
+    uint8_t timeout_backoff = 2;
+};
 
 }  // namespace serial_communication_framework
 
@@ -20,10 +20,12 @@ namespace serial_communication_framework {
 
 struct RequestPacket {
     struct Header {
-        uint8_t receiver_id    = 0;
-        uint8_t operation_code = 0;
-        uint8_t payload_size   = 0;
-        uint8_t header_crc     = 0;
+        uint8_t receiver_id     = 0;
+        uint8_t operation_code  = 0;
+        // Tells a retry of a non-idempotent request from a new one, K_NO_SEQUENCE_NUMBER on the other requests
+        uint8_t sequence_number = 0;
+        uint8_t payload_size    = 0;
+        uint8_t header_crc      = 0;
     };
 
     Header             header                  = {};
@@ -32,7 +34,8 @@ struct RequestPacket {
 
     static constexpr size_t K_PAYLOAD_MAX_SIZE = std::numeric_limits<decltype(Header::payload_size)>::max();
     static constexpr size_t K_HEADER_SIZE      = sizeof(Header::receiver_id) + sizeof(Header::operation_code) +
-                                            sizeof(Header::payload_size) + sizeof(Header::header_crc);
+                                            sizeof(Header::sequence_number) + sizeof(Header::payload_size) +
+                                            sizeof(Header::header_crc);
     static constexpr size_t K_HEADER_SIZE_WITHOUT_CRC      = K_HEADER_SIZE - sizeof(Header::header_crc);
 
     static constexpr size_t K_HEADER_WITH_PAYLOAD_CRC_SIZE = K_HEADER_SIZE + sizeof(payload_crc);
@@ -42,12 +45,19 @@ struct RequestPacket {
 
     static constexpr size_t K_PAYLOAD_START_OFFSET         = K_HEADER_SIZE + sizeof(payload_crc);
 
+    // Positions of the single byte fields in a serialized packet
+    static constexpr size_t K_PAYLOAD_SIZE_INDEX =
+        sizeof(Header::receiver_id) + sizeof(Header::operation_code) + sizeof(Header::sequence_number);
+    static constexpr size_t K_HEADER_CRC_INDEX   = K_HEADER_SIZE_WITHOUT_CRC;
+    static constexpr size_t K_PAYLOAD_CRC_INDEX  = K_HEADER_SIZE;
+
     RequestPacket()                                        = default;
-    RequestPacket(uint8_t receiver_id, uint8_t operation_code, std::span<uint8_t> payload)
+    RequestPacket(uint8_t receiver_id, uint8_t operation_code, std::span<uint8_t> payload, uint8_t sequence_number = 0)
         : header{
-              .receiver_id    = receiver_id,
-              .operation_code = operation_code,
-              .payload_size   = static_cast<uint8_t>(payload.size_bytes()),
+              .receiver_id     = receiver_id,
+              .operation_code  = operation_code,
+              .sequence_number = sequence_number,
+              .payload_size    = static_cast<uint8_t>(payload.size_bytes()),
               .header_crc = 0},  // will be assigned when packet is serialized, since the data might change before that
           payload_crc(0),        // will be assigned when packet is serialized, since the data might change before that
           payload(payload) {}
@@ -55,9 +65,12 @@ struct RequestPacket {
 
 struct ResponsePacket {
     struct Header {
-        uint8_t response_code = 0;
-        uint8_t payload_size  = 0;
-        uint8_t header_crc    = 0;
+        uint8_t response_code   = 0;
+        // The sequence number of the request answered, so that the master can tell which of the requests in flight
+        // the response belongs to. K_NO_SEQUENCE_NUMBER when the slave could not read it, and on unsolicited frames
+        uint8_t sequence_number = 0;
+        uint8_t payload_size    = 0;
+        uint8_t header_crc      = 0;
     };
 
     Header             header                  = {};
@@ -65,8 +78,8 @@ struct ResponsePacket {
     std::span<uint8_t> payload                 = {};
 
     static constexpr size_t K_PAYLOAD_MAX_SIZE = std::numeric_limits<decltype(Header::payload_size)>::max();
-    static constexpr size_t K_HEADER_SIZE =
-        sizeof(Header::response_code) + sizeof(Header::payload_size) + sizeof(Header::header_crc);
+    static constexpr size_t K_HEADER_SIZE      = sizeof(Header::response_code) + sizeof(Header::sequence_number) +
+                                            sizeof(Header::payload_size) + sizeof(Header::header_crc);
     static constexpr size_t K_HEADER_SIZE_WITHOUT_CRC      = K_HEADER_SIZE - sizeof(Header::header_crc);
     static constexpr size_t K_HEADER_WITH_PAYLOAD_CRC_SIZE = K_HEADER_SIZE + sizeof(payload_crc);
 
@@ -75,11 +88,17 @@ struct ResponsePacket {
 
     static constexpr size_t K_PAYLOAD_START_OFFSET         = K_HEADER_SIZE + sizeof(payload_crc);
 
+    // Positions of the single byte fields in a serialized packet
+    static constexpr size_t K_PAYLOAD_SIZE_INDEX = sizeof(Header::response_code) + sizeof(Header::sequence_number);
+    static constexpr size_t K_HEADER_CRC_INDEX   = K_HEADER_SIZE_WITHOUT_CRC;
+    static constexpr size_t K_PAYLOAD_CRC_INDEX  = K_HEADER_SIZE;
+
     ResponsePacket()                                       = default;
-    ResponsePacket(uint8_t response_code, std::span<uint8_t> payload)
+    ResponsePacket(uint8_t response_code, std::span<uint8_t> payload, uint8_t sequence_number = 0)
         : header{
-              .response_code = response_code,
-              .payload_size  = static_cast<uint8_t>(payload.size_bytes()),
+              .response_code   = response_code,
+              .sequence_number = sequence_number,
+              .payload_size    = static_cast<uint8_t>(payload.size_bytes()),
               .header_crc = 0},  // will be assigned when packet is serialized, since the data might change before that
           payload_crc(0),        // will be assigned when packet is serialized, since the data might change before that
           payload(payload) {}
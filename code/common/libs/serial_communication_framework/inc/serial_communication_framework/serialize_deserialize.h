@@ -16,6 +16,26 @@ bool requestHeaderHasValidCrc(const RequestPacket::Header& header);
 [[nodiscard]] std::span<uint8_t> serializeResponse(const ResponsePacket& resp, std::span<uint8_t> target_buffer);
 [[nodiscard]] std::span<uint8_t> serializeRequest(const RequestPacket& req, std::span<uint8_t> target_buffer);
 
+/**
+ * @brief Get the part of a packet buffer where the payload goes, so that the payload can be serialized in place.
+ */
+[[nodiscard]] std::span<uint8_t> getResponsePayloadBuffer(std::span<uint8_t> packet_buffer);
+[[nodiscard]] std::span<uint8_t> getRequestPayloadBuffer(std::span<uint8_t> packet_buffer);
+
+/**
+ * @brief Fill in the header and the CRCs of a packet whose payload is already in the packet buffer.
+ *
+ * The payload must have been written to the span given by `getResponsePayloadBuffer`/`getRequestPayloadBuffer` of
+ * the same packet buffer, it is not copied.
+ *
+ * @return The whole serialized packet.
+ */
+[[nodiscard]] std::span<uint8_t> finalizeResponseInPlace(uint8_t response_code, uint8_t sequence_number,
+                                                         size_t payload_size, std::span<uint8_t> packet_buffer);
+[[nodiscard]] std::span<uint8_t> finalizeRequestInPlace(uint8_t receiver_id, uint8_t operation_code,
+                                                        uint8_t sequence_number, size_t payload_size,
+                                                        std::span<uint8_t> packet_buffer);
+
 [[nodiscard]] ResponsePacket::Header deSerializeResponseHeader(std::span<uint8_t> data);
 [[nodiscard]] std::span<uint8_t>     serializeResponseHeader(const ResponsePacket::Header& resp_header,
                                                              std::span<uint8_t>            target_buffer);
@@ -0,0 +1,175 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_STATISTICS_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_STATISTICS_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace serial_communication_framework {
+
+// How many different op codes the statistics are kept for. Only a few of the 256 op codes are in use, and the RAM of
+// an entry for each of them would be mostly wasted on the device
+constexpr size_t K_MAX_TRACKED_OPERATION_CODES = 32;
+
+/**
+ * @brief Statistics of every op code in use, e.g. OperationStatistics.
+ *
+ * The op codes get their entries in the order they are first used, or registered with `track`. The lookups go
+ * through at most K_MAX_TRACKED_OPERATION_CODES op codes. The op codes that don't fit any more share one entry.
+ */
+template <typename T_Statistics>
+class OperationStatisticsTable {
+public:
+    /**
+     * @brief Give the op code its entry before it is first used, so that the op codes used later can't take it.
+     *
+     * @return false if the table is full.
+     */
+    bool track(uint8_t op_code) { return findIndex(op_code) < size_ || add(op_code) != nullptr; }
+
+    /**
+     * @brief The op code's entry, added if it has none yet.
+     */
+    T_Statistics& operator[](uint8_t op_code) {
+        const size_t index = findIndex(op_code);
+        if (index < size_) return entries_[index];
+
+        T_Statistics* added = add(op_code);
+        return added != nullptr ? *added : untracked_;
+    }
+
+    /**
+     * @brief The op code's entry. Empty for an op code that has not been used.
+     */
+    const T_Statistics& operator[](uint8_t op_code) const {
+        const size_t index = findIndex(op_code);
+        if (index < size_) return entries_[index];
+        return size_ == K_MAX_TRACKED_OPERATION_CODES ? untracked_ : K_UNUSED;
+    }
+
+private:
+    static constexpr T_Statistics K_UNUSED = {};
+
+    std::array<uint8_t, K_MAX_TRACKED_OPERATION_CODES>      op_codes_  = {};
+    std::array<T_Statistics, K_MAX_TRACKED_OPERATION_CODES> entries_   = {};
+    size_t                                                  size_      = 0;
+    T_Statistics                                            untracked_ = {};
+
+    [[nodiscard]] size_t findIndex(uint8_t op_code) const {
+        return static_cast<size_t>(std::find(op_codes_.begin(), op_codes_.begin() + size_, op_code) -
+                                   op_codes_.begin());
+    }
+
+    T_Statistics* add(uint8_t op_code) {
+        if (size_ == K_MAX_TRACKED_OPERATION_CODES) return nullptr;
+        op_codes_[size_] = op_code;
+        return &entries_[size_++];
+    }
+};
+
+struct OperationStatistics {
+    uint32_t requests = 0;  // Sent by the master, received intact by the slave
+    uint32_t errors   = 0;  // Completed with another response code than ResponseCode::ok, including the timeouts
+};
+
+struct CommunicationStatistics {
+    uint64_t total_packets_received      = 0;
+    uint64_t corrupted_packets_received  = 0;
+    uint64_t valid_packets_received      = 0;
+    uint64_t timed_out_packets           = 0;
+    uint64_t unsolicited_frames_received = 0;
+    uint64_t resynchronizations          = 0;  // Broken frames whose bytes were skipped to find the next frame
+    uint64_t bytes_received              = 0;  // As on the wire, with the framing
+    uint64_t bytes_transmitted           = 0;
+    uint64_t rx_overflows                = 0;  // Bytes the serial interface lost, see getRxOverflowCount()
+    uint64_t retransmissions             = 0;  // Master: requests sent again by the retry policy
+    uint64_t duplicate_requests          = 0;  // Slave: retries of handled requests, answered without handling them
+    uint64_t unmatched_responses         = 0;  // Master: responses to no request in flight, e.g. late ones, dropped
+
+    OperationStatisticsTable<OperationStatistics> operations;
+};
+
+/**
+ * @brief Minimum, maximum and mean of durations in microseconds.
+ */
+struct DurationStatistics {
+    uint32_t count    = 0;
+    uint32_t min_us   = 0;
+    uint32_t max_us   = 0;
+    uint64_t total_us = 0;
+
+    void addSample(uint64_t duration_us) {
+        const uint32_t sample = static_cast<uint32_t>(std::min<uint64_t>(duration_us, K_MAX_SAMPLE_US));
+        min_us                = count == 0 ? sample : std::min(min_us, sample);
+        max_us                = std::max(max_us, sample);
+        total_us += sample;
+        count++;
+    }
+
+    /**
+     * @brief The mean of the samples, 0 if there are none.
+     */
+    [[nodiscard]] uint32_t getMeanUs() const { return count == 0 ? 0 : static_cast<uint32_t>(total_us / count); }
+
+    static constexpr uint32_t K_MAX_SAMPLE_US = std::numeric_limits<uint32_t>::max();
+};
+
+/**
+ * @brief Distribution of durations in power of two buckets, e.g. of the round trips of a command.
+ *
+ * Bucket 0 counts the durations under 2 us, bucket n the ones from 2^n us up to 2^(n+1) us and the last bucket
+ * everything from there on. The percentiles are known to the resolution of a bucket, which is plenty for telling a
+ * slow link from a slow handler.
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t K_BUCKET_COUNT = 24;  // The last one starts at ~8.4 s
+
+    void addSample(uint64_t duration_us) {
+        const size_t bucket = duration_us < 2 ? 0 : static_cast<size_t>(std::bit_width(duration_us)) - 1;
+        bucket_counts_[std::min(bucket, K_BUCKET_COUNT - 1)]++;
+        duration_statistics_.addSample(duration_us);
+    }
+
+    [[nodiscard]] uint32_t getBucketCount(size_t bucket) const { return bucket_counts_[bucket]; }
+
+    /**
+     * @brief The shortest duration counted into the bucket.
+     */
+    [[nodiscard]] static uint64_t getBucketLowerBoundUs(size_t bucket) { return bucket == 0 ? 0 : 1ULL << bucket; }
+
+    /**
+     * @brief Get the duration that `percent` percent of the samples were shorter than or equal to.
+     *
+     * @return The upper bound of the bucket the percentile falls into, but never more than the longest sample. 0 if
+     *         there are no samples.
+     */
+    [[nodiscard]] uint32_t getPercentileUs(double percent) const {
+        const uint32_t sample_count = duration_statistics_.count;
+        if (sample_count == 0) return 0;
+
+        const double target_count = std::clamp(percent, 0.0, 100.0) / 100.0 * sample_count;
+        uint64_t     cumulative   = 0;
+        for (size_t bucket = 0; bucket < K_BUCKET_COUNT - 1; bucket++) {
+            cumulative += bucket_counts_[bucket];
+            if (static_cast<double>(cumulative) >= target_count && cumulative > 0) {
+                return static_cast<uint32_t>(std::min<uint64_t>(getBucketLowerBoundUs(bucket + 1) - 1,
+                                                                duration_statistics_.max_us));
+            }
+        }
+        return duration_statistics_.max_us;
+    }
+
+    [[nodiscard]] const DurationStatistics& getDurationStatistics() const { return duration_statistics_; }
+
+private:
+    std::array<uint32_t, K_BUCKET_COUNT> bucket_counts_ = {};
+    DurationStatistics                   duration_statistics_;
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_STATISTICS_H
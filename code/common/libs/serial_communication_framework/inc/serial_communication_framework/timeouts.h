@@ -0,0 +1,122 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TIMEOUTS_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TIMEOUTS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "serial_communication_framework/cobs.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/packets.h"
+
+/**
+ * The response timeouts are derived from the link instead of being fixed.
+ *
+ * Slave: the handler of a request gets the handler timeout of its command (K_DEFAULT_HANDLER_TIMEOUT_MS unless the
+ * command overrides it). A response that is not ready by then is not sent at all.
+ *
+ * Master: waits for the request to be sent, the slave's handler timeout, the largest possible response to be sent and
+ * a margin for the host side latencies (OS scheduling, USB serial adapters). The slave's timeout is part of the
+ * master's, so the slave's timeout is always the shorter one and a response can't arrive after the master has given up
+ * on it. That would make the master match the response to the next request.
+ *
+ * The master also measures how long each op code takes to be answered. The measurement includes the latencies of the
+ * host, so if they turn out to be larger than the margin, the master's timeout grows with them. It never goes below
+ * the calculated one, that would break the ordering of the timeouts.
+ */
+
+namespace serial_communication_framework {
+
+// Start bit, 8 data bits and a stop bit
+constexpr uint32_t K_UART_BITS_PER_BYTE                  = 10;
+
+// Added to the master's timeout on top of the time the transfers and the handler take
+constexpr uint32_t K_MASTER_TIMEOUT_MARGIN_US            = 20'000;
+
+// The master's timeout is at least this many times the measured handler time of the op code
+constexpr uint32_t K_HANDLER_TIME_ESTIMATE_SAFETY_FACTOR = 2;
+
+/**
+ * @brief Time it takes to transmit the given amount of bytes, rounded up.
+ */
+[[nodiscard]] constexpr uint64_t transmissionTimeUs(size_t byte_count, uint32_t baud_rate) {
+    const uint64_t bit_count = static_cast<uint64_t>(byte_count) * K_UART_BITS_PER_BYTE;
+    return (bit_count * 1'000'000 + baud_rate - 1) / baud_rate;
+}
+
+/**
+ * @brief Amount of bytes a packet of the given size takes on the wire, at most.
+ */
+[[nodiscard]] constexpr size_t wireSize(size_t packet_size, Framing framing) {
+    return framing == Framing::cobs ? cobsFrameMaxSize(packet_size) : packet_size;
+}
+
+/**
+ * @brief How long the slave's handler of the command may take before the response is dropped.
+ */
+template <commands::CommandType T_Command>
+[[nodiscard]] constexpr uint32_t handlerTimeoutUs() {
+    return T_Command::K_HANDLER_TIMEOUT_MS * 1'000;
+}
+
+/**
+ * @brief How long the master waits for a response, counted from when the request is sent or, when requests are
+ *        pipelined, from when the previous response was received.
+ *
+ * @param link_settings            The settings the link is used with.
+ * @param request_packet_size      Size of the serialized request packet, without framing.
+ * @param handler_timeout_us       The slave's handler timeout of the command.
+ * @param handler_time_estimate_us How long the command has been measured to take to be answered, without the response
+ *                                 transfer. 0 if unknown.
+ */
+[[nodiscard]] constexpr uint64_t masterResponseTimeoutUs(LinkSettings link_settings, size_t request_packet_size,
+                                                         uint32_t handler_timeout_us,
+                                                         uint32_t handler_time_estimate_us = 0) {
+    const uint64_t request_time_us =
+        transmissionTimeUs(wireSize(request_packet_size, link_settings.framing), link_settings.baud_rate);
+    const uint64_t response_time_us =
+        transmissionTimeUs(wireSize(ResponsePacket::K_PACKET_MAX_SIZE, link_settings.framing), link_settings.baud_rate);
+
+    // Never less than the slave's timeout and the margin, the estimate can only make it longer
+    const uint64_t handler_wait_us =
+        std::max(static_cast<uint64_t>(handler_timeout_us) + K_MASTER_TIMEOUT_MARGIN_US,
+                 static_cast<uint64_t>(handler_time_estimate_us) * K_HANDLER_TIME_ESTIMATE_SAFETY_FACTOR);
+    return request_time_us + handler_wait_us + response_time_us;
+}
+
+/**
+ * @brief Keeps track of how long the slave takes to answer each op code.
+ *
+ * A sample larger than the estimate replaces it right away, smaller ones pull it down slowly. A handler that slows
+ * down raises the timeout immediately, while a single quick answer does not lower it.
+ */
+class HandlerTimeEstimator {
+public:
+    void addSample(uint8_t op_code, uint64_t handler_time_us) {
+        const uint32_t sample   = static_cast<uint32_t>(std::min<uint64_t>(handler_time_us, K_MAX_ESTIMATE_US));
+        uint32_t&      estimate = estimates_us_[op_code];
+        if (sample >= estimate) {
+            estimate = sample;
+        } else {
+            estimate -= (estimate - sample) / K_DECAY_DIVISOR;
+        }
+    }
+
+    /**
+     * @brief The estimate of the op code, 0 if it has not been answered yet.
+     */
+    [[nodiscard]] uint32_t getEstimateUs(uint8_t op_code) const { return estimates_us_[op_code]; }
+
+private:
+    static constexpr uint32_t K_DECAY_DIVISOR   = 8;
+    static constexpr uint32_t K_MAX_ESTIMATE_US = std::numeric_limits<uint32_t>::max();
+
+    std::array<uint32_t, std::numeric_limits<uint8_t>::max() + 1> estimates_us_ = {};
+};
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TIMEOUTS_H
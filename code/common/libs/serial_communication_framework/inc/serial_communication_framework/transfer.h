@@ -0,0 +1,117 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFER_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/packets.h"
+
+/**
+ * Segmented transfers move data that does not fit into one packet, e.g. capture buffers or firmware images.
+ *
+ * The data is split into segments that are sent as separate commands, each carrying the id of the transfer and the
+ * offset of the segment. Several segments are kept in flight (the window) and only the segments that failed are sent
+ * again, so a lost packet costs one segment instead of the whole transfer or a stall of the link.
+ *
+ *   Upload (master to slave):   start (id, total size) -> segments (id, offset, bytes) -> finish (id)
+ *   Download (slave to master): read segments (id, offset, size), the size of the data is known by the master
+ *
+ * The payloads are defined here and the commands by the protocol, which gives them their op codes.
+ */
+
+namespace serial_communication_framework {
+
+// Transfer id and the offset in front of the segment's bytes
+constexpr size_t K_TRANSFER_SEGMENT_HEADER_SIZE = sizeof(uint8_t) + sizeof(uint32_t);
+// Same for both directions, the read responses echo the offset in front of the bytes
+constexpr size_t K_TRANSFER_SEGMENT_MAX_SIZE    = RequestPacket::K_PAYLOAD_MAX_SIZE - K_TRANSFER_SEGMENT_HEADER_SIZE;
+// Segments in flight at once. Bounded by the master's pipeline, the receiver holds one segment less than this
+// out of order
+constexpr size_t K_TRANSFER_MAX_WINDOW_SIZE     = K_MAX_IN_FLIGHT_REQUESTS;
+
+/**
+ * @brief Receives the bytes of a transfer in order.
+ *
+ * @param offset    Offset of the first byte in the transferred data.
+ * @param bytes     The next bytes of the data, only valid for the duration of the call.
+ * @param user_data The opaque pointer that was given with the sink.
+ * @return ResponseCode::ok to continue, anything else fails the segment with the code.
+ */
+using TransferSink = ResponseCode (*)(uint32_t offset, std::span<const uint8_t> bytes, void* user_data);
+
+/**
+ * @brief Provides the bytes of a download.
+ *
+ * @param offset        Offset of the first byte requested.
+ * @param target_buffer Where the bytes are copied to, its size is the amount of bytes requested.
+ * @param read_size_out Amount of bytes copied, less than requested only at the end of the data.
+ * @param user_data     The opaque pointer that was given with the source.
+ * @return ResponseCode::ok, or the code the read segment fails with (e.g. out_of_bounds).
+ */
+using TransferSource = ResponseCode (*)(uint32_t offset, std::span<uint8_t> target_buffer, size_t* read_size_out,
+                                        void* user_data);
+
+/**
+ * @brief Called when the master finishes an upload whose every byte has been received.
+ *
+ * @return ResponseCode::ok if the data was accepted, otherwise the code the finish command fails with.
+ */
+using TransferFinishCallback = ResponseCode (*)(uint32_t total_size, void* user_data);
+
+struct TransferStartRequest : commands::RequestBase {
+    uint8_t  transfer_id = 0;
+    uint32_t total_size  = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct TransferSegmentRequest : commands::RequestBase {
+    uint8_t  transfer_id = 0;
+    uint32_t offset      = 0;
+    // View, not a copy. Points to the data being uploaded on the master and to the receive buffer on the slave.
+    std::span<const uint8_t> raw_bytes = {};
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct TransferFinishRequest : commands::RequestBase {
+    uint8_t transfer_id = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct TransferReadRequest : commands::RequestBase {
+    uint8_t  transfer_id = 0;
+    uint32_t offset      = 0;
+    uint8_t  size        = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct TransferReadResponse : commands::ResponseBase {
+    // Echoed back so that a response can't be placed at the offset of another segment
+    uint32_t offset = 0;
+    // View, not a copy. Points to the receive buffer on the master and to the slave's read buffer on the slave.
+    std::span<const uint8_t> raw_bytes = {};
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+/**
+ * @brief Whether a segment that failed with the code can succeed when it is sent again.
+ */
+[[nodiscard]] constexpr bool isTransientFailure(ResponseCode response_code) {
+    return response_code == ResponseCode::timed_out || response_code == ResponseCode::corrupted;
+}
+
+}  // namespace serial_communication_framework
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TRANSFER_H
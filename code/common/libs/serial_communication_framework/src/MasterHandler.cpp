@@ -1,5 +1,7 @@
 #include "serial_communication_framework/MasterHandler.h"
 
+#include <algorithm>
+
 #include "assert/assert.h"
 #include "serial_communication_framework/packets.h"
 #include "serial_communication_framework/serialize_deserialize.h"
@@ -9,88 +11,333 @@ namespace serial_communication_framework {
 
 MasterHandler::MasterHandler(drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface,
                              drivers::interfaces::ClockInterface&                       clock_interface)
-    : timeout_clock_(clock_interface), communication_interface_(communication_interface) {
-    ASSERT_WITH_MESSAGE(std::span<uint8_t>(tx_buffer_).size_bytes() >= RequestPacket::K_PACKET_MAX_SIZE,
-                        "Too small tx_buffer");
-    ASSERT_WITH_MESSAGE(std::span<uint8_t>(rx_buffer_).size_bytes() >= ResponsePacket::K_PACKET_MAX_SIZE,
-                        "Too small rx_buffer");
+    : communication_interface_(communication_interface),
+      response_receiver_(communication_statistics_),
+      timeout_clock_(clock_interface) {
+    ASSERT_WITH_MESSAGE(std::span<uint8_t>(request_packets_[0]).size_bytes() >= RequestPacket::K_PACKET_MAX_SIZE,
+                        "Too small request packet buffer");
 }
 
 void MasterHandler::init() { /* TODO SET THE SERIAL COMMUNICATION SETTINGS */
 }
 
-/*
-ResponseData MasterHandler::sendRequestAndReceiveResponseBlocking(
-    uint8_t receiver_id, uint8_t operation_code,
-    utils::StaticList<uint8_t, RequestPacket::K_PAYLOAD_MAX_SIZE> payload) {
-    RequestPacket      request(receiver_id, operation_code, payload);
-    std::span<uint8_t> serialized_request = serializeRequest(request, tx_buffer_);
-    communication_interface_.transmitBytes(serialized_request);
+void MasterHandler::run() {
+    size_t available_byte_count = communication_interface_.getReceivedBytesAvailableAmount();
+    communication_statistics_.rx_overflows = communication_interface_.getRxOverflowCount();
 
-    startResponseTimeout();
+    // Unsolicited frames can arrive while nothing is in flight, give them the same time to arrive fully
+    if (available_byte_count > 0 && response_receiver_.getReceivedSize() == 0 && in_flight_requests_.empty()) {
+        startResponseTimeout();
+    }
 
-    size_t rx_index             = 0;
-    size_t expected_packet_size = ResponsePacket::K_PACKET_MAX_SIZE;
+    const ParseResult parse_result = response_receiver_.receive(communication_interface_, available_byte_count);
 
-    while (rx_index < expected_packet_size) {
-        if (responseHasTimedout()) {
+    if (parse_result == ParseResult::incomplete) {
+        if (!in_flight_requests_.empty() && responseHasTimedout()) {
             communication_statistics_.timed_out_packets++;
-            return {ResponseCode::timed_out, {}};
-        }
-
-        if (communication_interface_.getReceivedBytesAvailableAmount() > 0) {
-            rx_buffer_[rx_index] = communication_interface_.readReceivedByte();
-            rx_index++;
+            // Slave timeout is always shorter than master's so the slave won't answer to this request anymore
+            response_receiver_.dropPartialPacket();
+            completeOldestInFlightRequest(ResponseCode::timed_out, {});
+        } else if (in_flight_requests_.empty() && response_receiver_.getReceivedSize() > 0 && responseHasTimedout()) {
+            // Nobody is waiting for these bytes, so they can only be leftovers of failed commands or a broken frame
+            response_receiver_.dropPartialPacket();
         }
+        return;
+    }
 
-        if (rx_index == ResponsePacket::K_HEADER_SIZE) {
-            ResponsePacket::Header header = deSerializeResponseHeader(rx_buffer_);
-            expected_packet_size          = header.payload_size + ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE;
-
-            if (!responseHeaderHasValidCrc(header)) {
-                communication_statistics_.corrupted_packets_received++;
-                return ResponseData(ResponseCode::corrupted, {});
-            }
-        }
+    if (parse_result == ParseResult::header_corrupted || parse_result == ParseResult::frame_corrupted) {
+        handleCorruptedFrame();
+        return;
     }
 
-    ResponsePacket response = deSerializeResponse(rx_buffer_);
+    // The packet bytes stay untouched until the next receive, the response payload views point to them
+    const size_t   response_packet_size = response_receiver_.getReceivedSize();
+    ResponsePacket response             = deSerializeResponse(response_receiver_.getPacketBytes());
+    response_receiver_.finishPacket();
     communication_statistics_.total_packets_received++;
 
+    const auto response_code = static_cast<ResponseCode>(response.header.response_code);
+
     if (!responsePayloadHasValidCrc(response)) {
         communication_statistics_.corrupted_packets_received++;
-        return ResponseData(ResponseCode::corrupted, {});
+        // A corrupted unsolicited frame is just dropped, it was not an answer to anything in flight. The header was
+        // intact, so the sequence number tells which request the response was for
+        if (response_code != ResponseCode::unsolicited_frame) {
+            handleResponse(response, ResponseCode::corrupted, response_packet_size);
+        }
+        return;
     }
 
     communication_statistics_.valid_packets_received++;
 
-    // TODO Resetting tx buffer and rx buffer
+    if (response_code == ResponseCode::unsolicited_frame) {
+        dispatchUnsolicitedFrame(response.payload);
+        return;
+    }
+
+    handleResponse(response, response_code, response_packet_size);
+}
 
-    return ResponseData{static_cast<ResponseCode>(response.header.response_code),
-                        utils::StaticList<uint8_t, ResponsePacket::K_PAYLOAD_MAX_SIZE>(response.payload)};
-}*/
+void MasterHandler::waitForResponse() {
+    if (in_flight_requests_.empty() || response_receiver_.hasBufferedBytes()) return;
 
-/*
-void MasterHandler::sendRequestAndReceiveResponseASync(uint8_t receiver_id, uint8_t operation_code,
-                                                       std::span<uint8_t> payload, void(*cb)) {
-    // TODO implement
-}*/
+    // Woken up just after the timeout at the latest, so that the next run() fails or retries the command
+    const uint64_t elapsed_us   = timeout_clock_.uptimeMicroseconds() - response_timout_start_time_point_;
+    const uint64_t remaining_us = elapsed_us <= response_timeout_us_ ? response_timeout_us_ - elapsed_us + 1 : 0;
+    (void)communication_interface_.waitForReceivedBytes(remaining_us);
+}
 
-void MasterHandler::run() {
-    // TODO implement
+void MasterHandler::setUnsolicitedFrameCallback(UnsolicitedFrameCallback callback, void* user_data) {
+    unsolicited_frame_callback_           = callback;
+    unsolicited_frame_callback_user_data_ = user_data;
 }
 
+size_t MasterHandler::getInFlightCommandCount() const { return in_flight_requests_.size(); }
+
 const CommunicationStatistics& MasterHandler::getStatistics() const { return communication_statistics_; }
 
-void MasterHandler::startResponseTimeout() { response_timout_start_time_point_ = timeout_clock_.uptimeMilliseconds(); }
+const LatencyHistogram& MasterHandler::getRoundTripLatencyHistogram(uint8_t op_code) const {
+    return round_trip_latencies_[op_code];
+}
+
+const LatencyHistogram& MasterHandler::getRoundTripLatencyHistogram() const { return all_round_trip_latencies_; }
+
+void MasterHandler::setFraming(Framing framing) { response_receiver_.setFraming(framing); }
+
+Framing MasterHandler::getFraming() const { return response_receiver_.getFraming(); }
+
+void MasterHandler::setRetryPolicy(RetryPolicy retry_policy) { retry_policy_ = retry_policy; }
+
+RetryPolicy MasterHandler::getRetryPolicy() const { return retry_policy_; }
+
+void MasterHandler::setBaudRate(uint32_t baud_rate) { baud_rate_ = baud_rate; }
+
+uint32_t MasterHandler::getBaudRate() const { return baud_rate_; }
+
+uint32_t MasterHandler::getHandlerTimeEstimateUs(uint8_t op_code) const {
+    return handler_time_estimator_.getEstimateUs(op_code);
+}
+
+void MasterHandler::transmitPacket(std::span<uint8_t> packet_bytes) {
+    if (response_receiver_.getFraming() == Framing::cobs) {
+        packet_bytes = encodeCobsFrame(packet_bytes, tx_frame_buffer_);
+    }
+    communication_statistics_.bytes_transmitted += packet_bytes.size_bytes();
+    communication_interface_.transmitBytes(packet_bytes);
+}
+
+void MasterHandler::handleCorruptedFrame() {
+    communication_statistics_.corrupted_packets_received++;
+    response_receiver_.finishPacket();
+
+    if (response_receiver_.getFraming() == Framing::cobs) {
+        // The frame boundaries are known, so only the response in the broken frame was lost
+        if (!in_flight_requests_.empty()) completeOldestInFlightRequest(ResponseCode::corrupted, {});
+        return;
+    }
+
+    // The payload size can't be trusted so the position of the next response in the byte stream is unknown. Every
+    // response still in flight would be parsed from a wrong offset, so fail them all.
+    uint8_t discarded_bytes[ResponsePacket::K_PACKET_MAX_SIZE];
+    size_t  discarded_count;
+    do {
+        discarded_count = communication_interface_.readReceivedBytes(discarded_bytes);
+        communication_statistics_.bytes_received += discarded_count;
+    } while (discarded_count > 0);
+    failAllInFlightRequests(ResponseCode::corrupted);
+}
+
+void MasterHandler::startResponseTimeout() {
+    response_timout_start_time_point_ = timeout_clock_.uptimeMicroseconds();
+
+    const LinkSettings link_settings = {.baud_rate = baud_rate_, .framing = getFraming()};
+    if (in_flight_requests_.empty()) {
+        // Only an unsolicited frame can be on its way, nothing has to be sent or handled for it
+        response_timeout_us_ = masterResponseTimeoutUs(link_settings, 0, 0);
+        return;
+    }
+
+    const InFlightRequest& oldest_request = in_flight_requests_.front();
+    response_timeout_us_ =
+        masterResponseTimeoutUs(link_settings, oldest_request.request_packet_size, oldest_request.handler_timeout_us,
+                                handler_time_estimator_.getEstimateUs(oldest_request.operation_code));
+
+    // A retry that fails again was likely not just unlucky, e.g. the device is busier than measured
+    for (uint8_t retry = 0; retry < oldest_request.retry_count; retry++) {
+        response_timeout_us_ *= retry_policy_.timeout_backoff;
+    }
+}
 
 bool MasterHandler::responseHasTimedout() {
 #ifdef SERVO_CORE_DISABLE_SERIAL_COMMUNICATION_FRAMEWORK_TIMEOUTS
     return false;
 #endif
 
-    const uint64_t now = timeout_clock_.uptimeMilliseconds();
-    return (now - response_timout_start_time_point_) > K_MASTER_TIMEOUT_MS;
+    const uint64_t now = timeout_clock_.uptimeMicroseconds();
+    return (now - response_timout_start_time_point_) > response_timeout_us_;
+}
+
+void MasterHandler::addHandlerTimeSample(size_t response_packet_size) {
+    const uint64_t elapsed_us = timeout_clock_.uptimeMicroseconds() - response_timout_start_time_point_;
+    const uint64_t response_time_us =
+        transmissionTimeUs(wireSize(response_packet_size, getFraming()), baud_rate_);
+
+    const uint64_t handler_time_us = elapsed_us > response_time_us ? elapsed_us - response_time_us : 0;
+    handler_time_estimator_.addSample(in_flight_requests_.front().operation_code, handler_time_us);
+}
+
+void MasterHandler::addRoundTripSample(const InFlightRequest& answered_request) {
+    const uint64_t round_trip_us = timeout_clock_.uptimeMicroseconds() - answered_request.transmit_time_us;
+    round_trip_latencies_[answered_request.operation_code].addSample(round_trip_us);
+    all_round_trip_latencies_.addSample(round_trip_us);
+}
+
+void MasterHandler::handleResponse(const ResponsePacket& response, ResponseCode response_code,
+                                   size_t response_packet_size) {
+    // Late response to a command that has already failed (e.g. timed out)
+    if (in_flight_requests_.empty()) {
+        communication_statistics_.unmatched_responses++;
+        return;
+    }
+
+    // Without a sequence number the slave could not read the request's header, so it is for the oldest request
+    size_t answered_index = 0;
+    if (response.header.sequence_number != K_NO_SEQUENCE_NUMBER) {
+        // E.g. the response to a timed out request whose retry has already been answered
+        if (findInFlightRequest(response.header.sequence_number) == in_flight_requests_.size()) {
+            communication_statistics_.unmatched_responses++;
+            return;
+        }
+        answered_index = failSkippedInFlightRequests(response.header.sequence_number);
+    }
+
+    // The response timeout only runs for the oldest request, the handler time of the others is not known
+    if (answered_index == 0) addHandlerTimeSample(response_packet_size);
+    addRoundTripSample(in_flight_requests_[answered_index]);
+    completeInFlightRequest(answered_index, response_code, response.payload);
+}
+
+size_t MasterHandler::findInFlightRequest(uint8_t sequence_number) const {
+    const auto found = std::find_if(in_flight_requests_.begin(), in_flight_requests_.end(),
+                                    [sequence_number](const InFlightRequest& request) {
+                                        return request.sequence_number == sequence_number;
+                                    });
+    return static_cast<size_t>(found - in_flight_requests_.begin());
+}
+
+size_t MasterHandler::failSkippedInFlightRequests(uint8_t sequence_number) {
+    // The slave handles its requests in the order they were sent, so the ones sent to it before the answered one did
+    // not get a response and never will. The requests to other slaves on the bus are answered independently
+    while (true) {
+        const size_t  answered_index = findInFlightRequest(sequence_number);
+        const uint8_t receiver_id    = in_flight_requests_[answered_index].receiver_id;
+
+        size_t skipped_index = 0;
+        while (skipped_index < answered_index && in_flight_requests_[skipped_index].receiver_id != receiver_id) {
+            skipped_index++;
+        }
+        if (skipped_index == answered_index) return answered_index;
+
+        communication_statistics_.timed_out_packets++;
+        completeInFlightRequest(skipped_index, ResponseCode::timed_out, {});
+    }
+}
+
+void MasterHandler::completeInFlightRequest(size_t index, ResponseCode response_code,
+                                            std::span<uint8_t> response_payload) {
+    ASSERT(index < in_flight_requests_.size());
+
+    // Removed before invoking the callback so that the callback is free to submit new commands
+    const InFlightRequest completed_request = in_flight_requests_[index];
+    in_flight_requests_.removeElement(index);
+    if (shouldRetry(completed_request, response_code)) {
+        retry(completed_request);
+        return;
+    }
+
+    // The timeout runs for the next request in line when the oldest one completes
+    if (index == 0 && !in_flight_requests_.empty()) {
+        startResponseTimeout();
+    }
+
+    const ResponseCode completed_response_code =
+        completed_request.completion_adapter(completed_request, response_code, response_payload);
+    if (completed_response_code != ResponseCode::ok) {
+        communication_statistics_.operations[completed_request.operation_code].errors++;
+    }
+}
+
+void MasterHandler::completeOldestInFlightRequest(ResponseCode response_code, std::span<uint8_t> response_payload) {
+    completeInFlightRequest(0, response_code, response_payload);
+}
+
+void MasterHandler::failAllInFlightRequests(ResponseCode response_code) {
+    // The retried requests are queued again, only the ones in flight now are failed
+    for (size_t failed_count = in_flight_requests_.size(); failed_count > 0; failed_count--) {
+        completeOldestInFlightRequest(response_code, {});
+    }
+}
+
+uint8_t MasterHandler::findFreePacketSlot() const {
+    for (uint8_t packet_slot = 0; packet_slot < K_MAX_IN_FLIGHT_REQUESTS; packet_slot++) {
+        const bool is_used = std::any_of(in_flight_requests_.begin(), in_flight_requests_.end(),
+                                         [packet_slot](const InFlightRequest& request) {
+                                             return request.packet_slot == packet_slot;
+                                         });
+        if (!is_used) return packet_slot;
+    }
+
+    ASSERT_WITH_MESSAGE(false, "No free request packet slot");
+    return 0;
+}
+
+uint8_t MasterHandler::takeSequenceNumber() {
+    // The slave remembers the last sequence number it has handled. A master that starts numbering from the same value
+    // every time could have its first request taken for a retry of the previous session's last one. Seeded here and
+    // not in the constructor, as the clock may belong to a class that is still being constructed then
+    if (!sequence_number_seeded_) {
+        next_sequence_number_   = static_cast<uint8_t>(timeout_clock_.uptimeMicroseconds());
+        sequence_number_seeded_ = true;
+    }
+    if (next_sequence_number_ == K_NO_SEQUENCE_NUMBER) next_sequence_number_++;
+    return next_sequence_number_++;
+}
+
+bool MasterHandler::shouldRetry(const InFlightRequest& failed_request, ResponseCode response_code) const {
+    // Only the losses on the way are worth another try, the slave would answer the rest the same way again
+    if (response_code != ResponseCode::timed_out && response_code != ResponseCode::corrupted) return false;
+    if (failed_request.retry_count >= retry_policy_.max_retries) return false;
+
+    // The retry goes behind the requests still in flight. A request that changes something must not be handled after
+    // the ones that were sent after it
+    return failed_request.idempotency == commands::Idempotency::idempotent || in_flight_requests_.empty();
+}
+
+void MasterHandler::retry(InFlightRequest failed_request) {
+    failed_request.retry_count++;
+    failed_request.transmit_time_us = timeout_clock_.uptimeMicroseconds();
+    // Sent as it is, a non-idempotent request keeps its sequence number so that the slave recognizes it
+    const std::span<uint8_t> packet_bytes(request_packets_[failed_request.packet_slot],
+                                          failed_request.request_packet_size);
+    transmitPacket(packet_bytes);
+    communication_statistics_.retransmissions++;
+
+    in_flight_requests_.pushBack(failed_request);
+    // Runs for the next request in line, or for the retry if nothing else is in flight
+    startResponseTimeout();
+}
+
+void MasterHandler::dispatchUnsolicitedFrame(std::span<uint8_t> frame_payload) {
+    communication_statistics_.unsolicited_frames_received++;
+
+    // Frame without the stream id and the sender id is not usable
+    if (frame_payload.size_bytes() < K_UNSOLICITED_FRAME_HEADER_SIZE) return;
+    if (unsolicited_frame_callback_ == nullptr) return;
+
+    const uint8_t stream_id = frame_payload[0];
+    const uint8_t sender_id = frame_payload[1];
+    unsolicited_frame_callback_(stream_id, sender_id, frame_payload.subspan(K_UNSOLICITED_FRAME_HEADER_SIZE),
+                                unsolicited_frame_callback_user_data_);
 }
 
 }  // namespace serial_communication_framework
@@ -1,5 +1,7 @@
 #include "serial_communication_framework/SlaveHandler.h"
 
+#include <cstring>
+
 #include "assert/assert.h"
 #include "serial_communication_framework/packets.h"
 #include "serial_communication_framework/serialize_deserialize.h"
@@ -8,127 +10,197 @@ namespace serial_communication_framework {
 
 SlaveHandler::SlaveHandler(drivers::interfaces::BufferedSerialCommunicationInterface& communication_interface,
                            drivers::interfaces::ClockInterface& clock_interface, uint8_t device_id)
-    : communication_interface_(communication_interface), device_id_(device_id), timeout_clock_(clock_interface) {
+    : communication_interface_(communication_interface),
+      request_receiver_(communication_statistics_),
+      device_id_(device_id),
+      timeout_clock_(clock_interface) {
     ASSERT_WITH_MESSAGE(std::span<uint8_t>(tx_buffer_).size_bytes() >= ResponsePacket::K_PACKET_MAX_SIZE,
                         "Too small tx_buffer");
-    ASSERT_WITH_MESSAGE(std::span<uint8_t>(rx_buffer_).size_bytes() >= RequestPacket::K_PACKET_MAX_SIZE,
-                        "Too small rx_buffer");
 }
 
 void SlaveHandler::init() { /* TODO SET THE SERIAL COMMUNICATION SETTINGS */ }
 
 void SlaveHandler::run() {
-    static size_t rx_index             = 0;
-    static size_t expected_packet_size = RequestPacket::K_PACKET_MAX_SIZE;
-
-    if (communication_interface_.getReceivedBytesAvailableAmount() > 0) {
-        rx_buffer_[rx_index] = communication_interface_.readReceivedByte();
-        rx_index++;
+    // Only the bytes that have arrived by now are handled, so a continuous stream can't keep run() from returning
+    size_t available_byte_count = communication_interface_.getReceivedBytesAvailableAmount();
+    communication_statistics_.rx_overflows = communication_interface_.getRxOverflowCount();
+
+    while (true) {
+        const ParseResult parse_result = request_receiver_.receive(communication_interface_, available_byte_count);
+        switch (parse_result) {
+            case ParseResult::incomplete:
+                return;
+            case ParseResult::header_corrupted:
+            case ParseResult::frame_corrupted:
+                handleCorruptedHeader();
+                break;
+            case ParseResult::payload_corrupted:
+                handleRequest(request_receiver_.getPacketBytes(), false);
+                break;
+            case ParseResult::packet_complete:
+                handleRequest(request_receiver_.getPacketBytes(), true);
+                break;
+        }
+        request_receiver_.finishPacket();
     }
+}
+
+void SlaveHandler::handleCorruptedHeader() {
+    communication_statistics_.corrupted_packets_received++;
 
-    if (rx_index == RequestPacket::K_HEADER_SIZE) {
-        RequestPacket::Header header = deSerializeRequestHeader(rx_buffer_);
+    // Answered right after the header has been received, so there is no timeout to check. The sequence number can't
+    // be trusted, the master takes the response for the oldest request it has in flight
+    ResponsePacket     response(static_cast<uint8_t>(ResponseCode::corrupted), {}, K_NO_SEQUENCE_NUMBER);
+    std::span<uint8_t> serialized_response = serializeResponse(response, tx_buffer_);
+    transmitPacket(serialized_response);
+}
 
-        if (!requestHeaderHasValidCrc(header)) {
-            communication_statistics_.corrupted_packets_received++;
-            ResponsePacket     response(static_cast<uint8_t>(ResponseCode::corrupted), {});
-            std::span<uint8_t> serialized_response = serializeResponse(response, tx_buffer_);
+void SlaveHandler::handleRequest(std::span<uint8_t> packet_bytes, bool payload_is_valid) {
+    // Until the op code is known to be intact, the request does not get any more time than the default
+    startResponseTimeout(K_DEFAULT_HANDLER_TIMEOUT_MS * 1'000);
 
-            // restore index to default
-            rx_index                               = 0;
+    RequestPacket packet = deSerializeRequest(packet_bytes);
 
-            if (responseHasTimedout()) {
-                // Do not answer if the timeout has happened on slave side and let the master run to timeout
-                return;
-            }
+    // TODO which way around should this be check the crc first or the id
+    // if id then if tha packet is still corrupted and the id field is faulty this device might conflict with
+    // the device the packet was meant for if it gets the packet correctly if crc first and the packet is
+    // corrupted the the packet might be for some other device and the if it gets the packet correctly same
+    // issue happens
 
-            communication_interface_.transmitBytes(serialized_response);
-            return;
-        }
+    // This way it is really unlikely that even if the packet is corrupted te id of the packet would be device
+    // id
 
-        expected_packet_size = header.payload_size + RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE;
+    // Check if the packet is for this device or not
+    // If not, do not do anything with the packet
+    if (packet.header.receiver_id != device_id_) {
         return;
     }
 
-    // TODO SIZE OFF BY 1 indexing error?
-    if (rx_index == expected_packet_size) {
-        // restore to defaults
-        rx_index             = 0;
-        expected_packet_size = RequestPacket::K_PACKET_MAX_SIZE;
-
-        startResponseTimeout();
-
-        RequestPacket packet = deSerializeRequest(rx_buffer_);
+    // only increment this after te id checking
+    communication_statistics_.total_packets_received++;
 
-        // TODO which way around should this be check the crc first or the id
-        // if id then if tha packet is still corrupted and the id field is faulty this device might conflict with
-        // the device the packet was meant for if it gets the packet correctly if crc first and the packet is
-        // corrupted the the packet might be for some other device and the if it gets the packet correctly same
-        // issue happens
-
-        // This way it is really unlikely that even if the packet is corrupted te id of the packet would be device
-        // id
+    if (!payload_is_valid) {
+        communication_statistics_.corrupted_packets_received++;
+        ResponsePacket     response(static_cast<uint8_t>(ResponseCode::corrupted), {}, packet.header.sequence_number);
+        std::span<uint8_t> serialized_response = serializeResponse(response, tx_buffer_);
 
-        // Check if the packet is for this device or not
-        // If not, do not do anything with the packet
-        if (packet.header.receiver_id != device_id_) {
+        if (responseHasTimedout()) {
+            communication_statistics_.timed_out_packets++;
+            // Do not answer if the timeout has happened on slave side and let the master run to timeout
             return;
         }
 
-        // only increment this after te id checking
-        communication_statistics_.total_packets_received++;
+        transmitPacket(serialized_response);
+        return;
+    }
+    communication_statistics_.valid_packets_received++;
 
-        if (!requestPayloadHasValidCrc(packet)) {
-            communication_statistics_.corrupted_packets_received++;
-            ResponsePacket     response(static_cast<uint8_t>(ResponseCode::corrupted), {});
-            std::span<uint8_t> serialized_response = serializeResponse(response, tx_buffer_);
+    // The master did not get the response, handling the request again would e.g. apply a relative move twice
+    if (isRetryOfLastSequencedRequest(packet)) {
+        communication_statistics_.duplicate_requests++;
+        transmitPacket(std::span<uint8_t>(last_sequenced_response_, last_sequenced_request_.response_size));
+        return;
+    }
 
-            if (responseHasTimedout()) {
-                communication_statistics_.timed_out_packets++;
-                // Do not answer if the timeout has happened on slave side and let the master run to timeout
-                return;
-            }
+    const uint8_t        operation_code       = packet.header.operation_code;
+    OperationStatistics& operation_statistics = communication_statistics_.operations[operation_code];
+    operation_statistics.requests++;
+
+    const CommandHandler& command_handler = command_handlers_[operation_code];
+
+    AdapterFuncResponse adapter_func_response;
+    if (command_handler.adapter == nullptr) {
+        adapter_func_response = {ResponseCode::unknown_operation_code, 0};
+    } else {
+        // The master's timeout for the command is calculated from the same handler timeout
+        response_timeout_us_            = command_handler.timeout_us;
+        const uint64_t handler_start_us = timeout_clock_.uptimeMicroseconds();
+        adapter_func_response           = command_handler.adapter(this, packet.payload);
+        handler_time_statistics_[operation_code].addSample(timeout_clock_.uptimeMicroseconds() - handler_start_us);
+    }
+    if (adapter_func_response.response_code != ResponseCode::ok) operation_statistics.errors++;
+
+    std::span<uint8_t> serialized_response = finalizeResponseInPlace(
+        static_cast<uint8_t>(adapter_func_response.response_code), packet.header.sequence_number,
+        adapter_func_response.response_payload_size, tx_buffer_);
+    // Also when the response is too late, the master's retry then gets it. Every request is numbered so that its
+    // response can be matched, only the ones that must not be handled twice are remembered
+    if (packet.header.sequence_number != K_NO_SEQUENCE_NUMBER &&
+        command_handler.idempotency == commands::Idempotency::non_idempotent) {
+        rememberSequencedRequest(packet, serialized_response);
+    }
 
-            communication_interface_.transmitBytes(serialized_response);
-            return;
-        }
-        communication_statistics_.valid_packets_received++;
+    if (responseHasTimedout()) {
+        communication_statistics_.timed_out_packets++;
+        // An answered error was counted already, a timed out success is an error too
+        if (adapter_func_response.response_code == ResponseCode::ok) operation_statistics.errors++;
+        // Do not answer if the timeout has happened on slave side and let the master run to timeout
+        return;
+    }
+    transmitPacket(serialized_response);
+}
 
-        AdapterFunc adapter_func = command_handlers_[packet.header.operation_code];
+bool SlaveHandler::isRetryOfLastSequencedRequest(const RequestPacket& packet) const {
+    // A master that has restarted could come up with the same sequence number, the op code and the payload have to
+    // match as well
+    return packet.header.sequence_number != K_NO_SEQUENCE_NUMBER &&
+           packet.header.sequence_number == last_sequenced_request_.sequence_number &&
+           packet.header.operation_code == last_sequenced_request_.operation_code &&
+           packet.payload_crc == last_sequenced_request_.payload_crc;
+}
 
-        AdapterFuncResponse adapter_func_response;
-        if (adapter_func == nullptr) {
-            adapter_func_response = {ResponseCode::unknown_operation_code, {}};
-        } else {
-            adapter_func_response = adapter_func(this, packet.payload);
-        }
+void SlaveHandler::rememberSequencedRequest(const RequestPacket& packet, std::span<uint8_t> serialized_response) {
+    last_sequenced_request_ = {.operation_code  = packet.header.operation_code,
+                               .sequence_number = packet.header.sequence_number,
+                               .payload_crc     = packet.payload_crc,
+                               .response_size   = serialized_response.size_bytes()};
+    std::memcpy(last_sequenced_response_, serialized_response.data(), serialized_response.size_bytes());
+}
 
-        ResponsePacket     response(static_cast<uint8_t>(adapter_func_response.response_code),
-                                    adapter_func_response.response_data);
-        std::span<uint8_t> serialized_response = serializeResponse(response, tx_buffer_);
+void SlaveHandler::transmitUnsolicitedFrame(uint8_t stream_id, std::span<const uint8_t> payload) {
+    ASSERT_WITH_MESSAGE(payload.size_bytes() <= K_UNSOLICITED_FRAME_PAYLOAD_MAX_SIZE, "Unsolicited frame too large");
 
-        if (responseHasTimedout()) {
-            communication_statistics_.timed_out_packets++;
-            // Do not answer if the timeout has happened on slave side and let the master run to timeout
-            return;
-        }
-        communication_interface_.transmitBytes(serialized_response);
+    const std::span<uint8_t> frame_payload = getResponsePayloadBuffer(tx_buffer_);
+    frame_payload[0]                       = stream_id;
+    frame_payload[1]                       = device_id_;
+    std::memcpy(&frame_payload[K_UNSOLICITED_FRAME_HEADER_SIZE], payload.data(), payload.size_bytes());
 
-        // TODO Resetting tx buffer and rx buffer
-    }
+    std::span<uint8_t> serialized_frame =
+        finalizeResponseInPlace(static_cast<uint8_t>(ResponseCode::unsolicited_frame), K_NO_SEQUENCE_NUMBER,
+                                K_UNSOLICITED_FRAME_HEADER_SIZE + payload.size_bytes(), tx_buffer_);
+    transmitPacket(serialized_frame);
 }
 
 const CommunicationStatistics& SlaveHandler::getCommunicationStatistics() const { return communication_statistics_; }
 
-void SlaveHandler::startResponseTimeout() { response_timout_start_time_point_ = timeout_clock_.uptimeMilliseconds(); }
+const DurationStatistics& SlaveHandler::getHandlerTimeStatistics(uint8_t op_code) const {
+    return handler_time_statistics_[op_code];
+}
+
+void SlaveHandler::setFraming(Framing framing) { request_receiver_.setFraming(framing); }
+
+Framing SlaveHandler::getFraming() const { return request_receiver_.getFraming(); }
+
+void SlaveHandler::transmitPacket(std::span<uint8_t> packet_bytes) {
+    if (request_receiver_.getFraming() == Framing::cobs) {
+        packet_bytes = encodeCobsFrame(packet_bytes, tx_frame_buffer_);
+    }
+    communication_statistics_.bytes_transmitted += packet_bytes.size_bytes();
+    communication_interface_.transmitBytes(packet_bytes);
+}
+
+void SlaveHandler::startResponseTimeout(uint32_t timeout_us) {
+    response_timout_start_time_point_ = timeout_clock_.uptimeMicroseconds();
+    response_timeout_us_              = timeout_us;
+}
 
 bool SlaveHandler::responseHasTimedout() {
 #ifdef SERVO_CORE_DISABLE_SERIAL_COMMUNICATION_FRAMEWORK_TIMEOUTS
     return false;
 #endif
 
-    const uint64_t now = timeout_clock_.uptimeMilliseconds();
-    return (now - response_timout_start_time_point_) > K_SLAVE_TIMEOUT_MS;
+    const uint64_t now = timeout_clock_.uptimeMicroseconds();
+    return (now - response_timout_start_time_point_) > response_timeout_us_;
 }
 
 }  // namespace serial_communication_framework
\ No newline at end of file
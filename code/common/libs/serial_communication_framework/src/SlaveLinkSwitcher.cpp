@@ -0,0 +1,61 @@
+#include "serial_communication_framework/SlaveLinkSwitcher.h"
+
+namespace serial_communication_framework {
+
+SlaveLinkSwitcher::SlaveLinkSwitcher(SlaveHandler&                                          slave_handler,
+                                     drivers::interfaces::SerialPortConfigurationInterface& port,
+                                     drivers::interfaces::ClockInterface&                   clock_interface)
+    : slave_handler_(slave_handler), port_(port), clock_(clock_interface) {}
+
+bool SlaveLinkSwitcher::requestSwitch(LinkSettings settings) {
+    if (state_ != State::idle) return false;
+
+    requested_settings_ = settings;
+    state_              = State::switch_requested;
+    return true;
+}
+
+void SlaveLinkSwitcher::run() {
+    switch (state_) {
+        case State::idle:
+            return;
+
+        case State::switch_requested:
+            // The response to the request goes out with the settings the master sent the request with
+            port_.flushTx();
+            previous_settings_ = current_settings_;
+            if (!apply(requested_settings_)) {
+                // The port kept its rate, nothing was changed
+                state_ = State::idle;
+                return;
+            }
+            valid_packets_before_switch_ = slave_handler_.getCommunicationStatistics().valid_packets_received;
+            verify_start_time_point_     = clock_.uptimeMilliseconds();
+            state_                       = State::verifying;
+            return;
+
+        case State::verifying:
+            if (slave_handler_.getCommunicationStatistics().valid_packets_received > valid_packets_before_switch_) {
+                state_ = State::idle;
+                return;
+            }
+            if (clock_.uptimeMilliseconds() - verify_start_time_point_ > K_LINK_VERIFY_TIMEOUT_MS) {
+                (void)apply(previous_settings_);
+                state_ = State::idle;
+            }
+            return;
+    }
+}
+
+LinkSettings SlaveLinkSwitcher::getLinkSettings() const { return current_settings_; }
+
+bool SlaveLinkSwitcher::isSwitchInProgress() const { return state_ != State::idle; }
+
+bool SlaveLinkSwitcher::apply(LinkSettings settings) {
+    if (!port_.setBaudRate(settings.baud_rate)) return false;
+    slave_handler_.setFraming(settings.framing);
+    current_settings_ = settings;
+    return true;
+}
+
+}  // namespace serial_communication_framework
@@ -0,0 +1,125 @@
+#include "serial_communication_framework/TransferReceiver.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace serial_communication_framework {
+
+void TransferReceiver::start(std::span<uint8_t> target_buffer) {
+    reset();
+    target_buffer_ = target_buffer;
+    total_size_    = static_cast<uint32_t>(target_buffer.size_bytes());
+    started_       = true;
+}
+
+void TransferReceiver::start(uint32_t total_size, TransferSink sink, void* user_data) {
+    ASSERT(sink != nullptr);
+
+    reset();
+    sink_           = sink;
+    sink_user_data_ = user_data;
+    total_size_     = total_size;
+    started_        = true;
+}
+
+ResponseCode TransferReceiver::receiveSegment(uint32_t offset, std::span<const uint8_t> bytes) {
+    if (!started_) return ResponseCode::forbidden;
+    if (failure_code_ != ResponseCode::ok) return failure_code_;
+
+    if (bytes.empty() || bytes.size_bytes() > K_TRANSFER_SEGMENT_MAX_SIZE || offset > total_size_ ||
+        bytes.size_bytes() > total_size_ - offset) {
+        return ResponseCode::out_of_bounds;
+    }
+
+    const uint32_t segment_end = offset + static_cast<uint32_t>(bytes.size_bytes());
+    // Received already, its acknowledgement must have been lost
+    if (segment_end <= completed_size_) return ResponseCode::ok;
+    // The segments are always cut at the same offsets, so a partial overlap means that the sender is broken
+    if (offset < completed_size_) return ResponseCode::out_of_bounds;
+
+    if (offset == completed_size_) {
+        const ResponseCode delivery_result = deliver(offset, bytes);
+        if (delivery_result != ResponseCode::ok) return delivery_result;
+        return deliverPendingSegments();
+    }
+
+    // Ahead of a missing segment
+    PendingSegment* free_segment = nullptr;
+    for (PendingSegment& pending_segment : pending_segments_) {
+        if (pending_segment.used && pending_segment.offset == offset) return ResponseCode::ok;
+        if (!pending_segment.used && free_segment == nullptr) free_segment = &pending_segment;
+    }
+    // Further ahead than the window allows the sender to be
+    if (free_segment == nullptr) return ResponseCode::out_of_bounds;
+
+    free_segment->used   = true;
+    free_segment->offset = offset;
+    free_segment->size   = bytes.size_bytes();
+    if (sink_ == nullptr) {
+        std::memcpy(&target_buffer_[offset], bytes.data(), bytes.size_bytes());
+    } else {
+        std::memcpy(free_segment->bytes, bytes.data(), bytes.size_bytes());
+    }
+    return ResponseCode::ok;
+}
+
+bool TransferReceiver::isComplete() const {
+    return started_ && failure_code_ == ResponseCode::ok && completed_size_ == total_size_;
+}
+
+uint32_t TransferReceiver::getCompletedSize() const { return completed_size_; }
+
+uint32_t TransferReceiver::getTotalSize() const { return total_size_; }
+
+void TransferReceiver::reset() {
+    for (PendingSegment& pending_segment : pending_segments_) pending_segment.used = false;
+    target_buffer_  = {};
+    sink_           = nullptr;
+    sink_user_data_ = nullptr;
+    total_size_     = 0;
+    completed_size_ = 0;
+    started_        = false;
+    failure_code_   = ResponseCode::ok;
+}
+
+ResponseCode TransferReceiver::deliver(uint32_t offset, std::span<const uint8_t> bytes) {
+    if (sink_ == nullptr) {
+        std::memcpy(&target_buffer_[offset], bytes.data(), bytes.size_bytes());
+    } else {
+        const ResponseCode sink_result = sink_(offset, bytes, sink_user_data_);
+        if (sink_result != ResponseCode::ok) {
+            failure_code_ = sink_result;
+            return sink_result;
+        }
+    }
+
+    completed_size_ += static_cast<uint32_t>(bytes.size_bytes());
+    return ResponseCode::ok;
+}
+
+ResponseCode TransferReceiver::deliverPendingSegments() {
+    bool delivered_any = true;
+    while (delivered_any) {
+        delivered_any = false;
+        for (PendingSegment& pending_segment : pending_segments_) {
+            if (!pending_segment.used || pending_segment.offset != completed_size_) continue;
+
+            pending_segment.used = false;
+            delivered_any        = true;
+
+            if (sink_ == nullptr) {
+                // Written to its place when it arrived
+                completed_size_ += static_cast<uint32_t>(pending_segment.size);
+                continue;
+            }
+
+            const ResponseCode delivery_result =
+                deliver(pending_segment.offset, std::span<const uint8_t>(pending_segment.bytes, pending_segment.size));
+            if (delivery_result != ResponseCode::ok) return delivery_result;
+        }
+    }
+    return ResponseCode::ok;
+}
+
+}  // namespace serial_communication_framework
@@ -0,0 +1,109 @@
+#include "serial_communication_framework/TransferSlave.h"
+
+#include <algorithm>
+
+#include "assert/assert.h"
+
+namespace serial_communication_framework {
+
+void TransferSlave::registerUploadBuffer(uint8_t transfer_id, std::span<uint8_t> buffer,
+                                         TransferFinishCallback on_finish, void* user_data) {
+    registerEndpoint({.transfer_id   = transfer_id,
+                      .type          = EndpointType::upload_buffer,
+                      .upload_buffer = buffer,
+                      .max_size      = static_cast<uint32_t>(buffer.size_bytes()),
+                      .on_finish     = on_finish,
+                      .user_data     = user_data});
+}
+
+void TransferSlave::registerUploadSink(uint8_t transfer_id, uint32_t max_size, TransferSink sink,
+                                       TransferFinishCallback on_finish, void* user_data) {
+    ASSERT(sink != nullptr);
+    registerEndpoint({.transfer_id = transfer_id,
+                      .type        = EndpointType::upload_sink,
+                      .max_size    = max_size,
+                      .sink        = sink,
+                      .on_finish   = on_finish,
+                      .user_data   = user_data});
+}
+
+void TransferSlave::registerDownloadSource(uint8_t transfer_id, TransferSource source, void* user_data) {
+    ASSERT(source != nullptr);
+    registerEndpoint(
+        {.transfer_id = transfer_id, .type = EndpointType::download_source, .source = source, .user_data = user_data});
+}
+
+ResponseCode TransferSlave::startUpload(const TransferStartRequest& request) {
+    const Endpoint* endpoint = findEndpoint(request.transfer_id, true);
+    if (endpoint == nullptr) return ResponseCode::invalid_id;
+    if (request.total_size > endpoint->max_size) return ResponseCode::out_of_bounds;
+
+    if (endpoint->type == EndpointType::upload_buffer) {
+        receiver_.start(endpoint->upload_buffer.first(request.total_size));
+    } else {
+        receiver_.start(request.total_size, endpoint->sink, endpoint->user_data);
+    }
+    active_upload_ = endpoint;
+    finished_      = false;
+    return ResponseCode::ok;
+}
+
+ResponseCode TransferSlave::receiveSegment(const TransferSegmentRequest& request) {
+    if (active_upload_ == nullptr || active_upload_->transfer_id != request.transfer_id) {
+        return ResponseCode::forbidden;
+    }
+    return receiver_.receiveSegment(request.offset, request.raw_bytes);
+}
+
+ResponseCode TransferSlave::finishUpload(const TransferFinishRequest& request) {
+    if (active_upload_ == nullptr || active_upload_->transfer_id != request.transfer_id) {
+        return ResponseCode::forbidden;
+    }
+    // Finished already, the master did not get the answer
+    if (finished_) return finish_result_;
+    if (!receiver_.isComplete()) return ResponseCode::forbidden;
+
+    finish_result_ = ResponseCode::ok;
+    if (active_upload_->on_finish != nullptr) {
+        finish_result_ = active_upload_->on_finish(receiver_.getTotalSize(), active_upload_->user_data);
+    }
+    finished_ = true;
+    return finish_result_;
+}
+
+TransferReadResponse TransferSlave::readSegment(const TransferReadRequest& request) {
+    TransferReadResponse response;
+
+    const Endpoint* endpoint = findEndpoint(request.transfer_id, false);
+    if (endpoint == nullptr) {
+        response.response_code = ResponseCode::invalid_id;
+        return response;
+    }
+
+    const size_t read_size  = std::min<size_t>(request.size, K_TRANSFER_SEGMENT_MAX_SIZE);
+    size_t       bytes_read = 0;
+    response.response_code  = endpoint->source(request.offset, std::span(read_buffer_).first(read_size), &bytes_read,
+                                               endpoint->user_data);
+    if (response.response_code != ResponseCode::ok) return response;
+
+    response.offset    = request.offset;
+    response.raw_bytes = {read_buffer_, bytes_read};
+    return response;
+}
+
+void TransferSlave::registerEndpoint(const Endpoint& endpoint) {
+    ASSERT_WITH_MESSAGE(findEndpoint(endpoint.transfer_id, endpoint.type != EndpointType::download_source) == nullptr,
+                        "Transfer id already registered");
+    ASSERT_WITH_MESSAGE(!endpoints_.full(), "Too many transfer endpoints");
+    endpoints_.pushBack(endpoint);
+}
+
+const TransferSlave::Endpoint* TransferSlave::findEndpoint(uint8_t transfer_id, bool upload) const {
+    for (const Endpoint& endpoint : endpoints_) {
+        if (endpoint.transfer_id != transfer_id) continue;
+        if ((endpoint.type != EndpointType::download_source) == upload) return &endpoint;
+    }
+    return nullptr;
+}
+
+}  // namespace serial_communication_framework
@@ -0,0 +1,60 @@
+#include "serial_communication_framework/cobs.h"
+
+#include "assert/assert.h"
+
+namespace serial_communication_framework {
+
+std::span<uint8_t> encodeCobsFrame(std::span<const uint8_t> data, std::span<uint8_t> frame_buffer) {
+    ASSERT_WITH_MESSAGE(frame_buffer.size_bytes() >= cobsFrameMaxSize(data.size_bytes()), "Too small frame buffer");
+
+    size_t  code_index  = 0;
+    size_t  write_index = 1;
+    uint8_t code        = 1;
+
+    for (const uint8_t byte : data) {
+        if (byte != K_COBS_DELIMITER) {
+            frame_buffer[write_index++] = byte;
+            code++;
+        }
+
+        // A zero, or a full block which is not followed by an implicit zero, ends the block
+        if (byte == K_COBS_DELIMITER || code == K_COBS_MAX_BLOCK_SIZE + 1) {
+            frame_buffer[code_index] = code;
+            code_index               = write_index++;
+            code                     = 1;
+        }
+    }
+
+    frame_buffer[code_index]    = code;
+    frame_buffer[write_index++] = K_COBS_DELIMITER;
+    return frame_buffer.first(write_index);
+}
+
+CobsDecoder::Result CobsDecoder::decode(uint8_t encoded_byte, uint8_t& decoded_byte) {
+    if (encoded_byte == K_COBS_DELIMITER) {
+        reset();
+        return Result::frame_ended;
+    }
+
+    if (block_bytes_left_ > 0) {
+        block_bytes_left_--;
+        decoded_byte = encoded_byte;
+        return Result::data_byte;
+    }
+
+    // A code byte. The zero the previous block stood for is only known to be data once another block follows it
+    const bool previous_block_ended_in_zero = zero_pending_;
+    block_bytes_left_                       = encoded_byte - 1;
+    zero_pending_                           = encoded_byte != K_COBS_MAX_BLOCK_SIZE + 1;
+
+    if (!previous_block_ended_in_zero) return Result::no_data;
+    decoded_byte = 0;
+    return Result::data_byte;
+}
+
+void CobsDecoder::reset() {
+    block_bytes_left_ = 0;
+    zero_pending_     = false;
+}
+
+}  // namespace serial_communication_framework
@@ -1,5 +1,6 @@
 #include "serial_communication_framework/serialize_deserialize.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "assert/assert.h"
@@ -41,7 +42,7 @@ ResponsePacket deSerializeResponse(std::span<uint8_t> data) {
     ResponsePacket resp;
     resp.header      = deSerializeResponseHeader(data.subspan(0, ResponsePacket::K_HEADER_SIZE));
 
-    resp.payload_crc = data[3];
+    resp.payload_crc = data[ResponsePacket::K_PAYLOAD_CRC_INDEX];
 
     ASSERT(data.size_bytes() >= ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + resp.header.payload_size);
     resp.payload = data.subspan(ResponsePacket::K_PAYLOAD_START_OFFSET, resp.header.payload_size);
@@ -55,7 +56,7 @@ RequestPacket deSerializeRequest(std::span<uint8_t> data) {
     RequestPacket req;
     req.header      = deSerializeRequestHeader(data.subspan(0, RequestPacket::K_HEADER_SIZE));
 
-    req.payload_crc = data[4];
+    req.payload_crc = data[RequestPacket::K_PAYLOAD_CRC_INDEX];
 
     ASSERT(data.size_bytes() >= RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + req.header.payload_size);
     req.payload = data.subspan(RequestPacket::K_PAYLOAD_START_OFFSET, req.header.payload_size);
@@ -64,45 +65,87 @@ RequestPacket deSerializeRequest(std::span<uint8_t> data) {
 }
 
 std::span<uint8_t> serializeResponse(const ResponsePacket& resp, std::span<uint8_t> target_buffer) {
-    ASSERT(target_buffer.size_bytes() >= ResponsePacket::K_PAYLOAD_MAX_SIZE);
+    ASSERT(target_buffer.size_bytes() >= ResponsePacket::K_PAYLOAD_START_OFFSET + resp.header.payload_size);
+
+    uint8_t* payload_start = target_buffer.data() + ResponsePacket::K_PAYLOAD_START_OFFSET;
+    // Payload that was serialized in place is already where it should be
+    if (resp.payload.data() != payload_start) {
+        std::memcpy(payload_start, resp.payload.data(), resp.header.payload_size);
+    }
+
+    return finalizeResponseInPlace(resp.header.response_code, resp.header.sequence_number, resp.header.payload_size,
+                                   target_buffer);
+}
+
+std::span<uint8_t> serializeRequest(const RequestPacket& req, std::span<uint8_t> target_buffer) {
+    ASSERT(target_buffer.size_bytes() >= RequestPacket::K_PAYLOAD_START_OFFSET + req.header.payload_size);
+
+    uint8_t* payload_start = target_buffer.data() + RequestPacket::K_PAYLOAD_START_OFFSET;
+    // Payload that was serialized in place is already where it should be
+    if (req.payload.data() != payload_start) {
+        std::memcpy(payload_start, req.payload.data(), req.header.payload_size);
+    }
+
+    return finalizeRequestInPlace(req.header.receiver_id, req.header.operation_code, req.header.sequence_number,
+                                  req.header.payload_size, target_buffer);
+}
+
+std::span<uint8_t> getResponsePayloadBuffer(std::span<uint8_t> packet_buffer) {
+    ASSERT(packet_buffer.size_bytes() >= ResponsePacket::K_PAYLOAD_START_OFFSET);
+
+    const size_t payload_buffer_size = std::min(packet_buffer.size_bytes() - ResponsePacket::K_PAYLOAD_START_OFFSET,
+                                                ResponsePacket::K_PAYLOAD_MAX_SIZE);
+    return packet_buffer.subspan(ResponsePacket::K_PAYLOAD_START_OFFSET, payload_buffer_size);
+}
+
+std::span<uint8_t> getRequestPayloadBuffer(std::span<uint8_t> packet_buffer) {
+    ASSERT(packet_buffer.size_bytes() >= RequestPacket::K_PAYLOAD_START_OFFSET);
+
+    const size_t payload_buffer_size = std::min(packet_buffer.size_bytes() - RequestPacket::K_PAYLOAD_START_OFFSET,
+                                                RequestPacket::K_PAYLOAD_MAX_SIZE);
+    return packet_buffer.subspan(RequestPacket::K_PAYLOAD_START_OFFSET, payload_buffer_size);
+}
+
+std::span<uint8_t> finalizeResponseInPlace(uint8_t response_code, uint8_t sequence_number, size_t payload_size,
+                                           std::span<uint8_t> packet_buffer) {
+    ASSERT(payload_size <= ResponsePacket::K_PAYLOAD_MAX_SIZE);
+    ASSERT(packet_buffer.size_bytes() >= ResponsePacket::K_PAYLOAD_START_OFFSET + payload_size);
     // Check that the de serialization still since we are assuming that these values are only one byte long
     static_assert(sizeof(ResponsePacket::Header::response_code) == 1);
+    static_assert(sizeof(ResponsePacket::Header::sequence_number) == 1);
     static_assert(sizeof(ResponsePacket::Header::payload_size) == 1);
     static_assert(sizeof(ResponsePacket::Header::header_crc) == 1);
     static_assert(sizeof(ResponsePacket::payload_crc) == 1);
 
-    target_buffer[0]       = resp.header.response_code;
-    target_buffer[1]       = resp.header.payload_size;
-    target_buffer[2]       = math::generateCrc8(target_buffer.subspan(0, ResponsePacket::K_HEADER_SIZE_WITHOUT_CRC));
-
-    uint8_t* payload_start = target_buffer.data() + ResponsePacket::K_PAYLOAD_START_OFFSET;
-    std::memcpy(payload_start, resp.payload.data(), resp.header.payload_size);
-
-    target_buffer[3] = math::generateCrc8(resp.payload);
+    packet_buffer[0] = response_code;
+    packet_buffer[1] = sequence_number;
+    packet_buffer[2] = static_cast<uint8_t>(payload_size);
+    packet_buffer[3] = math::generateCrc8(packet_buffer.subspan(0, ResponsePacket::K_HEADER_SIZE_WITHOUT_CRC));
+    packet_buffer[4] = math::generateCrc8(packet_buffer.subspan(ResponsePacket::K_PAYLOAD_START_OFFSET, payload_size));
 
-    return target_buffer.subspan(0, ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + resp.header.payload_size);
+    return packet_buffer.subspan(0, ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + payload_size);
 }
 
-std::span<uint8_t> serializeRequest(const RequestPacket& req, std::span<uint8_t> target_buffer) {
-    ASSERT(target_buffer.size_bytes() >= RequestPacket::K_PAYLOAD_MAX_SIZE);
+std::span<uint8_t> finalizeRequestInPlace(uint8_t receiver_id, uint8_t operation_code, uint8_t sequence_number,
+                                          size_t payload_size, std::span<uint8_t> packet_buffer) {
+    ASSERT(payload_size <= RequestPacket::K_PAYLOAD_MAX_SIZE);
+    ASSERT(packet_buffer.size_bytes() >= RequestPacket::K_PAYLOAD_START_OFFSET + payload_size);
     // Check that the de serialization still works since we are assuming that these values are only one byte long
     static_assert(sizeof(RequestPacket::Header::receiver_id) == 1);
     static_assert(sizeof(RequestPacket::Header::operation_code) == 1);
+    static_assert(sizeof(RequestPacket::Header::sequence_number) == 1);
     static_assert(sizeof(RequestPacket::Header::payload_size) == 1);
     static_assert(sizeof(RequestPacket::Header::header_crc) == 1);
     static_assert(sizeof(RequestPacket::payload_crc) == 1);
 
-    target_buffer[0]       = req.header.receiver_id;
-    target_buffer[1]       = req.header.operation_code;
-    target_buffer[2]       = req.header.payload_size;
-    target_buffer[3]       = math::generateCrc8(target_buffer.subspan(0, RequestPacket::K_HEADER_SIZE_WITHOUT_CRC));
-
-    uint8_t* payload_start = target_buffer.data() + RequestPacket::K_PAYLOAD_START_OFFSET;
-    std::memcpy(payload_start, req.payload.data(), req.header.payload_size);
-
-    target_buffer[4] = math::generateCrc8(req.payload);
+    packet_buffer[0] = receiver_id;
+    packet_buffer[1] = operation_code;
+    packet_buffer[2] = sequence_number;
+    packet_buffer[3] = static_cast<uint8_t>(payload_size);
+    packet_buffer[4] = math::generateCrc8(packet_buffer.subspan(0, RequestPacket::K_HEADER_SIZE_WITHOUT_CRC));
+    packet_buffer[5] = math::generateCrc8(packet_buffer.subspan(RequestPacket::K_PAYLOAD_START_OFFSET, payload_size));
 
-    return target_buffer.subspan(0, RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + req.header.payload_size);
+    return packet_buffer.subspan(0, RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + payload_size);
 }
 
 ResponsePacket::Header deSerializeResponseHeader(std::span<uint8_t> data) {
@@ -111,12 +154,14 @@ ResponsePacket::Header deSerializeResponseHeader(std::span<uint8_t> data) {
     ResponsePacket::Header resp_header;
     // Check that the de serialization still since we are assuming that these values are only one byte long
     static_assert(sizeof(ResponsePacket::Header::response_code) == 1);
+    static_assert(sizeof(ResponsePacket::Header::sequence_number) == 1);
     static_assert(sizeof(ResponsePacket::Header::payload_size) == 1);
     static_assert(sizeof(ResponsePacket::Header::header_crc) == 1);
 
-    resp_header.response_code = data[0];
-    resp_header.payload_size  = data[1];
-    resp_header.header_crc    = data[2];
+    resp_header.response_code   = data[0];
+    resp_header.sequence_number = data[1];
+    resp_header.payload_size    = data[2];
+    resp_header.header_crc      = data[3];
 
     return resp_header;
 }
@@ -127,12 +172,14 @@ std::span<uint8_t> serializeResponseHeader(const ResponsePacket::Header& resp_he
 
     // Check that the de serialization still since we are assuming that these values are only one byte long
     static_assert(sizeof(ResponsePacket::Header::response_code) == 1);
+    static_assert(sizeof(ResponsePacket::Header::sequence_number) == 1);
     static_assert(sizeof(ResponsePacket::Header::payload_size) == 1);
     static_assert(sizeof(ResponsePacket::Header::header_crc) == 1);
 
     target_buffer[0] = resp_header.response_code;
-    target_buffer[1] = resp_header.payload_size;
-    target_buffer[2] = math::generateCrc8(target_buffer.subspan(0, ResponsePacket::K_HEADER_SIZE_WITHOUT_CRC));
+    target_buffer[1] = resp_header.sequence_number;
+    target_buffer[2] = resp_header.payload_size;
+    target_buffer[3] = math::generateCrc8(target_buffer.subspan(0, ResponsePacket::K_HEADER_SIZE_WITHOUT_CRC));
 
     return target_buffer.subspan(0, ResponsePacket::K_HEADER_SIZE);
 }
@@ -144,13 +191,15 @@ RequestPacket::Header deSerializeRequestHeader(std::span<uint8_t> data) {
     // Check that the de serialization still works since we are assuming that these values are only one byte long
     static_assert(sizeof(RequestPacket::Header::receiver_id) == 1);
     static_assert(sizeof(RequestPacket::Header::operation_code) == 1);
+    static_assert(sizeof(RequestPacket::Header::sequence_number) == 1);
     static_assert(sizeof(RequestPacket::Header::payload_size) == 1);
     static_assert(sizeof(RequestPacket::Header::header_crc) == 1);
 
-    req_header.receiver_id    = data[0];
-    req_header.operation_code = data[1];
-    req_header.payload_size   = data[2];
-    req_header.header_crc     = data[3];
+    req_header.receiver_id     = data[0];
+    req_header.operation_code  = data[1];
+    req_header.sequence_number = data[2];
+    req_header.payload_size    = data[3];
+    req_header.header_crc      = data[4];
 
     return req_header;
 }
@@ -161,13 +210,15 @@ std::span<uint8_t> serializeRequestHeader(const RequestPacket::Header& req_heade
     // Check that the de serialization still works since we are assuming that these values are only one byte long
     static_assert(sizeof(RequestPacket::Header::receiver_id) == 1);
     static_assert(sizeof(RequestPacket::Header::operation_code) == 1);
+    static_assert(sizeof(RequestPacket::Header::sequence_number) == 1);
     static_assert(sizeof(RequestPacket::Header::payload_size) == 1);
     static_assert(sizeof(RequestPacket::Header::header_crc) == 1);
 
     target_buffer[0] = req_header.receiver_id;
     target_buffer[1] = req_header.operation_code;
-    target_buffer[2] = req_header.payload_size;
-    target_buffer[3] = math::generateCrc8(target_buffer.subspan(0, RequestPacket::K_HEADER_SIZE_WITHOUT_CRC));
+    target_buffer[2] = req_header.sequence_number;
+    target_buffer[3] = req_header.payload_size;
+    target_buffer[4] = math::generateCrc8(target_buffer.subspan(0, RequestPacket::K_HEADER_SIZE_WITHOUT_CRC));
 
     return target_buffer.subspan(0, RequestPacket::K_HEADER_SIZE);
 }
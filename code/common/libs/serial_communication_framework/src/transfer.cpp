@@ -0,0 +1,137 @@
+#include "serial_communication_framework/transfer.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace serial_communication_framework {
+
+commands::ParsingError TransferStartRequest::deserialize(std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(transfer_id) + sizeof(total_size)) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&transfer_id, &bytes[idx], sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&total_size, &bytes[idx], sizeof(total_size));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> TransferStartRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(transfer_id) + sizeof(total_size) <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &transfer_id, sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&target_buffer[idx], &total_size, sizeof(total_size));
+    idx += sizeof(total_size);
+
+    return target_buffer.subspan(0, idx);
+}
+
+commands::ParsingError TransferSegmentRequest::deserialize(std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_TRANSFER_SEGMENT_HEADER_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&transfer_id, &bytes[idx], sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&offset, &bytes[idx], sizeof(offset));
+    idx += sizeof(offset);
+
+    raw_bytes = bytes.subspan(idx);
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> TransferSegmentRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_TRANSFER_SEGMENT_HEADER_SIZE + raw_bytes.size_bytes() <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &transfer_id, sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&target_buffer[idx], &offset, sizeof(offset));
+    idx += sizeof(offset);
+
+    std::memcpy(&target_buffer[idx], raw_bytes.data(), raw_bytes.size_bytes());
+    idx += raw_bytes.size_bytes();
+
+    return target_buffer.subspan(0, idx);
+}
+
+commands::ParsingError TransferFinishRequest::deserialize(std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(transfer_id)) return ParsingError::payload_missing_bytes;
+
+    std::memcpy(&transfer_id, bytes.data(), sizeof(transfer_id));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> TransferFinishRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(transfer_id) <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    std::memcpy(target_buffer.data(), &transfer_id, sizeof(transfer_id));
+
+    return target_buffer.subspan(0, sizeof(transfer_id));
+}
+
+commands::ParsingError TransferReadRequest::deserialize(std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(transfer_id) + sizeof(offset) + sizeof(size)) {
+        return ParsingError::payload_missing_bytes;
+    }
+
+    size_t idx = 0;
+    std::memcpy(&transfer_id, &bytes[idx], sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&offset, &bytes[idx], sizeof(offset));
+    idx += sizeof(offset);
+
+    std::memcpy(&size, &bytes[idx], sizeof(size));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> TransferReadRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(transfer_id) + sizeof(offset) + sizeof(size) <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &transfer_id, sizeof(transfer_id));
+    idx += sizeof(transfer_id);
+
+    std::memcpy(&target_buffer[idx], &offset, sizeof(offset));
+    idx += sizeof(offset);
+
+    std::memcpy(&target_buffer[idx], &size, sizeof(size));
+    idx += sizeof(size);
+
+    return target_buffer.subspan(0, idx);
+}
+
+commands::ParsingError TransferReadResponse::deserialize(std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(offset)) return ParsingError::payload_missing_bytes;
+    if (bytes.size_bytes() - sizeof(offset) > K_TRANSFER_SEGMENT_MAX_SIZE) return ParsingError::payload_does_not_fit;
+
+    std::memcpy(&offset, bytes.data(), sizeof(offset));
+    raw_bytes = bytes.subspan(sizeof(offset));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> TransferReadResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(offset) + raw_bytes.size_bytes() <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    std::memcpy(target_buffer.data(), &offset, sizeof(offset));
+    std::memcpy(&target_buffer[sizeof(offset)], raw_bytes.data(), raw_bytes.size_bytes());
+
+    return target_buffer.subspan(0, sizeof(offset) + raw_bytes.size_bytes());
+}
+
+}  // namespace serial_communication_framework
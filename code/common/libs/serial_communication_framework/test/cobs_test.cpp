@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/cobs.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+std::vector<uint8_t> encode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t>     frame_buffer(cobsFrameMaxSize(data.size()));
+    const std::span<uint8_t> frame = encodeCobsFrame(data, frame_buffer);
+    return {frame.begin(), frame.end()};
+}
+
+}  // namespace
+
+TEST(Cobs, known_encodings) {
+    EXPECT_EQ(encode({}), (std::vector<uint8_t>{0x01, 0x00}));
+    EXPECT_EQ(encode({0x00}), (std::vector<uint8_t>{0x01, 0x01, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x22, 0x00, 0x33}), (std::vector<uint8_t>{0x03, 0x11, 0x22, 0x02, 0x33, 0x00}));
+    EXPECT_EQ(encode({0x11, 0x00, 0x00}), (std::vector<uint8_t>{0x02, 0x11, 0x01, 0x01, 0x00}));
+}
+
+TEST(Cobs, frame_contains_no_zeros_before_the_delimiter) {
+    std::mt19937 random(1);
+    for (size_t size : {1u, 100u, 253u, 254u, 255u, 259u, 600u}) {
+        std::vector<uint8_t> data(size);
+        for (uint8_t& byte : data) byte = static_cast<uint8_t>(random() % 4 == 0 ? 0 : random());
+
+        const std::vector<uint8_t> frame = encode(data);
+        EXPECT_LE(frame.size(), cobsFrameMaxSize(size));
+        EXPECT_EQ(std::count(frame.begin(), frame.end(), K_COBS_DELIMITER), 1);
+        EXPECT_EQ(frame.back(), K_COBS_DELIMITER);
+    }
+}
+
+TEST(Cobs, decoding_restores_the_data) {
+    std::mt19937 random(2);
+    for (size_t size : {0u, 1u, 253u, 254u, 255u, 508u, 509u, 1000u}) {
+        for (int zero_every : {1, 3, 1000}) {
+            std::vector<uint8_t> data(size);
+            for (uint8_t& byte : data) byte = static_cast<uint8_t>(random() % zero_every == 0 ? 0 : random() | 1);
+
+            const std::vector<std::vector<uint8_t>> frames = decodeCobsFrames(encode(data));
+            ASSERT_EQ(frames.size(), 1u);
+            EXPECT_EQ(frames[0], data) << size << " " << zero_every;
+        }
+    }
+}
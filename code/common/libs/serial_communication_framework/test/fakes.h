@@ -0,0 +1,135 @@
+#ifndef COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TEST_FAKES_H
+#define COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TEST_FAKES_H
+
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <vector>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/ClockInterface.h"
+#include "serial_communication_framework/cobs.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+// Test doubles shared by the master and the slave handler tests
+namespace serial_communication_framework::test {
+
+class FakeSerial final : public drivers::interfaces::BufferedSerialCommunicationInterface {
+public:
+    void transmitByte(uint8_t byte) override { transmitted.push_back(byte); }
+    void transmitBytes(std::span<uint8_t> bytes) override {
+        transmitted.insert(transmitted.end(), bytes.begin(), bytes.end());
+    }
+
+    size_t  getReceivedBytesAvailableAmount() override { return received.size(); }
+    uint8_t readReceivedByte() override {
+        const uint8_t byte = received.front();
+        received.pop_front();
+        return byte;
+    }
+    size_t readReceivedBytes(std::span<uint8_t> bytes) override {
+        read_call_count++;
+        size_t i = 0;
+        for (; i < bytes.size() && !received.empty(); i++) bytes[i] = readReceivedByte();
+        return i;
+    }
+    uint64_t getRxOverflowCount() override { return rx_overflow_count; }
+
+    // Doesn't sleep, only records how long it was asked to
+    bool waitForReceivedBytes(uint64_t timeout_us) override {
+        wait_timeouts_us.push_back(timeout_us);
+        return !received.empty();
+    }
+
+    // Without a sequence number the master takes the response for the oldest request in flight
+    void queueResponse(ResponseCode code, std::vector<uint8_t> payload = {}, Framing framing = Framing::none,
+                       uint8_t sequence_number = K_NO_SEQUENCE_NUMBER) {
+        uint8_t        buffer[ResponsePacket::K_PACKET_MAX_SIZE];
+        ResponsePacket response(static_cast<uint8_t>(code), payload, sequence_number);
+        queue(serializeResponse(response, buffer), framing);
+    }
+
+    void queueRequest(uint8_t receiver_id, uint8_t operation_code, std::vector<uint8_t> payload = {},
+                      Framing framing = Framing::none) {
+        uint8_t       buffer[RequestPacket::K_PACKET_MAX_SIZE];
+        RequestPacket request(receiver_id, operation_code, payload);
+        queue(serializeRequest(request, buffer), framing);
+    }
+
+    void queue(std::span<const uint8_t> packet_bytes, Framing framing) {
+        uint8_t frame_buffer[cobsFrameMaxSize(ResponsePacket::K_PACKET_MAX_SIZE)];
+        if (framing == Framing::cobs) packet_bytes = encodeCobsFrame(packet_bytes, frame_buffer);
+        received.insert(received.end(), packet_bytes.begin(), packet_bytes.end());
+    }
+
+    std::vector<uint8_t>  transmitted;
+    std::deque<uint8_t>   received;
+    uint64_t              rx_overflow_count = 0;
+    size_t                read_call_count   = 0;
+    std::vector<uint64_t> wait_timeouts_us;
+};
+
+class FakeClock final : public drivers::interfaces::ClockInterface {
+public:
+    uint64_t uptimeMicroseconds() override { return now_us; }
+    uint64_t uptimeMilliseconds() override { return now_us / 1'000; }
+    uint64_t uptimeSeconds() override { return now_us / 1'000'000; }
+
+    uint64_t now_us = 0;
+};
+
+struct ByteRequest : commands::RequestBase {
+    uint8_t value = 0;
+
+    ParsingError deserialize(std::span<uint8_t> bytes) {
+        if (bytes.empty()) return ParsingError::payload_missing_bytes;
+        value = bytes[0];
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        target_buffer[0] = value;
+        return target_buffer.subspan(0, 1);
+    }
+};
+
+struct ByteResponse : commands::ResponseBase {
+    uint8_t value = 0;
+
+    ParsingError deserialize(std::span<uint8_t> bytes) {
+        if (bytes.empty()) return ParsingError::payload_missing_bytes;
+        value = bytes[0];
+        return ParsingError::no_error;
+    }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) {
+        target_buffer[0] = value;
+        return target_buffer.subspan(0, 1);
+    }
+};
+
+using EchoCommand = commands::Command<ByteRequest, ByteResponse, 0x10>;
+
+// Splits a COBS framed byte stream into the decoded frames
+inline std::vector<std::vector<uint8_t>> decodeCobsFrames(const std::vector<uint8_t>& bytes) {
+    std::vector<std::vector<uint8_t>> frames(1);
+    CobsDecoder                       decoder;
+    for (const uint8_t byte : bytes) {
+        uint8_t decoded_byte = 0;
+        switch (decoder.decode(byte, decoded_byte)) {
+            case CobsDecoder::Result::data_byte:
+                frames.back().push_back(decoded_byte);
+                break;
+            case CobsDecoder::Result::frame_ended:
+                frames.emplace_back();
+                break;
+            case CobsDecoder::Result::no_data:
+                break;
+        }
+    }
+    frames.pop_back();  // Not ended by a delimiter
+    return frames;
+}
+
+}  // namespace serial_communication_framework::test
+
+#endif  // COMMON_LIBS_SERIAL_COMMUNICATION_FRAMEWORK_TEST_FAKES_H
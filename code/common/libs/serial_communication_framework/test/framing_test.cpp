@@ -0,0 +1,218 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/SlaveHandler.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID = 3;
+
+ByteResponse increment(const ByteRequest& request) {
+    ByteResponse response;
+    response.value         = request.value + 1;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+struct ReceivedResponses {
+    std::multiset<uint8_t> ok_values;
+    size_t                 corrupted = 0;
+};
+
+ReceivedResponses parseFramedResponses(const std::vector<uint8_t>& bytes) {
+    ReceivedResponses responses;
+    for (std::vector<uint8_t>& frame : decodeCobsFrames(bytes)) {
+        ResponsePacket packet = deSerializeResponse(frame);
+        EXPECT_TRUE(responsePayloadHasValidCrc(packet));
+        if (packet.header.response_code == static_cast<uint8_t>(ResponseCode::ok)) {
+            responses.ok_values.insert(packet.payload[0]);
+        } else {
+            EXPECT_EQ(packet.header.response_code, static_cast<uint8_t>(ResponseCode::corrupted));
+            responses.corrupted++;
+        }
+    }
+    return responses;
+}
+
+struct LossyStream {
+    std::vector<uint8_t> bytes;
+    std::vector<size_t>  frame_ends;  // Index one past every frame's delimiter in the original stream
+    std::vector<size_t>  dropped;     // Indexes of the dropped bytes in the original stream
+};
+
+// Requests carrying their index, with payloads of random length so that drops hit all parts of the packets
+LossyStream makeLossyRequestStream(std::mt19937& random, size_t request_count, size_t drop_one_in, Framing framing) {
+    FakeSerial  sender;
+    LossyStream stream;
+    for (size_t i = 0; i < request_count; i++) {
+        std::vector<uint8_t> payload(1 + random() % 40);
+        for (uint8_t& byte : payload) byte = static_cast<uint8_t>(random());
+        payload[0] = static_cast<uint8_t>(i);
+
+        sender.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, payload, framing);
+        stream.frame_ends.push_back(sender.received.size());
+    }
+
+    for (size_t i = 0; i < sender.received.size(); i++) {
+        if (random() % drop_one_in == 0) {
+            stream.dropped.push_back(i);
+        } else {
+            stream.bytes.push_back(sender.received[i]);
+        }
+    }
+    return stream;
+}
+
+// Feeds the stream in chunks of random size, the way the bytes would come in between the run() calls
+ReceivedResponses feedToSlave(std::mt19937& random, const LossyStream& stream, Framing framing) {
+    FakeSerial   serial;
+    FakeClock    clock;
+    SlaveHandler slave(serial, clock, K_DEVICE_ID);
+    slave.registerCommandHandler<EchoCommand, increment>();
+    slave.setFraming(framing);
+
+    size_t index = 0;
+    while (index < stream.bytes.size()) {
+        const size_t count = std::min<size_t>(1 + random() % 32, stream.bytes.size() - index);
+        serial.received.insert(serial.received.end(), &stream.bytes[index], &stream.bytes[index] + count);
+        index += count;
+        slave.run();
+    }
+
+    if (framing == Framing::none) {
+        ReceivedResponses responses;
+        FakeSerial        response_stream;
+        response_stream.received.assign(serial.transmitted.begin(), serial.transmitted.end());
+        // Without framing the responses are well formed, only the requests were damaged
+        while (!response_stream.received.empty()) {
+            uint8_t buffer[ResponsePacket::K_PACKET_MAX_SIZE];
+            size_t  size = 0;
+            for (; size < ResponsePacket::K_HEADER_SIZE; size++) buffer[size] = response_stream.readReceivedByte();
+            const size_t packet_size =
+                ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + buffer[ResponsePacket::K_PAYLOAD_SIZE_INDEX];
+            for (; size < packet_size; size++) buffer[size] = response_stream.readReceivedByte();
+
+            ResponsePacket packet = deSerializeResponse(std::span<uint8_t>(buffer, size));
+            if (packet.header.response_code == static_cast<uint8_t>(ResponseCode::ok)) {
+                responses.ok_values.insert(packet.payload[0]);
+            } else {
+                responses.corrupted++;
+            }
+        }
+        return responses;
+    }
+
+    EXPECT_EQ(slave.getCommunicationStatistics().resynchronizations > 0, !stream.dropped.empty());
+    return parseFramedResponses(serial.transmitted);
+}
+
+}  // namespace
+
+TEST(Framing, slave_recovers_at_the_next_frame_after_random_byte_drops) {
+    std::mt19937      random(12345);
+    const LossyStream stream = makeLossyRequestStream(random, 250, 300, Framing::cobs);
+    ASSERT_GT(stream.dropped.size(), 10u);
+
+    // A drop damages the frame it hits. A dropped delimiter leaves its packet whole but merges the next frame into it
+    std::set<size_t> damaged_frames;
+    size_t           max_recovery_bytes = 0;
+    for (const size_t dropped_index : stream.dropped) {
+        size_t frame = std::upper_bound(stream.frame_ends.begin(), stream.frame_ends.end(), dropped_index) -
+                       stream.frame_ends.begin();
+        if (dropped_index == stream.frame_ends[frame] - 1) frame++;
+        if (frame == stream.frame_ends.size()) continue;
+
+        damaged_frames.insert(frame);
+        max_recovery_bytes = std::max(max_recovery_bytes, stream.frame_ends[frame] - dropped_index);
+    }
+
+    const ReceivedResponses responses = feedToSlave(random, stream, Framing::cobs);
+
+    // Every request in an undamaged frame is answered, never one from a damaged frame
+    for (size_t i = 0; i < stream.frame_ends.size(); i++) {
+        const auto answered = responses.ok_values.count(static_cast<uint8_t>(i + 1));
+        EXPECT_EQ(answered, damaged_frames.contains(i) ? 0u : 1u) << "request " << i;
+    }
+    // Every damaged frame is answered as corrupted, except one merged into an already broken frame
+    EXPECT_LE(responses.corrupted, damaged_frames.size());
+    EXPECT_GE(responses.corrupted, damaged_frames.size() / 2);
+
+    // Nothing past the damaged frame, or the one behind a lost delimiter, is lost
+    constexpr size_t K_MAX_FRAME_SIZE = cobsFrameMaxSize(RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 40);
+    EXPECT_LE(max_recovery_bytes, K_MAX_FRAME_SIZE + 1);
+    RecordProperty("dropped_bytes", static_cast<int>(stream.dropped.size()));
+    RecordProperty("lost_requests", static_cast<int>(damaged_frames.size()));
+    RecordProperty("max_recovery_bytes", static_cast<int>(max_recovery_bytes));
+}
+
+TEST(Framing, framing_keeps_more_requests_alive_than_header_only_parsing) {
+    std::mt19937      random(777);
+    const LossyStream framed   = makeLossyRequestStream(random, 250, 300, Framing::cobs);
+    random.seed(777);
+    const LossyStream unframed = makeLossyRequestStream(random, 250, 300, Framing::none);
+
+    const size_t framed_answered   = feedToSlave(random, framed, Framing::cobs).ok_values.size();
+    const size_t unframed_answered = feedToSlave(random, unframed, Framing::none).ok_values.size();
+
+    EXPECT_GT(framed_answered, unframed_answered);
+    RecordProperty("answered_with_framing", static_cast<int>(framed_answered));
+    RecordProperty("answered_without_framing", static_cast<int>(unframed_answered));
+}
+
+TEST(Framing, lost_delimiter_answers_both_merged_requests) {
+    FakeSerial   serial;
+    FakeClock    clock;
+    SlaveHandler slave(serial, clock, K_DEVICE_ID);
+    slave.registerCommandHandler<EchoCommand, increment>();
+    slave.setFraming(Framing::cobs);
+
+    serial.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {10}, Framing::cobs);
+    serial.received.pop_back();
+    serial.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {20}, Framing::cobs);
+    serial.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {30}, Framing::cobs);
+
+    slave.run();
+
+    // The master matches the responses by their order, so the skipped request must be answered too
+    const ReceivedResponses responses = parseFramedResponses(serial.transmitted);
+    EXPECT_EQ(responses.ok_values, (std::multiset<uint8_t>{11, 31}));
+    EXPECT_EQ(responses.corrupted, 1u);
+    EXPECT_EQ(slave.getCommunicationStatistics().resynchronizations, 1u);
+}
+
+TEST(Framing, master_fails_only_the_response_in_a_broken_frame) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    master.setFraming(Framing::cobs);
+
+    std::vector<ResponseCode> codes;
+    auto                      on_done = +[](const ByteResponse& response, void* user_data) {
+        static_cast<std::vector<ResponseCode>*>(user_data)->push_back(response.response_code);
+    };
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, {}, on_done, &codes));
+    }
+    EXPECT_EQ(decodeCobsFrames(serial.transmitted).size(), 3u);
+
+    serial.queueResponse(ResponseCode::ok, {1}, Framing::cobs);
+    const size_t second_frame_start = serial.received.size();
+    serial.queueResponse(ResponseCode::ok, {2}, Framing::cobs);
+    // The payload size, behind the COBS code bytes of the zero response code and sequence number
+    serial.received[second_frame_start + 3] ^= 0x40;
+    serial.queueResponse(ResponseCode::ok, {3}, Framing::cobs);
+
+    while (master.getInFlightCommandCount() > 0) master.run();
+
+    EXPECT_EQ(codes, (std::vector{ResponseCode::ok, ResponseCode::corrupted, ResponseCode::ok}));
+    EXPECT_EQ(master.getStatistics().resynchronizations, 1u);
+}
@@ -0,0 +1,391 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+// The payloads carry no vtable, only their own fields
+static_assert(commands::CommandType<EchoCommand>);
+static_assert(sizeof(ByteRequest) == sizeof(uint8_t));
+
+struct VirtualRequest : commands::RequestBase {
+    virtual ~VirtualRequest() = default;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes) { return ParsingError::no_error; }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) { return target_buffer.subspan(0, 0); }
+};
+static_assert(!commands::RequestType<VirtualRequest>);
+
+struct CompletionLog {
+    std::vector<ResponseCode> codes;
+    std::vector<uint8_t>      values;
+};
+
+void logCompletion(const ByteResponse& response, void* user_data) {
+    auto* log = static_cast<CompletionLog*>(user_data);
+    log->codes.push_back(response.response_code);
+    log->values.push_back(response.value);
+}
+
+struct UnsolicitedFrameLog {
+    std::vector<uint8_t>              stream_ids;
+    std::vector<uint8_t>              sender_ids;
+    std::vector<std::vector<uint8_t>> payloads;
+};
+
+void logUnsolicitedFrame(uint8_t stream_id, uint8_t sender_id, std::span<uint8_t> payload, void* user_data) {
+    auto* log = static_cast<UnsolicitedFrameLog*>(user_data);
+    log->stream_ids.push_back(stream_id);
+    log->sender_ids.push_back(sender_id);
+    log->payloads.emplace_back(payload.begin(), payload.end());
+}
+
+ByteRequest makeRequest(uint8_t value) {
+    ByteRequest request;
+    request.value = value;
+    return request;
+}
+
+// The sequence numbers of the echo requests the master has transmitted, in the order they were sent
+std::vector<uint8_t> transmittedSequenceNumbers(FakeSerial& serial) {
+    const size_t         request_size = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+    std::span<uint8_t>   requests(serial.transmitted);
+    std::vector<uint8_t> sequence_numbers;
+    for (size_t offset = 0; offset + request_size <= requests.size(); offset += request_size) {
+        sequence_numbers.push_back(deSerializeRequest(requests.subspan(offset, request_size)).header.sequence_number);
+    }
+    return sequence_numbers;
+}
+
+}  // namespace
+
+TEST(MasterHandlerAsync, requests_are_transmitted_without_waiting_for_responses) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    for (uint8_t i = 0; i < K_MAX_IN_FLIGHT_REQUESTS; i++) {
+        ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(i), logCompletion, &log));
+    }
+
+    // Every request is on the wire before a single response has arrived
+    const size_t request_size = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+    EXPECT_EQ(serial.transmitted.size(), request_size * K_MAX_IN_FLIGHT_REQUESTS);
+    EXPECT_EQ(master.getInFlightCommandCount(), K_MAX_IN_FLIGHT_REQUESTS);
+    EXPECT_TRUE(log.codes.empty());
+}
+
+TEST(MasterHandlerAsync, submitting_fails_when_pipeline_is_full) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    for (uint8_t i = 0; i < K_MAX_IN_FLIGHT_REQUESTS; i++) {
+        ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(i), logCompletion, &log));
+    }
+    EXPECT_FALSE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+}
+
+TEST(MasterHandlerAsync, responses_complete_requests_in_submission_order) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(i), logCompletion, &log));
+    }
+    serial.queueResponse(ResponseCode::ok, {10});
+    serial.queueResponse(ResponseCode::invalid_id);
+    serial.queueResponse(ResponseCode::ok, {12});
+
+    while (master.getInFlightCommandCount() > 0) master.run();
+
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok, ResponseCode::invalid_id, ResponseCode::ok}));
+    EXPECT_EQ(log.values[0], 10);
+    EXPECT_EQ(log.values[2], 12);
+}
+
+TEST(MasterHandlerAsync, a_response_lost_in_the_middle_of_the_pipeline_fails_only_its_request) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(i), logCompletion, &log));
+    }
+    const std::vector<uint8_t> sequence_numbers = transmittedSequenceNumbers(serial);
+
+    // The slave dropped the response to the second request, e.g. because it was too late
+    serial.queueResponse(ResponseCode::ok, {10}, Framing::none, sequence_numbers[0]);
+    serial.queueResponse(ResponseCode::ok, {12}, Framing::none, sequence_numbers[2]);
+    while (!serial.received.empty()) master.run();
+
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok, ResponseCode::timed_out, ResponseCode::ok}));
+    EXPECT_EQ(log.values[0], 10);
+    EXPECT_EQ(log.values[2], 12);
+    EXPECT_EQ(master.getInFlightCommandCount(), 0);
+    EXPECT_EQ(master.getStatistics().timed_out_packets, 1);
+}
+
+TEST(MasterHandlerAsync, responses_of_different_receivers_complete_their_own_requests) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(1), logCompletion, &log));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(2, makeRequest(2), logCompletion, &log));
+    const std::vector<uint8_t> sequence_numbers = transmittedSequenceNumbers(serial);
+
+    // The second device answers first, the first one's request is still being handled
+    serial.queueResponse(ResponseCode::ok, {2}, Framing::none, sequence_numbers[1]);
+    master.run();
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{2}));
+    EXPECT_EQ(master.getInFlightCommandCount(), 1);
+
+    serial.queueResponse(ResponseCode::ok, {1}, Framing::none, sequence_numbers[0]);
+    master.run();
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok, ResponseCode::ok}));
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{2, 1}));
+}
+
+TEST(MasterHandlerAsync, a_response_to_no_request_in_flight_is_dropped) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    const uint8_t sequence_number = transmittedSequenceNumbers(serial)[0];
+
+    // E.g. a late response to a request that has already timed out
+    serial.queueResponse(ResponseCode::ok, {9}, Framing::none, static_cast<uint8_t>(sequence_number + 1));
+    master.run();
+    EXPECT_TRUE(log.codes.empty());
+    EXPECT_EQ(master.getInFlightCommandCount(), 1);
+    EXPECT_EQ(master.getStatistics().unmatched_responses, 1);
+
+    serial.queueResponse(ResponseCode::ok, {1}, Framing::none, sequence_number);
+    master.run();
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{1}));
+}
+
+TEST(MasterHandlerAsync, only_oldest_request_times_out) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(1), logCompletion, &log));
+
+    const size_t request_size = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+    clock.now_us += masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, request_size, handlerTimeoutUs<EchoCommand>()) + 1;
+    master.run();
+    ASSERT_EQ(log.codes, (std::vector{ResponseCode::timed_out}));
+
+    // The timeout of the second request starts only after the first one has completed
+    serial.queueResponse(ResponseCode::ok, {7});
+    master.run();
+    ASSERT_EQ(log.codes, (std::vector{ResponseCode::timed_out, ResponseCode::ok}));
+    EXPECT_EQ(log.values[1], 7);
+    EXPECT_EQ(master.getStatistics().timed_out_packets, 1);
+}
+
+TEST(MasterHandlerAsync, corrupted_header_fails_every_in_flight_request) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(1), logCompletion, &log));
+
+    serial.queueResponse(ResponseCode::ok, {1});
+    serial.received[ResponsePacket::K_HEADER_CRC_INDEX] ^= 0xFF;
+    serial.queueResponse(ResponseCode::ok, {2});
+    master.run();
+
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::corrupted, ResponseCode::corrupted}));
+    EXPECT_EQ(master.getInFlightCommandCount(), 0);
+    EXPECT_TRUE(serial.received.empty());
+}
+
+TEST(MasterHandlerAsync, blocking_command_waits_for_previously_submitted_commands) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    serial.queueResponse(ResponseCode::ok, {1});
+    serial.queueResponse(ResponseCode::ok, {2});
+
+    ByteResponse response = master.sendCommandAndReceiveResponseBlocking<EchoCommand>(1, makeRequest(1));
+
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{1}));
+    EXPECT_EQ(response.response_code, ResponseCode::ok);
+    EXPECT_EQ(response.value, 2);
+}
+
+TEST(MasterHandlerUnsolicited, frames_between_responses_are_separated_from_responses) {
+    FakeSerial          serial;
+    FakeClock           clock;
+    MasterHandler       master(serial, clock);
+    CompletionLog       log;
+    UnsolicitedFrameLog frames;
+    master.setUnsolicitedFrameCallback(logUnsolicitedFrame, &frames);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(1), logCompletion, &log));
+
+    serial.queueResponse(ResponseCode::unsolicited_frame, {3, 1, 0xAA, 0xBB});
+    serial.queueResponse(ResponseCode::ok, {1});
+    serial.queueResponse(ResponseCode::unsolicited_frame, {3, 2, 0xCC});
+    serial.queueResponse(ResponseCode::ok, {2});
+
+    while (!serial.received.empty()) master.run();
+
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok, ResponseCode::ok}));
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{1, 2}));
+    EXPECT_EQ(frames.stream_ids, (std::vector<uint8_t>{3, 3}));
+    EXPECT_EQ(frames.sender_ids, (std::vector<uint8_t>{1, 2}));
+    EXPECT_EQ(frames.payloads[0], (std::vector<uint8_t>{0xAA, 0xBB}));
+    EXPECT_EQ(frames.payloads[1], (std::vector<uint8_t>{0xCC}));
+    EXPECT_EQ(master.getStatistics().unsolicited_frames_received, 2);
+}
+
+TEST(MasterHandlerUnsolicited, frames_are_received_while_nothing_is_in_flight) {
+    FakeSerial          serial;
+    FakeClock           clock;
+    MasterHandler       master(serial, clock);
+    UnsolicitedFrameLog frames;
+    master.setUnsolicitedFrameCallback(logUnsolicitedFrame, &frames);
+
+    serial.queueResponse(ResponseCode::unsolicited_frame, {1, 1, 0x10});
+    serial.queueResponse(ResponseCode::ok, {5});  // Stray response, nothing is waiting for it
+    serial.queueResponse(ResponseCode::unsolicited_frame, {1, 1, 0x11});
+
+    while (!serial.received.empty()) master.run();
+
+    ASSERT_EQ(frames.payloads.size(), 2);
+    EXPECT_EQ(frames.payloads[0], (std::vector<uint8_t>{0x10}));
+    EXPECT_EQ(frames.payloads[1], (std::vector<uint8_t>{0x11}));
+}
+
+TEST(MasterHandlerUnsolicited, corrupted_frame_does_not_complete_in_flight_request) {
+    FakeSerial          serial;
+    FakeClock           clock;
+    MasterHandler       master(serial, clock);
+    CompletionLog       log;
+    UnsolicitedFrameLog frames;
+    master.setUnsolicitedFrameCallback(logUnsolicitedFrame, &frames);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+
+    serial.queueResponse(ResponseCode::unsolicited_frame, {1, 1, 0x10});
+    serial.received.back() ^= 0xFF;  // payload corrupted
+    serial.queueResponse(ResponseCode::ok, {9});
+
+    while (!serial.received.empty()) master.run();
+
+    EXPECT_TRUE(frames.payloads.empty());
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok}));
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{9}));
+}
+
+TEST(MasterHandlerUnsolicited, partial_bytes_are_dropped_after_timeout_when_idle) {
+    FakeSerial          serial;
+    FakeClock           clock;
+    MasterHandler       master(serial, clock);
+    UnsolicitedFrameLog frames;
+    master.setUnsolicitedFrameCallback(logUnsolicitedFrame, &frames);
+
+    // Beginning of a frame whose end never arrives
+    serial.queueResponse(ResponseCode::unsolicited_frame, {1, 1, 0x10, 0x11});
+    serial.received.resize(4);
+    master.run();
+
+    clock.now_us += masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, 0, 0) + 1;
+    master.run();
+
+    serial.queueResponse(ResponseCode::unsolicited_frame, {1, 1, 0x20});
+    while (!serial.received.empty()) master.run();
+
+    ASSERT_EQ(frames.payloads.size(), 1);
+    EXPECT_EQ(frames.payloads[0], (std::vector<uint8_t>{0x20}));
+}
+
+TEST(MasterHandlerWait, sleeps_until_the_oldest_request_times_out) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), nullptr, nullptr));
+    const size_t   request_size = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+    const uint64_t timeout_us =
+        masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, request_size, handlerTimeoutUs<EchoCommand>());
+
+    master.waitForResponse();
+    clock.now_us += 100;
+    master.waitForResponse();
+    clock.now_us += timeout_us;
+    master.waitForResponse();
+
+    EXPECT_EQ(serial.wait_timeouts_us, (std::vector<uint64_t>{timeout_us + 1, timeout_us - 99, 0}));
+}
+
+TEST(MasterHandlerWait, does_not_sleep_while_nothing_is_in_flight) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+
+    master.waitForResponse();
+    EXPECT_TRUE(serial.wait_timeouts_us.empty());
+}
+
+TEST(MasterHandlerWait, does_not_sleep_over_a_response_that_was_read_with_the_previous_one) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+    master.setFraming(Framing::cobs);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(0), logCompletion, &log));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(1, makeRequest(1), logCompletion, &log));
+    serial.queueResponse(ResponseCode::ok, {1}, Framing::cobs);
+    serial.queueResponse(ResponseCode::ok, {2}, Framing::cobs);
+
+    master.run();
+    ASSERT_EQ(log.values, (std::vector<uint8_t>{1}));
+    ASSERT_TRUE(serial.received.empty());
+
+    master.waitForResponse();
+    EXPECT_TRUE(serial.wait_timeouts_us.empty());
+    master.run();
+    EXPECT_EQ(log.values, (std::vector<uint8_t>{1, 2}));
+}
+
+TEST(MasterHandlerWait, receives_a_response_with_a_read_for_the_header_and_one_for_the_payload) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    serial.queueResponse(ResponseCode::ok, {5});
+
+    const ByteResponse response = master.sendCommandAndReceiveResponseBlocking<EchoCommand>(1, makeRequest(5));
+
+    EXPECT_EQ(response.value, 5);
+    EXPECT_EQ(serial.read_call_count, 2u);
+}
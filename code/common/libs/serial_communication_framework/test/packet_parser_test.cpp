@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "serial_communication_framework/PacketParser.h"
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+namespace {
+
+std::vector<uint8_t> makeRequestBytes(uint8_t receiver_id, uint8_t operation_code, std::vector<uint8_t> payload) {
+    uint8_t       buffer[RequestPacket::K_PACKET_MAX_SIZE];
+    RequestPacket request(receiver_id, operation_code, payload);
+    auto          serialized = serializeRequest(request, buffer);
+    return {serialized.begin(), serialized.end()};
+}
+
+// Feeds the bytes to the parser at most chunk_size bytes at a time, like a serial driver would hand them over
+std::vector<ParseResult> feed(PacketParser<RequestPacket>& parser, const std::vector<uint8_t>& bytes,
+                              size_t chunk_size) {
+    std::vector<ParseResult> results;
+    size_t                   index = 0;
+    while (index < bytes.size()) {
+        std::span<uint8_t> receive_buffer = parser.getReceiveBuffer();
+        const size_t       count          = std::min({receive_buffer.size(), chunk_size, bytes.size() - index});
+        std::copy_n(&bytes[index], count, receive_buffer.begin());
+        index += count;
+
+        const ParseResult result = parser.commitReceivedBytes(count);
+        if (result != ParseResult::incomplete) {
+            results.push_back(result);
+            parser.reset();
+        }
+    }
+    return results;
+}
+
+}  // namespace
+
+TEST(PacketParser, parses_packets_with_any_chunk_size) {
+    std::vector<uint8_t> payload(100);
+    for (size_t i = 0; i < payload.size(); i++) payload[i] = static_cast<uint8_t>(i * 7);
+    const std::vector<uint8_t> bytes = makeRequestBytes(3, 0x21, payload);
+
+    for (size_t chunk_size = 1; chunk_size <= bytes.size(); chunk_size++) {
+        PacketParser<RequestPacket> parser;
+        ASSERT_EQ(feed(parser, bytes, chunk_size), std::vector{ParseResult::packet_complete}) << chunk_size;
+    }
+}
+
+TEST(PacketParser, receive_buffer_never_reaches_the_next_packet) {
+    std::vector<uint8_t> bytes        = makeRequestBytes(1, 0x10, {1, 2, 3});
+    std::vector<uint8_t> second       = makeRequestBytes(1, 0x11, {});
+    std::vector<uint8_t> third        = makeRequestBytes(2, 0x12, std::vector<uint8_t>(255, 0xAB));
+    bytes.insert(bytes.end(), second.begin(), second.end());
+    bytes.insert(bytes.end(), third.begin(), third.end());
+
+    PacketParser<RequestPacket> parser;
+    EXPECT_EQ(feed(parser, bytes, bytes.size()), std::vector<ParseResult>(3, ParseResult::packet_complete));
+}
+
+TEST(PacketParser, finished_packet_can_be_deserialized) {
+    const std::vector<uint8_t>  bytes = makeRequestBytes(9, 0x42, {5, 6});
+    PacketParser<RequestPacket> parser;
+
+    std::span<uint8_t> receive_buffer = parser.getReceiveBuffer();
+    std::copy_n(bytes.begin(), receive_buffer.size(), receive_buffer.begin());
+    size_t index = receive_buffer.size();
+    ASSERT_EQ(parser.commitReceivedBytes(receive_buffer.size()), ParseResult::incomplete);
+
+    receive_buffer = parser.getReceiveBuffer();
+    ASSERT_EQ(receive_buffer.size(), bytes.size() - index);
+    std::copy(bytes.begin() + index, bytes.end(), receive_buffer.begin());
+    ASSERT_EQ(parser.commitReceivedBytes(receive_buffer.size()), ParseResult::packet_complete);
+    EXPECT_TRUE(parser.getReceiveBuffer().empty());
+
+    RequestPacket packet = deSerializeRequest(parser.getPacketBytes());
+    EXPECT_EQ(packet.header.receiver_id, 9);
+    EXPECT_EQ(packet.header.operation_code, 0x42);
+    ASSERT_EQ(packet.payload.size(), 2u);
+    EXPECT_EQ(packet.payload[1], 6);
+}
+
+TEST(PacketParser, detects_corrupted_header_before_the_payload) {
+    std::vector<uint8_t> bytes = makeRequestBytes(1, 0x10, {1, 2, 3});
+    bytes[RequestPacket::K_PAYLOAD_SIZE_INDEX] ^= 0x01;
+
+    PacketParser<RequestPacket> parser;
+    std::span<uint8_t>          receive_buffer = parser.getReceiveBuffer();
+    ASSERT_EQ(receive_buffer.size(), RequestPacket::K_HEADER_SIZE);
+    std::copy_n(bytes.begin(), receive_buffer.size(), receive_buffer.begin());
+    EXPECT_EQ(parser.commitReceivedBytes(receive_buffer.size()), ParseResult::header_corrupted);
+}
+
+TEST(PacketParser, detects_corrupted_payload) {
+    std::vector<uint8_t> bytes = makeRequestBytes(1, 0x10, {1, 2, 3});
+    bytes.back() ^= 0x80;
+
+    for (size_t chunk_size : {1u, 2u, 64u}) {
+        PacketParser<RequestPacket> parser;
+        EXPECT_EQ(feed(parser, bytes, chunk_size), std::vector{ParseResult::payload_corrupted});
+    }
+}
+
+TEST(PacketParser, parses_responses_too) {
+    uint8_t            buffer[ResponsePacket::K_PACKET_MAX_SIZE];
+    ResponsePacket     response(static_cast<uint8_t>(ResponseCode::ok), {});
+    std::span<uint8_t> serialized = serializeResponse(response, buffer);
+
+    PacketParser<ResponsePacket> parser;
+    std::span<uint8_t>           receive_buffer = parser.getReceiveBuffer();
+    ASSERT_EQ(receive_buffer.size(), ResponsePacket::K_HEADER_SIZE);
+    std::copy_n(serialized.begin(), receive_buffer.size(), receive_buffer.begin());
+    ASSERT_EQ(parser.commitReceivedBytes(receive_buffer.size()), ParseResult::incomplete);
+
+    // Only the payload CRC is left of an empty response
+    receive_buffer = parser.getReceiveBuffer();
+    ASSERT_EQ(receive_buffer.size(), 1u);
+    receive_buffer[0] = serialized[ResponsePacket::K_PAYLOAD_CRC_INDEX];
+    EXPECT_EQ(parser.commitReceivedBytes(1), ParseResult::packet_complete);
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/timeouts.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID = 3;
+
+using ReadCommand  = commands::IdempotentCommand<ByteRequest, ByteResponse, 0x20>;
+using WriteCommand = commands::Command<ByteRequest, ByteResponse, 0x21>;
+
+// The handlers are plain functions, so they count into this
+int handled_count = 0;
+
+ByteResponse countedEcho(const ByteRequest& request) {
+    handled_count++;
+
+    ByteResponse response;
+    response.value         = request.value;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+struct CompletionLog {
+    std::vector<ResponseCode> codes;
+    std::vector<uint8_t>      values;
+};
+
+void logCompletion(const ByteResponse& response, void* user_data) {
+    auto* log = static_cast<CompletionLog*>(user_data);
+    log->codes.push_back(response.response_code);
+    log->values.push_back(response.value);
+}
+
+ByteRequest makeRequest(uint8_t value) {
+    ByteRequest request;
+    request.value = value;
+    return request;
+}
+
+void moveBytes(FakeSerial& from, FakeSerial& to) {
+    to.received.insert(to.received.end(), from.transmitted.begin(), from.transmitted.end());
+    from.transmitted.clear();
+}
+
+// The master and the slave with the bytes carried between them by hand, so that any of them can be lost
+class RetryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        handled_count = 0;
+        master_.setRetryPolicy({.max_retries = 2});
+        slave_.registerCommandHandler<ReadCommand, countedEcho>();
+        slave_.registerCommandHandler<WriteCommand, countedEcho>();
+    }
+
+    void handleRequests() {
+        moveBytes(master_serial_, slave_serial_);
+        slave_.run();
+    }
+
+    void receiveResponses() {
+        moveBytes(slave_serial_, master_serial_);
+        master_.run();
+    }
+
+    void timeOut() {
+        clock_.now_us += 1'000'000;
+        master_.run();
+    }
+
+    FakeSerial    master_serial_;
+    FakeSerial    slave_serial_;
+    FakeClock     clock_;
+    MasterHandler master_{master_serial_, clock_};
+    SlaveHandler  slave_{slave_serial_, clock_, K_DEVICE_ID};
+    CompletionLog log_;
+};
+
+}  // namespace
+
+TEST_F(RetryTest, retries_a_read_whose_response_was_lost) {
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(5), logCompletion, &log_));
+    handleRequests();
+    slave_serial_.transmitted.clear();
+
+    timeOut();
+    EXPECT_TRUE(log_.codes.empty());
+    EXPECT_EQ(master_.getStatistics().retransmissions, 1u);
+
+    handleRequests();
+    receiveResponses();
+
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::ok}));
+    EXPECT_EQ(log_.values, std::vector<uint8_t>({5}));
+    EXPECT_EQ(master_.getStatistics().operations[ReadCommand::K_OP_CODE].errors, 0u);
+    EXPECT_EQ(handled_count, 2);
+}
+
+TEST_F(RetryTest, retries_a_corrupted_response_right_away) {
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(5), logCompletion, &log_));
+    handleRequests();
+    slave_serial_.transmitted.back() ^= 0x01;  // The payload CRC
+
+    receiveResponses();
+    EXPECT_EQ(master_.getStatistics().retransmissions, 1u);
+
+    handleRequests();
+    receiveResponses();
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::ok}));
+}
+
+TEST_F(RetryTest, fails_after_the_last_retry) {
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(5), logCompletion, &log_));
+
+    timeOut();
+    timeOut();
+    EXPECT_TRUE(log_.codes.empty());
+    timeOut();
+
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::timed_out}));
+    EXPECT_EQ(master_.getStatistics().retransmissions, 2u);
+    EXPECT_EQ(master_.getStatistics().operations[ReadCommand::K_OP_CODE].errors, 1u);
+    EXPECT_EQ(master_.getInFlightCommandCount(), 0u);
+}
+
+TEST_F(RetryTest, every_retry_waits_longer_for_its_response) {
+    const uint64_t first_timeout_us =
+        masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1,
+                                handlerTimeoutUs<ReadCommand>());
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(5), logCompletion, &log_));
+
+    clock_.now_us = first_timeout_us + 1;
+    master_.run();
+    ASSERT_EQ(master_.getStatistics().retransmissions, 1u);
+
+    const uint64_t retry_start_us = clock_.now_us;
+    clock_.now_us                 = retry_start_us + 2 * first_timeout_us;
+    master_.run();
+    EXPECT_EQ(master_.getStatistics().retransmissions, 1u);
+
+    clock_.now_us = retry_start_us + 2 * first_timeout_us + 1;
+    master_.run();
+    EXPECT_EQ(master_.getStatistics().retransmissions, 2u);
+}
+
+TEST_F(RetryTest, does_not_retry_the_answers_of_the_slave) {
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(5), logCompletion, &log_));
+    master_serial_.queueResponse(ResponseCode::invalid_id);
+    master_.run();
+
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::invalid_id}));
+    EXPECT_EQ(master_.getStatistics().retransmissions, 0u);
+}
+
+TEST_F(RetryTest, a_retried_write_is_handled_only_once) {
+    ASSERT_TRUE(master_.submitCommand<WriteCommand>(K_DEVICE_ID, makeRequest(7), logCompletion, &log_));
+    const std::vector<uint8_t> first_attempt = master_serial_.transmitted;
+    EXPECT_NE(deSerializeRequest(master_serial_.transmitted).header.sequence_number, K_NO_SEQUENCE_NUMBER);
+
+    handleRequests();
+    slave_serial_.transmitted.clear();
+    timeOut();
+    EXPECT_EQ(master_serial_.transmitted, first_attempt);
+
+    handleRequests();
+    receiveResponses();
+
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::ok}));
+    EXPECT_EQ(log_.values, std::vector<uint8_t>({7}));
+    EXPECT_EQ(handled_count, 1);
+    EXPECT_EQ(slave_.getCommunicationStatistics().duplicate_requests, 1u);
+}
+
+TEST_F(RetryTest, a_write_is_not_retried_past_the_requests_sent_after_it) {
+    ASSERT_TRUE(master_.submitCommand<WriteCommand>(K_DEVICE_ID, makeRequest(7), logCompletion, &log_));
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(8), logCompletion, &log_));
+
+    timeOut();
+
+    EXPECT_EQ(log_.codes, std::vector<ResponseCode>({ResponseCode::timed_out}));
+    EXPECT_EQ(master_.getStatistics().retransmissions, 0u);
+    EXPECT_EQ(master_.getInFlightCommandCount(), 1u);
+}
+
+TEST_F(RetryTest, every_request_carries_a_new_sequence_number) {
+    ASSERT_TRUE(master_.submitCommand<ReadCommand>(K_DEVICE_ID, makeRequest(1), logCompletion, &log_));
+    ASSERT_TRUE(master_.submitCommand<WriteCommand>(K_DEVICE_ID, makeRequest(2), logCompletion, &log_));
+    ASSERT_TRUE(master_.submitCommand<WriteCommand>(K_DEVICE_ID, makeRequest(2), logCompletion, &log_));
+
+    const size_t        request_size = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+    std::span<uint8_t>  requests(master_serial_.transmitted);
+    const RequestPacket read         = deSerializeRequest(requests.subspan(0, request_size));
+    const RequestPacket first_write  = deSerializeRequest(requests.subspan(request_size, request_size));
+    const RequestPacket second_write = deSerializeRequest(requests.subspan(2 * request_size, request_size));
+
+    EXPECT_NE(read.header.sequence_number, K_NO_SEQUENCE_NUMBER);
+    EXPECT_NE(read.header.sequence_number, first_write.header.sequence_number);
+    EXPECT_NE(first_write.header.sequence_number, second_write.header.sequence_number);
+
+    // Both writes are handled although they are the same
+    handleRequests();
+    EXPECT_EQ(handled_count, 3);
+}
+
+TEST_F(RetryTest, writes_are_numbered_from_the_clock_at_the_first_write) {
+    // The master was constructed at 0, the clock must not be read before the first write
+    clock_.now_us = 0x1234;
+    ASSERT_TRUE(master_.submitCommand<WriteCommand>(K_DEVICE_ID, makeRequest(1), logCompletion, &log_));
+
+    EXPECT_EQ(deSerializeRequest(master_serial_.transmitted).header.sequence_number, 0x34);
+}
+
+TEST_F(RetryTest, slave_handles_requests_without_a_sequence_number_every_time) {
+    for (int i = 0; i < 2; i++) slave_serial_.queueRequest(K_DEVICE_ID, WriteCommand::K_OP_CODE, {1});
+    slave_.run();
+
+    EXPECT_EQ(handled_count, 2);
+    EXPECT_EQ(slave_.getCommunicationStatistics().duplicate_requests, 0u);
+}
+
+TEST_F(RetryTest, slave_handles_a_repeated_read_again) {
+    for (int i = 0; i < 2; i++) {
+        std::vector<uint8_t> payload = {1};
+        uint8_t              buffer[RequestPacket::K_PACKET_MAX_SIZE];
+        RequestPacket        request(K_DEVICE_ID, ReadCommand::K_OP_CODE, payload, 9);
+        slave_serial_.queue(serializeRequest(request, buffer), Framing::none);
+    }
+    slave_.run();
+
+    EXPECT_EQ(handled_count, 2);
+    EXPECT_EQ(slave_.getCommunicationStatistics().duplicate_requests, 0u);
+}
+
+TEST_F(RetryTest, slave_tells_a_repeated_sequence_number_with_another_payload_from_a_retry) {
+    for (uint8_t value : {1, 2}) {
+        std::vector<uint8_t> payload = {value};
+        uint8_t              buffer[RequestPacket::K_PACKET_MAX_SIZE];
+        RequestPacket        request(K_DEVICE_ID, WriteCommand::K_OP_CODE, payload, 9);
+        slave_serial_.queue(serializeRequest(request, buffer), Framing::none);
+    }
+    slave_.run();
+
+    EXPECT_EQ(handled_count, 2);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "serial_communication_framework/common.h"
+#include "serial_communication_framework/serialize_deserialize.h"
+
+using namespace serial_communication_framework;
+
+TEST(SerializeDeserialize, request_finalized_in_place_matches_copied_request) {
+    std::vector<uint8_t> payload = {1, 2, 3, 4, 5};
+
+    uint8_t            copied_buffer[RequestPacket::K_PACKET_MAX_SIZE] = {};
+    RequestPacket      request(7, 0x21, payload, 9);
+    std::span<uint8_t> copied = serializeRequest(request, copied_buffer);
+
+    uint8_t                  in_place_buffer[RequestPacket::K_PACKET_MAX_SIZE] = {};
+    const std::span<uint8_t> payload_buffer = getRequestPayloadBuffer(in_place_buffer);
+    ASSERT_EQ(payload_buffer.size_bytes(), RequestPacket::K_PAYLOAD_MAX_SIZE);
+    std::copy(payload.begin(), payload.end(), payload_buffer.begin());
+    std::span<uint8_t> in_place = finalizeRequestInPlace(7, 0x21, 9, payload.size(), in_place_buffer);
+
+    ASSERT_EQ(in_place.size_bytes(), copied.size_bytes());
+    EXPECT_TRUE(std::equal(in_place.begin(), in_place.end(), copied.begin()));
+
+    RequestPacket parsed = deSerializeRequest(in_place);
+    EXPECT_TRUE(requestPayloadHasValidCrc(parsed));
+    EXPECT_EQ(parsed.header.receiver_id, 7);
+    EXPECT_EQ(parsed.header.operation_code, 0x21);
+    EXPECT_EQ(parsed.header.sequence_number, 9);
+    // The parsed payload is a view into the packet, not a copy
+    EXPECT_EQ(parsed.payload.data(), payload_buffer.data());
+}
+
+TEST(SerializeDeserialize, response_finalized_in_place_matches_copied_response) {
+    std::vector<uint8_t> payload(ResponsePacket::K_PAYLOAD_MAX_SIZE, 0xA5);
+
+    uint8_t            copied_buffer[ResponsePacket::K_PACKET_MAX_SIZE] = {};
+    ResponsePacket     response(static_cast<uint8_t>(ResponseCode::ok), payload, 9);
+    std::span<uint8_t> copied = serializeResponse(response, copied_buffer);
+
+    uint8_t                  in_place_buffer[ResponsePacket::K_PACKET_MAX_SIZE] = {};
+    const std::span<uint8_t> payload_buffer = getResponsePayloadBuffer(in_place_buffer);
+    ASSERT_EQ(payload_buffer.size_bytes(), ResponsePacket::K_PAYLOAD_MAX_SIZE);
+    std::copy(payload.begin(), payload.end(), payload_buffer.begin());
+    std::span<uint8_t> in_place =
+        finalizeResponseInPlace(static_cast<uint8_t>(ResponseCode::ok), 9, payload.size(), in_place_buffer);
+
+    ASSERT_EQ(in_place.size_bytes(), copied.size_bytes());
+    EXPECT_TRUE(std::equal(in_place.begin(), in_place.end(), copied.begin()));
+
+    ResponsePacket parsed = deSerializeResponse(in_place);
+    EXPECT_TRUE(responsePayloadHasValidCrc(parsed));
+    EXPECT_EQ(parsed.header.sequence_number, 9);
+}
+
+TEST(SerializeDeserialize, serializing_a_payload_that_is_already_in_place_keeps_it) {
+    uint8_t                  buffer[ResponsePacket::K_PACKET_MAX_SIZE] = {};
+    const std::span<uint8_t> payload_buffer                            = getResponsePayloadBuffer(buffer);
+    payload_buffer[0]                                                  = 42;
+    payload_buffer[1]                                                  = 43;
+
+    ResponsePacket     response(static_cast<uint8_t>(ResponseCode::ok), payload_buffer.first(2));
+    std::span<uint8_t> serialized = serializeResponse(response, buffer);
+
+    ResponsePacket parsed = deSerializeResponse(serialized);
+    EXPECT_TRUE(responsePayloadHasValidCrc(parsed));
+    ASSERT_EQ(parsed.payload.size_bytes(), 2u);
+    EXPECT_EQ(parsed.payload[0], 42);
+    EXPECT_EQ(parsed.payload[1], 43);
+}
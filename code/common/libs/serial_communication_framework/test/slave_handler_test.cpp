@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/PacketParser.h"
+#include "serial_communication_framework/SlaveHandler.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID = 3;
+
+ByteResponse increment(const ByteRequest& request) {
+    ByteResponse response;
+    response.value         = request.value + 1;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+struct ParsedResponse {
+    ResponseCode         code;
+    std::vector<uint8_t> payload;
+};
+
+std::vector<ParsedResponse> parseResponses(const std::vector<uint8_t>& bytes) {
+    std::vector<ParsedResponse>  responses;
+    PacketParser<ResponsePacket> parser;
+    size_t                       index = 0;
+    while (index < bytes.size()) {
+        std::span<uint8_t> receive_buffer = parser.getReceiveBuffer();
+        const size_t       count          = std::min(receive_buffer.size(), bytes.size() - index);
+        std::copy_n(&bytes[index], count, receive_buffer.begin());
+        index += count;
+
+        const ParseResult result = parser.commitReceivedBytes(count);
+        if (result == ParseResult::incomplete) continue;
+        EXPECT_EQ(result, ParseResult::packet_complete);
+
+        ResponsePacket packet = deSerializeResponse(parser.getPacketBytes());
+        responses.push_back(
+            {static_cast<ResponseCode>(packet.header.response_code), {packet.payload.begin(), packet.payload.end()}});
+        parser.reset();
+    }
+    return responses;
+}
+
+class SlaveHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override { slave_.registerCommandHandler<EchoCommand, increment>(); }
+
+    FakeSerial   serial_;
+    FakeClock    clock_;
+    SlaveHandler slave_{serial_, clock_, K_DEVICE_ID};
+};
+
+}  // namespace
+
+TEST_F(SlaveHandlerTest, back_to_back_requests_are_handled_in_one_run) {
+    for (uint8_t i = 0; i < 3; i++) {
+        serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {static_cast<uint8_t>(i * 10)});
+    }
+
+    slave_.run();
+
+    const std::vector<ParsedResponse> responses = parseResponses(serial_.transmitted);
+    ASSERT_EQ(responses.size(), 3u);
+    for (uint8_t i = 0; i < 3; i++) {
+        EXPECT_EQ(responses[i].code, ResponseCode::ok);
+        EXPECT_EQ(responses[i].payload, std::vector<uint8_t>{static_cast<uint8_t>(i * 10 + 1)});
+    }
+    EXPECT_TRUE(serial_.received.empty());
+    EXPECT_EQ(slave_.getCommunicationStatistics().valid_packets_received, 3u);
+}
+
+TEST_F(SlaveHandlerTest, request_arriving_in_pieces_is_handled_once_complete) {
+    FakeSerial sender;
+    sender.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {41});
+
+    while (!sender.received.empty()) {
+        EXPECT_TRUE(serial_.transmitted.empty());
+        serial_.received.push_back(sender.readReceivedByte());
+        slave_.run();
+    }
+
+    const std::vector<ParsedResponse> responses = parseResponses(serial_.transmitted);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].payload, std::vector<uint8_t>{42});
+}
+
+TEST_F(SlaveHandlerTest, corrupted_request_is_answered_and_the_next_one_handled) {
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {1});
+    serial_.received.back() ^= 0xFF;
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {2});
+
+    slave_.run();
+
+    const std::vector<ParsedResponse> responses = parseResponses(serial_.transmitted);
+    ASSERT_EQ(responses.size(), 2u);
+    EXPECT_EQ(responses[0].code, ResponseCode::corrupted);
+    EXPECT_EQ(responses[1].code, ResponseCode::ok);
+    EXPECT_EQ(responses[1].payload, std::vector<uint8_t>{3});
+}
+
+TEST_F(SlaveHandlerTest, requests_for_other_devices_are_ignored) {
+    serial_.queueRequest(K_DEVICE_ID + 1, EchoCommand::K_OP_CODE, {1});
+    serial_.queueRequest(K_DEVICE_ID, 0x7F);
+
+    slave_.run();
+
+    const std::vector<ParsedResponse> responses = parseResponses(serial_.transmitted);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].code, ResponseCode::unknown_operation_code);
+}
+
+TEST_F(SlaveHandlerTest, instances_keep_their_own_parse_state) {
+    FakeSerial   other_serial;
+    SlaveHandler other_slave(other_serial, clock_, K_DEVICE_ID);
+    other_slave.registerCommandHandler<EchoCommand, increment>();
+
+    FakeSerial sender;
+    sender.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {5});
+    const std::vector<uint8_t> request(sender.received.begin(), sender.received.end());
+
+    // Half a request to one, a whole request to the other
+    serial_.received.insert(serial_.received.end(), request.begin(), request.begin() + 3);
+    other_serial.received.insert(other_serial.received.end(), request.begin(), request.end());
+    slave_.run();
+    other_slave.run();
+
+    EXPECT_TRUE(serial_.transmitted.empty());
+    EXPECT_EQ(parseResponses(other_serial.transmitted).size(), 1u);
+
+    serial_.received.insert(serial_.received.end(), request.begin() + 3, request.end());
+    slave_.run();
+    EXPECT_EQ(parseResponses(serial_.transmitted).size(), 1u);
+}
+
+TEST_F(SlaveHandlerTest, unsolicited_frames_carry_the_stream_and_the_device_id) {
+    const uint8_t stream_data[] = {0xAA, 0xBB};
+    slave_.transmitUnsolicitedFrame(7, stream_data);
+
+    const std::vector<ParsedResponse> responses = parseResponses(serial_.transmitted);
+    ASSERT_EQ(responses.size(), 1u);
+    EXPECT_EQ(responses[0].code, ResponseCode::unsolicited_frame);
+    EXPECT_EQ(responses[0].payload, (std::vector<uint8_t>{7, K_DEVICE_ID, 0xAA, 0xBB}));
+}
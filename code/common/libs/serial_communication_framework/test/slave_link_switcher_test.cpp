@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
+#include "fakes.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/SlaveLinkSwitcher.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t      K_DEVICE_ID     = 3;
+constexpr LinkSettings K_FAST_SETTINGS = {.baud_rate = 3'000'000, .framing = Framing::cobs};
+
+class FakePort final : public drivers::interfaces::SerialPortConfigurationInterface {
+public:
+    bool setBaudRate(uint32_t new_baud_rate) override {
+        if (!supported_baud_rates.contains(new_baud_rate)) return false;
+        baud_rate = new_baud_rate;
+        events.push_back("set " + std::to_string(new_baud_rate));
+        return true;
+    }
+    uint32_t getBaudRate() override { return baud_rate; }
+    void     flushTx() override { events.push_back("flush"); }
+
+    std::set<uint32_t>       supported_baud_rates = {K_DEFAULT_LINK_SETTINGS.baud_rate, K_FAST_SETTINGS.baud_rate};
+    uint32_t                 baud_rate            = K_DEFAULT_LINK_SETTINGS.baud_rate;
+    std::vector<std::string> events;
+};
+
+ByteResponse increment(const ByteRequest& request) {
+    ByteResponse response;
+    response.value         = request.value + 1;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+class SlaveLinkSwitcherTest : public ::testing::Test {
+protected:
+    void SetUp() override { slave_.registerCommandHandler<EchoCommand, increment>(); }
+
+    FakeSerial        serial_;
+    FakeClock         clock_;
+    FakePort          port_;
+    SlaveHandler      slave_{serial_, clock_, K_DEVICE_ID};
+    SlaveLinkSwitcher switcher_{slave_, port_, clock_};
+};
+
+}  // namespace
+
+TEST_F(SlaveLinkSwitcherTest, switches_after_the_pending_response_has_been_sent) {
+    ASSERT_TRUE(switcher_.requestSwitch(K_FAST_SETTINGS));
+    EXPECT_EQ(port_.baud_rate, K_DEFAULT_LINK_SETTINGS.baud_rate);
+
+    switcher_.run();
+
+    EXPECT_EQ(port_.events, (std::vector<std::string>{"flush", "set 3000000"}));
+    EXPECT_EQ(slave_.getFraming(), Framing::cobs);
+    EXPECT_EQ(switcher_.getLinkSettings().baud_rate, K_FAST_SETTINGS.baud_rate);
+    EXPECT_TRUE(switcher_.isSwitchInProgress());
+}
+
+TEST_F(SlaveLinkSwitcherTest, keeps_the_new_settings_once_a_packet_is_received_with_them) {
+    ASSERT_TRUE(switcher_.requestSwitch(K_FAST_SETTINGS));
+    switcher_.run();
+
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {1}, Framing::cobs);
+    slave_.run();
+    switcher_.run();
+    EXPECT_FALSE(switcher_.isSwitchInProgress());
+
+    clock_.now_us += 10 * K_LINK_VERIFY_TIMEOUT_MS * 1'000;
+    switcher_.run();
+    EXPECT_EQ(port_.baud_rate, K_FAST_SETTINGS.baud_rate);
+    EXPECT_EQ(slave_.getFraming(), Framing::cobs);
+}
+
+TEST_F(SlaveLinkSwitcherTest, falls_back_when_nothing_is_received_with_the_new_settings) {
+    ASSERT_TRUE(switcher_.requestSwitch(K_FAST_SETTINGS));
+    switcher_.run();
+
+    // Garbage only, the master's packets don't survive the new rate
+    serial_.received.assign({0x12, 0x00, 0x34, 0x56, 0x00});
+    slave_.run();
+    clock_.now_us += K_LINK_VERIFY_TIMEOUT_MS * 1'000;
+    switcher_.run();
+    EXPECT_TRUE(switcher_.isSwitchInProgress());
+
+    clock_.now_us += 1'000;
+    switcher_.run();
+    EXPECT_FALSE(switcher_.isSwitchInProgress());
+    EXPECT_EQ(port_.baud_rate, K_DEFAULT_LINK_SETTINGS.baud_rate);
+    EXPECT_EQ(slave_.getFraming(), K_DEFAULT_LINK_SETTINGS.framing);
+
+    // Reachable again with the previous settings
+    serial_.transmitted.clear();
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {1});
+    slave_.run();
+    EXPECT_FALSE(serial_.transmitted.empty());
+}
+
+TEST_F(SlaveLinkSwitcherTest, rate_the_port_cannot_run_changes_nothing) {
+    ASSERT_TRUE(switcher_.requestSwitch({.baud_rate = 1'234'567, .framing = Framing::cobs}));
+    switcher_.run();
+
+    EXPECT_FALSE(switcher_.isSwitchInProgress());
+    EXPECT_EQ(port_.baud_rate, K_DEFAULT_LINK_SETTINGS.baud_rate);
+    EXPECT_EQ(slave_.getFraming(), Framing::none);
+}
+
+TEST_F(SlaveLinkSwitcherTest, second_request_is_refused_while_switching) {
+    ASSERT_TRUE(switcher_.requestSwitch(K_FAST_SETTINGS));
+    EXPECT_FALSE(switcher_.requestSwitch(K_DEFAULT_LINK_SETTINGS));
+    switcher_.run();
+    EXPECT_FALSE(switcher_.requestSwitch(K_DEFAULT_LINK_SETTINGS));
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/statistics.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t  K_DEVICE_ID         = 3;
+constexpr uint32_t K_HANDLER_TIME_US   = 250;
+constexpr size_t   K_ECHO_REQUEST_SIZE = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+
+// The handlers are plain functions, so they reach the test's clock through this
+FakeClock* handler_clock = nullptr;
+
+ByteResponse timedIncrement(const ByteRequest& request) {
+    handler_clock->now_us += K_HANDLER_TIME_US * (request.value + 1);
+
+    ByteResponse response;
+    response.value         = request.value + 1;
+    response.response_code = request.value == 0xFF ? ResponseCode::out_of_bounds : ResponseCode::ok;
+    return response;
+}
+
+void ignoreCompletion(const ByteResponse&, void*) {}
+
+ByteRequest makeRequest(uint8_t value) {
+    ByteRequest request;
+    request.value = value;
+    return request;
+}
+
+class SlaveStatisticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        handler_clock = &clock_;
+        slave_.registerCommandHandler<EchoCommand, timedIncrement>();
+    }
+    void TearDown() override { handler_clock = nullptr; }
+
+    FakeSerial   serial_;
+    FakeClock    clock_;
+    SlaveHandler slave_{serial_, clock_, K_DEVICE_ID};
+};
+
+}  // namespace
+
+TEST(OperationStatisticsTable, keeps_the_entries_of_the_op_codes_in_use) {
+    OperationStatisticsTable<OperationStatistics> table;
+    table[0x42].requests++;
+    table[0x42].requests++;
+    table[0x07].errors++;
+
+    const auto& const_table = table;
+    EXPECT_EQ(const_table[0x42].requests, 2u);
+    EXPECT_EQ(const_table[0x07].errors, 1u);
+    EXPECT_EQ(const_table[0x08].requests, 0u);
+}
+
+TEST(OperationStatisticsTable, op_codes_that_do_not_fit_share_an_entry) {
+    OperationStatisticsTable<OperationStatistics> table;
+    for (size_t op_code = 0; op_code < K_MAX_TRACKED_OPERATION_CODES; op_code++) {
+        ASSERT_TRUE(table.track(static_cast<uint8_t>(op_code)));
+    }
+    EXPECT_TRUE(table.track(0));
+    EXPECT_FALSE(table.track(0xF0));
+
+    table[0xF0].requests++;
+    table[0xF1].requests++;
+    table[0].requests++;
+
+    const auto& const_table = table;
+    EXPECT_EQ(const_table[0xF0].requests, 2u);
+    EXPECT_EQ(const_table[0].requests, 1u);
+}
+
+TEST(DurationStatistics, keeps_the_min_the_max_and_the_mean) {
+    DurationStatistics statistics;
+    EXPECT_EQ(statistics.getMeanUs(), 0u);
+
+    for (const uint64_t sample_us : {30, 10, 20}) statistics.addSample(sample_us);
+
+    EXPECT_EQ(statistics.count, 3u);
+    EXPECT_EQ(statistics.min_us, 10u);
+    EXPECT_EQ(statistics.max_us, 30u);
+    EXPECT_EQ(statistics.getMeanUs(), 20u);
+}
+
+TEST(LatencyHistogram, counts_the_samples_into_power_of_two_buckets) {
+    LatencyHistogram histogram;
+    for (const uint64_t sample_us : {0, 1, 2, 3, 4, 1'000}) histogram.addSample(sample_us);
+    histogram.addSample(UINT64_MAX);
+
+    EXPECT_EQ(histogram.getBucketCount(0), 2u);  // Under 2 us
+    EXPECT_EQ(histogram.getBucketCount(1), 2u);  // 2 to 3 us
+    EXPECT_EQ(histogram.getBucketCount(2), 1u);
+    EXPECT_EQ(histogram.getBucketCount(9), 1u);  // 512 to 1023 us
+    EXPECT_EQ(histogram.getBucketCount(LatencyHistogram::K_BUCKET_COUNT - 1), 1u);
+    EXPECT_EQ(LatencyHistogram::getBucketLowerBoundUs(9), 512u);
+    EXPECT_EQ(histogram.getDurationStatistics().count, 7u);
+}
+
+TEST(LatencyHistogram, percentiles_are_bucket_upper_bounds_capped_at_the_max) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.getPercentileUs(50), 0u);
+
+    for (int i = 0; i < 98; i++) histogram.addSample(100);  // 64 to 127 us
+    histogram.addSample(5'000);
+    histogram.addSample(6'000);  // 4096 to 8191 us
+
+    EXPECT_EQ(histogram.getPercentileUs(50), 127u);
+    EXPECT_EQ(histogram.getPercentileUs(98), 127u);
+    EXPECT_EQ(histogram.getPercentileUs(99), 6'000u);
+    EXPECT_EQ(histogram.getPercentileUs(100), 6'000u);
+}
+
+TEST_F(SlaveStatisticsTest, counts_the_requests_the_errors_and_the_handler_time_per_op_code) {
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {0});
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {1});
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {0xFF});
+    serial_.queueRequest(K_DEVICE_ID, 0x7F);
+
+    slave_.run();
+
+    const CommunicationStatistics& statistics = slave_.getCommunicationStatistics();
+    EXPECT_EQ(statistics.operations[EchoCommand::K_OP_CODE].requests, 3u);
+    EXPECT_EQ(statistics.operations[EchoCommand::K_OP_CODE].errors, 1u);
+    EXPECT_EQ(statistics.operations[0x7F].requests, 1u);
+    EXPECT_EQ(statistics.operations[0x7F].errors, 1u);
+
+    const DurationStatistics& handler_time = slave_.getHandlerTimeStatistics(EchoCommand::K_OP_CODE);
+    EXPECT_EQ(handler_time.count, 3u);
+    EXPECT_EQ(handler_time.min_us, K_HANDLER_TIME_US);
+    EXPECT_EQ(handler_time.max_us, K_HANDLER_TIME_US * 256);
+    EXPECT_EQ(slave_.getHandlerTimeStatistics(0x7F).count, 0u);
+}
+
+TEST_F(SlaveStatisticsTest, counts_the_bytes_both_ways_and_the_rx_overflows) {
+    serial_.queueRequest(K_DEVICE_ID, EchoCommand::K_OP_CODE, {0});
+    serial_.rx_overflow_count = 5;
+
+    slave_.run();
+
+    const CommunicationStatistics& statistics = slave_.getCommunicationStatistics();
+    EXPECT_EQ(statistics.bytes_received, K_ECHO_REQUEST_SIZE);
+    EXPECT_EQ(statistics.bytes_transmitted, serial_.transmitted.size());
+    EXPECT_EQ(statistics.rx_overflows, 5u);
+}
+
+TEST(MasterStatistics, counts_the_requests_the_errors_and_the_round_trips_per_op_code) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(1), ignoreCompletion, nullptr));
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(2), ignoreCompletion, nullptr));
+    EXPECT_EQ(master.getStatistics().bytes_transmitted, 2 * K_ECHO_REQUEST_SIZE);
+
+    clock.now_us = 1'000;
+    serial.queueResponse(ResponseCode::ok, {2});
+    master.run();
+    clock.now_us = 3'000;
+    serial.queueResponse(ResponseCode::invalid_id);
+    master.run();
+
+    const CommunicationStatistics& statistics = master.getStatistics();
+    EXPECT_EQ(statistics.operations[EchoCommand::K_OP_CODE].requests, 2u);
+    EXPECT_EQ(statistics.operations[EchoCommand::K_OP_CODE].errors, 1u);
+    EXPECT_EQ(statistics.bytes_received, 2 * ResponsePacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1);
+
+    const LatencyHistogram& round_trips = master.getRoundTripLatencyHistogram(EchoCommand::K_OP_CODE);
+    EXPECT_EQ(round_trips.getDurationStatistics().count, 2u);
+    EXPECT_EQ(round_trips.getDurationStatistics().min_us, 1'000u);
+    EXPECT_EQ(round_trips.getDurationStatistics().max_us, 3'000u);
+    EXPECT_EQ(master.getRoundTripLatencyHistogram().getDurationStatistics().count, 2u);
+}
+
+TEST(MasterStatistics, timed_out_commands_are_errors_without_a_round_trip) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(1), ignoreCompletion, nullptr));
+    clock.now_us = 10'000'000;
+    master.run();
+
+    EXPECT_EQ(master.getStatistics().operations[EchoCommand::K_OP_CODE].errors, 1u);
+    EXPECT_EQ(master.getRoundTripLatencyHistogram(EchoCommand::K_OP_CODE).getDurationStatistics().count, 0u);
+}
@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/timeouts.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t  K_DEVICE_ID            = 3;
+constexpr uint32_t K_SLOW_HANDLER_TIME_MS = 300;
+constexpr size_t   K_ECHO_REQUEST_SIZE    = RequestPacket::K_HEADER_WITH_PAYLOAD_CRC_SIZE + 1;
+
+// Known to take long, so it overrides the handler timeout
+using SlowEchoCommand = commands::Command<ByteRequest, ByteResponse, 0x11, 2 * K_SLOW_HANDLER_TIME_MS>;
+
+// The handlers are plain functions, so they reach the test's clock through this
+FakeClock* handler_clock = nullptr;
+
+ByteResponse slowEcho(const ByteRequest& request) {
+    handler_clock->now_us += K_SLOW_HANDLER_TIME_MS * 1'000;
+
+    ByteResponse response;
+    response.value         = request.value;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+struct CompletionLog {
+    std::vector<ResponseCode> codes;
+};
+
+void logCompletion(const ByteResponse& response, void* user_data) {
+    static_cast<CompletionLog*>(user_data)->codes.push_back(response.response_code);
+}
+
+ByteRequest makeRequest(uint8_t value) {
+    ByteRequest request;
+    request.value = value;
+    return request;
+}
+
+class SlaveTimeoutTest : public ::testing::Test {
+protected:
+    void SetUp() override { handler_clock = &clock_; }
+    void TearDown() override { handler_clock = nullptr; }
+
+    FakeSerial   serial_;
+    FakeClock    clock_;
+    SlaveHandler slave_{serial_, clock_, K_DEVICE_ID};
+};
+
+}  // namespace
+
+TEST(Timeouts, transmission_time_follows_the_baud_rate) {
+    EXPECT_EQ(transmissionTimeUs(1, 115200), 87);  // 86.8 rounded up
+    EXPECT_EQ(transmissionTimeUs(300, 3'000'000), 1'000);
+    EXPECT_EQ(transmissionTimeUs(0, 9600), 0);
+}
+
+TEST(Timeouts, master_timeout_always_covers_the_slave_timeout_and_the_transfers) {
+    for (const uint32_t baud_rate : {9600u, 115200u, 1'000'000u, 3'000'000u}) {
+        for (const Framing framing : {Framing::none, Framing::cobs}) {
+            for (const uint32_t handler_timeout_us : {0u, handlerTimeoutUs<EchoCommand>(), 1'000'000u}) {
+                const LinkSettings link_settings = {.baud_rate = baud_rate, .framing = framing};
+                const uint64_t     transfers_us =
+                    transmissionTimeUs(wireSize(RequestPacket::K_PACKET_MAX_SIZE, framing), baud_rate) +
+                    transmissionTimeUs(wireSize(ResponsePacket::K_PACKET_MAX_SIZE, framing), baud_rate);
+
+                EXPECT_GT(masterResponseTimeoutUs(link_settings, RequestPacket::K_PACKET_MAX_SIZE, handler_timeout_us),
+                          transfers_us + handler_timeout_us);
+                // A quick estimate must not shorten it
+                EXPECT_EQ(masterResponseTimeoutUs(link_settings, RequestPacket::K_PACKET_MAX_SIZE, handler_timeout_us,
+                                                  1),
+                          masterResponseTimeoutUs(link_settings, RequestPacket::K_PACKET_MAX_SIZE, handler_timeout_us));
+            }
+        }
+    }
+}
+
+TEST(Timeouts, master_timeout_scales_with_the_link) {
+    const uint32_t handler_timeout_us = handlerTimeoutUs<EchoCommand>();
+
+    // Short packets on a fast link give up on a lost frame much sooner than large ones on a slow link
+    const uint64_t fast_us =
+        masterResponseTimeoutUs({.baud_rate = 3'000'000, .framing = Framing::cobs}, 8, handler_timeout_us);
+    const uint64_t slow_us = masterResponseTimeoutUs({.baud_rate = 9600, .framing = Framing::none},
+                                                     RequestPacket::K_PACKET_MAX_SIZE, handler_timeout_us);
+    EXPECT_LT(fast_us, 35'000);
+    // Just sending the largest response at 9600 baud takes longer than 250 ms
+    EXPECT_GT(slow_us, 500'000);
+}
+
+TEST(Timeouts, estimate_rises_immediately_and_decays_slowly) {
+    HandlerTimeEstimator estimator;
+    EXPECT_EQ(estimator.getEstimateUs(0x10), 0);
+
+    estimator.addSample(0x10, 8'000);
+    EXPECT_EQ(estimator.getEstimateUs(0x10), 8'000);
+    EXPECT_EQ(estimator.getEstimateUs(0x11), 0);
+
+    estimator.addSample(0x10, 0);
+    EXPECT_EQ(estimator.getEstimateUs(0x10), 7'000);
+
+    estimator.addSample(0x10, 50'000);
+    EXPECT_EQ(estimator.getEstimateUs(0x10), 50'000);
+}
+
+TEST(MasterHandlerTimeouts, long_running_command_waits_for_its_override) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    ASSERT_TRUE(master.submitCommand<SlowEchoCommand>(K_DEVICE_ID, makeRequest(1), logCompletion, &log));
+
+    // Longer than the default command would have been waited for, but within the command's own timeout
+    clock.now_us += masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, K_ECHO_REQUEST_SIZE,
+                                            handlerTimeoutUs<EchoCommand>()) +
+                    1;
+    master.run();
+    EXPECT_TRUE(log.codes.empty());
+
+    serial.queueResponse(ResponseCode::ok, {1});
+    master.run();
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok}));
+}
+
+TEST(MasterHandlerTimeouts, timeout_follows_the_baud_rate) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+    master.setBaudRate(9600);
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(1), logCompletion, &log));
+
+    // The default baud rate's timeout is not enough to receive the response at 9600 baud
+    clock.now_us += masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, K_ECHO_REQUEST_SIZE,
+                                            handlerTimeoutUs<EchoCommand>()) +
+                    1;
+    master.run();
+    EXPECT_TRUE(log.codes.empty());
+
+    // Counted from the submission at 0
+    const LinkSettings link_settings = {.baud_rate = 9600, .framing = Framing::none};
+    clock.now_us =
+        masterResponseTimeoutUs(link_settings, K_ECHO_REQUEST_SIZE, handlerTimeoutUs<EchoCommand>()) + 1;
+    master.run();
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::timed_out}));
+}
+
+TEST(MasterHandlerTimeouts, measured_handler_time_extends_the_timeout) {
+    FakeSerial    serial;
+    FakeClock     clock;
+    MasterHandler master(serial, clock);
+    CompletionLog log;
+
+    // The answers take longer than the margin allows for, e.g. because of a slow USB serial adapter
+    const uint64_t calculated_timeout_us =
+        masterResponseTimeoutUs(K_DEFAULT_LINK_SETTINGS, K_ECHO_REQUEST_SIZE, handlerTimeoutUs<EchoCommand>());
+    const uint64_t answer_time_us = calculated_timeout_us - 1'000;
+
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(1), logCompletion, &log));
+    clock.now_us += answer_time_us;
+    serial.queueResponse(ResponseCode::ok, {1});
+    master.run();
+    ASSERT_EQ(log.codes, (std::vector{ResponseCode::ok}));
+    EXPECT_GT(master.getHandlerTimeEstimateUs(EchoCommand::K_OP_CODE), handlerTimeoutUs<EchoCommand>());
+
+    // The next one gets more time than the calculated timeout
+    ASSERT_TRUE(master.submitCommand<EchoCommand>(K_DEVICE_ID, makeRequest(2), logCompletion, &log));
+    clock.now_us += calculated_timeout_us + 1;
+    master.run();
+    EXPECT_EQ(log.codes.size(), 1);
+
+    serial.queueResponse(ResponseCode::ok, {2});
+    master.run();
+    EXPECT_EQ(log.codes, (std::vector{ResponseCode::ok, ResponseCode::ok}));
+}
+
+TEST_F(SlaveTimeoutTest, response_is_dropped_when_handler_exceeds_its_timeout) {
+    using SlowWithoutOverride = commands::Command<ByteRequest, ByteResponse, 0x12>;
+    slave_.registerCommandHandler<SlowWithoutOverride, slowEcho>();
+
+    serial_.queueRequest(K_DEVICE_ID, SlowWithoutOverride::K_OP_CODE, {5});
+    slave_.run();
+
+    EXPECT_TRUE(serial_.transmitted.empty());
+    EXPECT_EQ(slave_.getCommunicationStatistics().timed_out_packets, 1);
+}
+
+TEST_F(SlaveTimeoutTest, long_running_command_is_answered_within_its_override) {
+    slave_.registerCommandHandler<SlowEchoCommand, slowEcho>();
+
+    serial_.queueRequest(K_DEVICE_ID, SlowEchoCommand::K_OP_CODE, {5});
+    slave_.run();
+
+    EXPECT_FALSE(serial_.transmitted.empty());
+    EXPECT_EQ(slave_.getCommunicationStatistics().timed_out_packets, 0);
+}
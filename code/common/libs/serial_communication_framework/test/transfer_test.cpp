@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "fakes.h"
+#include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/TransferMaster.h"
+#include "serial_communication_framework/TransferReceiver.h"
+#include "serial_communication_framework/TransferSlave.h"
+
+using namespace serial_communication_framework;
+using namespace serial_communication_framework::test;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID        = 3;
+constexpr uint8_t K_UPLOAD_ID        = 1;
+constexpr uint8_t K_DOWNLOAD_ID      = 2;
+constexpr size_t  K_UPLOAD_MAX_SIZE  = 4096;
+constexpr size_t  K_MAX_LOOPS        = 200'000;
+constexpr size_t  K_LOOP_DURATION_US = 100;
+
+struct EmptyResponse : commands::ResponseBase {
+    ParsingError       deserialize(std::span<uint8_t>) { return ParsingError::no_error; }
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) { return target_buffer.subspan(0, 0); }
+};
+
+struct Commands {
+    using Start   = commands::Command<TransferStartRequest, EmptyResponse, 0x50>;
+    using Segment = commands::Command<TransferSegmentRequest, EmptyResponse, 0x51>;
+    using Finish  = commands::Command<TransferFinishRequest, EmptyResponse, 0x52>;
+    using Read    = commands::Command<TransferReadRequest, TransferReadResponse, 0x53>;
+};
+
+// The slave's handlers are free functions, like on the device
+TransferSlave* transfer_slave = nullptr;
+
+EmptyResponse startTransfer(const TransferStartRequest& request) {
+    EmptyResponse response;
+    response.response_code = transfer_slave->startUpload(request);
+    return response;
+}
+
+EmptyResponse writeTransferSegment(const TransferSegmentRequest& request) {
+    EmptyResponse response;
+    response.response_code = transfer_slave->receiveSegment(request);
+    return response;
+}
+
+EmptyResponse finishTransfer(const TransferFinishRequest& request) {
+    EmptyResponse response;
+    response.response_code = transfer_slave->finishUpload(request);
+    return response;
+}
+
+TransferReadResponse readTransferSegment(const TransferReadRequest& request) {
+    return transfer_slave->readSegment(request);
+}
+
+std::vector<uint8_t> makeData(std::mt19937& random, size_t size) {
+    std::vector<uint8_t> data(size);
+    for (uint8_t& byte : data) byte = static_cast<uint8_t>(random());
+    return data;
+}
+
+ResponseCode readFromVector(uint32_t offset, std::span<uint8_t> target_buffer, size_t* read_size_out,
+                            void* user_data) {
+    const auto& data = *static_cast<const std::vector<uint8_t>*>(user_data);
+    if (offset >= data.size()) return ResponseCode::out_of_bounds;
+    *read_size_out = std::min(target_buffer.size(), data.size() - offset);
+    std::copy_n(data.begin() + offset, *read_size_out, target_buffer.begin());
+    return ResponseCode::ok;
+}
+
+ResponseCode appendToVector(uint32_t offset, std::span<const uint8_t> bytes, void* user_data) {
+    auto& data = *static_cast<std::vector<uint8_t>*>(user_data);
+    if (offset != data.size()) return ResponseCode::out_of_bounds;
+    data.insert(data.end(), bytes.begin(), bytes.end());
+    return ResponseCode::ok;
+}
+
+ResponseCode countFinish(uint32_t, void* user_data) {
+    (*static_cast<int*>(user_data))++;
+    return ResponseCode::ok;
+}
+
+// Master and slave over a COBS framed link that drops one byte in drop_one_in, both directions
+class TransferLink {
+public:
+    explicit TransferLink(size_t drop_one_in) : drop_one_in_(drop_one_in) {
+        transfer_slave = &slave_transfers;
+        slave.registerCommandHandler<Commands::Start, startTransfer>();
+        slave.registerCommandHandler<Commands::Segment, writeTransferSegment>();
+        slave.registerCommandHandler<Commands::Finish, finishTransfer>();
+        slave.registerCommandHandler<Commands::Read, readTransferSegment>();
+        slave.setFraming(Framing::cobs);
+        master.setFraming(Framing::cobs);
+    }
+
+    ~TransferLink() { transfer_slave = nullptr; }
+
+    // Runs both ends until the transfer has finished, false if it never did
+    bool runUntilFinished(TransferMaster<Commands>& transfer) {
+        for (size_t loop = 0; loop < K_MAX_LOOPS; loop++) {
+            transfer.run();
+            master.run();
+            carry(master_serial.transmitted, slave_serial.received);
+            slave.run();
+            carry(slave_serial.transmitted, master_serial.received);
+            clock.now_us += K_LOOP_DURATION_US;
+            if (transfer.isFinished()) return true;
+        }
+        return false;
+    }
+
+    FakeSerial    master_serial;
+    FakeSerial    slave_serial;
+    FakeClock     clock;
+    MasterHandler master{master_serial, clock};
+    SlaveHandler  slave{slave_serial, clock, K_DEVICE_ID};
+    TransferSlave slave_transfers;
+    size_t        dropped_bytes = 0;
+
+private:
+    size_t       drop_one_in_;
+    std::mt19937 random_{4242};
+
+    void carry(std::vector<uint8_t>& from, std::deque<uint8_t>& to) {
+        for (const uint8_t byte : from) {
+            if (drop_one_in_ != 0 && random_() % drop_one_in_ == 0) {
+                dropped_bytes++;
+                continue;
+            }
+            to.push_back(byte);
+        }
+        from.clear();
+    }
+};
+
+}  // namespace
+
+TEST(TransferReceiver, reassembles_out_of_order_segments_into_the_buffer) {
+    std::vector<uint8_t> target(30);
+    TransferReceiver     receiver;
+    receiver.start(target);
+
+    const std::vector<uint8_t> a(10, 0xAA), b(10, 0xBB), c(10, 0xCC);
+    EXPECT_EQ(receiver.receiveSegment(20, c), ResponseCode::ok);
+    EXPECT_EQ(receiver.receiveSegment(10, b), ResponseCode::ok);
+    EXPECT_EQ(receiver.getCompletedSize(), 0u);
+    EXPECT_FALSE(receiver.isComplete());
+
+    EXPECT_EQ(receiver.receiveSegment(0, a), ResponseCode::ok);
+    EXPECT_TRUE(receiver.isComplete());
+
+    std::vector<uint8_t> expected = a;
+    expected.insert(expected.end(), b.begin(), b.end());
+    expected.insert(expected.end(), c.begin(), c.end());
+    EXPECT_EQ(target, expected);
+}
+
+TEST(TransferReceiver, passes_the_bytes_to_the_sink_in_order) {
+    std::vector<uint8_t> sunk;
+    TransferReceiver     receiver;
+    receiver.start(30, appendToVector, &sunk);
+
+    const std::vector<uint8_t> a(10, 1), b(10, 2), c(10, 3);
+    EXPECT_EQ(receiver.receiveSegment(10, b), ResponseCode::ok);
+    EXPECT_EQ(receiver.receiveSegment(20, c), ResponseCode::ok);
+    EXPECT_TRUE(sunk.empty());
+
+    EXPECT_EQ(receiver.receiveSegment(0, a), ResponseCode::ok);
+    EXPECT_TRUE(receiver.isComplete());
+    ASSERT_EQ(sunk.size(), 30u);
+    EXPECT_EQ(sunk[0], 1);
+    EXPECT_EQ(sunk[10], 2);
+    EXPECT_EQ(sunk[29], 3);
+}
+
+TEST(TransferReceiver, accepts_duplicates_without_effect) {
+    std::vector<uint8_t> sunk;
+    TransferReceiver     receiver;
+    receiver.start(20, appendToVector, &sunk);
+
+    const std::vector<uint8_t> a(10, 1), b(10, 2);
+    EXPECT_EQ(receiver.receiveSegment(10, b), ResponseCode::ok);
+    EXPECT_EQ(receiver.receiveSegment(10, b), ResponseCode::ok);
+    EXPECT_EQ(receiver.receiveSegment(0, a), ResponseCode::ok);
+    EXPECT_EQ(receiver.receiveSegment(0, a), ResponseCode::ok);
+
+    EXPECT_TRUE(receiver.isComplete());
+    EXPECT_EQ(sunk.size(), 20u);
+}
+
+TEST(TransferReceiver, rejects_segments_outside_the_data_and_the_window) {
+    const std::vector<uint8_t> segment(10, 0);
+    std::vector<uint8_t>       sunk;
+    TransferReceiver           receiver;
+
+    EXPECT_EQ(receiver.receiveSegment(0, segment), ResponseCode::forbidden);
+
+    receiver.start(1000, appendToVector, &sunk);
+    EXPECT_EQ(receiver.receiveSegment(995, segment), ResponseCode::out_of_bounds);
+    EXPECT_EQ(receiver.receiveSegment(1000, segment), ResponseCode::out_of_bounds);
+
+    // The receiver holds one window less the missing segment
+    for (size_t i = 1; i < K_TRANSFER_MAX_WINDOW_SIZE; i++) {
+        EXPECT_EQ(receiver.receiveSegment(static_cast<uint32_t>(i * 10), segment), ResponseCode::ok);
+    }
+    EXPECT_EQ(receiver.receiveSegment(K_TRANSFER_MAX_WINDOW_SIZE * 10, segment), ResponseCode::out_of_bounds);
+}
+
+TEST(TransferReceiver, sink_failure_fails_the_rest_of_the_transfer) {
+    std::vector<uint8_t> sunk;
+    TransferReceiver     receiver;
+    receiver.start(20, appendToVector, &sunk);
+    sunk.push_back(0);  // The sink now expects another offset
+
+    const std::vector<uint8_t> segment(10, 0);
+    EXPECT_EQ(receiver.receiveSegment(0, segment), ResponseCode::out_of_bounds);
+    sunk.clear();
+    EXPECT_EQ(receiver.receiveSegment(0, segment), ResponseCode::out_of_bounds);
+    EXPECT_FALSE(receiver.isComplete());
+}
+
+TEST(Transfer, upload_over_a_clean_link) {
+    std::mt19937               random(1);
+    const std::vector<uint8_t> data = makeData(random, 3000);
+    std::vector<uint8_t>       received(K_UPLOAD_MAX_SIZE);
+    int                        finish_count = 0;
+
+    TransferLink link(0);
+    link.slave_transfers.registerUploadBuffer(K_UPLOAD_ID, received, countFinish, &finish_count);
+
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startUpload(K_DEVICE_ID, K_UPLOAD_ID, data));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    EXPECT_EQ(transfer.getResult(), ResponseCode::ok);
+    EXPECT_EQ(finish_count, 1);
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), received.begin()));
+    EXPECT_EQ(transfer.getStatistics().retransmissions, 0u);
+    EXPECT_EQ(transfer.getStatistics().segments_sent, (data.size() + K_TRANSFER_SEGMENT_MAX_SIZE - 1) /
+                                                          K_TRANSFER_SEGMENT_MAX_SIZE);
+}
+
+TEST(Transfer, upload_to_a_sink_over_a_lossy_link_resends_only_the_lost_segments) {
+    std::mt19937               random(2);
+    const std::vector<uint8_t> data = makeData(random, 20'000);
+    std::vector<uint8_t>       sunk;
+
+    TransferLink link(2000);
+    link.slave_transfers.registerUploadSink(K_UPLOAD_ID, 32'000, appendToVector, nullptr, &sunk);
+
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startUpload(K_DEVICE_ID, K_UPLOAD_ID, data, {.max_attempts = 20}));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    ASSERT_EQ(transfer.getResult(), ResponseCode::ok);
+    EXPECT_EQ(sunk, data);
+    EXPECT_GT(link.dropped_bytes, 0u);
+    EXPECT_GT(transfer.getStatistics().retransmissions, 0u);
+
+    const size_t segment_count = (data.size() + K_TRANSFER_SEGMENT_MAX_SIZE - 1) / K_TRANSFER_SEGMENT_MAX_SIZE;
+    EXPECT_LT(transfer.getStatistics().retransmissions, segment_count);
+    RecordProperty("dropped_bytes", static_cast<int>(link.dropped_bytes));
+    RecordProperty("retransmissions", static_cast<int>(transfer.getStatistics().retransmissions));
+}
+
+TEST(Transfer, download_over_a_lossy_link) {
+    std::mt19937               random(3);
+    const std::vector<uint8_t> data = makeData(random, 20'000);
+    std::vector<uint8_t>       received(data.size());
+
+    TransferLink link(2000);
+    link.slave_transfers.registerDownloadSource(K_DOWNLOAD_ID, readFromVector,
+                                                const_cast<std::vector<uint8_t>*>(&data));
+
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startDownload(K_DEVICE_ID, K_DOWNLOAD_ID, received, {.max_attempts = 20}));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    ASSERT_EQ(transfer.getResult(), ResponseCode::ok);
+    EXPECT_EQ(received, data);
+    EXPECT_GT(transfer.getStatistics().retransmissions, 0u);
+}
+
+TEST(Transfer, stop_and_wait_window_also_completes) {
+    std::mt19937               random(4);
+    const std::vector<uint8_t> data = makeData(random, 2000);
+    std::vector<uint8_t>       received(data.size());
+
+    TransferLink link(0);
+    link.slave_transfers.registerDownloadSource(K_DOWNLOAD_ID, readFromVector,
+                                                const_cast<std::vector<uint8_t>*>(&data));
+
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startDownload(K_DEVICE_ID, K_DOWNLOAD_ID, received, {.window_size = 1, .segment_size = 64}));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    EXPECT_EQ(transfer.getResult(), ResponseCode::ok);
+    EXPECT_EQ(received, data);
+}
+
+TEST(Transfer, unknown_transfer_id_fails_without_retrying) {
+    const std::vector<uint8_t> data(100, 0);
+
+    TransferLink             link(0);
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startUpload(K_DEVICE_ID, K_UPLOAD_ID, data));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    EXPECT_EQ(transfer.getResult(), ResponseCode::invalid_id);
+    EXPECT_EQ(transfer.getStatistics().segments_sent, 0u);
+}
+
+TEST(Transfer, upload_larger_than_the_endpoint_is_refused) {
+    const std::vector<uint8_t> data(200, 0);
+    std::vector<uint8_t>       received(100);
+
+    TransferLink link(0);
+    link.slave_transfers.registerUploadBuffer(K_UPLOAD_ID, received, nullptr, nullptr);
+
+    TransferMaster<Commands> transfer(link.master);
+    ASSERT_TRUE(transfer.startUpload(K_DEVICE_ID, K_UPLOAD_ID, data));
+    ASSERT_TRUE(link.runUntilFinished(transfer));
+
+    EXPECT_EQ(transfer.getResult(), ResponseCode::out_of_bounds);
+}
+
+TEST(Transfer, finish_is_answered_again_without_finishing_twice) {
+    std::vector<uint8_t> received(10);
+    int                  finish_count = 0;
+    TransferSlave        slave;
+    slave.registerUploadBuffer(K_UPLOAD_ID, received, countFinish, &finish_count);
+
+    TransferStartRequest start;
+    start.transfer_id = K_UPLOAD_ID;
+    start.total_size  = 10;
+    ASSERT_EQ(slave.startUpload(start), ResponseCode::ok);
+
+    const std::vector<uint8_t> bytes(10, 7);
+    TransferSegmentRequest     segment;
+    segment.transfer_id = K_UPLOAD_ID;
+    segment.raw_bytes   = bytes;
+
+    TransferFinishRequest finish;
+    finish.transfer_id = K_UPLOAD_ID;
+    EXPECT_EQ(slave.finishUpload(finish), ResponseCode::forbidden);
+
+    ASSERT_EQ(slave.receiveSegment(segment), ResponseCode::ok);
+    EXPECT_EQ(slave.finishUpload(finish), ResponseCode::ok);
+    EXPECT_EQ(slave.finishUpload(finish), ResponseCode::ok);
+    EXPECT_EQ(finish_count, 1);
+    EXPECT_EQ(received, bytes);
+}
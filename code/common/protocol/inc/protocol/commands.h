@@ -12,10 +12,22 @@ using serial_communication_framework::commands::EmptyResponse;
 
 }  // namespace protocol::commands
 
+#include "commands/arm_capture_command.h"
+#include "commands/firmware_update_commands.h"
+#include "commands/get_capture_status_command.h"
 #include "commands/get_param_metadata_command.h"
 #include "commands/get_registered_param_ids_command.h"
+#include "commands/link_commands.h"
 #include "commands/ping_command.h"
+#include "commands/read_capture_data_command.h"
+#include "commands/read_param_values_command.h"
 #include "commands/read_parm_value_command.h"
+#include "commands/reboot_command.h"
+#include "commands/save_parameters_command.h"
+#include "commands/statistics_commands.h"
+#include "commands/subscribe_telemetry_command.h"
+#include "commands/transfer_commands.h"
 #include "commands/write_param_value_command.h"
+#include "commands/write_param_values_command.h"
 
 #endif  // COMMON_PROTOCOL_COMMANDS_H
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef COMMON_PROTOCOL_ARM_CAPTURE_COMMAND_H
+#define COMMON_PROTOCOL_ARM_CAPTURE_COMMAND_H
+
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/common.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "utils/StaticList.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief Arms the device side signal capture, see parameter_system::SignalCapture.
+ *
+ * Discards the earlier capture. The device responds with ResponseCode::invalid_id if some of the parameters is not
+ * registered, ResponseCode::forbidden if some of them is not a signal and ResponseCode::out_of_bounds if the rest of
+ * the configuration is not valid.
+ */
+struct ArmCaptureRequest : serial_communication_framework::commands::RequestBase {
+    parameter_system::CaptureConfig config;
+    utils::StaticList<parameter_system::ParameterID, parameter_system::SignalCapture::K_MAX_SIGNALS> parameter_ids;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using ArmCapture = serial_communication_framework::commands::Command<
+    ArmCaptureRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::arm_capture)>;
+
+using TriggerCapture = serial_communication_framework::commands::Command<
+    serial_communication_framework::commands::EmptyRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::trigger_capture)>;
+
+using DisarmCapture = serial_communication_framework::commands::Command<
+    serial_communication_framework::commands::EmptyRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::disarm_capture)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_ARM_CAPTURE_COMMAND_H
@@ -0,0 +1,50 @@
+#ifndef COMMON_PROTOCOL_FIRMWARE_UPDATE_COMMANDS_H
+#define COMMON_PROTOCOL_FIRMWARE_UPDATE_COMMANDS_H
+
+#include <cstdint>
+
+#include "firmware_update/common.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+
+namespace protocol::commands {
+
+/**
+ * Firmware update over the serial link:
+ *   1. BeginFirmwareUpdate with the size and the CRC-32 of the image
+ *   2. Upload of the image with the segmented transfers, id protocol::TransferIds::firmware_image. The device programs
+ *      it into the slot that is not running as it arrives, and finishing the transfer verifies it and makes the slot
+ *      the one booted next
+ *   3. Reboot
+ */
+
+/**
+ * @brief Prepares the device to receive an image. Responds with ResponseCode::out_of_bounds if the image does not fit
+ *        into a slot.
+ */
+struct BeginFirmwareUpdateRequest : serial_communication_framework::commands::RequestBase {
+    uint32_t image_size = 0;
+    uint32_t image_crc  = 0;  // CRC-32 of the whole image, see math::generateCrc32
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using BeginFirmwareUpdate = serial_communication_framework::commands::Command<
+    BeginFirmwareUpdateRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::begin_firmware_update)>;
+
+struct GetFirmwareStatusResponse : serial_communication_framework::commands::ResponseBase {
+    firmware_update::FirmwareStatus status;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using GetFirmwareStatus = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::commands::EmptyRequest, GetFirmwareStatusResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_firmware_status)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_FIRMWARE_UPDATE_COMMANDS_H
@@ -0,0 +1,23 @@
+#ifndef COMMON_PROTOCOL_GET_CAPTURE_STATUS_COMMAND_H
+#define COMMON_PROTOCOL_GET_CAPTURE_STATUS_COMMAND_H
+
+#include "parameter_system/SignalCapture.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+
+namespace protocol::commands {
+
+struct GetCaptureStatusResponse : serial_communication_framework::commands::ResponseBase {
+    parameter_system::CaptureStatus status;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using GetCaptureStatus = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::commands::EmptyRequest, GetCaptureStatusResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_capture_status)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_GET_CAPTURE_STATUS_COMMAND_H
@@ -10,21 +10,20 @@ namespace protocol::commands {
 struct GetParamMetadataRequest : serial_communication_framework::commands::RequestBase {
     parameter_system::ParameterID parameter_id;
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 };
 
 struct GetParamMetadataResponse : serial_communication_framework::commands::ResponseBase {
     parameter_system::ParameterMetaData meta_data;
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 };
 
-using GetParamMetadata =
-    serial_communication_framework::commands::Command<GetParamMetadataRequest, GetParamMetadataResponse,
-                                                      static_cast<uint8_t>(
-                                                          internal::OperationCodes::get_parameter_metadata)>;
+using GetParamMetadata = serial_communication_framework::commands::IdempotentCommand<
+    GetParamMetadataRequest, GetParamMetadataResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_parameter_metadata)>;
 
 }  // namespace protocol::commands
 
@@ -10,11 +10,11 @@ namespace protocol::commands {
 struct GetRegisteredParamIdsResponse : serial_communication_framework::commands::ResponseBase {
     utils::StaticList<parameter_system::ParameterID, parameter_system::K_MAX_PARAMETER_ID> ids;
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 };
 
-using GetRegisteredParamIds = serial_communication_framework::commands::Command<
+using GetRegisteredParamIds = serial_communication_framework::commands::IdempotentCommand<
     serial_communication_framework::commands::EmptyRequest, GetRegisteredParamIdsResponse,
     static_cast<uint8_t>(internal::OperationCodes::get_all_registered_parameter_ids)>;
 
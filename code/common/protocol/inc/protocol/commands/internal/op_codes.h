@@ -10,17 +10,47 @@ enum class OperationCodes : uint8_t {
     ping                               = 0x01,
     reboot                             = 0x02,
     boot_to_pico_usb_mass_storage_mode = 0x03,
+    get_capabilities                   = 0x04,
+    configure_link                     = 0x05,
+
+    /** DIAGNOSTICS **/
+    get_communication_statistics       = 0x10,
+    get_operation_statistics           = 0x11,
 
     /** PARAMETER ACCESS **/
     write_parameter_value              = 0x20,
     read_parameter_value               = 0x21,
     get_parameter_metadata             = 0x22,
     get_all_registered_parameter_ids   = 0x23,
+    read_parameter_values              = 0x24,
+    write_parameter_values             = 0x25,
+    save_parameters                    = 0x26,
+
+    /** TELEMETRY **/
+    subscribe_telemetry                = 0x30,
+    unsubscribe_telemetry              = 0x31,
+
+    /** CAPTURE **/
+    arm_capture                        = 0x38,
+    trigger_capture                    = 0x39,
+    disarm_capture                     = 0x3A,
+    get_capture_status                 = 0x3B,
+    read_capture_data                  = 0x3C,
 
     /** MOTOR COMMANDS **/
     start_motor                        = 0x40,
     stop_motor                         = 0x41,
     // stop_motor_fading                  = 0x42,
+
+    /** SEGMENTED TRANSFERS **/
+    start_transfer                     = 0x50,
+    write_transfer_segment             = 0x51,
+    finish_transfer                    = 0x52,
+    read_transfer_segment              = 0x53,
+
+    /** FIRMWARE UPDATE **/
+    begin_firmware_update              = 0x58,
+    get_firmware_status                = 0x59,
 };
 
 }  // namespace protocol::commands::internal
@@ -0,0 +1,68 @@
+#ifndef COMMON_PROTOCOL_LINK_COMMANDS_H
+#define COMMON_PROTOCOL_LINK_COMMANDS_H
+
+#include <cstdint>
+
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/common.h"
+#include "utils/StaticList.h"
+
+namespace protocol::commands {
+
+// Increased when the commands change in a way that an older master or device can't handle
+constexpr uint8_t K_PROTOCOL_VERSION = 2;
+
+// Optional protocol features, as bits of GetCapabilitiesResponse::features
+enum class ProtocolFeature : uint32_t {
+    cobs_framing = 1 << 0,
+};
+
+/**
+ * @brief What the device supports, so that the master can pick the fastest link both ends can run.
+ */
+struct GetCapabilitiesResponse : serial_communication_framework::commands::ResponseBase {
+    static constexpr size_t K_MAX_BAUD_RATES = 16;
+
+    uint8_t  protocol_version          = 0;
+    uint16_t max_request_payload_size  = 0;
+    uint16_t max_response_payload_size = 0;
+    uint32_t features                  = 0;
+
+    // In ascending order
+    utils::StaticList<uint32_t, K_MAX_BAUD_RATES> baud_rates;
+
+    [[nodiscard]] bool hasFeature(ProtocolFeature feature) const {
+        return (features & static_cast<uint32_t>(feature)) != 0;
+    }
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using GetCapabilities = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::commands::EmptyRequest, GetCapabilitiesResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_capabilities)>;
+
+/**
+ * @brief Switches the link to the given settings.
+ *
+ * The device responds with the current settings and switches right after. The master must then send a packet with the
+ * new settings within K_LINK_VERIFY_TIMEOUT_MS, otherwise the device goes back to the previous settings. Responds
+ * with ResponseCode::out_of_bounds if the settings are not supported and ResponseCode::forbidden if a switch is
+ * already in progress.
+ */
+struct ConfigureLinkRequest : serial_communication_framework::commands::RequestBase {
+    serial_communication_framework::LinkSettings settings;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using ConfigureLink = serial_communication_framework::commands::Command<
+    ConfigureLinkRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::configure_link)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_LINK_COMMANDS_H
@@ -6,9 +6,9 @@
 
 namespace protocol::commands {
 
-using Ping = serial_communication_framework::commands::Command<serial_communication_framework::commands::EmptyRequest,
-                                                               serial_communication_framework::commands::EmptyResponse,
-                                                               static_cast<uint8_t>(internal::OperationCodes::ping)>;
+using Ping = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::commands::EmptyRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::ping)>;
 
 }  // namespace protocol::commands
 
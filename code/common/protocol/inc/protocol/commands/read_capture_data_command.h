@@ -0,0 +1,45 @@
+#ifndef COMMON_PROTOCOL_READ_CAPTURE_DATA_COMMAND_H
+#define COMMON_PROTOCOL_READ_CAPTURE_DATA_COMMAND_H
+
+#include <cstdint>
+#include <span>
+
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/packets.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief Reads a chunk of a completed capture, in chronological order.
+ *
+ * The device responds with ResponseCode::forbidden if the capture is not complete and ResponseCode::out_of_bounds if
+ * the offset is past the end of the capture. The response may be shorter than requested at the end of the capture.
+ */
+struct ReadCaptureDataRequest : serial_communication_framework::commands::RequestBase {
+    uint32_t byte_offset = 0;
+    uint8_t  byte_count  = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct ReadCaptureDataResponse : serial_communication_framework::commands::ResponseBase {
+    // The offset is echoed back so that pipelined chunks can be placed without bookkeeping on the master side
+    static constexpr size_t K_MAX_CHUNK_SIZE =
+        serial_communication_framework::ResponsePacket::K_PAYLOAD_MAX_SIZE - sizeof(uint32_t);
+
+    uint32_t byte_offset = 0;
+    // View, not a copy. Points to the receive buffer on the master and to the handler's buffer on the slave.
+    std::span<const uint8_t> raw_bytes = {};
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using ReadCaptureData = serial_communication_framework::commands::IdempotentCommand<
+    ReadCaptureDataRequest, ReadCaptureDataResponse, static_cast<uint8_t>(internal::OperationCodes::read_capture_data)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_READ_CAPTURE_DATA_COMMAND_H
@@ -0,0 +1,69 @@
+#ifndef COMMON_PROTOCOL_READ_PARAM_VALUES_COMMAND_H
+#define COMMON_PROTOCOL_READ_PARAM_VALUES_COMMAND_H
+
+#include <cstring>
+
+#include "assert/assert.h"
+#include "parameter_system/common.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/packets.h"
+#include "utils/StaticList.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief Reads multiple parameter values with a single request.
+ *
+ * The response carries the values back to back in the same order as they were requested, each value taking exactly
+ * the size of its parameter value type. If any of the requested parameters can't be read the whole command fails.
+ */
+struct ReadParamValuesRequest : serial_communication_framework::commands::RequestBase {
+    struct Entry {
+        parameter_system::ParameterID parameter_id;
+        // slave returns ResponseCode::type_mismatch if it doesn't match the registered parameter,
+        // same as with ReadParamValueRequest
+        parameter_system::ParameterValueType expected_value_type;
+    };
+
+    static constexpr size_t K_SERIALIZED_ENTRY_SIZE = sizeof(Entry::parameter_id) + sizeof(Entry::expected_value_type);
+    static constexpr size_t K_MAX_ENTRIES =
+        serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE / K_SERIALIZED_ENTRY_SIZE;
+
+    utils::StaticList<Entry, K_MAX_ENTRIES> entries;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+struct ReadParamValuesResponse : serial_communication_framework::commands::ResponseBase {
+    // The most value bytes that fit into one response
+    static constexpr size_t K_RAW_BUFF_SIZE = serial_communication_framework::ResponsePacket::K_PAYLOAD_MAX_SIZE;
+
+    // View, not a copy. Points to the receive buffer on the master and to the handler's buffer on the slave.
+    std::span<const uint8_t> raw_bytes = {};
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+
+    /**
+     * @brief Extract a value as a typed scalar of type @p T from the given byte offset. (Helper for master)
+     * @note Asserts that the value fits inside the bytes the slave sent.
+     */
+    template <typename T>
+    T take(size_t byte_offset) const {
+        ASSERT_WITH_MESSAGE(byte_offset + sizeof(T) <= raw_bytes.size_bytes(), "Value out of response bounds");
+
+        T var;
+        std::memcpy(&var, &raw_bytes[byte_offset], sizeof(T));
+        return var;
+    }
+};
+
+using ReadParamValues = serial_communication_framework::commands::IdempotentCommand<
+    ReadParamValuesRequest, ReadParamValuesResponse,
+    static_cast<uint8_t>(internal::OperationCodes::read_parameter_values)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_READ_PARAM_VALUES_COMMAND_H
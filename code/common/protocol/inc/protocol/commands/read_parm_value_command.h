@@ -18,21 +18,20 @@ struct ReadParamValueRequest : serial_communication_framework::commands::Request
     // control api compilation with protocol is stale compared to firmware
     parameter_system::ParameterValueType expected_value_type;
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 };
 
 // TODO Deduplicate: this same take/put + raw_bytes + valid_byte_count machinery is
 //      duplicated in WriteParamValueRequest (see write_param_value_command.h) and
 //      ReadParamValueResponse (see read_parm_value_command.h).
 struct ReadParamValueResponse : serial_communication_framework::commands::ResponseBase {
-    // TODO kinda allocating too much unneeded memory, but at least does not cause problems in the future
-    static constexpr size_t K_RAW_BUFF_SIZE = serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE;
+    static constexpr size_t K_RAW_BUFF_SIZE = parameter_system::K_MAX_VALUE_SIZE;
     uint8_t                 raw_bytes[K_RAW_BUFF_SIZE] = {};
     size_t                  valid_byte_count           = 0;  // Not actually transmitted, used for (de)serialization
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 
     /**
      * @brief Extract the response value as a typed scalar of type @p T. (Helper for master)
@@ -49,10 +48,9 @@ struct ReadParamValueResponse : serial_communication_framework::commands::Respon
     }
 };
 
-using ReadParamValue =
-    serial_communication_framework::commands::Command<ReadParamValueRequest, ReadParamValueResponse,
-                                                      static_cast<uint8_t>(
-                                                          internal::OperationCodes::read_parameter_value)>;
+using ReadParamValue = serial_communication_framework::commands::IdempotentCommand<
+    ReadParamValueRequest, ReadParamValueResponse,
+    static_cast<uint8_t>(internal::OperationCodes::read_parameter_value)>;
 
 }  // namespace protocol::commands
 
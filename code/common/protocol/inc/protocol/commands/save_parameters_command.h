@@ -0,0 +1,21 @@
+#ifndef COMMON_PROTOCOL_COMMANDS_SAVE_PARAMETERS_H
+#define COMMON_PROTOCOL_COMMANDS_SAVE_PARAMETERS_H
+
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+
+namespace protocol::commands {
+
+// Erasing a flash sector can take hundreds of milliseconds, and saving may have to erase one to compact the records
+constexpr uint32_t K_SAVE_PARAMETERS_HANDLER_TIMEOUT_MS = 1000;
+
+// Stores the current values of all the saved parameters to the non-volatile memory, they are loaded on every boot
+using SaveParameters =
+    serial_communication_framework::commands::Command<serial_communication_framework::commands::EmptyRequest,
+                                                      serial_communication_framework::commands::EmptyResponse,
+                                                      static_cast<uint8_t>(internal::OperationCodes::save_parameters),
+                                                      K_SAVE_PARAMETERS_HANDLER_TIMEOUT_MS>;
+
+}  // namespace protocol::commands
+
+#endif  //  COMMON_PROTOCOL_COMMANDS_SAVE_PARAMETERS_H
@@ -0,0 +1,53 @@
+#ifndef COMMON_PROTOCOL_STATISTICS_COMMANDS_H
+#define COMMON_PROTOCOL_STATISTICS_COMMANDS_H
+
+#include <cstdint>
+
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/statistics.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief The device's side of the link: packet, byte, overflow, resynchronization and duplicate request counts since
+ *        boot.
+ *
+ * `statistics.operations` is not included, the counts of an op code are read with GetOperationStatistics.
+ */
+struct GetCommunicationStatisticsResponse : serial_communication_framework::commands::ResponseBase {
+    serial_communication_framework::CommunicationStatistics statistics;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using GetCommunicationStatistics = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::commands::EmptyRequest, GetCommunicationStatisticsResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_communication_statistics)>;
+
+struct GetOperationStatisticsRequest : serial_communication_framework::commands::RequestBase {
+    uint8_t operation_code = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+/**
+ * @brief How many requests of the op code the device has received and failed, and how long its handler has taken.
+ */
+struct GetOperationStatisticsResponse : serial_communication_framework::commands::ResponseBase {
+    serial_communication_framework::OperationStatistics operation;
+    serial_communication_framework::DurationStatistics  handler_time;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using GetOperationStatistics = serial_communication_framework::commands::IdempotentCommand<
+    GetOperationStatisticsRequest, GetOperationStatisticsResponse,
+    static_cast<uint8_t>(internal::OperationCodes::get_operation_statistics)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_STATISTICS_COMMANDS_H
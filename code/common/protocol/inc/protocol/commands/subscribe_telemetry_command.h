@@ -0,0 +1,39 @@
+#ifndef COMMON_PROTOCOL_SUBSCRIBE_TELEMETRY_COMMAND_H
+#define COMMON_PROTOCOL_SUBSCRIBE_TELEMETRY_COMMAND_H
+
+#include "parameter_system/TelemetryStreamer.h"
+#include "parameter_system/common.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "utils/StaticList.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief Makes the device stream the values of the given signal parameters periodically as TelemetryFrames.
+ *
+ * Replaces the earlier subscription. The device responds with ResponseCode::forbidden if some of the parameters is
+ * not a signal and ResponseCode::out_of_bounds if the period is too short or the values don't fit into one frame.
+ */
+struct SubscribeTelemetryRequest : serial_communication_framework::commands::RequestBase {
+    // Shorter periods would fill the link with telemetry and starve the command responses
+    static constexpr uint32_t K_MIN_PERIOD_US = 1'000;
+
+    uint32_t period_us = 0;
+    utils::StaticList<parameter_system::ParameterID, parameter_system::TelemetryStreamer::K_MAX_SIGNALS> parameter_ids;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+};
+
+using SubscribeTelemetry = serial_communication_framework::commands::Command<
+    SubscribeTelemetryRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::subscribe_telemetry)>;
+
+using UnsubscribeTelemetry = serial_communication_framework::commands::Command<
+    serial_communication_framework::commands::EmptyRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::unsubscribe_telemetry)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_SUBSCRIBE_TELEMETRY_COMMAND_H
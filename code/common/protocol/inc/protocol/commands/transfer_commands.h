@@ -0,0 +1,49 @@
+#ifndef COMMON_PROTOCOL_TRANSFER_COMMANDS_H
+#define COMMON_PROTOCOL_TRANSFER_COMMANDS_H
+
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/transfer.h"
+
+namespace protocol::commands {
+
+/**
+ * The commands of the segmented transfers, see serial_communication_framework/transfer.h. The ids of the data that can
+ * be transferred are in protocol/transfer_ids.h.
+ *
+ * The device responds with ResponseCode::invalid_id to an unknown transfer id, ResponseCode::out_of_bounds to data
+ * that does not fit and ResponseCode::forbidden to segments of an upload that has not been started.
+ */
+// A segment of an upload may have to wait for a flash sector to be erased, e.g. with a firmware image
+constexpr uint32_t K_WRITE_TRANSFER_SEGMENT_HANDLER_TIMEOUT_MS = 100;
+// Finishing an upload may verify all of the data, e.g. read a firmware image back from the flash
+constexpr uint32_t K_FINISH_TRANSFER_HANDLER_TIMEOUT_MS        = 1000;
+
+using StartTransfer = serial_communication_framework::commands::Command<
+    serial_communication_framework::TransferStartRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::start_transfer)>;
+
+using WriteTransferSegment = serial_communication_framework::commands::Command<
+    serial_communication_framework::TransferSegmentRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::write_transfer_segment),
+    K_WRITE_TRANSFER_SEGMENT_HANDLER_TIMEOUT_MS>;
+
+using FinishTransfer = serial_communication_framework::commands::Command<
+    serial_communication_framework::TransferFinishRequest, serial_communication_framework::commands::EmptyResponse,
+    static_cast<uint8_t>(internal::OperationCodes::finish_transfer), K_FINISH_TRANSFER_HANDLER_TIMEOUT_MS>;
+
+using ReadTransferSegment = serial_communication_framework::commands::IdempotentCommand<
+    serial_communication_framework::TransferReadRequest, serial_communication_framework::TransferReadResponse,
+    static_cast<uint8_t>(internal::OperationCodes::read_transfer_segment)>;
+
+// For serial_communication_framework::TransferMaster
+struct TransferCommands {
+    using Start   = StartTransfer;
+    using Segment = WriteTransferSegment;
+    using Finish  = FinishTransfer;
+    using Read    = ReadTransferSegment;
+};
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_TRANSFER_COMMANDS_H
@@ -16,8 +16,7 @@ namespace protocol::commands {
 //      ReadParamValueResponse (see read_parm_value_command.h).
 struct WriteParamValueRequest : serial_communication_framework::commands::RequestBase {
 private:
-    // TODO kinda allocating too much unneeded memory, but at least does not cause problems in the future
-    static constexpr size_t K_RAW_BUFF_SIZE = serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE;
+    static constexpr size_t K_RAW_BUFF_SIZE = parameter_system::K_MAX_VALUE_SIZE;
 
 public:
     parameter_system::ParameterID parameter_id;
@@ -28,9 +27,8 @@ public:
     uint8_t                              raw_bytes[K_RAW_BUFF_SIZE] = {};
     size_t                               valid_byte_count           = 0;  // Not actually, used for (de)serialization
 
-    ParsingError       deserialize(std::span<uint8_t> bytes) override;
-    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer) override;
-    // TODO kinda allocating too much unneeded memory, but at least does not cause problems in the future
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
 
     /**
      * @brief Store a typed scalar of type @p T as the value to write (Helper for master).
@@ -0,0 +1,83 @@
+#ifndef COMMON_PROTOCOL_WRITE_PARAM_VALUES_COMMAND_H
+#define COMMON_PROTOCOL_WRITE_PARAM_VALUES_COMMAND_H
+
+#include <cstring>
+
+#include "assert/assert.h"
+#include "parameter_system/ParameterDeclaration.h"
+#include "parameter_system/common.h"
+#include "parameter_system/parameter_type_mappings.h"
+#include "protocol/commands/internal/op_codes.h"
+#include "serial_communication_framework/command_interface.h"
+#include "serial_communication_framework/packets.h"
+#include "utils/StaticList.h"
+
+namespace protocol::commands {
+
+/**
+ * @brief Writes multiple parameter values with a single request.
+ *
+ * Each entry is serialized as [parameter_id, expected_value_type, value bytes], the size of the value is defined by
+ * the value type. The slave validates all the entries before writing any of them, so either all the values are
+ * written or none of them. The on change callbacks are invoked only after all the values have been written.
+ */
+struct WriteParamValuesRequest : serial_communication_framework::commands::RequestBase {
+    struct Entry {
+        parameter_system::ParameterID parameter_id;
+        // slave returns ResponseCode::type_mismatch if it doesn't match the registered parameter,
+        // same as with WriteParamValueRequest
+        parameter_system::ParameterValueType expected_value_type;
+        size_t                               value_offset = 0;  // Position of the value in value_bytes
+    };
+
+    static constexpr size_t K_SERIALIZED_ENTRY_HEADER_SIZE =
+        sizeof(Entry::parameter_id) + sizeof(Entry::expected_value_type);
+    static constexpr size_t K_MAX_ENTRIES =
+        serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE / (K_SERIALIZED_ENTRY_HEADER_SIZE + 1);
+    static constexpr size_t K_VALUE_BUFF_SIZE = serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE;
+
+    utils::StaticList<Entry, K_MAX_ENTRIES> entries;
+    uint8_t                                 value_bytes[K_VALUE_BUFF_SIZE] = {};
+    size_t                                  valid_value_byte_count         = 0;
+
+    ParsingError       deserialize(std::span<uint8_t> bytes);
+    std::span<uint8_t> serialize(std::span<uint8_t> target_buffer);
+
+    /**
+     * @brief Add a value to write with raw bytes. (Helper for master)
+     * @return false if the entry doesn't fit into the same request anymore.
+     */
+    [[nodiscard]] bool putRaw(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+                              std::span<const uint8_t> value);
+
+    /**
+     * @brief Add a typed value to write. (Helper for master)
+     * @return false if the entry doesn't fit into the same request anymore.
+     */
+    template <parameter_system::ParameterValueType T_ValueType>
+    [[nodiscard]] bool put(const parameter_system::ParameterDeclaration<T_ValueType>&                   declaration,
+                           typename parameter_system::MapParameterValueTypeToCppType<T_ValueType>::type value) {
+        return putRaw(declaration.id, T_ValueType,
+                      {reinterpret_cast<const uint8_t*>(&value), sizeof(value)});
+    }
+
+    /**
+     * @brief Get the value bytes of an entry. (Helper for slave)
+     */
+    [[nodiscard]] std::span<const uint8_t> getValueBytes(const Entry& entry) const;
+
+    /**
+     * @brief Get the amount of bytes the request takes when serialized.
+     */
+    [[nodiscard]] size_t getSerializedSize() const;
+};
+
+using WriteParamValues =
+    serial_communication_framework::commands::Command<WriteParamValuesRequest,
+                                                      serial_communication_framework::commands::EmptyResponse,
+                                                      static_cast<uint8_t>(
+                                                          internal::OperationCodes::write_parameter_values)>;
+
+}  // namespace protocol::commands
+
+#endif  // COMMON_PROTOCOL_WRITE_PARAM_VALUES_COMMAND_H
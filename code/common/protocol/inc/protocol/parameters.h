@@ -11,11 +11,12 @@ namespace protocol {
 
 namespace internal {}  // namespace internal
 
+// Duplicate ids are detected at compile time by the ParameterRegistry the declared parameters are defined in, see
+// parameter_system::ParameterRegistry::hasUniqueIds
 #define DECLARE_PARAMETER(var_name, id, value_type)                                                                \
     static_assert(                                                                                                 \
         (static_cast<ParameterID>(id) <= parameter_system::K_MAX_PARAMETER_ID) && (static_cast<int64_t>(id) >= 0), \
         "Parameter id out of bounds");                                                                             \
-    static_assert(true /*TODO*/, "Duplicate ParameterID detected");                                                \
     constexpr ParameterDeclaration<ParameterValueType::value_type>(var_name) { static_cast<ParameterID>(id) }
 
 namespace test_params {
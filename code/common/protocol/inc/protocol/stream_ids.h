@@ -0,0 +1,17 @@
+#ifndef COMMON_PROTOCOL_STREAM_IDS_H
+#define COMMON_PROTOCOL_STREAM_IDS_H
+
+#include <cstdint>
+
+namespace protocol {
+
+/**
+ * @brief Ids of the unsolicited frame streams the device sends without being asked.
+ */
+enum class StreamIds : uint8_t {
+    telemetry = 0x01,
+};
+
+}  // namespace protocol
+
+#endif  // COMMON_PROTOCOL_STREAM_IDS_H
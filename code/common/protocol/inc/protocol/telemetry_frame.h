@@ -0,0 +1,55 @@
+#ifndef COMMON_PROTOCOL_TELEMETRY_FRAME_H
+#define COMMON_PROTOCOL_TELEMETRY_FRAME_H
+
+#include <cstring>
+#include <span>
+
+#include "assert/assert.h"
+#include "parameter_system/TelemetryStreamer.h"
+#include "serial_communication_framework/command_interface.h"
+
+namespace protocol {
+
+/**
+ * @brief A telemetry frame streamed by the device after SubscribeTelemetry. (Parsed by master)
+ *
+ * The values are back to back in the same order as the parameter ids were given in the subscription, each value
+ * taking exactly the size of its parameter value type. Several devices on the same bus can stream at the same time,
+ * their frames are told apart by the device id.
+ */
+struct TelemetryFrame {
+    using ParsingError = serial_communication_framework::commands::ParsingError;
+
+    static constexpr size_t K_RAW_BUFF_SIZE = parameter_system::TelemetryStreamer::K_FRAME_MAX_SIZE -
+                                              parameter_system::TelemetryStreamer::K_FRAME_HEADER_SIZE;
+
+    // Id of the device that sent the frame, from the header of the unsolicited frame that carried it
+    uint8_t  device_id                  = 0;
+    // Incremented by one on every sample the device takes, a gap means that frames were dropped
+    uint16_t sequence_number            = 0;
+    uint8_t  raw_bytes[K_RAW_BUFF_SIZE] = {};
+    size_t   valid_byte_count           = 0;
+
+    /**
+     * @param sender_id The id of the device that sent the unsolicited frame.
+     * @param bytes     The telemetry stream's data of the unsolicited frame.
+     */
+    ParsingError deserialize(uint8_t sender_id, std::span<uint8_t> bytes);
+
+    /**
+     * @brief Extract a value as a typed scalar of type @p T from the given byte offset.
+     * @note Asserts that the value fits inside the bytes of the frame.
+     */
+    template <typename T>
+    T take(size_t byte_offset) const {
+        ASSERT_WITH_MESSAGE(byte_offset + sizeof(T) <= valid_byte_count, "Value out of frame bounds");
+
+        T var;
+        std::memcpy(&var, &raw_bytes[byte_offset], sizeof(T));
+        return var;
+    }
+};
+
+}  // namespace protocol
+
+#endif  // COMMON_PROTOCOL_TELEMETRY_FRAME_H
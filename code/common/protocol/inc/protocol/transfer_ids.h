@@ -0,0 +1,18 @@
+#ifndef COMMON_PROTOCOL_TRANSFER_IDS_H
+#define COMMON_PROTOCOL_TRANSFER_IDS_H
+
+#include <cstdint>
+
+namespace protocol {
+
+/**
+ * @brief Ids of the data the device can upload or download with the segmented transfers.
+ */
+enum class TransferIds : uint8_t {
+    capture_data   = 0x01,  // Download of a completed capture, in chronological order
+    firmware_image = 0x02,  // Upload of a firmware image, after BeginFirmwareUpdate
+};
+
+}  // namespace protocol
+
+#endif  // COMMON_PROTOCOL_TRANSFER_IDS_H
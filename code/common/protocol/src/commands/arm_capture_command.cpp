@@ -0,0 +1,81 @@
+#include "protocol/commands/arm_capture_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+namespace {
+
+constexpr size_t K_SERIALIZED_CONFIG_SIZE =
+    sizeof(parameter_system::CaptureConfig::decimation) + sizeof(parameter_system::CaptureConfig::trigger_mode) +
+    sizeof(parameter_system::CaptureConfig::trigger_source_id) +
+    sizeof(parameter_system::CaptureConfig::trigger_threshold) +
+    sizeof(parameter_system::CaptureConfig::pre_trigger_samples);
+
+}  // namespace
+
+serial_communication_framework::commands::RequestBase::ParsingError ArmCaptureRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_CONFIG_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&config.decimation, &bytes[idx], sizeof(config.decimation));
+    idx += sizeof(config.decimation);
+
+    std::memcpy(&config.trigger_mode, &bytes[idx], sizeof(config.trigger_mode));
+    idx += sizeof(config.trigger_mode);
+
+    std::memcpy(&config.trigger_source_id, &bytes[idx], sizeof(config.trigger_source_id));
+    idx += sizeof(config.trigger_source_id);
+
+    std::memcpy(&config.trigger_threshold, &bytes[idx], sizeof(config.trigger_threshold));
+    idx += sizeof(config.trigger_threshold);
+
+    std::memcpy(&config.pre_trigger_samples, &bytes[idx], sizeof(config.pre_trigger_samples));
+    idx += sizeof(config.pre_trigger_samples);
+
+    const size_t id_count = (bytes.size_bytes() - idx) / sizeof(parameter_system::ParameterID);
+    if (id_count > parameter_ids.capacity()) return ParsingError::payload_does_not_fit;
+
+    parameter_ids.clear();
+    for (; idx < bytes.size_bytes(); idx += sizeof(parameter_system::ParameterID)) {
+        parameter_system::ParameterID id;
+        std::memcpy(&id, &bytes[idx], sizeof(id));
+        parameter_ids.pushBack(id);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ArmCaptureRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_CONFIG_SIZE + parameter_ids.size() * sizeof(parameter_system::ParameterID) <=
+                            target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &config.decimation, sizeof(config.decimation));
+    idx += sizeof(config.decimation);
+
+    std::memcpy(&target_buffer[idx], &config.trigger_mode, sizeof(config.trigger_mode));
+    idx += sizeof(config.trigger_mode);
+
+    std::memcpy(&target_buffer[idx], &config.trigger_source_id, sizeof(config.trigger_source_id));
+    idx += sizeof(config.trigger_source_id);
+
+    std::memcpy(&target_buffer[idx], &config.trigger_threshold, sizeof(config.trigger_threshold));
+    idx += sizeof(config.trigger_threshold);
+
+    std::memcpy(&target_buffer[idx], &config.pre_trigger_samples, sizeof(config.pre_trigger_samples));
+    idx += sizeof(config.pre_trigger_samples);
+
+    for (const parameter_system::ParameterID id : parameter_ids) {
+        std::memcpy(&target_buffer[idx], &id, sizeof(id));
+        idx += sizeof(id);
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
@@ -0,0 +1,84 @@
+#include "protocol/commands/firmware_update_commands.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+namespace {
+
+constexpr size_t K_SERIALIZED_BEGIN_SIZE =
+    sizeof(BeginFirmwareUpdateRequest::image_size) + sizeof(BeginFirmwareUpdateRequest::image_crc);
+
+constexpr size_t K_SERIALIZED_STATUS_SIZE =
+    sizeof(firmware_update::FirmwareStatus::running_slot) + sizeof(firmware_update::FirmwareStatus::boot_slot) +
+    sizeof(firmware_update::FirmwareStatus::update_state) + sizeof(firmware_update::FirmwareStatus::received_size);
+
+}  // namespace
+
+serial_communication_framework::commands::RequestBase::ParsingError BeginFirmwareUpdateRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_BEGIN_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&image_size, &bytes[idx], sizeof(image_size));
+    idx += sizeof(image_size);
+
+    std::memcpy(&image_crc, &bytes[idx], sizeof(image_crc));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> BeginFirmwareUpdateRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_BEGIN_SIZE <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &image_size, sizeof(image_size));
+    idx += sizeof(image_size);
+
+    std::memcpy(&target_buffer[idx], &image_crc, sizeof(image_crc));
+    idx += sizeof(image_crc);
+
+    return target_buffer.subspan(0, idx);
+}
+
+serial_communication_framework::commands::ResponseBase::ParsingError GetFirmwareStatusResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_STATUS_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&status.running_slot, &bytes[idx], sizeof(status.running_slot));
+    idx += sizeof(status.running_slot);
+
+    std::memcpy(&status.boot_slot, &bytes[idx], sizeof(status.boot_slot));
+    idx += sizeof(status.boot_slot);
+
+    std::memcpy(&status.update_state, &bytes[idx], sizeof(status.update_state));
+    idx += sizeof(status.update_state);
+
+    std::memcpy(&status.received_size, &bytes[idx], sizeof(status.received_size));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetFirmwareStatusResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_STATUS_SIZE <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &status.running_slot, sizeof(status.running_slot));
+    idx += sizeof(status.running_slot);
+
+    std::memcpy(&target_buffer[idx], &status.boot_slot, sizeof(status.boot_slot));
+    idx += sizeof(status.boot_slot);
+
+    std::memcpy(&target_buffer[idx], &status.update_state, sizeof(status.update_state));
+    idx += sizeof(status.update_state);
+
+    std::memcpy(&target_buffer[idx], &status.received_size, sizeof(status.received_size));
+    idx += sizeof(status.received_size);
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
@@ -0,0 +1,63 @@
+#include "protocol/commands/get_capture_status_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+namespace {
+
+constexpr size_t K_SERIALIZED_STATUS_SIZE =
+    sizeof(parameter_system::CaptureStatus::state) + sizeof(parameter_system::CaptureStatus::sample_size) +
+    sizeof(parameter_system::CaptureStatus::sample_count) +
+    sizeof(parameter_system::CaptureStatus::trigger_sample_index) +
+    sizeof(parameter_system::CaptureStatus::sample_interval_ns);
+
+}  // namespace
+
+serial_communication_framework::commands::ResponseBase::ParsingError GetCaptureStatusResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_STATUS_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&status.state, &bytes[idx], sizeof(status.state));
+    idx += sizeof(status.state);
+
+    std::memcpy(&status.sample_size, &bytes[idx], sizeof(status.sample_size));
+    idx += sizeof(status.sample_size);
+
+    std::memcpy(&status.sample_count, &bytes[idx], sizeof(status.sample_count));
+    idx += sizeof(status.sample_count);
+
+    std::memcpy(&status.trigger_sample_index, &bytes[idx], sizeof(status.trigger_sample_index));
+    idx += sizeof(status.trigger_sample_index);
+
+    std::memcpy(&status.sample_interval_ns, &bytes[idx], sizeof(status.sample_interval_ns));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetCaptureStatusResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_STATUS_SIZE <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &status.state, sizeof(status.state));
+    idx += sizeof(status.state);
+
+    std::memcpy(&target_buffer[idx], &status.sample_size, sizeof(status.sample_size));
+    idx += sizeof(status.sample_size);
+
+    std::memcpy(&target_buffer[idx], &status.sample_count, sizeof(status.sample_count));
+    idx += sizeof(status.sample_count);
+
+    std::memcpy(&target_buffer[idx], &status.trigger_sample_index, sizeof(status.trigger_sample_index));
+    idx += sizeof(status.trigger_sample_index);
+
+    std::memcpy(&target_buffer[idx], &status.sample_interval_ns, sizeof(status.sample_interval_ns));
+    idx += sizeof(status.sample_interval_ns);
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
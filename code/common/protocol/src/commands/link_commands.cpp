@@ -0,0 +1,103 @@
+#include "protocol/commands/link_commands.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+namespace {
+
+constexpr size_t K_SERIALIZED_CAPABILITIES_SIZE =
+    sizeof(GetCapabilitiesResponse::protocol_version) + sizeof(GetCapabilitiesResponse::max_request_payload_size) +
+    sizeof(GetCapabilitiesResponse::max_response_payload_size) + sizeof(GetCapabilitiesResponse::features);
+
+constexpr size_t K_SERIALIZED_LINK_SETTINGS_SIZE =
+    sizeof(serial_communication_framework::LinkSettings::baud_rate) +
+    sizeof(serial_communication_framework::LinkSettings::framing);
+
+}  // namespace
+
+serial_communication_framework::commands::ResponseBase::ParsingError GetCapabilitiesResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_CAPABILITIES_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&protocol_version, &bytes[idx], sizeof(protocol_version));
+    idx += sizeof(protocol_version);
+
+    std::memcpy(&max_request_payload_size, &bytes[idx], sizeof(max_request_payload_size));
+    idx += sizeof(max_request_payload_size);
+
+    std::memcpy(&max_response_payload_size, &bytes[idx], sizeof(max_response_payload_size));
+    idx += sizeof(max_response_payload_size);
+
+    std::memcpy(&features, &bytes[idx], sizeof(features));
+    idx += sizeof(features);
+
+    const size_t baud_rate_count = (bytes.size_bytes() - idx) / sizeof(uint32_t);
+    if (baud_rate_count > baud_rates.capacity()) return ParsingError::payload_does_not_fit;
+
+    baud_rates.clear();
+    for (; idx + sizeof(uint32_t) <= bytes.size_bytes(); idx += sizeof(uint32_t)) {
+        uint32_t baud_rate;
+        std::memcpy(&baud_rate, &bytes[idx], sizeof(baud_rate));
+        baud_rates.pushBack(baud_rate);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetCapabilitiesResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_CAPABILITIES_SIZE + baud_rates.size() * sizeof(uint32_t) <=
+                            target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &protocol_version, sizeof(protocol_version));
+    idx += sizeof(protocol_version);
+
+    std::memcpy(&target_buffer[idx], &max_request_payload_size, sizeof(max_request_payload_size));
+    idx += sizeof(max_request_payload_size);
+
+    std::memcpy(&target_buffer[idx], &max_response_payload_size, sizeof(max_response_payload_size));
+    idx += sizeof(max_response_payload_size);
+
+    std::memcpy(&target_buffer[idx], &features, sizeof(features));
+    idx += sizeof(features);
+
+    for (const uint32_t baud_rate : baud_rates) {
+        std::memcpy(&target_buffer[idx], &baud_rate, sizeof(baud_rate));
+        idx += sizeof(baud_rate);
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+serial_communication_framework::commands::RequestBase::ParsingError ConfigureLinkRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_LINK_SETTINGS_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&settings.baud_rate, &bytes[idx], sizeof(settings.baud_rate));
+    idx += sizeof(settings.baud_rate);
+
+    std::memcpy(&settings.framing, &bytes[idx], sizeof(settings.framing));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ConfigureLinkRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_LINK_SETTINGS_SIZE <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &settings.baud_rate, sizeof(settings.baud_rate));
+    idx += sizeof(settings.baud_rate);
+
+    std::memcpy(&target_buffer[idx], &settings.framing, sizeof(settings.framing));
+    idx += sizeof(settings.framing);
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
@@ -0,0 +1,57 @@
+#include "protocol/commands/read_capture_data_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+serial_communication_framework::commands::RequestBase::ParsingError ReadCaptureDataRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(byte_offset) + sizeof(byte_count)) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&byte_offset, &bytes[idx], sizeof(byte_offset));
+    idx += sizeof(byte_offset);
+
+    std::memcpy(&byte_count, &bytes[idx], sizeof(byte_count));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ReadCaptureDataRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(byte_offset) + sizeof(byte_count) <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &byte_offset, sizeof(byte_offset));
+    idx += sizeof(byte_offset);
+
+    std::memcpy(&target_buffer[idx], &byte_count, sizeof(byte_count));
+    idx += sizeof(byte_count);
+
+    return target_buffer.subspan(0, idx);
+}
+
+serial_communication_framework::commands::ResponseBase::ParsingError ReadCaptureDataResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(byte_offset)) return ParsingError::payload_missing_bytes;
+    if (bytes.size_bytes() - sizeof(byte_offset) > K_MAX_CHUNK_SIZE) return ParsingError::payload_does_not_fit;
+
+    std::memcpy(&byte_offset, bytes.data(), sizeof(byte_offset));
+    raw_bytes = bytes.subspan(sizeof(byte_offset));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ReadCaptureDataResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(byte_offset) + raw_bytes.size_bytes() <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    std::memcpy(target_buffer.data(), &byte_offset, sizeof(byte_offset));
+    std::memcpy(&target_buffer[sizeof(byte_offset)], raw_bytes.data(), raw_bytes.size_bytes());
+
+    return target_buffer.subspan(0, sizeof(byte_offset) + raw_bytes.size_bytes());
+}
+
+}  // namespace protocol::commands
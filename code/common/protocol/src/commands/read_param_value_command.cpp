@@ -35,8 +35,7 @@ std::span<uint8_t> ReadParamValueRequest::serialize(std::span<uint8_t> target_bu
 
 serial_communication_framework::commands::ResponseBase::ParsingError ReadParamValueResponse::deserialize(
     std::span<uint8_t> bytes) {
-    ASSERT_WITH_MESSAGE(bytes.size_bytes() <= K_RAW_BUFF_SIZE,
-                        "Incoming param value is larger than response raw buffer can hold");
+    if (bytes.size_bytes() > K_RAW_BUFF_SIZE) return ParsingError::payload_does_not_fit;
 
     valid_byte_count = bytes.size_bytes();
     std::memcpy(raw_bytes, bytes.data(), valid_byte_count);
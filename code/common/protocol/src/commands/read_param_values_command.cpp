@@ -0,0 +1,61 @@
+#include "protocol/commands/read_param_values_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+serial_communication_framework::commands::RequestBase::ParsingError ReadParamValuesRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() % K_SERIALIZED_ENTRY_SIZE != 0) return ParsingError::payload_missing_bytes;
+    if (bytes.size_bytes() / K_SERIALIZED_ENTRY_SIZE > K_MAX_ENTRIES) return ParsingError::payload_does_not_fit;
+
+    entries.clear();
+    for (size_t idx = 0; idx < bytes.size_bytes();) {
+        Entry entry{};
+        std::memcpy(&entry.parameter_id, &bytes[idx], sizeof(entry.parameter_id));
+        idx += sizeof(entry.parameter_id);
+
+        std::memcpy(&entry.expected_value_type, &bytes[idx], sizeof(entry.expected_value_type));
+        idx += sizeof(entry.expected_value_type);
+
+        entries.pushBack(entry);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ReadParamValuesRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(entries.size() * K_SERIALIZED_ENTRY_SIZE <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    for (const Entry& entry : entries) {
+        std::memcpy(&target_buffer[idx], &entry.parameter_id, sizeof(entry.parameter_id));
+        idx += sizeof(entry.parameter_id);
+
+        std::memcpy(&target_buffer[idx], &entry.expected_value_type, sizeof(entry.expected_value_type));
+        idx += sizeof(entry.expected_value_type);
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+serial_communication_framework::commands::ResponseBase::ParsingError ReadParamValuesResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() > K_RAW_BUFF_SIZE) return ParsingError::payload_does_not_fit;
+
+    raw_bytes = bytes;
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> ReadParamValuesResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(raw_bytes.size_bytes() <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    std::memcpy(target_buffer.data(), raw_bytes.data(), raw_bytes.size_bytes());
+    return target_buffer.subspan(0, raw_bytes.size_bytes());
+}
+
+}  // namespace protocol::commands
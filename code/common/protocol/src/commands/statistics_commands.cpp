@@ -0,0 +1,127 @@
+#include "protocol/commands/statistics_commands.h"
+
+#include <cstring>
+#include <iterator>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+namespace {
+
+using serial_communication_framework::CommunicationStatistics;
+using serial_communication_framework::DurationStatistics;
+using serial_communication_framework::OperationStatistics;
+
+// In the order they are serialized in, all of them uint64_t
+constexpr uint64_t CommunicationStatistics::* K_SERIALIZED_COUNTERS[] = {
+    &CommunicationStatistics::total_packets_received,      &CommunicationStatistics::corrupted_packets_received,
+    &CommunicationStatistics::valid_packets_received,      &CommunicationStatistics::timed_out_packets,
+    &CommunicationStatistics::unsolicited_frames_received, &CommunicationStatistics::resynchronizations,
+    &CommunicationStatistics::bytes_received,              &CommunicationStatistics::bytes_transmitted,
+    &CommunicationStatistics::rx_overflows,                &CommunicationStatistics::duplicate_requests,
+};
+
+constexpr size_t K_SERIALIZED_COMMUNICATION_STATISTICS_SIZE = std::size(K_SERIALIZED_COUNTERS) * sizeof(uint64_t);
+
+constexpr size_t K_SERIALIZED_OPERATION_STATISTICS_SIZE =
+    sizeof(OperationStatistics::requests) + sizeof(OperationStatistics::errors) + sizeof(DurationStatistics::count) +
+    sizeof(DurationStatistics::min_us) + sizeof(DurationStatistics::max_us) + sizeof(DurationStatistics::total_us);
+
+}  // namespace
+
+serial_communication_framework::commands::ResponseBase::ParsingError GetCommunicationStatisticsResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_COMMUNICATION_STATISTICS_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    for (const auto counter : K_SERIALIZED_COUNTERS) {
+        std::memcpy(&(statistics.*counter), &bytes[idx], sizeof(uint64_t));
+        idx += sizeof(uint64_t);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetCommunicationStatisticsResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_COMMUNICATION_STATISTICS_SIZE <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    for (const auto counter : K_SERIALIZED_COUNTERS) {
+        std::memcpy(&target_buffer[idx], &(statistics.*counter), sizeof(uint64_t));
+        idx += sizeof(uint64_t);
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+serial_communication_framework::commands::RequestBase::ParsingError GetOperationStatisticsRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(operation_code)) return ParsingError::payload_missing_bytes;
+
+    std::memcpy(&operation_code, &bytes[0], sizeof(operation_code));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetOperationStatisticsRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(operation_code) <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    std::memcpy(&target_buffer[0], &operation_code, sizeof(operation_code));
+
+    return target_buffer.subspan(0, sizeof(operation_code));
+}
+
+serial_communication_framework::commands::ResponseBase::ParsingError GetOperationStatisticsResponse::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < K_SERIALIZED_OPERATION_STATISTICS_SIZE) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&operation.requests, &bytes[idx], sizeof(operation.requests));
+    idx += sizeof(operation.requests);
+
+    std::memcpy(&operation.errors, &bytes[idx], sizeof(operation.errors));
+    idx += sizeof(operation.errors);
+
+    std::memcpy(&handler_time.count, &bytes[idx], sizeof(handler_time.count));
+    idx += sizeof(handler_time.count);
+
+    std::memcpy(&handler_time.min_us, &bytes[idx], sizeof(handler_time.min_us));
+    idx += sizeof(handler_time.min_us);
+
+    std::memcpy(&handler_time.max_us, &bytes[idx], sizeof(handler_time.max_us));
+    idx += sizeof(handler_time.max_us);
+
+    std::memcpy(&handler_time.total_us, &bytes[idx], sizeof(handler_time.total_us));
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> GetOperationStatisticsResponse::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(K_SERIALIZED_OPERATION_STATISTICS_SIZE <= target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &operation.requests, sizeof(operation.requests));
+    idx += sizeof(operation.requests);
+
+    std::memcpy(&target_buffer[idx], &operation.errors, sizeof(operation.errors));
+    idx += sizeof(operation.errors);
+
+    std::memcpy(&target_buffer[idx], &handler_time.count, sizeof(handler_time.count));
+    idx += sizeof(handler_time.count);
+
+    std::memcpy(&target_buffer[idx], &handler_time.min_us, sizeof(handler_time.min_us));
+    idx += sizeof(handler_time.min_us);
+
+    std::memcpy(&target_buffer[idx], &handler_time.max_us, sizeof(handler_time.max_us));
+    idx += sizeof(handler_time.max_us);
+
+    std::memcpy(&target_buffer[idx], &handler_time.total_us, sizeof(handler_time.total_us));
+    idx += sizeof(handler_time.total_us);
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
@@ -0,0 +1,47 @@
+#include "protocol/commands/subscribe_telemetry_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+serial_communication_framework::commands::RequestBase::ParsingError SubscribeTelemetryRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(period_us)) return ParsingError::payload_missing_bytes;
+
+    size_t idx = 0;
+    std::memcpy(&period_us, &bytes[idx], sizeof(period_us));
+    idx += sizeof(period_us);
+
+    const size_t id_count = (bytes.size_bytes() - idx) / sizeof(parameter_system::ParameterID);
+    if (id_count > parameter_ids.capacity()) return ParsingError::payload_does_not_fit;
+
+    parameter_ids.clear();
+    for (; idx < bytes.size_bytes(); idx += sizeof(parameter_system::ParameterID)) {
+        parameter_system::ParameterID id;
+        std::memcpy(&id, &bytes[idx], sizeof(id));
+        parameter_ids.pushBack(id);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> SubscribeTelemetryRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(sizeof(period_us) + parameter_ids.size() * sizeof(parameter_system::ParameterID) <=
+                            target_buffer.size_bytes(),
+                        "Target buffer is too small");
+
+    size_t idx = 0;
+    std::memcpy(&target_buffer[idx], &period_us, sizeof(period_us));
+    idx += sizeof(period_us);
+
+    for (const parameter_system::ParameterID id : parameter_ids) {
+        std::memcpy(&target_buffer[idx], &id, sizeof(id));
+        idx += sizeof(id);
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+}  // namespace protocol::commands
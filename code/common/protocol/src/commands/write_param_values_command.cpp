@@ -0,0 +1,91 @@
+#include "protocol/commands/write_param_values_command.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace protocol::commands {
+
+serial_communication_framework::commands::RequestBase::ParsingError WriteParamValuesRequest::deserialize(
+    std::span<uint8_t> bytes) {
+    entries.clear();
+    valid_value_byte_count = 0;
+
+    for (size_t idx = 0; idx < bytes.size_bytes();) {
+        if (bytes.size_bytes() - idx < K_SERIALIZED_ENTRY_HEADER_SIZE) return ParsingError::payload_missing_bytes;
+        if (entries.full()) return ParsingError::payload_does_not_fit;
+
+        Entry entry{};
+        std::memcpy(&entry.parameter_id, &bytes[idx], sizeof(entry.parameter_id));
+        idx += sizeof(entry.parameter_id);
+
+        std::memcpy(&entry.expected_value_type, &bytes[idx], sizeof(entry.expected_value_type));
+        idx += sizeof(entry.expected_value_type);
+
+        // The length of the value is only known from a valid value type, the rest of the payload can't be parsed
+        // without it
+        if (entry.expected_value_type >= parameter_system::ParameterValueType::none) {
+            return ParsingError::payload_missing_bytes;
+        }
+
+        const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type);
+        if (bytes.size_bytes() - idx < value_size) return ParsingError::payload_missing_bytes;
+
+        entry.value_offset = valid_value_byte_count;
+        std::memcpy(&value_bytes[valid_value_byte_count], &bytes[idx], value_size);
+        valid_value_byte_count += value_size;
+        idx += value_size;
+
+        entries.pushBack(entry);
+    }
+
+    return ParsingError::no_error;
+}
+
+std::span<uint8_t> WriteParamValuesRequest::serialize(std::span<uint8_t> target_buffer) {
+    ASSERT_WITH_MESSAGE(getSerializedSize() <= target_buffer.size_bytes(), "Target buffer is too small");
+
+    size_t idx = 0;
+    for (const Entry& entry : entries) {
+        std::memcpy(&target_buffer[idx], &entry.parameter_id, sizeof(entry.parameter_id));
+        idx += sizeof(entry.parameter_id);
+
+        std::memcpy(&target_buffer[idx], &entry.expected_value_type, sizeof(entry.expected_value_type));
+        idx += sizeof(entry.expected_value_type);
+
+        const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type);
+        std::memcpy(&target_buffer[idx], &value_bytes[entry.value_offset], value_size);
+        idx += value_size;
+    }
+
+    return target_buffer.subspan(0, idx);
+}
+
+bool WriteParamValuesRequest::putRaw(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+                                     std::span<const uint8_t> value) {
+    ASSERT_WITH_MESSAGE(value.size_bytes() == parameter_system::sizeOfCppTypeByParameterValueType(value_type),
+                        "Value size does not match the value type");
+
+    if (entries.full()) return false;
+    if (getSerializedSize() + K_SERIALIZED_ENTRY_HEADER_SIZE + value.size_bytes() >
+        serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE) {
+        return false;
+    }
+
+    entries.pushBack({.parameter_id = id, .expected_value_type = value_type, .value_offset = valid_value_byte_count});
+    std::memcpy(&value_bytes[valid_value_byte_count], value.data(), value.size_bytes());
+    valid_value_byte_count += value.size_bytes();
+
+    return true;
+}
+
+std::span<const uint8_t> WriteParamValuesRequest::getValueBytes(const Entry& entry) const {
+    return {&value_bytes[entry.value_offset],
+            parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type)};
+}
+
+size_t WriteParamValuesRequest::getSerializedSize() const {
+    return entries.size() * K_SERIALIZED_ENTRY_HEADER_SIZE + valid_value_byte_count;
+}
+
+}  // namespace protocol::commands
@@ -0,0 +1,18 @@
+#include "protocol/telemetry_frame.h"
+
+namespace protocol {
+
+TelemetryFrame::ParsingError TelemetryFrame::deserialize(uint8_t sender_id, std::span<uint8_t> bytes) {
+    if (bytes.size_bytes() < sizeof(sequence_number)) return ParsingError::payload_missing_bytes;
+    if (bytes.size_bytes() - sizeof(sequence_number) > K_RAW_BUFF_SIZE) return ParsingError::payload_does_not_fit;
+
+    device_id = sender_id;
+    std::memcpy(&sequence_number, bytes.data(), sizeof(sequence_number));
+
+    valid_byte_count = bytes.size_bytes() - sizeof(sequence_number);
+    std::memcpy(raw_bytes, &bytes[sizeof(sequence_number)], valid_byte_count);
+
+    return ParsingError::no_error;
+}
+
+}  // namespace protocol
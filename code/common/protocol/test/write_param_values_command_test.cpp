@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "protocol/commands/write_param_values_command.h"
+#include "protocol/parameters.h"
+
+using protocol::commands::WriteParamValuesRequest;
+using ParsingError = WriteParamValuesRequest::ParsingError;
+
+namespace {
+
+template <typename T>
+T valueOf(const WriteParamValuesRequest& request, size_t entry_index) {
+    T value;
+    std::memcpy(&value, request.getValueBytes(request.entries[entry_index]).data(), sizeof(value));
+    return value;
+}
+
+}  // namespace
+
+TEST(WriteParamValuesRequest, round_trips_the_entries_and_values) {
+    WriteParamValuesRequest request;
+    ASSERT_TRUE(request.put(protocol::test_params::test_uint8, 7));
+    ASSERT_TRUE(request.put(protocol::test_params::test_float, 2.5f));
+    ASSERT_TRUE(request.put(protocol::test_params::test_bool, true));
+
+    uint8_t                  buffer[serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE];
+    const std::span<uint8_t> serialized = request.serialize(buffer);
+    // Every entry is its id, its value type and its value
+    EXPECT_EQ(serialized.size_bytes(), request.getSerializedSize());
+    EXPECT_EQ(serialized.size_bytes(), 3 * WriteParamValuesRequest::K_SERIALIZED_ENTRY_HEADER_SIZE + 1 + 4 + 1);
+
+    WriteParamValuesRequest parsed;
+    ASSERT_EQ(parsed.deserialize(serialized), ParsingError::no_error);
+    ASSERT_EQ(parsed.entries.size(), 3u);
+    EXPECT_EQ(parsed.entries[0].parameter_id, protocol::test_params::test_uint8.id);
+    EXPECT_EQ(parsed.entries[0].expected_value_type, parameter_system::ParameterValueType::uint8);
+    EXPECT_EQ(parsed.entries[1].parameter_id, protocol::test_params::test_float.id);
+    EXPECT_EQ(parsed.entries[1].expected_value_type, parameter_system::ParameterValueType::floating_point);
+    EXPECT_EQ(parsed.entries[2].parameter_id, protocol::test_params::test_bool.id);
+    EXPECT_EQ(valueOf<uint8_t>(parsed, 0), 7);
+    EXPECT_FLOAT_EQ(valueOf<float>(parsed, 1), 2.5f);
+    EXPECT_EQ(valueOf<bool>(parsed, 2), true);
+}
+
+TEST(WriteParamValuesRequest, refuses_entries_that_do_not_fit_into_one_request) {
+    WriteParamValuesRequest request;
+    size_t                  put_count = 0;
+    while (request.put(protocol::test_params::test_test, put_count)) put_count++;
+
+    EXPECT_GT(put_count, 0u);
+    EXPECT_LE(request.getSerializedSize(), serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE);
+    EXPECT_EQ(request.entries.size(), put_count);
+}
+
+TEST(WriteParamValuesRequest, rejects_truncated_payloads) {
+    WriteParamValuesRequest request;
+    ASSERT_TRUE(request.put(protocol::test_params::test_uint32, 123456));
+
+    uint8_t                  buffer[serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE];
+    const std::span<uint8_t> serialized = request.serialize(buffer);
+
+    WriteParamValuesRequest parsed;
+    // Only part of the header, then only part of the value
+    EXPECT_EQ(parsed.deserialize(serialized.first(1)), ParsingError::payload_missing_bytes);
+    EXPECT_EQ(parsed.deserialize(serialized.first(serialized.size_bytes() - 1)), ParsingError::payload_missing_bytes);
+}
+
+TEST(WriteParamValuesRequest, rejects_an_unknown_value_type) {
+    std::vector<uint8_t> payload = {protocol::test_params::test_uint8.id,
+                                    static_cast<uint8_t>(parameter_system::ParameterValueType::none), 7};
+
+    WriteParamValuesRequest parsed;
+    EXPECT_EQ(parsed.deserialize(payload), ParsingError::payload_missing_bytes);
+}
@@ -0,0 +1,45 @@
+#ifndef CONTROL_API_LINUX_CONTEXT_H
+#define CONTROL_API_LINUX_CONTEXT_H
+
+#include <cstdint>
+#include <string>
+
+#include "control_api/Context.h"
+#include "control_api/linux/internal/MonotonicClock.h"
+#include "control_api/linux/internal/PosixSerialPortDriver.h"
+
+namespace servo_core_control_api::posix {
+
+namespace internal {
+
+// The base class of the Context is given the port and the clock in its constructor, so they are in a base class of
+// their own that is constructed before it
+struct SerialPortAndClock {
+    explicit SerialPortAndClock(const std::string& serial_port_name)
+        : serial_communication_driver(serial_port_name.c_str()) {}
+
+    PosixSerialPortDriver serial_communication_driver;
+    MonotonicClock        monotonic_clock;
+};
+
+}  // namespace internal
+
+class Context : private internal::SerialPortAndClock, public servo_core_control_api::Context {
+public:
+    /**
+     * @param serial_port_name Path of the tty the devices are connected to, e.g. `/dev/ttyACM0`.
+     */
+    explicit Context(std::string serial_port_name);
+    ~        Context() = default;
+
+    /**
+     * @brief Get the file descriptor of the serial port, for waiting on it in the application's own epoll set.
+     *
+     * The descriptor becomes readable when the devices have sent something, `run()` must then be called.
+     */
+    [[nodiscard]] int getFileDescriptor() const;
+};
+
+}  // namespace servo_core_control_api::posix
+
+#endif  // CONTROL_API_LINUX_CONTEXT_H
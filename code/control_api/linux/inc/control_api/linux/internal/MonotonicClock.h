@@ -0,0 +1,32 @@
+#ifndef CONTROL_API_LINUX_MONOTONICCLOCK_H
+#define CONTROL_API_LINUX_MONOTONICCLOCK_H
+
+#include <cstdint>
+
+#include "drivers/interfaces/ClockInterface.h"
+
+namespace servo_core_control_api::posix::internal {
+
+/**
+ * @brief Program uptime from CLOCK_MONOTONIC. Starts at zero when constructed.
+ *
+ * The clock isn't changed by setting the system time or by NTP steps, so the communication timeouts can't jump.
+ */
+class MonotonicClock final : public drivers::interfaces::ClockInterface {
+public:
+     MonotonicClock();
+    ~MonotonicClock() override = default;
+
+    uint64_t uptimeMicroseconds() override;
+    uint64_t uptimeMilliseconds() override;
+    uint64_t uptimeSeconds() override;
+
+private:
+    static uint64_t nowMicroseconds();
+
+    const uint64_t start_time_us_;
+};
+
+}  // namespace servo_core_control_api::posix::internal
+
+#endif  // CONTROL_API_LINUX_MONOTONICCLOCK_H
@@ -0,0 +1,107 @@
+#ifndef CONTROL_API_LINUX_POSIXSERIALPORTDRIVER_H
+#define CONTROL_API_LINUX_POSIXSERIALPORTDRIVER_H
+
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
+
+// `linux` is predefined as a macro by the GNU dialects of the compilers, so the namespace can't be named after the
+// directory
+namespace servo_core_control_api::posix::internal {
+
+/**
+ * @brief Serial port driver for a Linux tty, e.g. `/dev/ttyACM0` or `/dev/ttyUSB0`.
+ *
+ * The port is opened in raw mode, 8N1 without flow control, at the rate of K_DEFAULT_LINK_SETTINGS. The kernel's
+ * buffers of the tty are the rx and tx buffers, so nothing is read before it is asked for. Reads never block, and
+ * `waitForReceivedBytes()` sleeps until bytes arrive instead of polling the port in a busy loop.
+ *
+ * The low latency mode of the port's driver is turned on where there is one, so that e.g. a USB serial adapter passes
+ * on small responses right away instead of collecting them for its latency timer.
+ *
+ * Errors of the port throw std::runtime_error, the failed system calls std::system_error with their errno.
+ */
+class PosixSerialPortDriver : public drivers::interfaces::BufferedSerialCommunicationInterface,
+                              public drivers::interfaces::SerialPortConfigurationInterface {
+public:
+    explicit PosixSerialPortDriver(const char* serial_port_name);
+    ~        PosixSerialPortDriver() override;
+
+    PosixSerialPortDriver(const PosixSerialPortDriver&)            = delete;
+    PosixSerialPortDriver& operator=(const PosixSerialPortDriver&) = delete;
+
+    /**
+     * @brief Transmit the byte, waiting while the tx buffer of the tty is full.
+     */
+    void transmitByte(uint8_t byte) override;
+
+    /**
+     * @brief Transmit the bytes, waiting while the tx buffer of the tty is full.
+     */
+    void transmitBytes(std::span<uint8_t> bytes) override;
+
+    size_t getReceivedBytesAvailableAmount() override;
+
+    uint8_t readReceivedByte() override;
+
+    size_t readReceivedBytes(std::span<uint8_t> buffer) override;
+
+    /**
+     * @brief Get the amount of bytes the port's hardware and the tty have dropped since the port was opened.
+     *
+     * Always 0 for the ttys that don't count them, e.g. pseudo terminals.
+     */
+    uint64_t getRxOverflowCount() override;
+
+    /**
+     * @brief Change the baud rate. The standard rates of termios are supported, up to 4000000.
+     */
+    [[nodiscard]] bool setBaudRate(uint32_t baud_rate) override;
+
+    [[nodiscard]] uint32_t getBaudRate() override;
+
+    void flushTx() override;
+
+    /**
+     * @brief Sleep in ppoll until received bytes are available, the timeout has passed or the wait is interrupted.
+     */
+    bool waitForReceivedBytes(uint64_t timeout_us) override;
+
+    /**
+     * @brief Wake up the wait by signalling an eventfd that it polls together with the port.
+     */
+    void interruptWaitForReceivedBytes() override;
+
+    /**
+     * @brief Get the file descriptor of the port, e.g. to wait for received bytes in an epoll set with other sources.
+     *
+     * The descriptor stays owned by the driver and must only be waited on, not read from or written to.
+     */
+    [[nodiscard]] int getFileDescriptor() const;
+
+private:
+    void setUpRawMode();
+
+    void enableLowLatencyMode();
+
+    /**
+     * @brief Get the amount of rx overruns the port's driver has counted since it was loaded.
+     */
+    uint64_t readKernelRxOverflowCount();
+
+    /**
+     * @brief Wait until the tx buffer of the tty has room for more bytes.
+     */
+    void waitUntilWritable();
+
+    int      file_descriptor_;
+    int      wake_up_file_descriptor_;  // eventfd, readable while a wait is interrupted
+    uint32_t baud_rate_;
+    uint64_t rx_overflow_count_at_open_ = 0;
+};
+
+}  // namespace servo_core_control_api::posix::internal
+
+#endif  // CONTROL_API_LINUX_POSIXSERIALPORTDRIVER_H
@@ -0,0 +1,20 @@
+#include "control_api/linux/Context.h"
+
+#include <iostream>
+
+#include "debug_print/debug_print.h"
+
+namespace servo_core_control_api::posix {
+
+void debugPrintPutChar(char c) { std::cout << c; }
+void debugPrintFlush() { std::cout << std::flush; }
+
+Context::Context(std::string serial_port_name)
+    : internal::SerialPortAndClock(serial_port_name),
+      servo_core_control_api::Context(serial_communication_driver, monotonic_clock, &serial_communication_driver) {
+    debug_print::connectPutCharAndFlushFunctions(debugPrintPutChar, debugPrintFlush);
+}
+
+int Context::getFileDescriptor() const { return serial_communication_driver.getFileDescriptor(); }
+
+}  // namespace servo_core_control_api::posix
@@ -0,0 +1,21 @@
+#include "control_api/linux/internal/MonotonicClock.h"
+
+#include <time.h>
+
+namespace servo_core_control_api::posix::internal {
+
+MonotonicClock::MonotonicClock() : start_time_us_(nowMicroseconds()) {}
+
+uint64_t MonotonicClock::uptimeMicroseconds() { return nowMicroseconds() - start_time_us_; }
+
+uint64_t MonotonicClock::uptimeMilliseconds() { return uptimeMicroseconds() / 1'000; }
+
+uint64_t MonotonicClock::uptimeSeconds() { return uptimeMicroseconds() / 1'000'000; }
+
+uint64_t MonotonicClock::nowMicroseconds() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1'000'000 + static_cast<uint64_t>(now.tv_nsec) / 1'000;
+}
+
+}  // namespace servo_core_control_api::posix::internal
@@ -0,0 +1,264 @@
+#include "control_api/linux/internal/PosixSerialPortDriver.h"
+
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "serial_communication_framework/common.h"
+
+namespace servo_core_control_api::posix::internal {
+
+namespace {
+
+// How long a transmit waits for room in a full tx buffer, e.g. while the device doesn't let the adapter send
+constexpr int K_TX_TIMEOUT_MS = 1'000;
+
+constexpr std::array<std::pair<uint32_t, speed_t>, 18> K_BAUD_RATE_SPEEDS = {{
+    {9600, B9600},
+    {19200, B19200},
+    {38400, B38400},
+    {57600, B57600},
+    {115200, B115200},
+    {230400, B230400},
+    {460800, B460800},
+    {500000, B500000},
+    {576000, B576000},
+    {921600, B921600},
+    {1000000, B1000000},
+    {1152000, B1152000},
+    {1500000, B1500000},
+    {2000000, B2000000},
+    {2500000, B2500000},
+    {3000000, B3000000},
+    {3500000, B3500000},
+    {4000000, B4000000},
+}};
+
+std::optional<speed_t> toTermiosSpeed(uint32_t baud_rate) {
+    for (const auto& [rate, speed] : K_BAUD_RATE_SPEEDS) {
+        if (rate == baud_rate) return speed;
+    }
+    return {};
+}
+
+}  // namespace
+
+PosixSerialPortDriver::PosixSerialPortDriver(const char* serial_port_name)
+    : baud_rate_(serial_communication_framework::K_DEFAULT_LINK_SETTINGS.baud_rate) {
+    // Not the controlling terminal of this process, a device that drops its line would otherwise hang it up
+    file_descriptor_ = open(serial_port_name, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (file_descriptor_ < 0) {
+        if (errno == ENOENT) {
+            throw std::runtime_error("could not open serial port: The serial port does not exist");
+        }
+        throw std::system_error(errno, std::generic_category(), "could not open serial port");
+    }
+
+    wake_up_file_descriptor_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_up_file_descriptor_ < 0) {
+        const int error = errno;
+        close(file_descriptor_);
+        throw std::system_error(error, std::generic_category(), "could not create the wake up event");
+    }
+
+    try {
+        // Another process writing into the same port would corrupt the packets of both
+        if (ioctl(file_descriptor_, TIOCEXCL) != 0) {
+            throw std::system_error(errno, std::generic_category(), "could not lock serial port");
+        }
+        setUpRawMode();
+    } catch (...) {
+        close(wake_up_file_descriptor_);
+        close(file_descriptor_);
+        throw;
+    }
+
+    enableLowLatencyMode();
+    rx_overflow_count_at_open_ = readKernelRxOverflowCount();
+
+    // Clear out garbage that might exist in the tty buffers from before the port was opened
+    tcflush(file_descriptor_, TCIOFLUSH);
+}
+
+PosixSerialPortDriver::~PosixSerialPortDriver() {
+    close(wake_up_file_descriptor_);
+    close(file_descriptor_);
+}
+
+void PosixSerialPortDriver::transmitByte(uint8_t byte) { transmitBytes(std::span<uint8_t>(&byte, 1)); }
+
+void PosixSerialPortDriver::transmitBytes(std::span<uint8_t> bytes) {
+    size_t written_count = 0;
+    while (written_count < bytes.size()) {
+        const ssize_t written = write(file_descriptor_, bytes.data() + written_count, bytes.size() - written_count);
+        if (written >= 0) {
+            written_count += written;
+        } else if (errno == EAGAIN) {
+            waitUntilWritable();
+        } else if (errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "could not write to serial port");
+        }
+    }
+}
+
+size_t PosixSerialPortDriver::getReceivedBytesAvailableAmount() {
+    int available_count = 0;
+    if (ioctl(file_descriptor_, FIONREAD, &available_count) != 0) {
+        throw std::system_error(errno, std::generic_category(), "could not get received byte count");
+    }
+    return available_count;
+}
+
+uint8_t PosixSerialPortDriver::readReceivedByte() {
+    uint8_t byte;
+    if (readReceivedBytes(std::span<uint8_t>(&byte, 1)) != 1) {
+        throw std::runtime_error("Serial port reading timed out");
+    }
+    return byte;
+}
+
+size_t PosixSerialPortDriver::readReceivedBytes(std::span<uint8_t> buffer) {
+    while (true) {
+        const ssize_t bytes_read = read(file_descriptor_, buffer.data(), buffer.size_bytes());
+        if (bytes_read >= 0) return bytes_read;
+        if (errno == EAGAIN) return 0;
+        if (errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "could not read from serial port");
+        }
+    }
+}
+
+uint64_t PosixSerialPortDriver::getRxOverflowCount() {
+    return readKernelRxOverflowCount() - rx_overflow_count_at_open_;
+}
+
+bool PosixSerialPortDriver::setBaudRate(uint32_t baud_rate) {
+    const std::optional<speed_t> speed = toTermiosSpeed(baud_rate);
+    if (!speed.has_value()) return false;
+
+    termios settings;
+    if (tcgetattr(file_descriptor_, &settings) != 0) {
+        throw std::system_error(errno, std::generic_category(), "could not get serial parameters");
+    }
+    cfsetispeed(&settings, *speed);
+    cfsetospeed(&settings, *speed);
+    // The driver refuses the rates its hardware can't produce, the port keeps the previous rate then
+    if (tcsetattr(file_descriptor_, TCSANOW, &settings) != 0) return false;
+
+    // Whatever was received during the switch is garbage
+    tcflush(file_descriptor_, TCIFLUSH);
+    baud_rate_ = baud_rate;
+    return true;
+}
+
+uint32_t PosixSerialPortDriver::getBaudRate() { return baud_rate_; }
+
+void PosixSerialPortDriver::flushTx() {
+    if (tcdrain(file_descriptor_) != 0) {
+        throw std::system_error(errno, std::generic_category(), "could not flush serial port");
+    }
+}
+
+bool PosixSerialPortDriver::waitForReceivedBytes(uint64_t timeout_us) {
+    std::array<pollfd, 2> poll_fds = {{
+        {.fd = file_descriptor_, .events = POLLIN, .revents = 0},
+        {.fd = wake_up_file_descriptor_, .events = POLLIN, .revents = 0},
+    }};
+    const timespec timeout = {.tv_sec  = static_cast<time_t>(timeout_us / 1'000'000),
+                              .tv_nsec = static_cast<long>(timeout_us % 1'000'000 * 1'000)};
+    const int      result  = ppoll(poll_fds.data(), poll_fds.size(), &timeout, nullptr);
+
+    if (result < 0) {
+        // Interrupted by a signal, the caller waits again if it has to
+        if (errno == EINTR) return false;
+        throw std::system_error(errno, std::generic_category(), "could not wait for the serial port");
+    }
+    if ((poll_fds[1].revents & POLLIN) != 0) {
+        // Consumes the interruption, reading resets the counter of the eventfd
+        uint64_t                       interruption_count = 0;
+        [[maybe_unused]] const ssize_t read_count =
+            read(wake_up_file_descriptor_, &interruption_count, sizeof(interruption_count));
+    }
+
+    const short port_events = poll_fds[0].revents;
+    if ((port_events & (POLLERR | POLLHUP | POLLNVAL)) != 0 && (port_events & POLLIN) == 0) {
+        throw std::runtime_error("serial port was disconnected");
+    }
+    return (port_events & POLLIN) != 0;
+}
+
+void PosixSerialPortDriver::interruptWaitForReceivedBytes() {
+    // Only fails when the counter is about to overflow, the wait is interrupted then anyway
+    const uint64_t                 interruption  = 1;
+    [[maybe_unused]] const ssize_t written_count = write(wake_up_file_descriptor_, &interruption, sizeof(interruption));
+}
+
+int PosixSerialPortDriver::getFileDescriptor() const { return file_descriptor_; }
+
+void PosixSerialPortDriver::setUpRawMode() {
+    const std::optional<speed_t> speed = toTermiosSpeed(baud_rate_);
+    if (!speed.has_value()) {
+        throw std::runtime_error("unsupported default baud rate " + std::to_string(baud_rate_));
+    }
+
+    termios settings;
+    if (tcgetattr(file_descriptor_, &settings) != 0) {
+        throw std::system_error(errno, std::generic_category(), "could not get serial parameters");
+    }
+
+    // No line editing, echo, signals or translation of any bytes, 8 data bits without parity
+    cfmakeraw(&settings);
+    settings.c_cflag |= CLOCAL | CREAD;
+    settings.c_cflag &= ~(CSTOPB | CRTSCTS);
+    settings.c_iflag &= ~(IXON | IXOFF | IXANY);
+    // A read returns whatever has arrived right away, the waiting is done with poll
+    settings.c_cc[VMIN]  = 0;
+    settings.c_cc[VTIME] = 0;
+    cfsetispeed(&settings, *speed);
+    cfsetospeed(&settings, *speed);
+
+    if (tcsetattr(file_descriptor_, TCSANOW, &settings) != 0) {
+        throw std::system_error(errno, std::generic_category(), "could not set serial parameters");
+    }
+}
+
+void PosixSerialPortDriver::enableLowLatencyMode() {
+    // Only the drivers of real serial ports have these settings, everything works without them, just slower
+    serial_struct serial_info;
+    if (ioctl(file_descriptor_, TIOCGSERIAL, &serial_info) != 0) return;
+
+    serial_info.flags |= ASYNC_LOW_LATENCY;
+    (void)ioctl(file_descriptor_, TIOCSSERIAL, &serial_info);
+}
+
+uint64_t PosixSerialPortDriver::readKernelRxOverflowCount() {
+    serial_icounter_struct counters;
+    if (ioctl(file_descriptor_, TIOCGICOUNT, &counters) != 0) return rx_overflow_count_at_open_;
+
+    // Overruns of the hardware fifo and of the tty's own buffer
+    return static_cast<uint64_t>(counters.overrun) + static_cast<uint64_t>(counters.buf_overrun);
+}
+
+void PosixSerialPortDriver::waitUntilWritable() {
+    pollfd    poll_fd = {.fd = file_descriptor_, .events = POLLOUT, .revents = 0};
+    const int result  = poll(&poll_fd, 1, K_TX_TIMEOUT_MS);
+
+    if (result == 0) throw std::runtime_error("Serial port writing timed out");
+    if (result < 0 && errno != EINTR) {
+        throw std::system_error(errno, std::generic_category(), "could not wait for the serial port");
+    }
+}
+
+}  // namespace servo_core_control_api::posix::internal
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <thread>
+
+#include "control_api/linux/Context.h"
+#include "control_api/linux/internal/MonotonicClock.h"
+#include "protocol/commands.h"
+#include "pseudo_terminal.h"
+#include "serial_communication_framework/SlaveHandler.h"
+
+using serial_communication_framework::ResponseCode;
+using servo_core_control_api::posix::Context;
+using servo_core_control_api::posix::test::PseudoTerminal;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID = 5;
+
+protocol::commands::Ping::Response ping(const protocol::commands::Ping::Request& request) {
+    (void)request;  // unused
+    protocol::commands::Ping::Response response;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+// Answers pings on the other end of the pseudo terminal, in its own thread
+class PingedDevice {
+public:
+    explicit PingedDevice(PseudoTerminal& pseudo_terminal) : slave_handler_(pseudo_terminal, clock_, K_DEVICE_ID) {
+        slave_handler_.registerCommandHandler<protocol::commands::Ping, ping>();
+        thread_ = std::thread([this] {
+            while (!stop_) slave_handler_.run();
+        });
+    }
+
+    ~PingedDevice() {
+        stop_ = true;
+        thread_.join();
+    }
+
+private:
+    servo_core_control_api::posix::internal::MonotonicClock clock_;
+    serial_communication_framework::SlaveHandler            slave_handler_;
+    std::atomic<bool>                                       stop_ = false;
+    std::thread                                             thread_;
+};
+
+void countAnsweredPing(const protocol::commands::Ping::Response& response, void* user_data) {
+    if (response.response_code == ResponseCode::ok) (*static_cast<int*>(user_data))++;
+}
+
+}  // namespace
+
+TEST(LinuxContext, finds_a_device_over_a_pseudo_terminal) {
+    PseudoTerminal pseudo_terminal;
+    Context        context(pseudo_terminal.getPortName());
+    context.open();
+    PingedDevice device(pseudo_terminal);
+
+    EXPECT_TRUE(context.tryFindDeviceById(K_DEVICE_ID).has_value());
+}
+
+TEST(LinuxContext, runs_only_when_woken_up_by_a_response) {
+    PseudoTerminal pseudo_terminal;
+    Context        context(pseudo_terminal.getPortName());
+    context.open();
+    PingedDevice device(pseudo_terminal);
+
+    std::optional<servo_core_control_api::Device> found_device = context.tryFindDeviceById(K_DEVICE_ID);
+    ASSERT_TRUE(found_device.has_value());
+
+    int answered_count = 0;
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(found_device->submitCommand<protocol::commands::Ping>({}, countAnsweredPing, &answered_count));
+    }
+
+    int wake_up_count = 0;
+    while (answered_count < 3 && context.waitForReceivedBytes(1'000'000)) {
+        context.run();
+        wake_up_count++;
+    }
+    EXPECT_EQ(answered_count, 3);
+    EXPECT_LE(wake_up_count, 100);
+}
+
+TEST(LinuxContext, throws_for_a_port_that_does_not_exist) {
+    EXPECT_THROW(Context("/dev/servo_core_no_such_port"), std::runtime_error);
+}
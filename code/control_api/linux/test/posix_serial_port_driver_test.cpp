@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "control_api/linux/internal/MonotonicClock.h"
+#include "control_api/linux/internal/PosixSerialPortDriver.h"
+#include "pseudo_terminal.h"
+#include "serial_communication_framework/common.h"
+
+using servo_core_control_api::posix::internal::MonotonicClock;
+using servo_core_control_api::posix::internal::PosixSerialPortDriver;
+using servo_core_control_api::posix::test::PseudoTerminal;
+
+namespace {
+
+constexpr uint64_t K_WAIT_TIMEOUT_US = 1'000'000;
+
+std::vector<uint8_t> readAll(PosixSerialPortDriver& driver) {
+    std::vector<uint8_t> bytes(driver.getReceivedBytesAvailableAmount());
+    bytes.resize(driver.readReceivedBytes(bytes));
+    return bytes;
+}
+
+}  // namespace
+
+TEST(PosixSerialPortDriver, transmits_bytes_to_the_other_end) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+
+    // Raw mode, none of these is translated or taken for a control character
+    std::vector<uint8_t> bytes = {'\n', '\r', 0x03, 0x11, 0x13, 0x7F, 0x00, 0xFF};
+    driver.transmitBytes(bytes);
+    driver.transmitByte(0x42);
+
+    bytes.push_back(0x42);
+    EXPECT_EQ(pseudo_terminal.receive(bytes.size()), bytes);
+}
+
+TEST(PosixSerialPortDriver, receives_the_bytes_of_the_other_end) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+    EXPECT_EQ(driver.getReceivedBytesAvailableAmount(), 0u);
+
+    std::vector<uint8_t> bytes = {'\n', '\r', 0x03, 0x11, 0x13, 0x7F, 0x00, 0xFF};
+    pseudo_terminal.transmitBytes(bytes);
+
+    ASSERT_TRUE(driver.waitForReceivedBytes(K_WAIT_TIMEOUT_US));
+    std::vector<uint8_t> received;
+    while (received.size() < bytes.size() && driver.waitForReceivedBytes(K_WAIT_TIMEOUT_US)) {
+        const std::vector<uint8_t> chunk = readAll(driver);
+        received.insert(received.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(received, bytes);
+    EXPECT_EQ(driver.readReceivedBytes(received), 0u);
+    EXPECT_EQ(driver.getRxOverflowCount(), 0u);
+}
+
+TEST(PosixSerialPortDriver, wait_times_out_when_nothing_arrives) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+    MonotonicClock        clock;
+
+    EXPECT_FALSE(driver.waitForReceivedBytes(0));
+    EXPECT_FALSE(driver.waitForReceivedBytes(20'000));
+    EXPECT_GE(clock.uptimeMicroseconds(), 20'000u);
+}
+
+TEST(PosixSerialPortDriver, wait_wakes_up_when_a_byte_arrives) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+    MonotonicClock        clock;
+
+    pseudo_terminal.transmitByte(7);
+    ASSERT_TRUE(driver.waitForReceivedBytes(10 * K_WAIT_TIMEOUT_US));
+    EXPECT_LT(clock.uptimeMicroseconds(), K_WAIT_TIMEOUT_US);
+    EXPECT_EQ(driver.readReceivedByte(), 7);
+}
+
+TEST(PosixSerialPortDriver, wait_wakes_up_when_interrupted) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+    MonotonicClock        clock;
+
+    std::thread interrupter([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        driver.interruptWaitForReceivedBytes();
+    });
+    EXPECT_FALSE(driver.waitForReceivedBytes(10 * K_WAIT_TIMEOUT_US));
+    interrupter.join();
+    EXPECT_LT(clock.uptimeMicroseconds(), K_WAIT_TIMEOUT_US);
+
+    // The interruption is used up, the next wait sleeps again
+    const uint64_t start_time_us = clock.uptimeMicroseconds();
+    EXPECT_FALSE(driver.waitForReceivedBytes(20'000));
+    EXPECT_GE(clock.uptimeMicroseconds() - start_time_us, 20'000u);
+}
+
+TEST(PosixSerialPortDriver, switches_between_the_standard_baud_rates) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+    EXPECT_EQ(driver.getBaudRate(), serial_communication_framework::K_DEFAULT_LINK_SETTINGS.baud_rate);
+
+    for (uint32_t baud_rate : {115200u, 921600u, 3000000u}) {
+        EXPECT_TRUE(driver.setBaudRate(baud_rate));
+        EXPECT_EQ(driver.getBaudRate(), baud_rate);
+    }
+
+    EXPECT_FALSE(driver.setBaudRate(123'456));
+    EXPECT_EQ(driver.getBaudRate(), 3'000'000u);
+}
+
+TEST(PosixSerialPortDriver, locks_the_port_from_other_users) {
+    PseudoTerminal        pseudo_terminal;
+    PosixSerialPortDriver driver(pseudo_terminal.getPortName().c_str());
+
+    // Root may open a locked tty anyway
+    if (geteuid() == 0) GTEST_SKIP();
+    EXPECT_THROW(PosixSerialPortDriver(pseudo_terminal.getPortName().c_str()), std::runtime_error);
+}
+
+TEST(PosixSerialPortDriver, throws_for_a_port_that_does_not_exist) {
+    EXPECT_THROW(PosixSerialPortDriver("/dev/servo_core_no_such_port"), std::runtime_error);
+}
+
+TEST(MonotonicClock, starts_at_zero_and_moves_forward) {
+    MonotonicClock clock;
+    EXPECT_LT(clock.uptimeMilliseconds(), 1'000u);
+
+    const uint64_t first_us = clock.uptimeMicroseconds();
+    usleep(2'000);
+    EXPECT_GE(clock.uptimeMicroseconds(), first_us + 2'000);
+}
@@ -0,0 +1,89 @@
+#ifndef CONTROL_API_LINUX_TEST_PSEUDO_TERMINAL_H
+#define CONTROL_API_LINUX_TEST_PSEUDO_TERMINAL_H
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+
+namespace servo_core_control_api::posix::test {
+
+/**
+ * @brief A pseudo terminal pair, the serial port under test is opened from `getPortName()`.
+ *
+ * The other end, the pseudo terminal master, stands in for the device. It is a serial interface too, so that a
+ * SlaveHandler can answer on it.
+ */
+class PseudoTerminal final : public drivers::interfaces::BufferedSerialCommunicationInterface {
+public:
+    PseudoTerminal() {
+        master_fd_ = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (master_fd_ < 0 || grantpt(master_fd_) != 0 || unlockpt(master_fd_) != 0) {
+            throw std::runtime_error("could not open a pseudo terminal");
+        }
+        port_name_ = ptsname(master_fd_);
+    }
+
+    ~PseudoTerminal() override { close(master_fd_); }
+
+    [[nodiscard]] const std::string& getPortName() const { return port_name_; }
+
+    /**
+     * @brief Read what the port under test has transmitted, waiting until the amount has arrived.
+     */
+    std::vector<uint8_t> receive(size_t size, int timeout_ms = 1'000) {
+        std::vector<uint8_t> bytes;
+        pollfd               poll_fd = {.fd = master_fd_, .events = POLLIN, .revents = 0};
+        while (bytes.size() < size && poll(&poll_fd, 1, timeout_ms) > 0) {
+            uint8_t       buffer[256];
+            const ssize_t bytes_read = read(master_fd_, buffer, std::min(sizeof(buffer), size - bytes.size()));
+            if (bytes_read > 0) bytes.insert(bytes.end(), buffer, buffer + bytes_read);
+        }
+        return bytes;
+    }
+
+    void transmitByte(uint8_t byte) override { transmitBytes(std::span<uint8_t>(&byte, 1)); }
+
+    void transmitBytes(std::span<uint8_t> bytes) override {
+        if (write(master_fd_, bytes.data(), bytes.size()) != static_cast<ssize_t>(bytes.size())) {
+            throw std::runtime_error("could not write to the pseudo terminal");
+        }
+    }
+
+    size_t getReceivedBytesAvailableAmount() override {
+        int available_count = 0;
+        ioctl(master_fd_, FIONREAD, &available_count);
+        return available_count;
+    }
+
+    uint8_t readReceivedByte() override {
+        uint8_t byte = 0;
+        (void)readReceivedBytes(std::span<uint8_t>(&byte, 1));
+        return byte;
+    }
+
+    size_t readReceivedBytes(std::span<uint8_t> bytes) override {
+        const ssize_t bytes_read = read(master_fd_, bytes.data(), bytes.size());
+        return bytes_read > 0 ? bytes_read : 0;
+    }
+
+    uint64_t getRxOverflowCount() override { return 0; }
+
+private:
+    int         master_fd_;
+    std::string port_name_;
+};
+
+}  // namespace servo_core_control_api::posix::test
+
+#endif  // CONTROL_API_LINUX_TEST_PSEUDO_TERMINAL_H
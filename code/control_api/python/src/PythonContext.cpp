@@ -0,0 +1,121 @@
+#include "PythonContext.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+namespace py = pybind11;
+
+namespace servo_core_control_api::python {
+
+PythonContext::PythonContext(const std::string& serial_port_name)
+    : context_(std::make_unique<PlatformContext>(serial_port_name)) {
+    init();
+}
+
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+PythonContext::PythonContext(std::unique_ptr<device_simulator::DeviceSimulator> simulator)
+    : simulator_(std::move(simulator)),
+      context_(std::make_unique<Context>(simulator_->getMasterEnd(), simulator_->getClock(),
+                                         &simulator_->getMasterEnd())) {
+    init();
+}
+
+std::shared_ptr<PythonContext> PythonContext::simulated() {
+    // The device runs in a thread of its own, so that run() can wait for its telemetry like for a real one
+    auto simulator = std::make_unique<device_simulator::DeviceSimulator>(
+        drivers::host::LinkModel{}, device_simulator::DeviceSimulator::RunMode::own_thread);
+    // Not with make_shared, the constructor is private
+    return std::shared_ptr<PythonContext>(new PythonContext(std::move(simulator)));
+}
+#endif
+
+void PythonContext::init() {
+    context_->open();
+    context_->setTelemetryCallback(onTelemetryFrame, this);
+}
+
+std::unique_lock<std::mutex> PythonContext::lock() { return std::unique_lock(mutex_); }
+
+Context& PythonContext::getContext() { return *context_; }
+
+DeviceParameters& PythonContext::getDeviceParameters(uint8_t device_id) { return device_parameters_[device_id]; }
+
+void PythonContext::run(double timeout_s) {
+    py::gil_scoped_release       release;
+    std::unique_lock<std::mutex> context_lock = lock();
+
+    const double timeout_us = std::max(timeout_s, 0.0) * 1e6;
+    (void)context_->waitForReceivedBytes(static_cast<uint64_t>(timeout_us));
+    context_->run();
+}
+
+void PythonContext::setTelemetryLayout(uint8_t device_id, ValueLayout layout) {
+    ValueLayout record_layout = toRecordLayout(std::move(layout));
+
+    std::scoped_lock telemetry_lock(telemetry_mutex_);
+    TelemetryStream& stream = telemetry_streams_[device_id];
+    stream.layout           = std::move(record_layout);
+    stream.records.clear();
+}
+
+py::array PythonContext::takeTelemetry(uint8_t device_id) {
+    std::unique_lock telemetry_lock(telemetry_mutex_);
+    const auto       stream_it = telemetry_streams_.find(device_id);
+    if (stream_it == telemetry_streams_.end()) {
+        telemetry_lock.unlock();
+        return py::array(toRecordLayout({}).toDtype(), {py::ssize_t{0}});
+    }
+
+    TelemetryStream& stream  = stream_it->second;
+    auto             records = std::make_unique<std::vector<uint8_t>>(std::move(stream.records));
+    stream.records.clear();
+    const py::dtype dtype       = stream.layout.toDtype();
+    const size_t    record_size = stream.layout.size;
+    telemetry_lock.unlock();
+
+    // The records are not copied, the array owns the buffer they are in
+    const auto            record_count = static_cast<py::ssize_t>(records->size() / record_size);
+    std::vector<uint8_t>* buffer       = records.release();
+    py::capsule           owner(buffer, [](void* buffer) { delete static_cast<std::vector<uint8_t>*>(buffer); });
+
+    return py::array(dtype, {record_count}, {static_cast<py::ssize_t>(record_size)}, buffer->data(), owner);
+}
+
+uint64_t PythonContext::getMismatchedTelemetryFrameCount() {
+    std::scoped_lock telemetry_lock(telemetry_mutex_);
+    return mismatched_telemetry_frame_count_;
+}
+
+ValueLayout PythonContext::toRecordLayout(ValueLayout layout) {
+    // Every record starts with the sequence number of its frame
+    ValueLayout record_layout;
+    record_layout.append("sequence_number", parameter_system::ParameterValueType::uint16);
+    for (ValueLayout::Field& field : layout.fields) {
+        record_layout.append(std::move(field.name), field.value_type);
+    }
+    return record_layout;
+}
+
+void PythonContext::onTelemetryFrame(const protocol::TelemetryFrame& frame, void* user_data) {
+    auto* self = static_cast<PythonContext*>(user_data);
+
+    std::scoped_lock telemetry_lock(self->telemetry_mutex_);
+    const auto       stream_it = self->telemetry_streams_.find(frame.device_id);
+    // E.g. from a device subscribed elsewhere or from the subscription before the current one
+    if (stream_it == self->telemetry_streams_.end() ||
+        K_SEQUENCE_NUMBER_SIZE + frame.valid_byte_count != stream_it->second.layout.size) {
+        self->mismatched_telemetry_frame_count_++;
+        return;
+    }
+
+    TelemetryStream&      stream       = stream_it->second;
+    std::vector<uint8_t>& records      = stream.records;
+    const size_t          record_index = records.size();
+    records.resize(record_index + stream.layout.size);
+    std::memcpy(&records[record_index], &frame.sequence_number, K_SEQUENCE_NUMBER_SIZE);
+    std::memcpy(&records[record_index + K_SEQUENCE_NUMBER_SIZE], frame.raw_bytes, frame.valid_byte_count);
+}
+
+}  // namespace servo_core_control_api::python
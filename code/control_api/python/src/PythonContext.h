@@ -0,0 +1,145 @@
+#ifndef CONTROL_API_PYTHON_PYTHONCONTEXT_H
+#define CONTROL_API_PYTHON_PYTHONCONTEXT_H
+
+#include <pybind11/numpy.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+#include "protocol/telemetry_frame.h"
+#include "value_layout.h"
+
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+#include "device_simulator/DeviceSimulator.h"
+#endif
+
+#if defined(_WIN32)
+#include "control_api/windows/Context.h"
+#else
+#include "control_api/linux/Context.h"
+#endif
+
+namespace servo_core_control_api::python {
+
+#if defined(_WIN32)
+using PlatformContext = servo_core_control_api::windows::Context;
+#else
+using PlatformContext = servo_core_control_api::posix::Context;
+#endif
+
+/**
+ * @brief What is known of the parameters of one device, filled in as they are used.
+ */
+struct DeviceParameters {
+    std::unordered_map<ParameterID, ParameterMetaData> meta_data;
+    bool                                               all_fetched = false;  // Every registered id is in meta_data
+    ValueLayout                                        capture_layout;
+};
+
+/**
+ * @brief The Context of one serial port as seen from Python.
+ *
+ * The Context and the devices on it are used by one thread at a time, the one holding `lock()`. The serial I/O is
+ * done with the lock held and the GIL released, so the Python threads using the other ports keep running.
+ *
+ * The telemetry frames received in `run()` are appended to a buffer of records per device, which `takeTelemetry()`
+ * hands over to NumPy as is.
+ */
+class PythonContext {
+public:
+    explicit PythonContext(const std::string& serial_port_name);
+
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+    /**
+     * @brief Create a Context connected to a DeviceSimulator instead of a serial port, e.g. for trying out scripts
+     *        and for the tests of the module. Only one simulated Context can exist at a time.
+     *
+     * Only in the module built for the tests, the released one doesn't carry the firmware's protocol handlers.
+     */
+    static std::shared_ptr<PythonContext> simulated();
+#endif
+
+    PythonContext(const PythonContext&)            = delete;
+    PythonContext& operator=(const PythonContext&) = delete;
+
+    [[nodiscard]] std::unique_lock<std::mutex> lock();
+
+    /**
+     * @brief Only with `lock()` held.
+     */
+    [[nodiscard]] Context& getContext();
+
+    /**
+     * @brief Only with `lock()` held.
+     */
+    [[nodiscard]] DeviceParameters& getDeviceParameters(uint8_t device_id);
+
+    /**
+     * @brief Wait for the devices to send something and receive it. Releases the GIL.
+     *
+     * @param timeout_s How long to wait at most.
+     */
+    void run(double timeout_s);
+
+    /**
+     * @brief Start collecting the telemetry records of the device in the layout, dropping the ones collected so far.
+     *
+     * Only with `lock()` held, the records are appended in `run()`.
+     */
+    void setTelemetryLayout(uint8_t device_id, ValueLayout layout);
+
+    /**
+     * @brief Hand over the telemetry records of the device collected since the previous call, without copying them.
+     *        Needs the GIL.
+     *
+     * @return Structured array with the `sequence_number` and the subscribed values of every frame.
+     */
+    pybind11::array takeTelemetry(uint8_t device_id);
+
+    /**
+     * @brief Get the amount of frames dropped because they didn't match the parameters subscribed from their device.
+     */
+    [[nodiscard]] uint64_t getMismatchedTelemetryFrameCount();
+
+private:
+    static constexpr size_t K_SEQUENCE_NUMBER_SIZE = sizeof(protocol::TelemetryFrame::sequence_number);
+
+    // The records of the frames of one device
+    struct TelemetryStream {
+        ValueLayout          layout;
+        std::vector<uint8_t> records;
+    };
+
+    std::mutex mutex_;
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+    // Declared before the Context, which uses its link until destroyed
+    std::unique_ptr<device_simulator::DeviceSimulator> simulator_;
+#endif
+    std::unique_ptr<Context> context_;
+
+    std::unordered_map<uint8_t, DeviceParameters> device_parameters_;
+
+    // Written by run() while the Python threads may be taking them, so behind a mutex of their own
+    std::mutex                                   telemetry_mutex_;
+    std::unordered_map<uint8_t, TelemetryStream> telemetry_streams_;
+    uint64_t                                     mismatched_telemetry_frame_count_ = 0;
+
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+    explicit PythonContext(std::unique_ptr<device_simulator::DeviceSimulator> simulator);
+#endif
+
+    void init();
+
+    static ValueLayout toRecordLayout(ValueLayout layout);
+    static void        onTelemetryFrame(const protocol::TelemetryFrame& frame, void* user_data);
+};
+
+}  // namespace servo_core_control_api::python
+
+#endif  // CONTROL_API_PYTHON_PYTHONCONTEXT_H
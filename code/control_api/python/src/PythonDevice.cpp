@@ -0,0 +1,307 @@
+#include "PythonDevice.h"
+
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <utility>
+
+#include "parameter_system/parameter_type_mappings.h"
+#include "protocol/commands.h"
+
+namespace py = pybind11;
+
+namespace servo_core_control_api::python {
+
+namespace {
+
+using serial_communication_framework::ResponseCode;
+
+const char* responseCodeName(ResponseCode response_code) {
+    switch (response_code) {
+        case ResponseCode::ok:
+            return "ok";
+        case ResponseCode::timed_out:
+            return "timed_out";
+        case ResponseCode::corrupted:
+            return "corrupted";
+        case ResponseCode::unknown_operation_code:
+            return "unknown_operation_code";
+        case ResponseCode::malformed_response:
+            return "malformed_response";
+        case ResponseCode::malformed_request:
+            return "malformed_request";
+        case ResponseCode::unexpected_local_error:
+            return "unexpected_local_error";
+        case ResponseCode::invalid_id:
+            return "invalid_id";
+        case ResponseCode::out_of_bounds:
+            return "out_of_bounds";
+        case ResponseCode::type_mismatch:
+            return "type_mismatch";
+        case ResponseCode::forbidden:
+            return "forbidden";
+        case ResponseCode::unsolicited_frame:
+            return "unsolicited_frame";
+        case ResponseCode::unset_default_value:
+            return "unset_default_value";
+    }
+    return "unknown";
+}
+
+void throwIfFailed(const char* operation, ResponseCode response_code) {
+    if (response_code != ResponseCode::ok) throw CommandError(operation, response_code);
+}
+
+}  // namespace
+
+std::string getParameterName(const ParameterMetaData& meta_data) {
+    return {meta_data.name, strnlen(meta_data.name, ParameterMetaData::K_PARAMETER_NAME_MAX_LENGTH)};
+}
+
+CommandError::CommandError(const std::string& operation, ResponseCode response_code)
+    : std::runtime_error(operation + " failed: " + responseCodeName(response_code)), response_code_(response_code) {}
+
+ResponseCode CommandError::getResponseCode() const { return response_code_; }
+
+PythonDevice::PythonDevice(std::shared_ptr<PythonContext> context, Device device)
+    : context_(std::move(context)), device_(device) {}
+
+std::optional<PythonDevice> PythonDevice::find(const std::shared_ptr<PythonContext>& context, uint8_t device_id) {
+    std::optional<Device> device;
+    {
+        py::gil_scoped_release       release;
+        std::unique_lock<std::mutex> context_lock = context->lock();
+        device                                    = context->getContext().tryFindDeviceById(device_id);
+    }
+
+    if (!device.has_value()) return std::nullopt;
+    return PythonDevice(context, *device);
+}
+
+uint8_t PythonDevice::getId() { return device_.getId(); }
+
+std::vector<ParameterMetaData> PythonDevice::fetchParameters() {
+    return withPort([this] {
+        DeviceParameters& parameters = context_->getDeviceParameters(device_.getId());
+        fetchAllParametersLocked(parameters);
+
+        std::vector<ParameterMetaData> all_meta_data;
+        for (const auto& [id, meta_data] : parameters.meta_data) all_meta_data.push_back(meta_data);
+        std::sort(all_meta_data.begin(), all_meta_data.end(),
+                  [](const ParameterMetaData& a, const ParameterMetaData& b) { return a.id < b.id; });
+        return all_meta_data;
+    });
+}
+
+py::object PythonDevice::readValue(py::handle parameter) {
+    py::tuple values = readValues(py::make_tuple(parameter));
+    return values[0];
+}
+
+py::tuple PythonDevice::readValues(py::handle parameters) {
+    const std::vector<ParameterReference>       references = toReferences(parameters);
+    const std::vector<const ParameterMetaData*> meta_data  = resolve(references);
+    const ValueLayout                           layout     = toLayout(meta_data);
+
+    std::vector<protocol::commands::ReadParamValuesRequest::Entry> entries;
+    for (const ParameterMetaData* parameter : meta_data) entries.push_back({parameter->id, parameter->value_type});
+
+    std::vector<uint8_t> raw_values(layout.size);
+    withPort([&] { throwIfFailed("reading values", device_.readParameterValuesRaw(entries, raw_values)); });
+
+    py::tuple values(layout.fields.size());
+    for (size_t i = 0; i < layout.fields.size(); i++) {
+        const ValueLayout::Field& field = layout.fields[i];
+        values[i]                       = valueToPython(
+            field.value_type,
+            std::span<const uint8_t>(raw_values)
+                .subspan(field.offset, parameter_system::sizeOfCppTypeByParameterValueType(field.value_type)));
+    }
+    return values;
+}
+
+void PythonDevice::writeValue(py::handle parameter, py::handle value) {
+    py::dict values;
+    values[parameter] = value;
+    writeValues(values);
+}
+
+void PythonDevice::writeValues(const py::dict& values) {
+    std::vector<ParameterReference> references;
+    for (const auto& [parameter, value] : values) references.push_back(toReference(parameter));
+    const std::vector<const ParameterMetaData*> meta_data = resolve(references);
+
+    protocol::commands::WriteParamValuesRequest request;
+    size_t                                      i = 0;
+    for (const auto& [parameter, value] : values) {
+        const std::vector<uint8_t> raw_value = valueFromPython(meta_data[i]->value_type, value);
+        if (!request.putRaw(meta_data[i]->id, meta_data[i]->value_type, raw_value)) {
+            throw std::length_error("values do not fit into one command");
+        }
+        i++;
+    }
+
+    withPort([&] { throwIfFailed("writing values", device_.writeParameterValues(request)); });
+}
+
+void PythonDevice::saveParameters() {
+    withPort([this] { throwIfFailed("saving parameters", device_.saveParameters()); });
+}
+
+void PythonDevice::subscribeTelemetry(py::handle parameters, uint32_t period_us) {
+    const std::vector<const ParameterMetaData*> meta_data = resolve(toReferences(parameters));
+    ValueLayout                                 layout    = toLayout(meta_data);
+
+    std::vector<ParameterID> ids;
+    for (const ParameterMetaData* parameter : meta_data) ids.push_back(parameter->id);
+
+    withPort([&] {
+        throwIfFailed("subscribing telemetry", device_.subscribeTelemetry(ids, period_us));
+        context_->setTelemetryLayout(device_.getId(), std::move(layout));
+    });
+}
+
+void PythonDevice::unsubscribeTelemetry() {
+    withPort([this] { throwIfFailed("unsubscribing telemetry", device_.unsubscribeTelemetry()); });
+}
+
+py::array PythonDevice::takeTelemetry() { return context_->takeTelemetry(device_.getId()); }
+
+void PythonDevice::armCapture(py::handle parameters, uint16_t decimation,
+                              parameter_system::CaptureTriggerMode trigger_mode, py::handle trigger_source,
+                              float trigger_threshold, uint32_t pre_trigger_samples) {
+    std::vector<ParameterReference> references         = toReferences(parameters);
+    const bool                      has_trigger_source = !trigger_source.is_none();
+    if (has_trigger_source) references.push_back(toReference(trigger_source));
+
+    std::vector<const ParameterMetaData*> meta_data = resolve(references);
+
+    parameter_system::CaptureConfig config;
+    config.decimation          = decimation;
+    config.trigger_mode        = trigger_mode;
+    config.trigger_threshold   = trigger_threshold;
+    config.pre_trigger_samples = pre_trigger_samples;
+    if (has_trigger_source) {
+        config.trigger_source_id = meta_data.back()->id;
+        meta_data.pop_back();
+    }
+
+    ValueLayout              layout = toLayout(meta_data);
+    std::vector<ParameterID> ids;
+    for (const ParameterMetaData* parameter : meta_data) ids.push_back(parameter->id);
+
+    withPort([&] {
+        throwIfFailed("arming capture", device_.armCapture(ids, config));
+        context_->getDeviceParameters(device_.getId()).capture_layout = std::move(layout);
+    });
+}
+
+void PythonDevice::triggerCapture() {
+    withPort([this] { throwIfFailed("triggering capture", device_.triggerCapture()); });
+}
+
+void PythonDevice::disarmCapture() {
+    withPort([this] { throwIfFailed("disarming capture", device_.disarmCapture()); });
+}
+
+parameter_system::CaptureStatus PythonDevice::getCaptureStatus() {
+    parameter_system::CaptureStatus status;
+    withPort([&] { throwIfFailed("reading capture status", device_.getCaptureStatus(&status)); });
+    return status;
+}
+
+py::array PythonDevice::downloadCapture() {
+    parameter_system::CaptureStatus status;
+    ValueLayout                     layout;
+    withPort([&] {
+        throwIfFailed("reading capture status", device_.getCaptureStatus(&status));
+        layout = context_->getDeviceParameters(device_.getId()).capture_layout;
+    });
+    if (status.state != parameter_system::CaptureState::complete) {
+        throw std::runtime_error("capture is not complete");
+    }
+
+    const auto sample_count = static_cast<py::ssize_t>(status.sample_count);
+    py::array  samples;
+    if (layout.size > 0 && layout.size == status.sample_size) {
+        samples = py::array(layout.toDtype(), {sample_count});
+    } else {
+        samples = py::array_t<uint8_t>({sample_count, static_cast<py::ssize_t>(status.sample_size)});
+    }
+
+    // Downloaded straight into the array, which no other thread can see before it is returned
+    const std::span<uint8_t> samples_bytes(static_cast<uint8_t*>(samples.mutable_data()),
+                                           static_cast<size_t>(samples.nbytes()));
+    withPort([&] { throwIfFailed("downloading capture", device_.downloadCapture(samples_bytes)); });
+    return samples;
+}
+
+void PythonDevice::reboot() {
+    withPort([this] { throwIfFailed("rebooting", device_.reboot()); });
+}
+
+PythonDevice::ParameterReference PythonDevice::toReference(py::handle parameter) {
+    if (py::isinstance<py::str>(parameter)) return {std::nullopt, parameter.cast<std::string>()};
+
+    const int id = parameter.cast<int>();
+    if (id < 0 || id > parameter_system::K_MAX_PARAMETER_ID) throw std::out_of_range("parameter id out of range");
+    return {static_cast<ParameterID>(id), {}};
+}
+
+std::vector<PythonDevice::ParameterReference> PythonDevice::toReferences(py::handle parameters) {
+    std::vector<ParameterReference> references;
+    for (py::handle parameter : parameters) references.push_back(toReference(parameter));
+    return references;
+}
+
+const ParameterMetaData& PythonDevice::resolveLocked(const ParameterReference& reference) {
+    DeviceParameters& parameters = context_->getDeviceParameters(device_.getId());
+
+    if (reference.id.has_value()) {
+        if (auto found = parameters.meta_data.find(*reference.id); found != parameters.meta_data.end()) {
+            return found->second;
+        }
+
+        ParameterMetaData meta_data;
+        throwIfFailed("reading parameter metadata", device_.fetchParameterMetaData(*reference.id, &meta_data));
+        return parameters.meta_data.emplace(*reference.id, meta_data).first->second;
+    }
+
+    fetchAllParametersLocked(parameters);
+    for (const auto& [id, meta_data] : parameters.meta_data) {
+        if (getParameterName(meta_data) == reference.name) return meta_data;
+    }
+    throw std::invalid_argument("no parameter named " + reference.name);
+}
+
+std::vector<const ParameterMetaData*> PythonDevice::resolve(const std::vector<ParameterReference>& references) {
+    // The metadata stays where it is in the map, new parameters are only added to it
+    return withPort([&] {
+        std::vector<const ParameterMetaData*> meta_data;
+        for (const ParameterReference& reference : references) meta_data.push_back(&resolveLocked(reference));
+        return meta_data;
+    });
+}
+
+void PythonDevice::fetchAllParametersLocked(DeviceParameters& parameters) {
+    if (parameters.all_fetched) return;
+
+    for (const ParameterID id : device_.fetchRegisteredParamIds()) {
+        if (parameters.meta_data.contains(id)) continue;
+
+        ParameterMetaData meta_data;
+        throwIfFailed("reading parameter metadata", device_.fetchParameterMetaData(id, &meta_data));
+        parameters.meta_data.emplace(id, meta_data);
+    }
+    parameters.all_fetched = true;
+}
+
+ValueLayout PythonDevice::toLayout(const std::vector<const ParameterMetaData*>& meta_data) {
+    ValueLayout layout;
+    for (const ParameterMetaData* parameter : meta_data) {
+        layout.append(getParameterName(*parameter), parameter->value_type);
+    }
+    return layout;
+}
+
+}  // namespace servo_core_control_api::python
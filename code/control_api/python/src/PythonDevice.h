@@ -0,0 +1,143 @@
+#ifndef CONTROL_API_PYTHON_PYTHONDEVICE_H
+#define CONTROL_API_PYTHON_PYTHONDEVICE_H
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "PythonContext.h"
+#include "control_api/Device.h"
+#include "parameter_system/SignalCapture.h"
+#include "value_layout.h"
+
+namespace servo_core_control_api::python {
+
+/**
+ * @brief A command that the device answered with something else than ResponseCode::ok. CommandError in Python.
+ */
+class CommandError : public std::runtime_error {
+public:
+    CommandError(const std::string& operation, serial_communication_framework::ResponseCode response_code);
+
+    [[nodiscard]] serial_communication_framework::ResponseCode getResponseCode() const;
+
+private:
+    serial_communication_framework::ResponseCode response_code_;
+};
+
+/**
+ * @brief Get the name of the parameter, which isn't terminated if it takes the whole buffer.
+ */
+std::string getParameterName(const ParameterMetaData& meta_data);
+
+/**
+ * @brief A device as seen from Python.
+ *
+ * The parameters are given by id or by name, their types are read from the device the first time they are used. The
+ * values are converted to Python numbers, or to NumPy records for telemetry and captures.
+ *
+ * Every method that talks to the device releases the GIL and holds the port of the PythonContext while doing it.
+ */
+class PythonDevice {
+public:
+    /**
+     * @brief Ping the device. Releases the GIL.
+     */
+    static std::optional<PythonDevice> find(const std::shared_ptr<PythonContext>& context, uint8_t device_id);
+
+    [[nodiscard]] uint8_t getId();
+
+    /**
+     * @brief Get the metadata of every parameter of the device.
+     */
+    std::vector<ParameterMetaData> fetchParameters();
+
+    pybind11::object readValue(pybind11::handle parameter);
+
+    /**
+     * @brief Read the values with as few commands as they fit into.
+     *
+     * @return Tuple of the values in the same order as the parameters.
+     */
+    pybind11::tuple readValues(pybind11::handle parameters);
+
+    void writeValue(pybind11::handle parameter, pybind11::handle value);
+
+    /**
+     * @brief Write the values atomically with a single command.
+     *
+     * @param values Dict of the values by the parameters.
+     */
+    void writeValues(const pybind11::dict& values);
+
+    void saveParameters();
+
+    /**
+     * @brief Stream the values of the signals, received in `PythonContext::run()` for `takeTelemetry()`.
+     */
+    void subscribeTelemetry(pybind11::handle parameters, uint32_t period_us);
+
+    void unsubscribeTelemetry();
+
+    /**
+     * @brief Take the telemetry frames of this device received since the previous call, without copying them.
+     */
+    pybind11::array takeTelemetry();
+
+    void armCapture(pybind11::handle parameters, uint16_t decimation, parameter_system::CaptureTriggerMode trigger_mode,
+                    pybind11::handle trigger_source, float trigger_threshold, uint32_t pre_trigger_samples);
+
+    void triggerCapture();
+
+    void disarmCapture();
+
+    parameter_system::CaptureStatus getCaptureStatus();
+
+    /**
+     * @brief Download the completed capture straight into a NumPy array of the captured signals.
+     *
+     * A capture armed elsewhere, whose signals are not known, is returned as a 2D array of the sample bytes.
+     */
+    pybind11::array downloadCapture();
+
+    void reboot();
+
+private:
+    // A parameter given from Python, resolved to its metadata with the port held
+    struct ParameterReference {
+        std::optional<ParameterID> id;
+        std::string                name;
+    };
+
+    std::shared_ptr<PythonContext> context_;
+    Device                         device_;
+
+    PythonDevice(std::shared_ptr<PythonContext> context, Device device);
+
+    static ParameterReference              toReference(pybind11::handle parameter);
+    static std::vector<ParameterReference> toReferences(pybind11::handle parameters);
+
+    const ParameterMetaData&              resolveLocked(const ParameterReference& reference);
+    std::vector<const ParameterMetaData*> resolve(const std::vector<ParameterReference>& references);
+    void                                  fetchAllParametersLocked(DeviceParameters& parameters);
+    static ValueLayout                    toLayout(const std::vector<const ParameterMetaData*>& meta_data);
+
+    // Run the function with the port held and the GIL released, it must not touch Python objects
+    template <typename T_Function>
+    auto withPort(T_Function function) {
+        pybind11::gil_scoped_release release;
+        std::unique_lock<std::mutex> context_lock = context_->lock();
+        return function();
+    }
+};
+
+}  // namespace servo_core_control_api::python
+
+#endif  // CONTROL_API_PYTHON_PYTHONDEVICE_H
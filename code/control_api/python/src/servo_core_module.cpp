@@ -0,0 +1,135 @@
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <memory>
+#include <string>
+
+#include "PythonContext.h"
+#include "PythonDevice.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/common.h"
+#include "serial_communication_framework/common.h"
+
+namespace py = pybind11;
+
+using servo_core_control_api::ParameterMetaData;
+using servo_core_control_api::python::CommandError;
+using servo_core_control_api::python::getParameterName;
+using servo_core_control_api::python::PythonContext;
+using servo_core_control_api::python::PythonDevice;
+
+PYBIND11_MODULE(servo_core, module) {
+    module.doc() = "Control ServoCore devices over serial ports.";
+
+    py::register_exception<CommandError>(module, "CommandError", PyExc_RuntimeError);
+
+    py::enum_<serial_communication_framework::ResponseCode>(module, "ResponseCode")
+        .value("ok", serial_communication_framework::ResponseCode::ok)
+        .value("timed_out", serial_communication_framework::ResponseCode::timed_out)
+        .value("corrupted", serial_communication_framework::ResponseCode::corrupted)
+        .value("unknown_operation_code", serial_communication_framework::ResponseCode::unknown_operation_code)
+        .value("malformed_response", serial_communication_framework::ResponseCode::malformed_response)
+        .value("malformed_request", serial_communication_framework::ResponseCode::malformed_request)
+        .value("unexpected_local_error", serial_communication_framework::ResponseCode::unexpected_local_error)
+        .value("invalid_id", serial_communication_framework::ResponseCode::invalid_id)
+        .value("out_of_bounds", serial_communication_framework::ResponseCode::out_of_bounds)
+        .value("type_mismatch", serial_communication_framework::ResponseCode::type_mismatch)
+        .value("forbidden", serial_communication_framework::ResponseCode::forbidden);
+
+    py::enum_<parameter_system::ParameterValueType>(module, "ParameterValueType")
+        .value("uint8", parameter_system::ParameterValueType::uint8)
+        .value("uint16", parameter_system::ParameterValueType::uint16)
+        .value("uint32", parameter_system::ParameterValueType::uint32)
+        .value("uint64", parameter_system::ParameterValueType::uint64)
+        .value("int8", parameter_system::ParameterValueType::int8)
+        .value("int16", parameter_system::ParameterValueType::int16)
+        .value("int32", parameter_system::ParameterValueType::int32)
+        .value("int64", parameter_system::ParameterValueType::int64)
+        .value("floating_point", parameter_system::ParameterValueType::floating_point)
+        .value("double_float", parameter_system::ParameterValueType::double_float)
+        .value("boolean", parameter_system::ParameterValueType::boolean)
+        .value("none", parameter_system::ParameterValueType::none);
+
+    py::enum_<parameter_system::ParameterCategory>(module, "ParameterCategory")
+        .value("saved_parameter", parameter_system::ParameterCategory::saved_parameter)
+        .value("runtime_parameter", parameter_system::ParameterCategory::runtime_parameter)
+        .value("signal", parameter_system::ParameterCategory::signal);
+
+    py::enum_<parameter_system::ReadWriteAccess>(module, "ReadWriteAccess")
+        .value("read_only", parameter_system::ReadWriteAccess::read_only)
+        .value("read_write", parameter_system::ReadWriteAccess::read_write);
+
+    py::enum_<parameter_system::CaptureTriggerMode>(module, "CaptureTriggerMode")
+        .value("manual", parameter_system::CaptureTriggerMode::manual)
+        .value("rising_threshold", parameter_system::CaptureTriggerMode::rising_threshold)
+        .value("falling_threshold", parameter_system::CaptureTriggerMode::falling_threshold);
+
+    py::enum_<parameter_system::CaptureState>(module, "CaptureState")
+        .value("idle", parameter_system::CaptureState::idle)
+        .value("armed", parameter_system::CaptureState::armed)
+        .value("triggered", parameter_system::CaptureState::triggered)
+        .value("complete", parameter_system::CaptureState::complete);
+
+    py::class_<ParameterMetaData>(module, "ParameterMetaData")
+        .def_readonly("id", &ParameterMetaData::id)
+        .def_readonly("category", &ParameterMetaData::category)
+        .def_readonly("value_type", &ParameterMetaData::value_type)
+        .def_readonly("read_write_access", &ParameterMetaData::read_write_access)
+        .def_property_readonly("name", &getParameterName)
+        .def("__repr__", [](const ParameterMetaData& meta_data) {
+            return "<ParameterMetaData " + std::to_string(meta_data.id) + " " + getParameterName(meta_data) + ">";
+        });
+
+    py::class_<parameter_system::CaptureStatus>(module, "CaptureStatus")
+        .def_readonly("state", &parameter_system::CaptureStatus::state)
+        .def_readonly("sample_size", &parameter_system::CaptureStatus::sample_size)
+        .def_readonly("sample_count", &parameter_system::CaptureStatus::sample_count)
+        .def_readonly("trigger_sample_index", &parameter_system::CaptureStatus::trigger_sample_index)
+        .def_readonly("sample_interval_ns", &parameter_system::CaptureStatus::sample_interval_ns);
+
+    py::class_<PythonContext, std::shared_ptr<PythonContext>> context_class(module, "Context", R"doc(
+The devices on one serial port.
+
+The devices of a Context are used by one thread at a time. The GIL is released while talking to them, so threads
+using different Contexts run in parallel.
+)doc");
+    context_class
+        .def(py::init<const std::string&>(), py::arg("serial_port_name"),
+             "Open the serial port, e.g. '/dev/ttyACM0' or 'COM3'.")
+        .def("find_device", &PythonDevice::find, py::arg("device_id"),
+             "Ping the device. None if it doesn't answer.")
+        .def("run", &PythonContext::run, py::arg("timeout_s") = 0.0,
+             "Wait for the devices to send something and receive it, telemetry frames included.")
+        .def_property_readonly("mismatched_telemetry_frame_count", &PythonContext::getMismatchedTelemetryFrameCount);
+#ifdef SERVO_CORE_PYTHON_SIMULATOR
+    context_class.def_static("simulated", &PythonContext::simulated,
+                             "A Context connected to a simulated device of id 0 instead of a serial port.");
+#endif
+
+    py::class_<PythonDevice>(module, "Device")
+        .def_property_readonly("id", &PythonDevice::getId)
+        .def("fetch_parameters", &PythonDevice::fetchParameters, "Metadata of every parameter of the device.")
+        .def("read", &PythonDevice::readValue, py::arg("parameter"), "Read a value by the id or the name.")
+        .def("read_many", &PythonDevice::readValues, py::arg("parameters"),
+             "Read the values with as few commands as they fit into, as a tuple.")
+        .def("write", &PythonDevice::writeValue, py::arg("parameter"), py::arg("value"))
+        .def("write_many", &PythonDevice::writeValues, py::arg("values"),
+             "Write a dict of values atomically with a single command.")
+        .def("save_parameters", &PythonDevice::saveParameters)
+        .def("subscribe_telemetry", &PythonDevice::subscribeTelemetry, py::arg("parameters"), py::arg("period_us"),
+             "Stream the signals, the frames are received in Context.run().")
+        .def("unsubscribe_telemetry", &PythonDevice::unsubscribeTelemetry)
+        .def("take_telemetry", &PythonDevice::takeTelemetry,
+             "Take the telemetry frames received since the previous call as a structured array, without copying.")
+        .def("arm_capture", &PythonDevice::armCapture, py::arg("parameters"), py::arg("decimation") = 1,
+             py::arg("trigger_mode")        = parameter_system::CaptureTriggerMode::manual,
+             py::arg("trigger_source")      = py::none(), py::arg("trigger_threshold") = 0.0f,
+             py::arg("pre_trigger_samples") = 0)
+        .def("trigger_capture", &PythonDevice::triggerCapture)
+        .def("disarm_capture", &PythonDevice::disarmCapture)
+        .def("capture_status", &PythonDevice::getCaptureStatus)
+        .def("download_capture", &PythonDevice::downloadCapture,
+             "Download the completed capture straight into a structured array of the captured signals.")
+        .def("reboot", &PythonDevice::reboot);
+}
@@ -0,0 +1,150 @@
+#include "value_layout.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "parameter_system/parameter_type_mappings.h"
+
+namespace py = pybind11;
+
+namespace servo_core_control_api::python {
+
+namespace {
+
+using parameter_system::MapParameterValueTypeToCppType;
+using parameter_system::ParameterValueType;
+
+template <ParameterValueType T_ValueType>
+py::object toPython(std::span<const uint8_t> raw_bytes) {
+    typename MapParameterValueTypeToCppType<T_ValueType>::type value;
+    std::memcpy(&value, raw_bytes.data(), sizeof(value));
+    return py::cast(value);
+}
+
+template <ParameterValueType T_ValueType>
+std::vector<uint8_t> fromPython(py::handle object) {
+    const auto           value = object.cast<typename MapParameterValueTypeToCppType<T_ValueType>::type>();
+    std::vector<uint8_t> raw_bytes(sizeof(value));
+    std::memcpy(raw_bytes.data(), &value, sizeof(value));
+    return raw_bytes;
+}
+
+}  // namespace
+
+void ValueLayout::append(std::string name, parameter_system::ParameterValueType value_type) {
+    const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(value_type);
+    fields.push_back({std::move(name), value_type, size});
+    size += value_size;
+}
+
+py::dtype ValueLayout::toDtype() const {
+    py::list names;
+    py::list formats;
+    py::list offsets;
+    for (const Field& field : fields) {
+        names.append(field.name);
+        formats.append(numpyFormat(field.value_type));
+        offsets.append(field.offset);
+    }
+
+    // Packed, the values are back to back without any alignment
+    py::dict description;
+    description["names"]    = names;
+    description["formats"]  = formats;
+    description["offsets"]  = offsets;
+    description["itemsize"] = size;
+    return py::dtype::from_args(description);
+}
+
+const char* numpyFormat(parameter_system::ParameterValueType value_type) {
+    switch (value_type) {
+        case ParameterValueType::uint8:
+            return "u1";
+        case ParameterValueType::uint16:
+            return "<u2";
+        case ParameterValueType::uint32:
+            return "<u4";
+        case ParameterValueType::uint64:
+            return "<u8";
+        case ParameterValueType::int8:
+            return "i1";
+        case ParameterValueType::int16:
+            return "<i2";
+        case ParameterValueType::int32:
+            return "<i4";
+        case ParameterValueType::int64:
+            return "<i8";
+        case ParameterValueType::floating_point:
+            return "<f4";
+        case ParameterValueType::double_float:
+            return "<f8";
+        case ParameterValueType::boolean:
+            return "?";
+        case ParameterValueType::none:
+            break;
+    }
+    throw std::invalid_argument("parameter has no value");
+}
+
+py::object valueToPython(parameter_system::ParameterValueType value_type, std::span<const uint8_t> raw_bytes) {
+    switch (value_type) {
+        case ParameterValueType::uint8:
+            return toPython<ParameterValueType::uint8>(raw_bytes);
+        case ParameterValueType::uint16:
+            return toPython<ParameterValueType::uint16>(raw_bytes);
+        case ParameterValueType::uint32:
+            return toPython<ParameterValueType::uint32>(raw_bytes);
+        case ParameterValueType::uint64:
+            return toPython<ParameterValueType::uint64>(raw_bytes);
+        case ParameterValueType::int8:
+            return toPython<ParameterValueType::int8>(raw_bytes);
+        case ParameterValueType::int16:
+            return toPython<ParameterValueType::int16>(raw_bytes);
+        case ParameterValueType::int32:
+            return toPython<ParameterValueType::int32>(raw_bytes);
+        case ParameterValueType::int64:
+            return toPython<ParameterValueType::int64>(raw_bytes);
+        case ParameterValueType::floating_point:
+            return toPython<ParameterValueType::floating_point>(raw_bytes);
+        case ParameterValueType::double_float:
+            return toPython<ParameterValueType::double_float>(raw_bytes);
+        case ParameterValueType::boolean:
+            return toPython<ParameterValueType::boolean>(raw_bytes);
+        case ParameterValueType::none:
+            break;
+    }
+    return py::none();
+}
+
+std::vector<uint8_t> valueFromPython(parameter_system::ParameterValueType value_type, py::handle value) {
+    switch (value_type) {
+        case ParameterValueType::uint8:
+            return fromPython<ParameterValueType::uint8>(value);
+        case ParameterValueType::uint16:
+            return fromPython<ParameterValueType::uint16>(value);
+        case ParameterValueType::uint32:
+            return fromPython<ParameterValueType::uint32>(value);
+        case ParameterValueType::uint64:
+            return fromPython<ParameterValueType::uint64>(value);
+        case ParameterValueType::int8:
+            return fromPython<ParameterValueType::int8>(value);
+        case ParameterValueType::int16:
+            return fromPython<ParameterValueType::int16>(value);
+        case ParameterValueType::int32:
+            return fromPython<ParameterValueType::int32>(value);
+        case ParameterValueType::int64:
+            return fromPython<ParameterValueType::int64>(value);
+        case ParameterValueType::floating_point:
+            return fromPython<ParameterValueType::floating_point>(value);
+        case ParameterValueType::double_float:
+            return fromPython<ParameterValueType::double_float>(value);
+        case ParameterValueType::boolean:
+            return fromPython<ParameterValueType::boolean>(value);
+        case ParameterValueType::none:
+            break;
+    }
+    throw std::invalid_argument("parameter has no value");
+}
+
+}  // namespace servo_core_control_api::python
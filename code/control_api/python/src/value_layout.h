@@ -0,0 +1,57 @@
+#ifndef CONTROL_API_PYTHON_VALUE_LAYOUT_H
+#define CONTROL_API_PYTHON_VALUE_LAYOUT_H
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "parameter_system/common.h"
+
+namespace servo_core_control_api::python {
+
+/**
+ * @brief Values of parameters back to back, as in telemetry frames, capture samples and batched reads.
+ *
+ * Turned into a NumPy structured dtype whose fields are named after the parameters, so a buffer of such records is
+ * an array without a Python object per value.
+ */
+struct ValueLayout {
+    struct Field {
+        std::string                          name;
+        parameter_system::ParameterValueType value_type;
+        size_t                               offset;
+    };
+
+    std::vector<Field> fields;
+    size_t             size = 0;
+
+    void append(std::string name, parameter_system::ParameterValueType value_type);
+
+    [[nodiscard]] pybind11::dtype toDtype() const;
+};
+
+/**
+ * @brief Get the NumPy format of the value type, little-endian like the devices.
+ */
+const char* numpyFormat(parameter_system::ParameterValueType value_type);
+
+/**
+ * @brief Convert the raw bytes of a value to a Python int, float or bool. Needs the GIL.
+ */
+pybind11::object valueToPython(parameter_system::ParameterValueType value_type, std::span<const uint8_t> raw_bytes);
+
+/**
+ * @brief Convert a Python number to the raw bytes of a value. Needs the GIL.
+ *
+ * @throw pybind11::cast_error if the object is not a number.
+ */
+std::vector<uint8_t> valueFromPython(parameter_system::ParameterValueType value_type, pybind11::handle value);
+
+}  // namespace servo_core_control_api::python
+
+#endif  // CONTROL_API_PYTHON_VALUE_LAYOUT_H
@@ -0,0 +1,80 @@
+import time
+
+import numpy
+import pytest
+
+import servo_core
+
+
+# The simulator keeps the firmware's state in globals, so all the tests share one simulated device
+@pytest.fixture(scope="module")
+def context():
+    return servo_core.Context.simulated()
+
+
+@pytest.fixture
+def device(context):
+    device = context.find_device(0)
+    assert device is not None
+    return device
+
+
+def test_finds_only_the_simulated_device(context):
+    assert context.find_device(0).id == 0
+    assert context.find_device(5) is None
+
+
+def test_fetches_the_metadata_of_every_parameter(device):
+    parameters = {parameter.name: parameter for parameter in device.fetch_parameters()}
+
+    assert parameters["Test Uint8"].id == 0x02
+    assert parameters["Test Uint8"].value_type == servo_core.ParameterValueType.uint8
+    assert parameters["Test Uint16"].category == servo_core.ParameterCategory.signal
+    assert parameters["Test Uint16"].read_write_access == servo_core.ReadWriteAccess.read_only
+
+
+def test_reads_by_id_and_by_name(device):
+    assert device.read(0x04) == 123456
+    assert device.read("Test Uint32") == 123456
+    assert device.read_many(["Test Uint32", "Test Float"]) == (123456, pytest.approx(3.1415))
+
+
+def test_writes_single_values_and_many_together(device):
+    device.write("Test Uint8", 7)
+    assert device.read("Test Uint8") == 7
+
+    device.write_many({"Test Uint8": 9, "Test Bool": False})
+    assert device.read_many(["Test Uint8", "Test Bool"]) == (9, False)
+
+
+def test_a_refused_write_raises_and_writes_nothing(device):
+    device.write("Test Uint8", 11)
+
+    with pytest.raises(servo_core.CommandError, match="forbidden"):
+        device.write_many({"Test Uint8": 12, "Test Uint16": 1})
+
+    assert device.read("Test Uint8") == 11
+
+
+def test_unknown_parameter_names_raise(device):
+    with pytest.raises(ValueError, match="no parameter named"):
+        device.read("No Such Parameter")
+
+
+def test_telemetry_frames_arrive_as_records_of_the_device(context, device):
+    device.subscribe_telemetry(["Test Uint16", "Test Float"], period_us=1000)
+    try:
+        frames = device.take_telemetry()
+        deadline = time.monotonic() + 5
+        while len(frames) < 10 and time.monotonic() < deadline:
+            context.run(timeout_s=0.01)
+            frames = numpy.concatenate([frames, device.take_telemetry()])
+    finally:
+        device.unsubscribe_telemetry()
+
+    assert len(frames) >= 10
+    assert frames.dtype.names == ("sequence_number", "Test Uint16", "Test Float")
+    assert (frames["Test Uint16"] == 1337).all()
+    # In the order the device sampled them
+    assert (numpy.diff(frames["sequence_number"].astype(numpy.int64)) > 0).all()
+
@@ -2,30 +2,140 @@
 #define CONTROL_API_CONTEXT_H
 
 #include <cstdint>
+#include <map>
 #include <optional>
 
 #include "control_api/Device.h"
 #include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
 #include "drivers/interfaces/ClockInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
+#include "protocol/telemetry_frame.h"
 #include "serial_communication_framework/MasterHandler.h"
 
 namespace servo_core_control_api {
 
+/**
+ * @brief Callback invoked for every received telemetry frame, see `Device::subscribeTelemetry`.
+ *
+ * Called from inside `Context::run()`. The frame is only valid for the duration of the call.
+ */
+using TelemetryCallback = void (*)(const protocol::TelemetryFrame& frame, void* user_data);
+
+// How often the commands that got lost on the way are retried, unless changed with
+// `communication_handler.setRetryPolicy()`. Reads and pings are retried right away, writes only when nothing else is in
+// flight, see serial_communication_framework::commands::Idempotency
+constexpr serial_communication_framework::RetryPolicy K_DEFAULT_RETRY_POLICY = {.max_retries = 2};
+
 class Context {
 public:
+    /**
+     * @param comm_interface     The serial port the devices are connected to.
+     * @param comm_timeout_clock Clock for the communication timeouts.
+     * @param port_configuration Changes the line settings of the same port. Without it the link stays at
+     *                           K_DEFAULT_LINK_SETTINGS.
+     */
      Context(drivers::interfaces::BufferedSerialCommunicationInterface& comm_interface,
-             drivers::interfaces::ClockInterface&                       comm_timeout_clock);
+             drivers::interfaces::ClockInterface&                       comm_timeout_clock,
+             drivers::interfaces::SerialPortConfigurationInterface*     port_configuration = nullptr);
     ~Context();
 
     virtual void open();
 
     [[nodiscard]] std::optional<Device> tryFindDeviceById(uint8_t id);
 
+    /**
+     * @brief Receive the responses of commands submitted with `Device::submitCommand` and invoke their callbacks.
+     *
+     * Non-blocking, must be called periodically while asynchronous commands are in flight.
+     */
+    void run();
+
+    /**
+     * @brief Sleep until the devices have sent something, so that an event loop calls `run()` only when needed.
+     *
+     * Returns right away if the driver of the port can't sleep, see
+     * `BufferedSerialCommunicationInterface::waitForReceivedBytes()`.
+     *
+     * @param timeout_us How long to wait at most, e.g. until the next command timeout is due.
+     * @return true if received bytes are waiting for `run()`.
+     */
+    bool waitForReceivedBytes(uint64_t timeout_us);
+
+    /**
+     * @brief Make the `waitForReceivedBytes()` in progress in another thread return right away, or the next one.
+     *
+     * Unlike the rest of the Context, this can be called from any thread, e.g. to hand work to the thread that waits.
+     */
+    void interruptWaitForReceivedBytes();
+
+    /**
+     * @brief Set the callback that receives the telemetry frames streamed by the devices.
+     *
+     * The frames are received in `run()`, so it must be called periodically while telemetry is subscribed.
+     *
+     * @param callback  Invoked for every received telemetry frame. Can be nullptr.
+     * @param user_data Opaque pointer passed to the callback.
+     */
+    void setTelemetryCallback(TelemetryCallback callback, void* user_data);
+
+    /**
+     * @brief Switch the link to the fastest settings that both the device and the port support.
+     *
+     * The device's capabilities are queried and the supported baud rates are tried from the fastest down. For each,
+     * the device is told to switch, the port is switched and the new settings are verified with a ping. If the ping
+     * fails, the port goes back to the previous settings, which the device also returns to on its own after
+     * K_LINK_VERIFY_TIMEOUT_MS, and the next slower rate is tried.
+     *
+     * Must be called while no commands are in flight. All the devices on the port must be switched, so this is meant
+     * for a port with a single device.
+     *
+     * @param device_id     Id of the device to negotiate with.
+     * @param max_baud_rate Upper limit for the rate, e.g. what the cable is known to carry.
+     * @param use_framing   Use COBS framing if the device supports it.
+     * @return The settings the link runs with afterwards, the previous ones if nothing faster worked.
+     */
+    serial_communication_framework::LinkSettings negotiateLinkSettings(uint8_t device_id, uint32_t max_baud_rate,
+                                                                       bool use_framing = true);
+
+    [[nodiscard]] serial_communication_framework::LinkSettings getLinkSettings() const;
+
+    /**
+     * @brief Get the master's side of the link statistics, e.g. to compare with `Device::getCommunicationStatistics`.
+     */
+    [[nodiscard]] const serial_communication_framework::CommunicationStatistics& getCommunicationStatistics() const;
+
+    /**
+     * @brief Get the round trip times of the op code, see `MasterHandler::getRoundTripLatencyHistogram`.
+     */
+    [[nodiscard]] const serial_communication_framework::LatencyHistogram& getRoundTripLatencyHistogram(
+        uint8_t op_code) const;
+
     /* TODO: should something like this be here? Who allocates the buffer?
     const std::span<Device*> findAllConnectedDevices();*/
 
 protected:
     serial_communication_framework::MasterHandler communication_handler;
+
+private:
+    TelemetryCallback telemetry_callback_           = nullptr;
+    void*             telemetry_callback_user_data_ = nullptr;
+
+    drivers::interfaces::BufferedSerialCommunicationInterface& comm_interface_;
+    drivers::interfaces::ClockInterface&                       clock_;
+    drivers::interfaces::SerialPortConfigurationInterface*     port_configuration_;
+    serial_communication_framework::LinkSettings               link_settings_ =
+        serial_communication_framework::K_DEFAULT_LINK_SETTINGS;
+
+    // Created when a device is first found and shared by every Device of its id, so that a write through one is seen
+    // by the others. A map, since a cache for every possible id would take over a megabyte
+    std::map<uint8_t, ParameterValueCache> value_caches_;
+
+    static void onUnsolicitedFrameReceived(uint8_t stream_id, uint8_t sender_id, std::span<uint8_t> payload,
+                                           void* user_data);
+
+    bool trySwitchLinkSettings(uint8_t device_id, serial_communication_framework::LinkSettings settings);
+    bool applyLinkSettings(serial_communication_framework::LinkSettings settings);
+    bool pingUntilAnswered(uint8_t device_id, uint64_t time_limit_ms);
 };
 
 }  // namespace servo_core_control_api
@@ -2,12 +2,20 @@
 #define CONTROL_API_DEVICE_H
 
 #include <cstdint>
+#include <span>
+#include <tuple>
 
+#include "control_api/ParameterValueCache.h"
+#include "drivers/interfaces/ClockInterface.h"
+#include "firmware_update/common.h"
 #include "parameter_system/ParameterDeclaration.h"
+#include "parameter_system/SignalCapture.h"
 #include "parameter_system/common.h"
 #include "parameter_system/parameter_type_mappings.h"
 #include "protocol/commands.h"
+#include "protocol/transfer_ids.h"
 #include "serial_communication_framework/MasterHandler.h"
+#include "serial_communication_framework/TransferMaster.h"
 #include "utils/StaticList.h"
 
 namespace servo_core_control_api {
@@ -16,6 +24,17 @@ using ParameterMetaData = parameter_system::ParameterMetaData;
 
 using ParameterID       = parameter_system::ParameterID;
 
+using TransferOptions   = serial_communication_framework::TransferOptions;
+
+/**
+ * @brief A parameter value to write, used with `Device::writeParameterValues`.
+ */
+template <parameter_system::ParameterValueType T_ValueType>
+struct ParameterValue {
+    parameter_system::ParameterDeclaration<T_ValueType>                          declaration;
+    typename parameter_system::MapParameterValueTypeToCppType<T_ValueType>::type value;
+};
+
 template <typename T>
 concept ParameterDeclaration = requires(T t) {
     { T::param_type };  // The param_type static member must exist
@@ -30,6 +49,12 @@ concept ParameterDeclaration = requires(T t) {
 // Forward declaration
 class Context;
 
+/**
+ * @brief A device on the port of a Context.
+ *
+ * The values of the parameters are cached, see `setValueCachePolicy`. The cache belongs to the Context, one for each
+ * device id, so every Device found for the same device shares it.
+ */
 class Device {
     friend Context;
 
@@ -42,11 +67,28 @@ public:
 
     ParameterMetaData fetchParameterMetaData(ParameterID id);
 
+    /**
+     * @brief Read the metadata of the parameter, telling apart a parameter that doesn't exist.
+     *
+     * @return ResponseCode::invalid_id if the device has no parameter of the id.
+     */
+    serial_communication_framework::ResponseCode fetchParameterMetaData(ParameterID        id,
+                                                                        ParameterMetaData* meta_data_out);
+
+    /**
+     * @brief Read the value of the parameter, from the cache if the policy allows it.
+     *
+     * @return Default value if the reading failed.
+     */
     template <parameter_system::ParameterValueType T_ValueType>
     auto readParameterValue(const parameter_system::ParameterDeclaration<T_ValueType>& declaration) {
         using CppType = parameter_system::MapParameterValueTypeToCppType<T_ValueType>::type;
         using namespace serial_communication_framework;
 
+        CppType                  value{};
+        const std::span<uint8_t> value_bytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+        if (tryReadCachedValue(declaration.id, T_ValueType, value_bytes)) return value;
+
         protocol::commands::ReadParamValueRequest request;
         request.parameter_id        = declaration.id;
         request.expected_value_type = T_ValueType;
@@ -58,9 +100,78 @@ public:
         if (response.response_code != ResponseCode::ok) {
             return CppType{};
         }
-        return response.take<CppType>();
+        value = response.take<CppType>();
+        cacheReadValue(declaration.id, T_ValueType, value_bytes);
+        return value;
+    }
+
+    /**
+     * @brief Read the values of multiple parameters with a single command.
+     *
+     * All the values must fit into one response packet, which is checked at compile time. They are always read from
+     * the device, and refresh the cache.
+     *
+     * @return Tuple of the values in the same order as the declarations were given. Default values if the reading
+     *         failed.
+     */
+    template <parameter_system::ParameterValueType... T_ValueTypes>
+    auto readParameterValues(const parameter_system::ParameterDeclaration<T_ValueTypes>&... declarations) {
+        using ValuesTuple =
+            std::tuple<typename parameter_system::MapParameterValueTypeToCppType<T_ValueTypes>::type...>;
+        using namespace serial_communication_framework;
+
+        constexpr size_t K_VALUES_SIZE =
+            (sizeof(typename parameter_system::MapParameterValueTypeToCppType<T_ValueTypes>::type) + ... + 0);
+        static_assert(sizeof...(T_ValueTypes) <= protocol::commands::ReadParamValuesRequest::K_MAX_ENTRIES,
+                      "Too many parameters for one request");
+        static_assert(K_VALUES_SIZE <= protocol::commands::ReadParamValuesResponse::K_RAW_BUFF_SIZE,
+                      "Values do not fit into one response");
+
+        protocol::commands::ReadParamValuesRequest request;
+        (request.entries.pushBack({declarations.id, T_ValueTypes}), ...);
+
+        protocol::commands::ReadParamValuesResponse response =
+            communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::ReadParamValues>(
+                device_id_, request);
+
+        if (response.response_code != ResponseCode::ok || response.raw_bytes.size_bytes() != K_VALUES_SIZE) {
+            return ValuesTuple{};
+        }
+
+        ValuesTuple values;
+        size_t      byte_offset = 0;
+        std::apply(
+            [&](auto&... value) {
+                ((value = response.take<std::remove_reference_t<decltype(value)>>(byte_offset),
+                  byte_offset += sizeof(value)),
+                 ...);
+            },
+            values);
+
+        size_t cache_offset = 0;
+        ((cacheReadValue(declarations.id, T_ValueTypes,
+                         response.raw_bytes.subspan(
+                             cache_offset,
+                             sizeof(typename parameter_system::MapParameterValueTypeToCppType<T_ValueTypes>::type))),
+          cache_offset += sizeof(typename parameter_system::MapParameterValueTypeToCppType<T_ValueTypes>::type)),
+         ...);
+        return values;
     }
 
+    /**
+     * @brief Read the values of multiple parameters whose types are only known at runtime.
+     *
+     * The values are written back to back into @p values_out in the same order as the entries, each one taking the
+     * size of its value type. Entries that don't fit into one response are split over multiple commands. The values
+     * that the cache policy allows are taken from the cache and left out of the commands.
+     *
+     * @param entries    Ids and value types of the parameters to read.
+     * @param values_out Buffer for the values, must fit the values of all the entries.
+     * @return ResponseCode::ok if all the values were read, otherwise the error that stopped the reading.
+     */
+    serial_communication_framework::ResponseCode readParameterValuesRaw(
+        std::span<const protocol::commands::ReadParamValuesRequest::Entry> entries, std::span<uint8_t> values_out);
+
     template <parameter_system::ParameterValueType T_ValueType>
     serial_communication_framework::ResponseCode writeParameterValue(
         const parameter_system::ParameterDeclaration<T_ValueType>&                   declaration,
@@ -77,16 +188,218 @@ public:
             communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::WriteParamValue>(
                 device_id_, request);
 
+        onValueWritten(declaration.id, T_ValueType, {reinterpret_cast<const uint8_t*>(&value), sizeof(value)},
+                       response.response_code);
         return response.response_code;
     }
 
+    /**
+     * @brief Write the values of multiple parameters atomically with a single command.
+     *
+     * The device validates all the values before writing any of them, so either all the values are written or none
+     * of them. The on change callbacks are invoked once after all the values have been written. All the values must
+     * fit into one request packet, which is checked at compile time.
+     *
+     * Usage: `device.writeParameterValues(ParameterValue{GAIN_P, 1.5f}, ParameterValue{CURRENT_LIMIT, 2.0f});`
+     */
+    template <parameter_system::ParameterValueType... T_ValueTypes>
+    serial_communication_framework::ResponseCode writeParameterValues(const ParameterValue<T_ValueTypes>&... values) {
+        static_assert(sizeof...(T_ValueTypes) <= protocol::commands::WriteParamValuesRequest::K_MAX_ENTRIES,
+                      "Too many parameters for one request");
+        static_assert(
+            ((protocol::commands::WriteParamValuesRequest::K_SERIALIZED_ENTRY_HEADER_SIZE + sizeof(values.value)) +
+             ... + 0) <= serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE,
+            "Values do not fit into one request");
+
+        protocol::commands::WriteParamValuesRequest request;
+        bool                                        all_fit = (request.put(values.declaration, values.value) && ...);
+        ASSERT(all_fit);
+
+        return writeParameterValues(request);
+    }
+
+    /**
+     * @brief Write the values of multiple parameters atomically with a single command.
+     *
+     * Same as the typed version but the values are given in a prebuilt request, for when the types are only known at
+     * runtime. Use `WriteParamValuesRequest::putRaw` to add the values.
+     */
+    serial_communication_framework::ResponseCode writeParameterValues(
+        const protocol::commands::WriteParamValuesRequest& request);
+
+    /**
+     * @brief Store the current values of the device's saved parameters to its flash.
+     *
+     * The stored values are loaded when the device boots. Values that have not changed since they were last saved
+     * are not written again, so the flash is not worn by saving repeatedly.
+     */
+    serial_communication_framework::ResponseCode saveParameters();
+
+    /**
+     * @brief Make the device stream the values of the given signal parameters periodically.
+     *
+     * The device samples the values on its own timer and sends them as sequence numbered telemetry frames which are
+     * delivered to the callback set with `Context::setTelemetryCallback`. The values are in the frame in the same
+     * order as the ids are given here and `TelemetryFrame::device_id` tells which device sent the frame. Replaces the
+     * earlier subscription of this device, other devices on the same bus can stream at the same time.
+     *
+     * @param parameter_ids Ids of the signal parameters to stream.
+     * @param period_us     Sample period in microseconds.
+     */
+    serial_communication_framework::ResponseCode subscribeTelemetry(std::span<const ParameterID> parameter_ids,
+                                                                    uint32_t                     period_us);
+
+    /**
+     * @brief Stop the telemetry streaming of this device.
+     */
+    serial_communication_framework::ResponseCode unsubscribeTelemetry();
+
+    /**
+     * @brief Arm the device side signal capture.
+     *
+     * The device records the signals into its own RAM at the control loop rate, which is far beyond what the serial
+     * link could stream, and the samples are downloaded afterwards with `downloadCapture`. Discards the earlier
+     * capture.
+     *
+     * @param parameter_ids Ids of the signal parameters to capture, in the order their values are placed in a sample.
+     * @param config        Decimation and trigger configuration.
+     */
+    serial_communication_framework::ResponseCode armCapture(std::span<const ParameterID>           parameter_ids,
+                                                            const parameter_system::CaptureConfig& config);
+
+    /**
+     * @brief Fire the trigger of an armed capture manually, regardless of the trigger mode.
+     */
+    serial_communication_framework::ResponseCode triggerCapture();
+
+    /**
+     * @brief Stop the capture and discard the captured samples.
+     */
+    serial_communication_framework::ResponseCode disarmCapture();
+
+    /**
+     * @brief Read the state of the capture. Poll until the state is `complete` before downloading.
+     */
+    serial_communication_framework::ResponseCode getCaptureStatus(parameter_system::CaptureStatus* status_out);
+
+    /**
+     * @brief Download a completed capture in chronological order.
+     *
+     * The capture is read in chunks that are pipelined to keep the serial link busy. The size of the capture is
+     * `sample_count * sample_size` bytes from `getCaptureStatus`.
+     *
+     * @param values_out Where the captured bytes are copied to. Exactly as many bytes are downloaded as fit.
+     */
+    serial_communication_framework::ResponseCode downloadCapture(std::span<uint8_t> values_out);
+
+    /**
+     * @brief Upload the data to the device's transfer endpoint with the id, e.g. a firmware image.
+     *
+     * The data is sent in segments with a window of them in flight, a lost segment is sent again on its own.
+     *
+     * @param transfer_id One of protocol::TransferIds.
+     */
+    serial_communication_framework::ResponseCode uploadTransfer(protocol::TransferIds    transfer_id,
+                                                                std::span<const uint8_t> data,
+                                                                TransferOptions          options = {});
+
+    /**
+     * @brief Download the device's transfer endpoint with the id, e.g. a completed capture.
+     *
+     * @param transfer_id One of protocol::TransferIds.
+     * @param data_out    Where the bytes are copied to. Exactly as many bytes are downloaded as fit.
+     */
+    serial_communication_framework::ResponseCode downloadTransfer(protocol::TransferIds transfer_id,
+                                                                  std::span<uint8_t>    data_out,
+                                                                  TransferOptions       options = {});
+
+    /**
+     * @brief Write a new firmware image to the device's inactive slot and make it the one booted next.
+     *
+     * The device verifies the CRC-32 of the image before switching, an update that fails or is interrupted leaves the
+     * current firmware in place. The new firmware starts after `reboot`, which copies it over the slot the device
+     * boots from first. The copy takes a few seconds, during which the device does not respond.
+     *
+     * @param image The firmware binary, as placed in the flash.
+     */
+    serial_communication_framework::ResponseCode updateFirmware(std::span<const uint8_t> image);
+
+    serial_communication_framework::ResponseCode getFirmwareStatus(firmware_update::FirmwareStatus* status_out);
+
+    /**
+     * @brief Restart the device. It stops responding until it has booted again.
+     *
+     * Invalidates the value cache, the runtime parameters start over from their defaults.
+     */
+    serial_communication_framework::ResponseCode reboot();
+
+    /**
+     * @brief Read the device's side of the link statistics: packets, bytes, rx overflows and resynchronizations.
+     *
+     * The master's side is `Context::getCommunicationStatistics()`. `operations` is not filled in, see
+     * `getOperationStatistics`.
+     */
+    serial_communication_framework::ResponseCode getCommunicationStatistics(
+        serial_communication_framework::CommunicationStatistics* statistics_out);
+
+    /**
+     * @brief Read how many requests of the op code the device has received and failed, and how long its handler took.
+     */
+    serial_communication_framework::ResponseCode getOperationStatistics(
+        uint8_t op_code, serial_communication_framework::OperationStatistics* operation_out,
+        serial_communication_framework::DurationStatistics* handler_time_out);
+
+    /**
+     * @brief Set which values are served from the cache, see ValueCachePolicy. Applies to every Device of the same
+     * device, K_DEFAULT_VALUE_CACHE_POLICY until changed.
+     *
+     * The cache follows the category of each parameter, which is read with its metadata the first time one of its
+     * values is read with the cache on, unless `fetchParameterMetaData` has already been called for it.
+     */
+    void setValueCachePolicy(ValueCachePolicy policy);
+
+    [[nodiscard]] ValueCachePolicy getValueCachePolicy() const;
+
+    /**
+     * @brief Forget the cached values, so that they are read from the device again.
+     *
+     * Needed when the values may have changed behind the master's back, e.g. after a reconnect or when another master
+     * has written them.
+     */
+    void invalidateValueCache();
+
+    /**
+     * @brief Send a command to this device without waiting for the response.
+     *
+     * The callback is invoked from `Context::run()` once the response has arrived. Several commands can be in flight
+     * at the same time which keeps the serial link busy instead of waiting for each response separately.
+     *
+     * @return true if the command was sent, false if too many commands are already waiting for their responses.
+     */
+    template <serial_communication_framework::commands::CommandType T_Command>
+    [[nodiscard]] bool submitCommand(typename T_Command::Request                                    request,
+                                     serial_communication_framework::AsyncResponseCallback<T_Command> callback,
+                                     void*                                                          user_data) {
+        return communication_handler_->submitCommand<T_Command>(device_id_, request, callback, user_data);
+    }
+
     static constexpr size_t K_MAX_DEVICE_ID = std::numeric_limits<uint8_t>::max();
 
 private:
-    explicit Device(uint8_t id, serial_communication_framework::MasterHandler& communication_handler);
+    explicit Device(uint8_t id, serial_communication_framework::MasterHandler& communication_handler,
+                    drivers::interfaces::ClockInterface& clock, ParameterValueCache& value_cache);
 
     uint8_t                                        device_id_;
     serial_communication_framework::MasterHandler* communication_handler_;
+    drivers::interfaces::ClockInterface*           clock_;
+    ParameterValueCache*                           value_cache_;
+
+    bool tryReadCachedValue(ParameterID id, parameter_system::ParameterValueType value_type,
+                            std::span<uint8_t> value_out);
+    void cacheReadValue(ParameterID id, parameter_system::ParameterValueType value_type,
+                        std::span<const uint8_t> value);
+    void onValueWritten(ParameterID id, parameter_system::ParameterValueType value_type,
+                        std::span<const uint8_t> value, serial_communication_framework::ResponseCode response_code);
 
     /*
     template <typename T_Command>
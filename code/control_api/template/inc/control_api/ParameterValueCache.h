@@ -0,0 +1,96 @@
+#ifndef CONTROL_API_PARAMETERVALUECACHE_H
+#define CONTROL_API_PARAMETERVALUECACHE_H
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "parameter_system/common.h"
+
+namespace servo_core_control_api {
+
+/**
+ * @brief Which parameter values `Device` serves from its cache instead of reading them from the device.
+ */
+struct ValueCachePolicy {
+    /// Serve the saved and runtime parameters from the cache once they have been read or written. Only the master
+    /// changes them, so they stay valid until the device reboots or the cache is invalidated.
+    bool     cache_parameters  = true;
+    /// How long a read signal value is served from the cache. 0 reads the signals from the device every time.
+    uint64_t signal_max_age_us = 0;
+};
+
+// The parameters are served from the cache, the signals are read from the device every time
+constexpr ValueCachePolicy K_DEFAULT_VALUE_CACHE_POLICY = {};
+
+// Every read goes to the device, e.g. to measure the bus or when another master writes the parameters too
+constexpr ValueCachePolicy K_NO_VALUE_CACHE_POLICY = {.cache_parameters = false, .signal_max_age_us = 0};
+
+/**
+ * @brief The last known values of the parameters of one device, with the rules of their categories.
+ *
+ * Saved and runtime parameters only change when the master writes them, so their values stay valid. Signals are
+ * changed by the device on its own, so their values only stay valid for the max age of the policy. A value is only
+ * served once the category of its parameter is known.
+ *
+ * Fixed size, one entry for every parameter id, so it can be used without a heap.
+ */
+class ParameterValueCache {
+public:
+    void setPolicy(ValueCachePolicy policy);
+
+    [[nodiscard]] ValueCachePolicy getPolicy() const;
+
+    /**
+     * @brief Check if any value is cached with the policy.
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+    void setCategory(parameter_system::ParameterID id, parameter_system::ParameterCategory category);
+
+    [[nodiscard]] bool hasCategory(parameter_system::ParameterID id) const;
+
+    /**
+     * @brief Copy the cached value of the parameter if it is still valid.
+     *
+     * @param value_out Where the value is copied to, must be the size of the value type.
+     * @param now_us    Current time of the same clock as given to `store()`.
+     * @return false if the value must be read from the device.
+     */
+    bool tryGet(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+                std::span<uint8_t> value_out, uint64_t now_us) const;
+
+    /**
+     * @brief Store a value that was read from the device or written to it.
+     */
+    void store(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+               std::span<const uint8_t> value, uint64_t now_us);
+
+    /**
+     * @brief Forget the value of the parameter, e.g. after a write whose outcome is not known.
+     */
+    void invalidate(parameter_system::ParameterID id);
+
+    /**
+     * @brief Forget all the values, e.g. after a reconnect or a reboot. The categories are kept, they never change.
+     */
+    void invalidate();
+
+private:
+    struct Entry {
+        uint8_t  value[parameter_system::K_MAX_VALUE_SIZE] = {};
+        uint64_t stored_at_us                              = 0;
+
+        parameter_system::ParameterValueType value_type   = parameter_system::ParameterValueType::none;
+        parameter_system::ParameterCategory  category     = parameter_system::ParameterCategory::signal;
+        bool                                 has_category = false;
+        bool                                 has_value    = false;
+    };
+
+    ValueCachePolicy                                                    policy_ = K_DEFAULT_VALUE_CACHE_POLICY;
+    std::array<Entry, size_t{parameter_system::K_MAX_PARAMETER_ID} + 1> entries_;
+};
+
+}  // namespace servo_core_control_api
+
+#endif  // CONTROL_API_PARAMETERVALUECACHE_H
@@ -1,29 +1,151 @@
 #include "control_api/Context.h"
 
 #include "protocol/commands.h"
+#include "protocol/stream_ids.h"
 
 namespace servo_core_control_api {
 
 Context::Context(drivers::interfaces::BufferedSerialCommunicationInterface& comm_interface,
-                 drivers::interfaces::ClockInterface&                       comm_timeout_clock)
-    : communication_handler{comm_interface, comm_timeout_clock} {}
+                 drivers::interfaces::ClockInterface&                       comm_timeout_clock,
+                 drivers::interfaces::SerialPortConfigurationInterface*     port_configuration)
+    : communication_handler{comm_interface, comm_timeout_clock},
+      comm_interface_(comm_interface),
+      clock_(comm_timeout_clock),
+      port_configuration_(port_configuration) {
+    communication_handler.setUnsolicitedFrameCallback(&Context::onUnsolicitedFrameReceived, this);
+    communication_handler.setRetryPolicy(K_DEFAULT_RETRY_POLICY);
+}
 
 Context::~Context() {}
 
 void Context::open() { communication_handler.init(); }
 
+void Context::run() { communication_handler.run(); }
+
+bool Context::waitForReceivedBytes(uint64_t timeout_us) { return comm_interface_.waitForReceivedBytes(timeout_us); }
+
+void Context::interruptWaitForReceivedBytes() { comm_interface_.interruptWaitForReceivedBytes(); }
+
+void Context::setTelemetryCallback(TelemetryCallback callback, void* user_data) {
+    telemetry_callback_           = callback;
+    telemetry_callback_user_data_ = user_data;
+}
+
+void Context::onUnsolicitedFrameReceived(uint8_t stream_id, uint8_t sender_id, std::span<uint8_t> payload,
+                                         void* user_data) {
+    auto* self = static_cast<Context*>(user_data);
+
+    if (stream_id != static_cast<uint8_t>(protocol::StreamIds::telemetry)) return;
+    if (self->telemetry_callback_ == nullptr) return;
+
+    protocol::TelemetryFrame frame;
+    if (frame.deserialize(sender_id, payload) != protocol::TelemetryFrame::ParsingError::no_error) return;
+
+    self->telemetry_callback_(frame, self->telemetry_callback_user_data_);
+}
+
 std::optional<Device> Context::tryFindDeviceById(uint8_t id) {
     using serial_communication_framework::ResponseCode;
 
     protocol::commands::Ping::Response response =
         communication_handler.sendCommandAndReceiveResponseBlocking<protocol::commands::Ping>(id, {});
 
-    if (response.response_code != ResponseCode::ok) {  // TODO what if the result is "corrupted"?
+    // A corrupted ping has already been retried, see K_DEFAULT_RETRY_POLICY
+    if (response.response_code != ResponseCode::ok) {
         // Return empty std::optional
         return {};
     }
 
-    return Device(id, communication_handler);
+    return Device(id, communication_handler, clock_, value_caches_[id]);
+}
+
+serial_communication_framework::LinkSettings Context::negotiateLinkSettings(uint8_t device_id, uint32_t max_baud_rate,
+                                                                            bool use_framing) {
+    using serial_communication_framework::Framing;
+    using serial_communication_framework::ResponseCode;
+
+    if (port_configuration_ == nullptr) return link_settings_;
+
+    protocol::commands::GetCapabilities::Response capabilities =
+        communication_handler.sendCommandAndReceiveResponseBlocking<protocol::commands::GetCapabilities>(device_id,
+                                                                                                         {});
+    if (capabilities.response_code != ResponseCode::ok) return link_settings_;
+    if (capabilities.protocol_version != protocol::commands::K_PROTOCOL_VERSION) return link_settings_;
+
+    const Framing framing = use_framing && capabilities.hasFeature(protocol::commands::ProtocolFeature::cobs_framing)
+                                ? Framing::cobs
+                                : Framing::none;
+
+    // Fastest first
+    for (auto it = capabilities.baud_rates.end(); it != capabilities.baud_rates.begin();) {
+        const uint32_t baud_rate = *--it;
+        if (baud_rate > max_baud_rate) continue;
+
+        const serial_communication_framework::LinkSettings settings = {.baud_rate = baud_rate, .framing = framing};
+        if (settings.baud_rate == link_settings_.baud_rate && settings.framing == link_settings_.framing) break;
+        if (trySwitchLinkSettings(device_id, settings)) break;
+    }
+
+    return link_settings_;
+}
+
+serial_communication_framework::LinkSettings Context::getLinkSettings() const { return link_settings_; }
+
+const serial_communication_framework::CommunicationStatistics& Context::getCommunicationStatistics() const {
+    return communication_handler.getStatistics();
+}
+
+const serial_communication_framework::LatencyHistogram& Context::getRoundTripLatencyHistogram(uint8_t op_code) const {
+    return communication_handler.getRoundTripLatencyHistogram(op_code);
+}
+
+bool Context::trySwitchLinkSettings(uint8_t device_id, serial_communication_framework::LinkSettings settings) {
+    using serial_communication_framework::K_LINK_VERIFY_TIMEOUT_MS;
+    using serial_communication_framework::ResponseCode;
+
+    const serial_communication_framework::LinkSettings previous_settings = link_settings_;
+
+    protocol::commands::ConfigureLinkRequest request;
+    request.settings = settings;
+    protocol::commands::ConfigureLink::Response response =
+        communication_handler.sendCommandAndReceiveResponseBlocking<protocol::commands::ConfigureLink>(device_id,
+                                                                                                       request);
+    if (response.response_code != ResponseCode::ok) return false;
+
+    // The device has switched once its response was sent. It only keeps the settings if it hears from us in time
+    if (applyLinkSettings(settings) && pingUntilAnswered(device_id, K_LINK_VERIFY_TIMEOUT_MS / 2)) return true;
+
+    // The device returns to the previous settings after the verify timeout
+    (void)applyLinkSettings(previous_settings);
+    if (pingUntilAnswered(device_id, 2 * K_LINK_VERIFY_TIMEOUT_MS)) return false;
+
+    // A ping got through to the device with the new settings but its answers did not get back, so it kept them
+    if (applyLinkSettings(settings) && pingUntilAnswered(device_id, K_LINK_VERIFY_TIMEOUT_MS)) return true;
+
+    (void)applyLinkSettings(previous_settings);
+    return false;
+}
+
+bool Context::applyLinkSettings(serial_communication_framework::LinkSettings settings) {
+    port_configuration_->flushTx();
+    if (!port_configuration_->setBaudRate(settings.baud_rate)) return false;
+
+    communication_handler.setFraming(settings.framing);
+    communication_handler.setBaudRate(settings.baud_rate);
+    link_settings_ = settings;
+    return true;
+}
+
+bool Context::pingUntilAnswered(uint8_t device_id, uint64_t time_limit_ms) {
+    const uint64_t start_time_point = clock_.uptimeMilliseconds();
+
+    do {
+        protocol::commands::Ping::Response response =
+            communication_handler.sendCommandAndReceiveResponseBlocking<protocol::commands::Ping>(device_id, {});
+        if (response.response_code == serial_communication_framework::ResponseCode::ok) return true;
+    } while (clock_.uptimeMilliseconds() - start_time_point < time_limit_ms);
+
+    return false;
 }
 
-}  // namespace servo_core_control_api
\ No newline at end of file
+}  // namespace servo_core_control_api
@@ -1,10 +1,19 @@
 #include "control_api/Device.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "assert/assert.h"
+#include "math/crc.h"
 #include "parameter_system/common.h"
+#include "parameter_system/parameter_type_mappings.h"
 
 namespace servo_core_control_api {
+
+namespace {
+using ProtocolTransferMaster = serial_communication_framework::TransferMaster<protocol::commands::TransferCommands>;
+}  // namespace
+
 Device::~Device() {}
 
 uint8_t Device::getId() { return device_id_; }
@@ -25,7 +34,15 @@ utils::StaticList<ParameterID, parameter_system::K_MAX_PARAMETER_ID> Device::fet
 }
 
 ParameterMetaData Device::fetchParameterMetaData(ParameterID id) {
-    using serial_communication_framework::ResponseCode;
+    // TODO throw, stays empty if the reading failed
+    ParameterMetaData meta_data = {};
+    (void)fetchParameterMetaData(id, &meta_data);
+    return meta_data;
+}
+
+serial_communication_framework::ResponseCode Device::fetchParameterMetaData(ParameterID        id,
+                                                                            ParameterMetaData* meta_data_out) {
+    ASSERT(meta_data_out != nullptr);
 
     protocol::commands::GetParamMetadataRequest request;
     request.parameter_id = id;
@@ -34,15 +51,359 @@ ParameterMetaData Device::fetchParameterMetaData(ParameterID id) {
         communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::GetParamMetadata>(device_id_,
                                                                                                             request);
 
-    if (response.response_code != ResponseCode::ok) {
-        // TODO throw
-        return {};
+    if (response.response_code == serial_communication_framework::ResponseCode::ok) {
+        *meta_data_out = response.meta_data;
+        value_cache_->setCategory(id, response.meta_data.category);
+    }
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::readParameterValuesRaw(
+    std::span<const protocol::commands::ReadParamValuesRequest::Entry> entries, std::span<uint8_t> values_out) {
+    using serial_communication_framework::ResponseCode;
+
+    size_t entry_index      = 0;
+    size_t values_out_index = 0;
+    while (entry_index < entries.size()) {
+        // Pack as many entries into one request as the response can carry
+        protocol::commands::ReadParamValuesRequest request;
+        size_t                                     batch_values_size = 0;
+        // Where the values go in values_out, the ones served from the cache leave gaps between them
+        size_t batch_value_offsets[protocol::commands::ReadParamValuesRequest::K_MAX_ENTRIES];
+        while (entry_index < entries.size() && !request.entries.full()) {
+            const protocol::commands::ReadParamValuesRequest::Entry& entry = entries[entry_index];
+            const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type);
+            if (batch_values_size + value_size > protocol::commands::ReadParamValuesResponse::K_RAW_BUFF_SIZE) break;
+            ASSERT_WITH_MESSAGE(values_out_index + value_size <= values_out.size_bytes(),
+                                "Values do not fit into the output buffer");
+
+            if (!tryReadCachedValue(entry.parameter_id, entry.expected_value_type,
+                                    values_out.subspan(values_out_index, value_size))) {
+                batch_value_offsets[request.entries.size()] = values_out_index;
+                request.entries.pushBack(entry);
+                batch_values_size += value_size;
+            }
+            values_out_index += value_size;
+            entry_index++;
+        }
+        if (request.entries.empty()) continue;
+
+        protocol::commands::ReadParamValuesResponse response =
+            communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::ReadParamValues>(
+                device_id_, request);
+
+        if (response.response_code != ResponseCode::ok) {
+            return response.response_code;
+        }
+        if (response.raw_bytes.size_bytes() != batch_values_size) {
+            return ResponseCode::malformed_response;
+        }
+
+        size_t response_index = 0;
+        for (size_t i = 0; i < request.entries.size(); i++) {
+            const protocol::commands::ReadParamValuesRequest::Entry& entry = request.entries[i];
+            const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type);
+            const std::span<const uint8_t> value = response.raw_bytes.subspan(response_index, value_size);
+
+            std::memcpy(&values_out[batch_value_offsets[i]], value.data(), value_size);
+            cacheReadValue(entry.parameter_id, entry.expected_value_type, value);
+            response_index += value_size;
+        }
     }
 
-    return response.meta_data;
+    return ResponseCode::ok;
+}
+
+serial_communication_framework::ResponseCode Device::writeParameterValues(
+    const protocol::commands::WriteParamValuesRequest& request) {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::WriteParamValues>(device_id_,
+                                                                                                          request);
+
+    for (const protocol::commands::WriteParamValuesRequest::Entry& entry : request.entries) {
+        const size_t value_size = parameter_system::sizeOfCppTypeByParameterValueType(entry.expected_value_type);
+        onValueWritten(entry.parameter_id, entry.expected_value_type,
+                       {&request.value_bytes[entry.value_offset], value_size}, response.response_code);
+    }
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::saveParameters() {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::SaveParameters>(device_id_,
+                                                                                                        {});
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::subscribeTelemetry(std::span<const ParameterID> parameter_ids,
+                                                                        uint32_t                     period_us) {
+    protocol::commands::SubscribeTelemetryRequest request;
+    ASSERT_WITH_MESSAGE(parameter_ids.size() <= request.parameter_ids.capacity(), "Too many telemetry signals");
+
+    request.period_us = period_us;
+    for (const ParameterID id : parameter_ids) {
+        request.parameter_ids.pushBack(id);
+    }
+
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::SubscribeTelemetry>(
+            device_id_, request);
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::unsubscribeTelemetry() {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::UnsubscribeTelemetry>(
+            device_id_, {});
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::armCapture(std::span<const ParameterID>           parameter_ids,
+                                                                const parameter_system::CaptureConfig& config) {
+    protocol::commands::ArmCaptureRequest request;
+    ASSERT_WITH_MESSAGE(parameter_ids.size() <= request.parameter_ids.capacity(), "Too many capture signals");
+
+    request.config = config;
+    for (const ParameterID id : parameter_ids) {
+        request.parameter_ids.pushBack(id);
+    }
+
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::ArmCapture>(device_id_,
+                                                                                                    request);
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::triggerCapture() {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::TriggerCapture>(device_id_,
+                                                                                                        {});
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::disarmCapture() {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::DisarmCapture>(device_id_,
+                                                                                                       {});
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::getCaptureStatus(parameter_system::CaptureStatus* status_out) {
+    ASSERT(status_out != nullptr);
+
+    protocol::commands::GetCaptureStatusResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::GetCaptureStatus>(device_id_,
+                                                                                                          {});
+
+    if (response.response_code == serial_communication_framework::ResponseCode::ok) {
+        *status_out = response.status;
+    }
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::downloadCapture(std::span<uint8_t> values_out) {
+    using serial_communication_framework::ResponseCode;
+    using protocol::commands::ReadCaptureDataResponse;
+
+    struct DownloadState {
+        std::span<uint8_t> values_out;
+        size_t             in_flight_count = 0;
+        ResponseCode       result          = ResponseCode::ok;
+    };
+
+    // Chunks are placed by the offset echoed in the response so their completion order does not matter
+    auto on_chunk_received = +[](const ReadCaptureDataResponse& response, void* user_data) {
+        auto* state = static_cast<DownloadState*>(user_data);
+        state->in_flight_count--;
+
+        if (response.response_code != ResponseCode::ok) {
+            if (state->result == ResponseCode::ok) state->result = response.response_code;
+            return;
+        }
+
+        const size_t expected_size =
+            std::min(ReadCaptureDataResponse::K_MAX_CHUNK_SIZE, state->values_out.size_bytes() - response.byte_offset);
+        if (response.byte_offset >= state->values_out.size_bytes() ||
+            response.raw_bytes.size_bytes() != expected_size) {
+            if (state->result == ResponseCode::ok) state->result = ResponseCode::malformed_response;
+            return;
+        }
+
+        std::memcpy(&state->values_out[response.byte_offset], response.raw_bytes.data(),
+                    response.raw_bytes.size_bytes());
+    };
+
+    DownloadState state{.values_out = values_out};
+    size_t        next_offset = 0;
+    while ((next_offset < values_out.size_bytes() && state.result == ResponseCode::ok) || state.in_flight_count > 0) {
+        // Keep as many chunk requests in flight as the master handler allows
+        while (next_offset < values_out.size_bytes() && state.result == ResponseCode::ok) {
+            protocol::commands::ReadCaptureDataRequest request;
+            request.byte_offset = static_cast<uint32_t>(next_offset);
+            request.byte_count  = static_cast<uint8_t>(
+                std::min(ReadCaptureDataResponse::K_MAX_CHUNK_SIZE, values_out.size_bytes() - next_offset));
+
+            if (!submitCommand<protocol::commands::ReadCaptureData>(request, on_chunk_received, &state)) break;
+
+            state.in_flight_count++;
+            next_offset += request.byte_count;
+        }
+
+        communication_handler_->waitForResponse();
+        communication_handler_->run();
+    }
+
+    return state.result;
+}
+
+serial_communication_framework::ResponseCode Device::uploadTransfer(protocol::TransferIds    transfer_id,
+                                                                   std::span<const uint8_t> data,
+                                                                   TransferOptions          options) {
+    ProtocolTransferMaster transfer(*communication_handler_);
+    const bool started = transfer.startUpload(device_id_, static_cast<uint8_t>(transfer_id), data, options);
+    ASSERT(started);
+
+    while (!transfer.isFinished()) {
+        transfer.run();
+        communication_handler_->waitForResponse();
+        communication_handler_->run();
+    }
+    return transfer.getResult();
+}
+
+serial_communication_framework::ResponseCode Device::downloadTransfer(protocol::TransferIds transfer_id,
+                                                                     std::span<uint8_t>    data_out,
+                                                                     TransferOptions       options) {
+    ProtocolTransferMaster transfer(*communication_handler_);
+    const bool started = transfer.startDownload(device_id_, static_cast<uint8_t>(transfer_id), data_out, options);
+    ASSERT(started);
+
+    while (!transfer.isFinished()) {
+        transfer.run();
+        communication_handler_->waitForResponse();
+        communication_handler_->run();
+    }
+    return transfer.getResult();
+}
+
+serial_communication_framework::ResponseCode Device::updateFirmware(std::span<const uint8_t> image) {
+    using serial_communication_framework::ResponseCode;
+
+    protocol::commands::BeginFirmwareUpdateRequest request;
+    request.image_size = static_cast<uint32_t>(image.size_bytes());
+    request.image_crc  = math::generateCrc32(image);
+
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::BeginFirmwareUpdate>(
+            device_id_, request);
+    if (response.response_code != ResponseCode::ok) return response.response_code;
+
+    return uploadTransfer(protocol::TransferIds::firmware_image, image);
+}
+
+serial_communication_framework::ResponseCode Device::getFirmwareStatus(firmware_update::FirmwareStatus* status_out) {
+    ASSERT(status_out != nullptr);
+
+    protocol::commands::GetFirmwareStatusResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::GetFirmwareStatus>(
+            device_id_, {});
+
+    if (response.response_code == serial_communication_framework::ResponseCode::ok) {
+        *status_out = response.status;
+    }
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::getCommunicationStatistics(
+    serial_communication_framework::CommunicationStatistics* statistics_out) {
+    ASSERT(statistics_out != nullptr);
+
+    protocol::commands::GetCommunicationStatisticsResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::GetCommunicationStatistics>(
+            device_id_, {});
+
+    if (response.response_code == serial_communication_framework::ResponseCode::ok) {
+        *statistics_out = response.statistics;
+    }
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::getOperationStatistics(
+    uint8_t op_code, serial_communication_framework::OperationStatistics* operation_out,
+    serial_communication_framework::DurationStatistics* handler_time_out) {
+    ASSERT(operation_out != nullptr);
+    ASSERT(handler_time_out != nullptr);
+
+    protocol::commands::GetOperationStatisticsRequest request;
+    request.operation_code = op_code;
+
+    protocol::commands::GetOperationStatisticsResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::GetOperationStatistics>(
+            device_id_, request);
+
+    if (response.response_code == serial_communication_framework::ResponseCode::ok) {
+        *operation_out    = response.operation;
+        *handler_time_out = response.handler_time;
+    }
+
+    return response.response_code;
+}
+
+serial_communication_framework::ResponseCode Device::reboot() {
+    protocol::commands::EmptyResponse response =
+        communication_handler_->sendCommandAndReceiveResponseBlocking<protocol::commands::Reboot>(device_id_, {});
+    // Even without a response the device may have rebooted
+    value_cache_->invalidate();
+    return response.response_code;
+}
+
+void Device::setValueCachePolicy(ValueCachePolicy policy) { value_cache_->setPolicy(policy); }
+
+ValueCachePolicy Device::getValueCachePolicy() const { return value_cache_->getPolicy(); }
+
+void Device::invalidateValueCache() { value_cache_->invalidate(); }
+
+bool Device::tryReadCachedValue(ParameterID id, parameter_system::ParameterValueType value_type,
+                                std::span<uint8_t> value_out) {
+    if (!value_cache_->isEnabled()) return false;
+
+    if (!value_cache_->hasCategory(id)) {
+        // Records the category, a parameter that doesn't exist is left to the read to report
+        ParameterMetaData meta_data;
+        if (fetchParameterMetaData(id, &meta_data) != serial_communication_framework::ResponseCode::ok) return false;
+    }
+    return value_cache_->tryGet(id, value_type, value_out, clock_->uptimeMicroseconds());
+}
+
+void Device::cacheReadValue(ParameterID id, parameter_system::ParameterValueType value_type,
+                            std::span<const uint8_t> value) {
+    if (!value_cache_->isEnabled()) return;
+    value_cache_->store(id, value_type, value, clock_->uptimeMicroseconds());
+}
+
+void Device::onValueWritten(ParameterID id, parameter_system::ParameterValueType value_type,
+                            std::span<const uint8_t> value,
+                            serial_communication_framework::ResponseCode response_code) {
+    if (response_code == serial_communication_framework::ResponseCode::ok) {
+        cacheReadValue(id, value_type, value);
+    } else {
+        // The write may or may not have reached the device
+        value_cache_->invalidate(id);
+    }
 }
 
-Device::Device(uint8_t id, serial_communication_framework::MasterHandler& communication_handler)
-    : device_id_(id), communication_handler_(&communication_handler) {}
+Device::Device(uint8_t id, serial_communication_framework::MasterHandler& communication_handler,
+               drivers::interfaces::ClockInterface& clock, ParameterValueCache& value_cache)
+    : device_id_(id), communication_handler_(&communication_handler), clock_(&clock), value_cache_(&value_cache) {}
 
 }  // namespace servo_core_control_api
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "control_api/ParameterValueCache.h"
+
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace servo_core_control_api {
+
+void ParameterValueCache::setPolicy(ValueCachePolicy policy) { policy_ = policy; }
+
+ValueCachePolicy ParameterValueCache::getPolicy() const { return policy_; }
+
+bool ParameterValueCache::isEnabled() const { return policy_.cache_parameters || policy_.signal_max_age_us > 0; }
+
+void ParameterValueCache::setCategory(parameter_system::ParameterID id, parameter_system::ParameterCategory category) {
+    entries_[id].category     = category;
+    entries_[id].has_category = true;
+}
+
+bool ParameterValueCache::hasCategory(parameter_system::ParameterID id) const { return entries_[id].has_category; }
+
+bool ParameterValueCache::tryGet(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+                                 std::span<uint8_t> value_out, uint64_t now_us) const {
+    const Entry& entry = entries_[id];
+    if (!entry.has_value || !entry.has_category || entry.value_type != value_type) return false;
+
+    if (entry.category == parameter_system::ParameterCategory::signal) {
+        if (now_us - entry.stored_at_us >= policy_.signal_max_age_us) return false;
+    } else if (!policy_.cache_parameters) {
+        return false;
+    }
+
+    ASSERT_WITH_MESSAGE(value_out.size_bytes() <= sizeof(entry.value), "Value too large for the cache");
+    std::memcpy(value_out.data(), entry.value, value_out.size_bytes());
+    return true;
+}
+
+void ParameterValueCache::store(parameter_system::ParameterID id, parameter_system::ParameterValueType value_type,
+                                std::span<const uint8_t> value, uint64_t now_us) {
+    Entry& entry = entries_[id];
+    ASSERT_WITH_MESSAGE(value.size_bytes() <= sizeof(entry.value), "Value too large for the cache");
+
+    std::memcpy(entry.value, value.data(), value.size_bytes());
+    entry.stored_at_us = now_us;
+    entry.value_type   = value_type;
+    entry.has_value    = true;
+}
+
+void ParameterValueCache::invalidate(parameter_system::ParameterID id) { entries_[id].has_value = false; }
+
+void ParameterValueCache::invalidate() {
+    for (Entry& entry : entries_) entry.has_value = false;
+}
+
+}  // namespace servo_core_control_api
@@ -0,0 +1,111 @@
+#ifndef CONTROL_API_THREADED_MULTIPORTCONTEXT_H
+#define CONTROL_API_THREADED_MULTIPORTCONTEXT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+#include "control_api/threaded/internal/PortWorker.h"
+
+namespace servo_core_control_api::threaded {
+
+/**
+ * @brief The devices on several serial ports, used from any number of threads.
+ *
+ * Every port has a worker thread of its own that does all the I/O of the port's Context. The functions submitted for
+ * a port run in its worker one after another, in the order they were submitted, so the bus is never shared. The
+ * ports progress in parallel, a slow device only holds up the functions submitted for its own port.
+ *
+ * The results are returned as futures. Exceptions thrown by the functions, e.g. by the serial port drivers, are
+ * passed on through them.
+ *
+ * @code
+ * MultiPortContext context;
+ * const size_t     port = context.addPort(linux_context);
+ * std::future<float> value =
+ *     context.submitToDevice(port, 3, [](Device& device) { return device.readParameterValue(protocol::params::x); });
+ * @endcode
+ */
+class MultiPortContext {
+public:
+     MultiPortContext() = default;
+    ~MultiPortContext() = default;
+
+    MultiPortContext(const MultiPortContext&)            = delete;
+    MultiPortContext& operator=(const MultiPortContext&) = delete;
+
+    /**
+     * @brief Add a port and start its worker.
+     *
+     * The Context must outlive this and must not be used directly afterwards. Not thread safe, the ports are added
+     * before the functions are submitted from other threads.
+     *
+     * @param port_context The Context of the port, e.g. a `posix::Context`.
+     * @return The index of the port for submitting functions.
+     */
+    size_t addPort(Context& port_context);
+
+    [[nodiscard]] size_t getPortCount() const;
+
+    /**
+     * @brief Run the function with the Context of the port in the port's worker.
+     *
+     * @param port_index Index returned by `addPort()`.
+     * @param function   Invoked as `function(Context&)`.
+     * @return The future of the function's result.
+     * @throw std::out_of_range if there is no port of the index.
+     */
+    template <typename T_Function>
+    auto submit(size_t port_index, T_Function function) -> std::future<std::invoke_result_t<T_Function&, Context&>> {
+        using Result = std::invoke_result_t<T_Function&, Context&>;
+        return post<Result>(port_index, [function = std::move(function)](internal::PortWorker& worker) mutable {
+            return function(worker.getContext());
+        });
+    }
+
+    /**
+     * @brief Run the function with a device on the port in the port's worker.
+     *
+     * The device is pinged the first time it is used. If it doesn't answer, the future holds a std::runtime_error.
+     * The Device must not be kept after the function returns, it is only valid in the worker.
+     *
+     * @param port_index Index returned by `addPort()`.
+     * @param device_id  Id of the device on the port.
+     * @param function   Invoked as `function(Device&)`.
+     * @return The future of the function's result.
+     * @throw std::out_of_range if there is no port of the index.
+     */
+    template <typename T_Function>
+    auto submitToDevice(size_t port_index, uint8_t device_id, T_Function function)
+        -> std::future<std::invoke_result_t<T_Function&, Device&>> {
+        using Result = std::invoke_result_t<T_Function&, Device&>;
+        return post<Result>(port_index,
+                            [device_id, function = std::move(function)](internal::PortWorker& worker) mutable {
+                                return function(worker.findDevice(device_id));
+                            });
+    }
+
+private:
+    std::vector<std::unique_ptr<internal::PortWorker>> workers_;
+
+    template <typename T_Result, typename T_Job>
+    std::future<T_Result> post(size_t port_index, T_Job job) {
+        internal::PortWorker& worker = *workers_.at(port_index);
+
+        // Shared, std::function can only hold copyable jobs
+        auto task = std::make_shared<std::packaged_task<T_Result(internal::PortWorker&)>>(std::move(job));
+        std::future<T_Result> result = task->get_future();
+        worker.post([task](internal::PortWorker& worker) { (*task)(worker); });
+        return result;
+    }
+};
+
+}  // namespace servo_core_control_api::threaded
+
+#endif  // CONTROL_API_THREADED_MULTIPORTCONTEXT_H
@@ -0,0 +1,79 @@
+#ifndef CONTROL_API_THREADED_PORTWORKER_H
+#define CONTROL_API_THREADED_PORTWORKER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+
+namespace servo_core_control_api::threaded::internal {
+
+/**
+ * @brief Thread that does all the I/O of one port, by running the jobs posted to it one after another.
+ *
+ * Only the jobs use the port's Context, so no two of them are ever on the bus at the same time. While there are no
+ * jobs, the worker sleeps in `Context::waitForReceivedBytes()` and runs the Context when the devices have sent
+ * something, so that the telemetry frames keep being received. Posting a job interrupts the wait.
+ *
+ * The driver of the port must be able to sleep and to interrupt its wait, see
+ * `BufferedSerialCommunicationInterface::interruptWaitForReceivedBytes()`. The idle worker polls the port otherwise.
+ * After the port has failed, e.g. because its device was unplugged, the idle worker only waits for the next job.
+ */
+class PortWorker {
+public:
+    using Job = std::function<void(PortWorker&)>;
+
+    // The longest an idle worker sleeps before it runs the Context anyway, so that the timeouts of the asynchronous
+    // commands a job has left in flight are noticed
+    static constexpr uint64_t K_IDLE_WAIT_TIMEOUT_US = 100'000;
+
+    explicit PortWorker(Context& context);
+    /**
+     * @brief Run the jobs still queued, then stop the thread.
+     */
+    ~PortWorker();
+
+    PortWorker(const PortWorker&)            = delete;
+    PortWorker& operator=(const PortWorker&) = delete;
+
+    /**
+     * @brief Queue the job behind the ones already posted. Can be called from any thread.
+     */
+    void post(Job job);
+
+    /**
+     * @brief Get the Context of the port. Only for the jobs.
+     */
+    [[nodiscard]] Context& getContext();
+
+    /**
+     * @brief Get the device of the id, pinging it the first time. Only for the jobs.
+     *
+     * @throw std::runtime_error if the device doesn't answer.
+     */
+    [[nodiscard]] Device& findDevice(uint8_t device_id);
+
+private:
+    void run();
+
+    Context&                            context_;
+    std::unordered_map<uint8_t, Device> found_devices_;  // Only used by the jobs
+
+    std::mutex              mutex_;
+    std::condition_variable job_posted_;  // Only waited for while the port has failed
+    std::deque<Job>         jobs_;
+    bool                    stop_requested_ = false;
+
+    // Started last, when everything it uses has been constructed
+    std::thread thread_;
+};
+
+}  // namespace servo_core_control_api::threaded::internal
+
+#endif  // CONTROL_API_THREADED_PORTWORKER_H
@@ -0,0 +1,12 @@
+#include "control_api/threaded/MultiPortContext.h"
+
+namespace servo_core_control_api::threaded {
+
+size_t MultiPortContext::addPort(Context& port_context) {
+    workers_.push_back(std::make_unique<internal::PortWorker>(port_context));
+    return workers_.size() - 1;
+}
+
+size_t MultiPortContext::getPortCount() const { return workers_.size(); }
+
+}  // namespace servo_core_control_api::threaded
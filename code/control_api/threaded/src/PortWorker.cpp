@@ -0,0 +1,79 @@
+#include "control_api/threaded/internal/PortWorker.h"
+
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace servo_core_control_api::threaded::internal {
+
+PortWorker::PortWorker(Context& context) : context_(context), thread_([this] { run(); }) {}
+
+PortWorker::~PortWorker() {
+    {
+        std::scoped_lock lock(mutex_);
+        stop_requested_ = true;
+    }
+    job_posted_.notify_one();
+    context_.interruptWaitForReceivedBytes();
+    thread_.join();
+}
+
+void PortWorker::post(Job job) {
+    {
+        std::scoped_lock lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    job_posted_.notify_one();
+    context_.interruptWaitForReceivedBytes();
+}
+
+Context& PortWorker::getContext() { return context_; }
+
+Device& PortWorker::findDevice(uint8_t device_id) {
+    if (auto found_device = found_devices_.find(device_id); found_device != found_devices_.end()) {
+        return found_device->second;
+    }
+
+    std::optional<Device> device = context_.tryFindDeviceById(device_id);
+    if (!device.has_value()) {
+        throw std::runtime_error("device " + std::to_string(device_id) + " does not answer");
+    }
+    return found_devices_.emplace(device_id, *device).first->second;
+}
+
+void PortWorker::run() {
+    bool port_failed = false;
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex_);
+            if (port_failed) job_posted_.wait(lock, [this] { return !jobs_.empty() || stop_requested_; });
+
+            if (!jobs_.empty()) {
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            } else if (stop_requested_) {
+                return;
+            }
+        }
+
+        if (job) {
+            job(*this);
+            port_failed = false;
+            continue;
+        }
+
+        // A job posted after the queue was looked at interrupts the wait before or while it sleeps
+        try {
+            (void)context_.waitForReceivedBytes(K_IDLE_WAIT_TIMEOUT_US);
+            context_.run();
+        } catch (const std::exception&) {
+            // Nobody is waiting for this, the next job runs into the same error of the port and reports it
+            port_failed = true;
+        }
+    }
+}
+
+}  // namespace servo_core_control_api::threaded::internal
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+#include "control_api/threaded/MultiPortContext.h"
+#include "drivers/host/LoopbackLink.h"
+#include "drivers/host/SteadyClock.h"
+#include "parameter_system/ParameterDeclaration.h"
+#include "protocol/commands.h"
+#include "serial_communication_framework/SlaveHandler.h"
+
+using serial_communication_framework::ResponseCode;
+using servo_core_control_api::Context;
+using servo_core_control_api::Device;
+using servo_core_control_api::threaded::MultiPortContext;
+using servo_core_control_api::threaded::internal::PortWorker;
+
+namespace {
+
+constexpr uint8_t K_DEVICE_ID = 7;
+
+protocol::commands::Ping::Response ping(const protocol::commands::Ping::Request& request) {
+    (void)request;  // unused
+    protocol::commands::Ping::Response response;
+    response.response_code = ResponseCode::ok;
+    return response;
+}
+
+// Every parameter reads back its own id
+protocol::commands::ReadParamValueResponse readParamValue(const protocol::commands::ReadParamValueRequest& request) {
+    protocol::commands::ReadParamValueResponse response;
+    const uint32_t                             value = request.parameter_id;
+    std::memcpy(response.raw_bytes, &value, sizeof(value));
+    response.valid_byte_count = sizeof(value);
+    response.response_code    = ResponseCode::ok;
+    return response;
+}
+
+uint32_t readParameter(Device& device, parameter_system::ParameterID id) {
+    return device.readParameterValue(
+        parameter_system::ParameterDeclaration<parameter_system::ParameterValueType::uint32>{id});
+}
+
+// A port with a device on the other end of a LoopbackLink, answering in its own thread
+class SimulatedPort {
+public:
+    SimulatedPort()
+        : link_(clock_),
+          device_(link_.getEndB(), clock_, K_DEVICE_ID),
+          context_(link_.getEndA(), clock_, &link_.getEndA()) {
+        device_.init();
+        device_.registerCommandHandler<protocol::commands::Ping, ping>();
+        device_.registerCommandHandler<protocol::commands::ReadParamValue, readParamValue>();
+        context_.open();
+
+        thread_ = std::thread([this] {
+            while (!stop_) {
+                link_.getEndB().waitForReceivedBytes(1'000);
+                device_.run();
+            }
+        });
+    }
+
+    ~SimulatedPort() {
+        stop_ = true;
+        thread_.join();
+    }
+
+    SimulatedPort(const SimulatedPort&)            = delete;
+    SimulatedPort& operator=(const SimulatedPort&) = delete;
+
+    Context& getContext() { return context_; }
+
+private:
+    drivers::host::SteadyClock                   clock_;
+    drivers::host::LoopbackLink                  link_;
+    serial_communication_framework::SlaveHandler device_;
+    Context                                      context_;
+    std::atomic<bool>                            stop_ = false;
+    std::thread                                  thread_;
+};
+
+// The ports are declared before the MultiPortContext, whose workers must stop before the ports go away
+struct SimulatedPorts {
+    explicit SimulatedPorts(size_t port_count) {
+        for (size_t i = 0; i < port_count; i++) {
+            ports.push_back(std::make_unique<SimulatedPort>());
+            context.addPort(ports.back()->getContext());
+        }
+    }
+
+    std::vector<std::unique_ptr<SimulatedPort>> ports;
+    MultiPortContext                            context;
+};
+
+}  // namespace
+
+TEST(MultiPortContext, runs_functions_with_the_context_of_the_port) {
+    SimulatedPorts simulated(2);
+    ASSERT_EQ(simulated.context.getPortCount(), 2);
+
+    std::future<bool> found = simulated.context.submit(
+        1, [](Context& context) { return context.tryFindDeviceById(K_DEVICE_ID).has_value(); });
+    EXPECT_TRUE(found.get());
+}
+
+TEST(MultiPortContext, submits_to_the_devices_on_every_port) {
+    SimulatedPorts simulated(3);
+
+    std::vector<std::future<uint32_t>> values;
+    for (size_t port = 0; port < 3; port++) {
+        const auto id = static_cast<parameter_system::ParameterID>(10 + port);
+        values.push_back(simulated.context.submitToDevice(port, K_DEVICE_ID,
+                                                          [id](Device& device) { return readParameter(device, id); }));
+    }
+
+    for (size_t port = 0; port < 3; port++) {
+        EXPECT_EQ(values[port].get(), 10 + port);
+    }
+}
+
+TEST(MultiPortContext, passes_on_the_errors_through_the_future) {
+    SimulatedPorts simulated(1);
+
+    std::future<void> missing_device = simulated.context.submitToDevice(0, K_DEVICE_ID + 1, [](Device&) {});
+    EXPECT_THROW(missing_device.get(), std::runtime_error);
+
+    std::future<int> failed = simulated.context.submit(0, [](Context&) -> int { throw std::logic_error("failed"); });
+    EXPECT_THROW(failed.get(), std::logic_error);
+
+    EXPECT_THROW((void)simulated.context.submit(1, [](Context&) {}), std::out_of_range);
+}
+
+TEST(MultiPortContext, a_busy_port_does_not_hold_up_the_others) {
+    SimulatedPorts simulated(2);
+
+    std::promise<void> release;
+    std::future<void>  released = release.get_future();
+    std::future<void>  busy     = simulated.context.submit(0, [&released](Context&) { released.wait(); });
+
+    std::future<uint32_t> value =
+        simulated.context.submitToDevice(1, K_DEVICE_ID, [](Device& device) { return readParameter(device, 42); });
+    EXPECT_EQ(value.get(), 42);
+    EXPECT_EQ(busy.wait_for(std::chrono::seconds(0)), std::future_status::timeout);
+
+    release.set_value();
+    busy.get();
+}
+
+TEST(MultiPortContext, runs_the_functions_of_a_port_one_at_a_time) {
+    SimulatedPorts simulated(1);
+
+    std::atomic<int> running_count = 0;
+    std::atomic<int> max_running   = 0;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 20; i++) {
+                simulated.context
+                    .submitToDevice(0, K_DEVICE_ID,
+                                    [&](Device& device) {
+                                        const int running = ++running_count;
+                                        if (running > max_running) max_running = running;
+                                        (void)readParameter(device, 1);
+                                        running_count--;
+                                    })
+                    .get();
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    EXPECT_EQ(max_running, 1);
+}
+
+TEST(MultiPortContext, an_idle_worker_wakes_up_for_a_submitted_function) {
+    SimulatedPorts simulated(1);
+    ASSERT_TRUE(simulated.context.submit(0, [](Context&) { return true; }).get());
+
+    // The worker has gone back to sleeping in the wait of the port
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    const auto        start = std::chrono::steady_clock::now();
+    std::future<bool> ran   = simulated.context.submit(0, [](Context&) { return true; });
+    EXPECT_TRUE(ran.get());
+    const std::chrono::microseconds wake_up_limit(PortWorker::K_IDLE_WAIT_TIMEOUT_US / 2);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, wake_up_limit);
+}
+
+TEST(MultiPortContext, stress_many_threads_on_many_ports) {
+    constexpr size_t K_PORT_COUNT      = 4;
+    constexpr size_t K_THREAD_COUNT    = 8;
+    constexpr size_t K_READS_PER_BATCH = 10;
+    constexpr size_t K_BATCH_COUNT     = 20;
+
+    SimulatedPorts simulated(K_PORT_COUNT);
+
+    std::atomic<size_t> wrong_value_count = 0;
+    std::atomic<size_t> command_count     = 0;
+
+    const auto               start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < K_THREAD_COUNT; t++) {
+        threads.emplace_back([&, t] {
+            for (size_t batch = 0; batch < K_BATCH_COUNT; batch++) {
+                // A batch of reads is in the queues of all the ports at once
+                std::vector<std::future<bool>> checks;
+                for (size_t i = 0; i < K_READS_PER_BATCH; i++) {
+                    const size_t port = (t + batch + i) % K_PORT_COUNT;
+                    const auto   id   = static_cast<parameter_system::ParameterID>(1 + (t * 31 + batch * 7 + i) % 255);
+                    checks.push_back(simulated.context.submitToDevice(
+                        port, K_DEVICE_ID, [id](Device& device) { return readParameter(device, id) == id; }));
+                }
+                for (std::future<bool>& check : checks) {
+                    if (!check.get()) wrong_value_count++;
+                    command_count++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(wrong_value_count, 0);
+    EXPECT_EQ(command_count, K_THREAD_COUNT * K_BATCH_COUNT * K_READS_PER_BATCH);
+
+    const auto commands_per_second = static_cast<int>(static_cast<double>(command_count) / elapsed.count());
+    RecordProperty("commands_per_second", commands_per_second);
+}
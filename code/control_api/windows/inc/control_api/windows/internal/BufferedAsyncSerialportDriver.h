@@ -4,14 +4,17 @@
 #include <windows.h>
 
 #include <format>
+#include <mutex>
 #include <string>
 
 #include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
 #include "utils/RingBuffer.h"
 
 namespace servo_core_control_api::windows::internal {
 
-class BufferedAsyncSerialPortDriver : public drivers::interfaces::BufferedSerialCommunicationInterface {
+class BufferedAsyncSerialPortDriver : public drivers::interfaces::BufferedSerialCommunicationInterface,
+                                      public drivers::interfaces::SerialPortConfigurationInterface {
 public:
     explicit BufferedAsyncSerialPortDriver(const char* serial_port_name);
     ~        BufferedAsyncSerialPortDriver() override;
@@ -26,9 +29,42 @@ public:
 
     size_t readReceivedBytes(std::span<uint8_t> buffer) override;
 
+    uint64_t getRxOverflowCount() override;
+
+    /**
+     * @brief Sleep in ReadFile until a byte arrives or the timeout, rounded up to milliseconds, has passed.
+     *
+     * The arrived byte is kept by the driver and is the first one read after this.
+     */
+    bool waitForReceivedBytes(uint64_t timeout_us) override;
+
+    /**
+     * @brief Cancel the ReadFile of the wait in progress with CancelIoEx.
+     *
+     * Only the ReadFile of the wait is cancelled, never a write. An interruption that comes just before the wait
+     * calls ReadFile is noticed by the next wait, this one then sleeps until its timeout.
+     */
+    void interruptWaitForReceivedBytes() override;
+
+    bool setBaudRate(uint32_t baud_rate) override;
+
+    uint32_t getBaudRate() override;
+
+    void flushTx() override;
+
 private:
     std::string getLastErrorStr();
 
+    void countRxOverflows(DWORD comm_errors);
+
+    /**
+     * @brief Get the amount of received bytes in the buffer of the port, without the one taken by
+     *        `waitForReceivedBytes()`.
+     */
+    DWORD getPortReceivedBytesAmount();
+
+    void setReadTimeout(DWORD timeout_ms);
+
     /**
      * @brief Normalize a COM port name to the Win32 device-namespace form `\\.\COMn`.
      *
@@ -46,7 +82,18 @@ private:
      */
     static std::string makeValidComPortPath(std::string_view str);
 
-    HANDLE serial_port_handle_;
+    HANDLE   serial_port_handle_;
+    uint64_t rx_overflow_count_ = 0;
+    DWORD    read_timeout_ms_   = 0;
+
+    // Taken out of the port by waitForReceivedBytes(), Windows can't wait for a byte without reading it
+    bool    has_waited_byte_ = false;
+    uint8_t waited_byte_     = 0;
+
+    // Taken by the thread that interrupts the wait, so that it only cancels the ReadFile of the wait
+    std::mutex wait_mutex_;
+    bool       is_waiting_       = false;
+    bool       wait_interrupted_ = false;
 };
 
 }  // namespace servo_core_control_api::windows::internal
@@ -1,7 +1,10 @@
 #include "control_api/windows/internal/BufferedAsyncSerialportDriver.h"
 
+#include <algorithm>
 #include <format>
 #include <stdexcept>
+
+#include "serial_communication_framework/common.h"
 #ifdef SERVO_CORE_CONTROL_API_WINDOWS_COMPORT_DRIVER_DEBUG_PRINTS
 #include <iostream>
 #endif
@@ -36,7 +39,7 @@ BufferedAsyncSerialPortDriver::BufferedAsyncSerialPortDriver(const char* serial_
         // error getting state
         throw std::runtime_error(std::format("could not get serial parameters: {}", getLastErrorStr()));
     }
-    serial_params.BaudRate = CBR_115200;
+    serial_params.BaudRate = serial_communication_framework::K_DEFAULT_LINK_SETTINGS.baud_rate;
     serial_params.ByteSize = 8;
     serial_params.StopBits = ONESTOPBIT;
     serial_params.Parity   = NOPARITY;
@@ -45,13 +48,8 @@ BufferedAsyncSerialPortDriver::BufferedAsyncSerialPortDriver(const char* serial_
         throw std::runtime_error(std::format("could not set serial parameters: {}", getLastErrorStr()));
     }
 
-    // TODO CALCULATE THESE TIMEOUTS FROM SERIAL_COMMUNICATION_FRAMEWORK TIMEOUTS SO THAT THESE ARE ALWAYS SHORTER?
-    COMMTIMEOUTS timeouts                = {};
-    timeouts.ReadIntervalTimeout         = 25;  // Time between received bytes (ms)
-    timeouts.ReadTotalTimeoutConstant    = 50;  // Total timeout if no bytes received (ms)
-    timeouts.ReadTotalTimeoutMultiplier  = 10;  // Additional time per byte expected
-    timeouts.WriteTotalTimeoutConstant   = 50;
-    timeouts.WriteTotalTimeoutMultiplier = 10;
+    // ReadFile returns as soon as anything has been received, only waitForReceivedBytes() reads before that
+    setReadTimeout(1);
 }
 
 BufferedAsyncSerialPortDriver::~BufferedAsyncSerialPortDriver() {
@@ -95,48 +93,56 @@ void BufferedAsyncSerialPortDriver::transmitBytes(std::span<uint8_t> bytes) {
 }
 
 size_t BufferedAsyncSerialPortDriver::getReceivedBytesAvailableAmount() {
+    return getPortReceivedBytesAmount() + (has_waited_byte_ ? 1 : 0);
+}
+
+uint64_t BufferedAsyncSerialPortDriver::getRxOverflowCount() {
     COMSTAT comStat;
     DWORD   errors;
-    if (ClearCommError(serial_port_handle_, &errors, &comStat)) {
-        return comStat.cbInQue;
-    }
+    if (ClearCommError(serial_port_handle_, &errors, &comStat)) countRxOverflows(errors);
+    return rx_overflow_count_;
+}
 
-    return 0;
+void BufferedAsyncSerialPortDriver::countRxOverflows(DWORD comm_errors) {
+    // Windows only tells that bytes were lost since the errors were last cleared, not how many
+    if ((comm_errors & (CE_RXOVER | CE_OVERRUN)) != 0) rx_overflow_count_++;
 }
 
 uint8_t BufferedAsyncSerialPortDriver::readReceivedByte() {
     uint8_t byte;
-    DWORD   bytes_read = 0;
-    if (!ReadFile(serial_port_handle_, &byte, 1, &bytes_read, nullptr)) {
-        throw std::runtime_error(std::format("could not read from serial port: {}", getLastErrorStr()));
-    }
-
-    if (bytes_read != 1) {
+    if (readReceivedBytes(std::span<uint8_t>(&byte, 1)) != 1) {
         throw std::runtime_error("Serial port reading timed out");
     }
-
-#ifdef SERVO_CORE_CONTROL_API_WINDOWS_COMPORT_DRIVER_DEBUG_PRINTS
-    std::cout << "Read: " << std::hex << static_cast<int>(byte) << std::endl;
-#endif
-
     return byte;
 }
 
 size_t BufferedAsyncSerialPortDriver::readReceivedBytes(std::span<uint8_t> buffer) {
-    DWORD bytes_read    = 0;
-    DWORD bytes_to_read = (buffer.size_bytes() < getReceivedBytesAvailableAmount()) ? buffer.size_bytes()
-                                                                                    : getReceivedBytesAvailableAmount();
-    if (!ReadFile(serial_port_handle_, buffer.data(), bytes_to_read, &bytes_read, nullptr)) {
+    if (buffer.empty()) return 0;
+
+    DWORD bytes_read = 0;
+    if (has_waited_byte_) {
+        buffer[0]        = waited_byte_;
+        has_waited_byte_ = false;
+        bytes_read       = 1;
+    }
+
+    // Only what has already been received is read, so that ReadFile does not wait
+    const DWORD buffer_room     = static_cast<DWORD>(buffer.size_bytes()) - bytes_read;
+    const DWORD bytes_to_read   = std::min(buffer_room, getPortReceivedBytesAmount());
+    DWORD       port_bytes_read = 0;
+    if (bytes_to_read > 0 &&
+        !ReadFile(serial_port_handle_, buffer.data() + bytes_read, bytes_to_read, &port_bytes_read, nullptr)) {
         throw std::runtime_error(std::format("could not read from serial port: {}", getLastErrorStr()));
     }
 
-    if (bytes_read != bytes_to_read) {
+    if (port_bytes_read != bytes_to_read) {
         throw std::runtime_error("Serial port reading timed out");
     }
+    bytes_read += port_bytes_read;
 
 #ifdef SERVO_CORE_CONTROL_API_WINDOWS_COMPORT_DRIVER_DEBUG_PRINTS
     std::cout << "Read:";
-    for (uint8_t& byte : buffer) {
+    for (uint8_t& byte : buffer.first(bytes_read)) {
         std::cout << static_cast<int>(byte);
     }
     std::cout << " " << std::hex << std::endl;
@@ -145,6 +151,104 @@ size_t BufferedAsyncSerialPortDriver::readReceivedBytes(std::span<uint8_t> buffe
     return bytes_read;
 }
 
+bool BufferedAsyncSerialPortDriver::waitForReceivedBytes(uint64_t timeout_us) {
+    if (getReceivedBytesAvailableAmount() > 0) return true;
+    if (timeout_us == 0) return false;
+
+    // Rounded up, the timeout must have passed when this returns without a byte
+    const uint64_t timeout_ms = std::min<uint64_t>((timeout_us + 999) / 1'000, MAXDWORD - 1);
+    setReadTimeout(static_cast<DWORD>(timeout_ms));
+
+    {
+        std::scoped_lock lock(wait_mutex_);
+        if (wait_interrupted_) {
+            wait_interrupted_ = false;
+            return false;
+        }
+        is_waiting_ = true;
+    }
+
+    DWORD       bytes_read = 0;
+    const BOOL  read_ok    = ReadFile(serial_port_handle_, &waited_byte_, 1, &bytes_read, nullptr);
+    const DWORD read_error = read_ok ? ERROR_SUCCESS : GetLastError();
+    {
+        std::scoped_lock lock(wait_mutex_);
+        is_waiting_ = false;
+        if (read_error == ERROR_OPERATION_ABORTED) wait_interrupted_ = false;
+    }
+
+    if (read_error == ERROR_OPERATION_ABORTED) return false;
+    if (!read_ok) {
+        SetLastError(read_error);
+        throw std::runtime_error(std::format("could not read from serial port: {}", getLastErrorStr()));
+    }
+    has_waited_byte_ = bytes_read == 1;
+    return has_waited_byte_;
+}
+
+void BufferedAsyncSerialPortDriver::interruptWaitForReceivedBytes() {
+    std::scoped_lock lock(wait_mutex_);
+    wait_interrupted_ = true;
+    // The waiting thread is between the two locks of the wait, so the only I/O of the port it can be in is its ReadFile
+    if (is_waiting_) CancelIoEx(serial_port_handle_, nullptr);
+}
+
+bool BufferedAsyncSerialPortDriver::setBaudRate(uint32_t baud_rate) {
+    DCB serial_params       = {0};
+    serial_params.DCBlength = sizeof(serial_params);
+    if (!GetCommState(serial_port_handle_, &serial_params)) {
+        throw std::runtime_error(std::format("could not get serial parameters: {}", getLastErrorStr()));
+    }
+
+    serial_params.BaudRate = baud_rate;
+    // The driver refuses the rates its hardware can't produce, the port keeps the previous rate then
+    if (!SetCommState(serial_port_handle_, &serial_params)) return false;
+
+    // Whatever was received during the switch is garbage
+    PurgeComm(serial_port_handle_, PURGE_RXCLEAR);
+    has_waited_byte_ = false;
+    return true;
+}
+
+uint32_t BufferedAsyncSerialPortDriver::getBaudRate() {
+    DCB serial_params       = {0};
+    serial_params.DCBlength = sizeof(serial_params);
+    if (!GetCommState(serial_port_handle_, &serial_params)) {
+        throw std::runtime_error(std::format("could not get serial parameters: {}", getLastErrorStr()));
+    }
+    return serial_params.BaudRate;
+}
+
+void BufferedAsyncSerialPortDriver::flushTx() {
+    if (!FlushFileBuffers(serial_port_handle_)) {
+        throw std::runtime_error(std::format("could not flush serial port: {}", getLastErrorStr()));
+    }
+}
+
+DWORD BufferedAsyncSerialPortDriver::getPortReceivedBytesAmount() {
+    COMSTAT comStat;
+    DWORD   errors;
+    if (!ClearCommError(serial_port_handle_, &errors, &comStat)) return 0;
+
+    countRxOverflows(errors);
+    return comStat.cbInQue;
+}
+
+void BufferedAsyncSerialPortDriver::setReadTimeout(DWORD timeout_ms) {
+    if (timeout_ms == read_timeout_ms_) return;
+
+    // With both of these at MAXDWORD ReadFile returns as soon as any byte has been received, or after the constant
+    // if none is. The writes wait until they are done
+    COMMTIMEOUTS timeouts               = {};
+    timeouts.ReadIntervalTimeout        = MAXDWORD;
+    timeouts.ReadTotalTimeoutMultiplier = MAXDWORD;
+    timeouts.ReadTotalTimeoutConstant   = timeout_ms;
+    if (!SetCommTimeouts(serial_port_handle_, &timeouts)) {
+        throw std::runtime_error(std::format("could not set serial timeouts: {}", getLastErrorStr()));
+    }
+    read_timeout_ms_ = timeout_ms;
+}
+
 std::string BufferedAsyncSerialPortDriver::getLastErrorStr() {
     constexpr size_t K_ERROR_STRING_BUFF_SIZE              = 1024;
     char             string_buff[K_ERROR_STRING_BUFF_SIZE] = {};
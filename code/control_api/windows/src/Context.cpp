@@ -12,7 +12,8 @@ void debugPrintFlush() { std::cout << std::flush; }
 Context::Context(std::string serial_port_name)
     // serial communication driver must be initialized first before initializing the base class of the context
     : serial_communication_driver_{serial_port_name.c_str()},
-      servo_core_control_api::Context(serial_communication_driver_, program_uptime_clock_) {
+      servo_core_control_api::Context(serial_communication_driver_, program_uptime_clock_,
+                                      &serial_communication_driver_) {
     debug_print::connectPutCharAndFlushFunctions(debugPrintPutChar, debugPrintFlush);
 }
 
@@ -1,6 +1,8 @@
 #ifndef DEV_TOOL_PARAMETER_TABLE_PARAMETERTABLEWIDGET_H
 #define DEV_TOOL_PARAMETER_TABLE_PARAMETERTABLEWIDGET_H
 
+#include <QByteArray>
+#include <QPair>
 #include <QSortFilterProxyModel>
 #include <QTableView>
 #include <QTimer>
@@ -59,12 +61,20 @@ private:
     QSortFilterProxyModel   table_filter_proxy_model_;  ///< Proxy model for filtering table data.
     QTimer                  refresh_timer_;             ///< Timer for automatic parameter refresh.
     QVector<RowData>        rows_;                      ///< Storage for table parameter rows.
+    QVector<QPair<parameter_system::ParameterID, QVariant>>
+        pending_writes_;  ///< Edits waiting to be written together when batch editing.
 
     [[nodiscard]] QVector<RowData> fetchParameters() const;
     void                           refreshSignalParameterValues();
     void                           refreshAllParameterValues();
+    void                           refreshParameterValues(const QVector<int>& row_indices);
+    [[nodiscard]] static QVariant  decodeParameterValue(parameter_system::ParameterValueType type,
+                                                        const uint8_t*                       raw_value);
     QVariant getParameterValue(parameter_system::ParameterID id, parameter_system::ParameterValueType type) const;
     void     writeParameterValue(parameter_system::ParameterID id, const QVariant& value);
+    void     applyPendingParameterWrites();
+    [[nodiscard]] static QByteArray encodeParameterValue(parameter_system::ParameterValueType type,
+                                                         const QVariant&                      value);
 };
 
 }  // namespace parameter_table
@@ -3,8 +3,11 @@
 #include "parameter_table/ParameterTableWidget.h"
 
 #include <chrono>
+#include <cstring>
+#include <vector>
 
 #include "parameter_system/ParameterDeclaration.h"
+#include "parameter_system/parameter_type_mappings.h"
 #include "ui_ParameterTableWidget.h"
 
 namespace parameter_table {
@@ -29,11 +32,21 @@ ParameterTableWidget::ParameterTableWidget(QWidget* parent) : QWidget(parent), u
                               [&](const QString& text) { table_filter_proxy_model_.setFilterFixedString(text); }));
 
     // Configure refresh buttons and the auto refresh setting.
-    // Default refresh (button + timer) only re-reads Signal parameters; Saved/Runtime are written by
-    // this dev tool and don't change without our knowledge. The "Force Refresh All" button re-reads
-    // everything for sanity checks (e.g., another tool wrote, reconnect, etc.).
+    // Default refresh (button + timer) goes through the device's value cache, which only re-reads Signal
+    // parameters; Saved/Runtime are written by this dev tool and don't change without our knowledge. The
+    // "Force Refresh All" button invalidates the cache and re-reads everything for sanity checks (e.g., another
+    // tool wrote, reconnect, etc.).
     Q_UNUSED(QObject::connect(ui_->refreshPushButton, &QPushButton::clicked, this, &refreshSignalParameterValues));
     Q_UNUSED(QObject::connect(ui_->forceRefreshAllPushButton, &QPushButton::clicked, this, &refreshAllParameterValues));
+    // Batch editing collects the edits and writes them atomically with one command when applied, so that related
+    // parameters (e.g. controller gains) don't pass through intermediate combinations on the device
+    Q_UNUSED(QObject::connect(ui_->applyEditsPushButton, &QPushButton::clicked, this,
+                              &ParameterTableWidget::applyPendingParameterWrites));
+    Q_UNUSED(QObject::connect(ui_->batchEditsCheckBox, &QCheckBox::toggled, this, [&](bool checked) {
+        // Don't leave collected edits hanging when batch editing is turned off
+        if (!checked) applyPendingParameterWrites();
+    }));
+
     ui_->automaticRefreshComboBox->addItem("No Automatic Refresh", QVariant(false));
     ui_->automaticRefreshComboBox->addItem("Auto Refresh Every 5 Seconds",
                                            QVariant::fromValue(std::chrono::milliseconds(5000)));
@@ -99,27 +112,95 @@ QVector<RowData> ParameterTableWidget::fetchParameters() const {
 
 void ParameterTableWidget::refreshSignalParameterValues() {
     // Only Signal parameters can change without our knowledge — the device sets them autonomously.
-    // Saved and Runtime parameters are written by the master (this dev tool) and stay put until we
-    // write them again, so re-reading them every refresh just wastes bus bandwidth.
-    for (size_t i = 0; i < rows_.size(); i++) {
-        RowData& row = rows_[i];
-        if (row.meta_data.category != parameter_system::ParameterCategory::signal) continue;
-
-        QVariant new_value = getParameterValue(row.meta_data.id, row.meta_data.value_type);
-        table_model_->updateValueFromDevice(static_cast<int>(i), new_value);
+    // The value cache of the device serves the Saved and Runtime parameters, which the master (this dev
+    // tool) writes through it, so only the signals are read from the bus.
+    QVector<int> all_row_indices;
+    for (int i = 0; i < rows_.size(); i++) {
+        all_row_indices.push_back(i);
     }
+
+    refreshParameterValues(all_row_indices);
 }
 
 void ParameterTableWidget::refreshAllParameterValues() {
     // Re-reads every parameter regardless of category. Used as a manual sanity check (e.g., another
     // tool may have written, after reconnect, debugging) — not used by the auto-refresh timer.
-    for (size_t i = 0; i < rows_.size(); i++) {
-        RowData& row       = rows_[i];
-        QVariant new_value = getParameterValue(row.meta_data.id, row.meta_data.value_type);
-        table_model_->updateValueFromDevice(static_cast<int>(i), new_value);
+    device_->invalidateValueCache();
+    refreshSignalParameterValues();
+}
+
+void ParameterTableWidget::refreshParameterValues(const QVector<int>& row_indices) {
+    using ReadEntry = protocol::commands::ReadParamValuesRequest::Entry;
+
+    // Read all the values with batched commands instead of one round trip per parameter
+    std::vector<ReadEntry> entries;
+    size_t                 values_size = 0;
+    for (int row_index : row_indices) {
+        const parameter_system::ParameterMetaData& meta_data = rows_[row_index].meta_data;
+        entries.push_back({meta_data.id, meta_data.value_type});
+        values_size += parameter_system::sizeOfCppTypeByParameterValueType(meta_data.value_type);
+    }
+
+    std::vector<uint8_t> values(values_size);
+    const serial_communication_framework::ResponseCode result = device_->readParameterValuesRaw(entries, values);
+    if (result != serial_communication_framework::ResponseCode::ok) {
+        qDebug() << "ParameterTableWidget::refreshParameterValues: batched read failed, code"
+                 << static_cast<int>(result);
+        return;
+    }
+
+    size_t value_offset = 0;
+    for (int row_index : row_indices) {
+        const parameter_system::ParameterValueType type = rows_[row_index].meta_data.value_type;
+        table_model_->updateValueFromDevice(row_index, decodeParameterValue(type, &values[value_offset]));
+        value_offset += parameter_system::sizeOfCppTypeByParameterValueType(type);
     }
 }
 
+QVariant ParameterTableWidget::decodeParameterValue(parameter_system::ParameterValueType type,
+                                                    const uint8_t*                       raw_value) {
+    using parameter_system::ParameterValueType;
+
+    // Values arrive in the device's (little endian) byte order, same as the host's
+    auto read = [raw_value]<typename T>(T) {
+        T value;
+        std::memcpy(&value, raw_value, sizeof(T));
+        return value;
+    };
+
+    switch (type) {
+        case ParameterValueType::uint8:
+            // Widen to quint16 — QVariant treats uint8_t as a character, see getParameterValue
+            return QVariant::fromValue(static_cast<quint16>(read(uint8_t{})));
+        case ParameterValueType::uint16:
+            return QVariant::fromValue(read(uint16_t{}));
+        case ParameterValueType::uint32:
+            return QVariant::fromValue(read(uint32_t{}));
+        case ParameterValueType::uint64:
+            return QVariant::fromValue(read(uint64_t{}));
+        case ParameterValueType::int8:
+            return QVariant::fromValue(static_cast<qint16>(read(int8_t{})));
+        case ParameterValueType::int16:
+            return QVariant::fromValue(read(int16_t{}));
+        case ParameterValueType::int32:
+            return QVariant::fromValue(read(int32_t{}));
+        case ParameterValueType::int64:
+            return QVariant::fromValue(read(int64_t{}));
+        case ParameterValueType::floating_point:
+            return QVariant::fromValue(read(float{}));
+        case ParameterValueType::double_float:
+            return QVariant::fromValue(read(double{}));
+        case ParameterValueType::boolean:
+            return QVariant::fromValue(read(bool{}));
+
+        case ParameterValueType::none:
+            qDebug() << "ParameterTableWidget::decodeParameterValue"
+                     << "unhandled type";
+            break;
+    }
+    return {};
+}
+
 QVariant ParameterTableWidget::getParameterValue(parameter_system::ParameterID        id,
                                                  parameter_system::ParameterValueType type) const {
     using parameter_system::ParameterDeclaration;
@@ -176,6 +257,19 @@ void ParameterTableWidget::writeParameterValue(parameter_system::ParameterID id,
     using parameter_system::ParameterValueType;
     using ResponseCode = serial_communication_framework::ResponseCode;
 
+    if (ui_->batchEditsCheckBox->isChecked()) {
+        // Replace an earlier edit of the same parameter, the device should only see the latest value
+        for (QPair<parameter_system::ParameterID, QVariant>& pending_write : pending_writes_) {
+            if (pending_write.first == id) {
+                pending_write.second = value;
+                return;
+            }
+        }
+        pending_writes_.push_back({id, value});
+        ui_->applyEditsPushButton->setEnabled(true);
+        return;
+    }
+
     // Find the row to look up the value type — the signal only carries id + value.
     const RowData* row = nullptr;
     for (const RowData& candidate : rows_) {
@@ -247,4 +341,84 @@ void ParameterTableWidget::writeParameterValue(parameter_system::ParameterID id,
     }
 }
 
+void ParameterTableWidget::applyPendingParameterWrites() {
+    using ResponseCode = serial_communication_framework::ResponseCode;
+
+    if (pending_writes_.isEmpty()) return;
+
+    protocol::commands::WriteParamValuesRequest request;
+    QVector<int>                                written_row_indices;
+    bool                                        all_fit = true;
+    for (const QPair<parameter_system::ParameterID, QVariant>& pending_write : pending_writes_) {
+        for (int i = 0; i < rows_.size(); i++) {
+            const parameter_system::ParameterMetaData& meta_data = rows_[i].meta_data;
+            if (meta_data.id != pending_write.first) continue;
+
+            QByteArray raw_value = encodeParameterValue(meta_data.value_type, pending_write.second);
+            all_fit &= request.putRaw(meta_data.id, meta_data.value_type,
+                                      {reinterpret_cast<const uint8_t*>(raw_value.constData()),
+                                       static_cast<size_t>(raw_value.size())});
+            written_row_indices.push_back(i);
+            break;
+        }
+    }
+    pending_writes_.clear();
+    ui_->applyEditsPushButton->setEnabled(false);
+
+    ResponseCode result = ResponseCode::ok;
+    if (!all_fit) {
+        qDebug() << "ParameterTableWidget::applyPendingParameterWrites: too many edits for one atomic write";
+        result = ResponseCode::out_of_bounds;
+    } else {
+        result = device_->writeParameterValues(request);
+    }
+
+    if (result != ResponseCode::ok) {
+        qDebug() << "ParameterTableWidget::applyPendingParameterWrites: device returned error code"
+                 << static_cast<int>(result);
+        // None of the values were written, show what the device actually has
+        refreshParameterValues(written_row_indices);
+    }
+}
+
+QByteArray ParameterTableWidget::encodeParameterValue(parameter_system::ParameterValueType type,
+                                                      const QVariant&                      value) {
+    using parameter_system::ParameterValueType;
+
+    auto bytes = []<typename T>(T typed_value) {
+        return QByteArray(reinterpret_cast<const char*>(&typed_value), sizeof(T));
+    };
+
+    switch (type) {
+        case ParameterValueType::uint8:
+            return bytes(value.value<uint8_t>());
+        case ParameterValueType::uint16:
+            return bytes(value.value<uint16_t>());
+        case ParameterValueType::uint32:
+            return bytes(value.value<uint32_t>());
+        case ParameterValueType::uint64:
+            return bytes(value.value<uint64_t>());
+        case ParameterValueType::int8:
+            return bytes(value.value<int8_t>());
+        case ParameterValueType::int16:
+            return bytes(value.value<int16_t>());
+        case ParameterValueType::int32:
+            return bytes(value.value<int32_t>());
+        case ParameterValueType::int64:
+            return bytes(value.value<int64_t>());
+        case ParameterValueType::floating_point:
+            return bytes(value.value<float>());
+        case ParameterValueType::double_float:
+            return bytes(value.value<double>());
+        case ParameterValueType::boolean:
+            return bytes(value.toBool());
+
+        case ParameterValueType::none:
+            qDebug() << "ParameterTableWidget::encodeParameterValue"
+                     << "unhandled type";
+            break;
+    }
+    return {};
+}
+
 }  // namespace parameter_table
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+#include "device_simulator/DeviceSimulator.h"
+#include "protocol/commands.h"
+#include "protocol/parameters.h"
+
+using device_simulator::DeviceSimulator;
+using serial_communication_framework::ResponseCode;
+
+/**
+ * Master to slave round trips through the whole stack: the control API, the MasterHandler, the LoopbackLink, the
+ * SlaveHandler and the firmware's protocol handlers, reading a parameter.
+ *
+ * The link has no transmission time unless the baud rate argument is given, so the times are those of the software.
+ * Besides the round trips per second the round trip latency is reported as its median and 99th percentile in the
+ * `p50_us` and `p99_us` counters, and the bytes moved over the link in both directions as bytes per second.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t K_PIPELINED_COMMANDS_PER_ITERATION = 64;
+
+double toMicroseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+void reportLatencies(benchmark::State& state, std::vector<double>& latencies_us) {
+    if (latencies_us.empty()) return;
+    std::sort(latencies_us.begin(), latencies_us.end());
+    state.counters["p50_us"] = latencies_us[latencies_us.size() / 2];
+    state.counters["p99_us"] = latencies_us[std::min(latencies_us.size() - 1, latencies_us.size() * 99 / 100)];
+}
+
+protocol::commands::ReadParamValueRequest makeReadRequest() {
+    protocol::commands::ReadParamValueRequest request;
+    request.parameter_id        = protocol::test_params::test_uint8.id;
+    request.expected_value_type = parameter_system::ParameterValueType::uint8;
+    return request;
+}
+
+// One blocking read at a time, the way a simple application polls a value
+void BM_blockingRoundTrip(benchmark::State& state) {
+    const auto run_mode  = static_cast<DeviceSimulator::RunMode>(state.range(0));
+    const auto baud_rate = static_cast<uint32_t>(state.range(1));
+
+    DeviceSimulator                 simulator({.baud_rate = baud_rate}, run_mode);
+    servo_core_control_api::Context context(simulator.getMasterEnd(), simulator.getClock(), &simulator.getMasterEnd());
+    context.open();
+    std::optional<servo_core_control_api::Device> device = context.tryFindDeviceById(DeviceSimulator::K_DEVICE_ID);
+    if (!device.has_value()) {
+        state.SkipWithError("Device not found");
+        return;
+    }
+    // Every read goes over the link
+    device->setValueCachePolicy(servo_core_control_api::K_NO_VALUE_CACHE_POLICY);
+
+    drivers::host::LoopbackLink::End& master_end = simulator.getMasterEnd();
+    const uint64_t                    start_link_bytes =
+        master_end.getTransmittedByteCount() + master_end.getReadByteCount();
+
+    std::vector<double> latencies_us;
+    for (auto _ : state) {
+        const Clock::time_point start_time = Clock::now();
+        benchmark::DoNotOptimize(device->readParameterValue(protocol::test_params::test_uint8));
+        latencies_us.push_back(toMicroseconds(Clock::now() - start_time));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(
+        static_cast<int64_t>(master_end.getTransmittedByteCount() + master_end.getReadByteCount() - start_link_bytes));
+    reportLatencies(state, latencies_us);
+}
+
+struct PipelineState {
+    std::deque<Clock::time_point> submit_times;  // Responses arrive in the submission order
+    std::vector<double>           latencies_us;
+    size_t                        failed_count = 0;
+};
+
+void onReadCompleted(const protocol::commands::ReadParamValueResponse& response, void* user_data) {
+    auto* pipeline = static_cast<PipelineState*>(user_data);
+    pipeline->latencies_us.push_back(toMicroseconds(Clock::now() - pipeline->submit_times.front()));
+    pipeline->submit_times.pop_front();
+    if (response.response_code != ResponseCode::ok) pipeline->failed_count++;
+}
+
+// As many reads in flight as the master allows, the way a high rate application keeps the link busy
+void BM_pipelinedRoundTrip(benchmark::State& state) {
+    const auto run_mode  = static_cast<DeviceSimulator::RunMode>(state.range(0));
+    const auto baud_rate = static_cast<uint32_t>(state.range(1));
+
+    DeviceSimulator                 simulator({.baud_rate = baud_rate}, run_mode);
+    servo_core_control_api::Context context(simulator.getMasterEnd(), simulator.getClock(), &simulator.getMasterEnd());
+    context.open();
+    std::optional<servo_core_control_api::Device> device = context.tryFindDeviceById(DeviceSimulator::K_DEVICE_ID);
+    if (!device.has_value()) {
+        state.SkipWithError("Device not found");
+        return;
+    }
+
+    drivers::host::LoopbackLink::End& master_end = simulator.getMasterEnd();
+    const uint64_t                    start_link_bytes =
+        master_end.getTransmittedByteCount() + master_end.getReadByteCount();
+
+    PipelineState pipeline;
+    for (auto _ : state) {
+        size_t submitted_count = 0;
+        while (submitted_count < K_PIPELINED_COMMANDS_PER_ITERATION || !pipeline.submit_times.empty()) {
+            // Refill the window as the responses come in
+            while (submitted_count < K_PIPELINED_COMMANDS_PER_ITERATION) {
+                pipeline.submit_times.push_back(Clock::now());
+                if (!device->submitCommand<protocol::commands::ReadParamValue>(makeReadRequest(), onReadCompleted,
+                                                                               &pipeline)) {
+                    pipeline.submit_times.pop_back();
+                    break;
+                }
+                submitted_count++;
+            }
+            context.run();
+        }
+    }
+    if (pipeline.failed_count != 0) state.SkipWithError("Read failed");
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * K_PIPELINED_COMMANDS_PER_ITERATION));
+    state.SetBytesProcessed(
+        static_cast<int64_t>(master_end.getTransmittedByteCount() + master_end.getReadByteCount() - start_link_bytes));
+    reportLatencies(state, pipeline.latencies_us);
+}
+
+void roundTripArguments(benchmark::internal::Benchmark* benchmark) {
+    benchmark->ArgNames({"own_thread", "baud"});
+    for (const DeviceSimulator::RunMode run_mode :
+         {DeviceSimulator::RunMode::on_master_poll, DeviceSimulator::RunMode::own_thread}) {
+        // Without transmission time, and at the fastest rate the firmware negotiates
+        for (const int64_t baud_rate : {0, 3'000'000}) benchmark->Args({static_cast<int64_t>(run_mode), baud_rate});
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_blockingRoundTrip)->Apply(roundTripArguments)->UseRealTime();
+BENCHMARK(BM_pipelinedRoundTrip)->Apply(roundTripArguments)->UseRealTime();
+
+BENCHMARK_MAIN();
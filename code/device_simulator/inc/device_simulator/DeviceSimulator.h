@@ -0,0 +1,96 @@
+#ifndef DEVICE_SIMULATOR_DEVICESIMULATOR_H
+#define DEVICE_SIMULATOR_DEVICESIMULATOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "drivers/host/LoopbackLink.h"
+#include "drivers/host/RamFlash.h"
+#include "drivers/interfaces/ClockInterface.h"
+#include "firmware_update/common.h"
+
+namespace device_simulator {
+
+/**
+ * @brief The firmware's protocol side running on the host, connected to the master over a LoopbackLink.
+ *
+ * Runs the firmware's protocol handlers with a SlaveHandler, the parameter database and the rest of the libraries
+ * the way the firmware's main loop does, with the flash emulated in RAM and the hardware timer replaced by a polled
+ * one. The master side, e.g. servo_core_control_api::Context, is connected to `getMasterEnd()`.
+ *
+ * The firmware state lives in globals like on the device, so only one simulator can exist at a time. Constructing one
+ * powers on a device with blank flash.
+ */
+class DeviceSimulator {
+public:
+    static constexpr uint8_t K_DEVICE_ID = 0;
+
+    enum class RunMode {
+        on_master_poll,  ///< The main loop runs whenever the master end polls for received bytes, in its thread
+        own_thread,      ///< The main loop runs continuously in a thread of its own
+    };
+
+    /**
+     * @param link_model Timing of the link. Its baud rate is the one the device boots with.
+     * @param run_mode   Where the device's main loop runs.
+     */
+    explicit DeviceSimulator(drivers::host::LinkModel link_model = {}, RunMode run_mode = RunMode::on_master_poll);
+    ~DeviceSimulator();
+
+    DeviceSimulator(const DeviceSimulator&)            = delete;
+    DeviceSimulator& operator=(const DeviceSimulator&) = delete;
+
+    /**
+     * @brief Get the end of the link the master is connected to.
+     */
+    [[nodiscard]] drivers::host::LoopbackLink::End& getMasterEnd();
+
+    /**
+     * @brief Get the clock of the device and the link, which the master should use too.
+     */
+    [[nodiscard]] drivers::interfaces::ClockInterface& getClock();
+
+    /**
+     * @brief Run one pass of the device's main loop. Done automatically in both run modes.
+     */
+    void runMainLoopOnce();
+
+    /**
+     * @brief Restart the device. The RAM state is lost, the flash is kept.
+     */
+    void reboot();
+
+    /**
+     * @brief Get the amount of boots, including the one at construction.
+     */
+    [[nodiscard]] uint32_t getBootCount() const;
+
+    /**
+     * @brief Get the amount of calls of the on change callback that Test Uint8 and Test Bool share, since construction.
+     *
+     * The firmware's parameters have no callbacks, the simulator adds this one so that the tests can check that a
+     * batched write notifies a shared callback only once.
+     */
+    [[nodiscard]] uint32_t getParameterChangeNotificationCount() const;
+
+    [[nodiscard]] drivers::host::RamFlash& getFirmwareSlotFlash(firmware_update::FirmwareSlot slot);
+
+private:
+    RunMode               run_mode_;
+    uint32_t              boot_baud_rate_;
+    std::atomic<uint32_t> boot_count_{0};
+
+    std::thread       thread_;
+    std::atomic<bool> stop_requested_{false};
+
+    static void onMasterPoll(void* user_data);
+
+    void boot();
+    void startThread();
+    void stopThread();
+};
+
+}  // namespace device_simulator
+
+#endif  // DEVICE_SIMULATOR_DEVICESIMULATOR_H
@@ -0,0 +1,334 @@
+#include "device_simulator/DeviceSimulator.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "assert/assert.h"
+#include "board.h"
+#include "drivers/host/PolledTimer.h"
+#include "drivers/host/SteadyClock.h"
+#include "firmware_update/FirmwareUpdater.h"
+#include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterRegistry.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/TelemetryStreamer.h"
+#include "parameter_system/definition_helpers.h"
+#include "persistent_storage/RecordStore.h"
+#include "persistent_storage/parameter_storage.h"
+#include "protocol/commands.h"
+#include "protocol/parameters.h"
+#include "protocol/stream_ids.h"
+#include "protocol/transfer_ids.h"
+#include "protocol_handlers.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/SlaveLinkSwitcher.h"
+#include "serial_communication_framework/TransferSlave.h"
+
+// The globals mirror the ones of the firmware's main.cpp, the protocol handlers use them by these names
+
+// -------------------------------- GENERAL -------------------------------
+drivers::host::SteadyClock        simulation_clock;
+drivers::host::LoopbackLink       simulation_link(simulation_clock);
+drivers::host::LoopbackLink::End& device_link_end = simulation_link.getEndB();
+
+// ----------------------------- PARAMETER SYSTEM ------------------------------
+// Grouped so that a reboot can restore the initial values in one go
+struct TestParameterValues {
+    uint8_t  test_uint8  = 42;
+    uint16_t test_uint16 = 1337;
+    uint32_t test_uint32 = 123456;
+    float    test_float  = 3.1415;
+    bool     test_bool   = true;
+    uint64_t test_uint64 = 123456;
+};
+TestParameterValues test_values;
+
+// Counts the calls of the on change callback that Test Uint8 and Test Bool share, see DeviceSimulator
+std::atomic<uint32_t> parameter_change_notification_count = 0;
+void                  onTestParameterChanged() { parameter_change_notification_count++; }
+
+// Same parameters as the firmware, only the on change callback is added
+constexpr parameter_system::ParameterRegistry parameter_registry{
+    parameter_system::SavedParameter(protocol::test_params::test_uint8, "Test Uint8", test_values.test_uint8,
+                                     onTestParameterChanged),
+    parameter_system::SignalParameter(protocol::test_params::test_uint16, "Test Uint16", test_values.test_uint16),
+    parameter_system::SignalParameter(protocol::test_params::test_uint32, "Test Uint32", test_values.test_uint32),
+    parameter_system::SignalParameter(protocol::test_params::test_float, "Test Float", test_values.test_float),
+    parameter_system::RuntimeParameter(protocol::test_params::test_bool, "Test Bool", test_values.test_bool,
+                                       onTestParameterChanged),
+    parameter_system::RuntimeParameter(protocol::test_params::test_test, "Test U64", test_values.test_uint64),
+    parameter_system::SignalParameter(protocol::test_params::loop_back, "Loopback of Test Uint8",
+                                      test_values.test_uint8),
+};
+static_assert(parameter_registry.hasUniqueIds(), "Duplicate ParameterID detected");
+
+parameter_system::ParameterDatabase parameter_database(parameter_registry);
+
+constexpr size_t K_FLASH_SECTOR_SIZE = 4096;  // Same as the RP2040's
+
+constexpr size_t                K_PARAMETER_STORAGE_SECTOR_COUNT = 4;
+drivers::host::RamFlash         parameter_storage_flash(K_FLASH_SECTOR_SIZE, K_PARAMETER_STORAGE_SECTOR_COUNT);
+persistent_storage::RecordStore parameter_record_store(parameter_storage_flash);
+
+void telemetrySampleTimerFired(void* user_data);
+
+parameter_system::TelemetryStreamer telemetry_streamer(parameter_database);
+drivers::host::PolledTimer          telemetry_timer_driver(simulation_clock, telemetrySampleTimerFired, nullptr);
+uint8_t                             telemetry_frame_buffer[parameter_system::TelemetryStreamer::K_FRAME_MAX_SIZE];
+
+drivers::interfaces::TimerInterface& telemetry_timer = telemetry_timer_driver;
+
+void captureSampleTimerFired(void* user_data);
+
+constexpr uint32_t K_CAPTURE_SAMPLE_PERIOD_US = 100;  // Same as the firmware's
+
+uint8_t                         capture_buffer[32 * 1024];
+parameter_system::SignalCapture signal_capture(parameter_database, simulation_clock, capture_buffer);
+drivers::host::PolledTimer      capture_timer_driver(simulation_clock, captureSampleTimerFired, nullptr);
+
+drivers::interfaces::TimerInterface& capture_timer = capture_timer_driver;
+
+// ----------------------------- FIRMWARE UPDATE ------------------------------
+constexpr size_t                 K_FIRMWARE_SLOT_SECTOR_COUNT = 64;
+constexpr size_t                 K_BOOT_RECORD_SECTOR_COUNT   = 2;
+drivers::host::RamFlash          firmware_slot_a_flash(K_FLASH_SECTOR_SIZE, K_FIRMWARE_SLOT_SECTOR_COUNT);
+drivers::host::RamFlash          firmware_slot_b_flash(K_FLASH_SECTOR_SIZE, K_FIRMWARE_SLOT_SECTOR_COUNT);
+drivers::host::RamFlash          boot_record_flash(K_FLASH_SECTOR_SIZE, K_BOOT_RECORD_SECTOR_COUNT);
+persistent_storage::RecordStore  boot_record_store(boot_record_flash);
+firmware_update::FirmwareUpdater firmware_updater(firmware_slot_a_flash, firmware_slot_b_flash, boot_record_store);
+
+// ----------------------------- COMM PROTOCOL --------------------------------
+serial_communication_framework::SlaveHandler      protocol_handler(device_link_end, simulation_clock,
+                                                                   device_simulator::DeviceSimulator::K_DEVICE_ID);
+serial_communication_framework::SlaveLinkSwitcher link_switcher(protocol_handler, device_link_end, simulation_clock);
+serial_communication_framework::TransferSlave     transfer_slave;
+
+void telemetrySampleTimerFired(void* user_data) {
+    (void)user_data;  // unused
+
+    telemetry_streamer.sample();
+
+    // Restart instead of start to keep the sampling period free of drift
+    telemetry_timer_driver.restart();
+}
+
+void captureSampleTimerFired(void* user_data) {
+    (void)user_data;  // unused
+
+    signal_capture.sample();
+    capture_timer_driver.restart();
+}
+
+namespace {
+
+device_simulator::DeviceSimulator* active_simulator = nullptr;
+std::optional<uint64_t>            scheduled_reboot_time_ms;
+
+// Rates the master can switch the link to, the same as the firmware's
+constexpr std::array<uint32_t, 8> K_SERIAL_COMMUNICATION_BAUD_RATES = {115200,  230400,  460800,  921600,
+                                                                        1000000, 1500000, 2000000, 3000000};
+
+// Destructs the global and constructs it again in place, which is what a reboot does to the RAM
+template <typename T, typename... T_Args>
+void reconstruct(T& object, T_Args&&... args) {
+    std::destroy_at(&object);
+    std::construct_at(&object, std::forward<T_Args>(args)...);
+}
+
+void eraseFlash(drivers::host::RamFlash& flash) {
+    std::ranges::fill(flash.getBytes(), drivers::interfaces::FlashInterface::K_ERASED_BYTE);
+}
+
+void registerHandlers() {
+    protocol_handler.registerCommandHandler<protocol::commands::Ping, protocol_handlers::ping>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetCapabilities, protocol_handlers::getCapabilities>();
+    protocol_handler.registerCommandHandler<protocol::commands::ConfigureLink, protocol_handlers::configureLink>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetCommunicationStatistics,
+                                            protocol_handlers::getCommunicationStatistics>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetOperationStatistics,
+                                            protocol_handlers::getOperationStatistics>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetRegisteredParamIds, protocol_handlers::getParamIds>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetParamMetadata, protocol_handlers::getParamMetaData>();
+    protocol_handler.registerCommandHandler<protocol::commands::ReadParamValue, protocol_handlers::readParamValue>();
+    protocol_handler.registerCommandHandler<protocol::commands::ReadParamValues, protocol_handlers::readParamValues>();
+    protocol_handler.registerCommandHandler<protocol::commands::WriteParamValue, protocol_handlers::writeParamValue>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::WriteParamValues, protocol_handlers::writeParamValues>();
+    protocol_handler.registerCommandHandler<protocol::commands::SaveParameters, protocol_handlers::saveParameters>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::SubscribeTelemetry, protocol_handlers::subscribeTelemetry>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::UnsubscribeTelemetry, protocol_handlers::unsubscribeTelemetry>();
+    protocol_handler.registerCommandHandler<protocol::commands::ArmCapture, protocol_handlers::armCapture>();
+    protocol_handler.registerCommandHandler<protocol::commands::TriggerCapture, protocol_handlers::triggerCapture>();
+    protocol_handler.registerCommandHandler<protocol::commands::DisarmCapture, protocol_handlers::disarmCapture>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetCaptureStatus, protocol_handlers::getCaptureStatus>();
+    protocol_handler.registerCommandHandler<protocol::commands::ReadCaptureData, protocol_handlers::readCaptureData>();
+    protocol_handler.registerCommandHandler<protocol::commands::StartTransfer, protocol_handlers::startTransfer>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::WriteTransferSegment, protocol_handlers::writeTransferSegment>();
+    protocol_handler.registerCommandHandler<protocol::commands::FinishTransfer, protocol_handlers::finishTransfer>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::ReadTransferSegment, protocol_handlers::readTransferSegment>();
+
+    protocol_handler
+        .registerCommandHandler<protocol::commands::BeginFirmwareUpdate, protocol_handlers::beginFirmwareUpdate>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetFirmwareStatus, protocol_handlers::getFirmwareStatus>();
+    protocol_handler.registerCommandHandler<protocol::commands::Reboot, protocol_handlers::reboot>();
+
+    transfer_slave.registerDownloadSource(static_cast<uint8_t>(protocol::TransferIds::capture_data),
+                                          protocol_handlers::captureDataSource, nullptr);
+    transfer_slave.registerUploadSink(static_cast<uint8_t>(protocol::TransferIds::firmware_image),
+                                      K_FIRMWARE_SLOT_SECTOR_COUNT * K_FLASH_SECTOR_SIZE,
+                                      protocol_handlers::firmwareImageSink, protocol_handlers::finishFirmwareImage,
+                                      nullptr);
+}
+
+}  // namespace
+
+// --------------------------------- BOARD ---------------------------------
+namespace board {
+
+std::span<const uint32_t> getSerialCommunicationBaudRates() { return K_SERIAL_COMMUNICATION_BAUD_RATES; }
+
+void scheduleReboot(uint32_t delay_ms) { scheduled_reboot_time_ms = simulation_clock.uptimeMilliseconds() + delay_ms; }
+
+}  // namespace board
+
+namespace device_simulator {
+
+DeviceSimulator::DeviceSimulator(drivers::host::LinkModel link_model, RunMode run_mode)
+    : run_mode_(run_mode), boot_baud_rate_(link_model.baud_rate) {
+    ASSERT_WITH_MESSAGE(active_simulator == nullptr, "Only one DeviceSimulator can exist at a time");
+    active_simulator                    = this;
+    parameter_change_notification_count = 0;
+
+    simulation_link.setModel(link_model);
+    for (drivers::host::RamFlash* flash :
+         {&parameter_storage_flash, &firmware_slot_a_flash, &firmware_slot_b_flash, &boot_record_flash}) {
+        eraseFlash(*flash);
+    }
+    boot();
+
+    if (run_mode_ == RunMode::on_master_poll) {
+        getMasterEnd().setPollCallback(&DeviceSimulator::onMasterPoll, this);
+    } else {
+        startThread();
+    }
+}
+
+DeviceSimulator::~DeviceSimulator() {
+    stopThread();
+    getMasterEnd().setPollCallback(nullptr, nullptr);
+    active_simulator = nullptr;
+}
+
+drivers::host::LoopbackLink::End& DeviceSimulator::getMasterEnd() { return simulation_link.getEndA(); }
+
+drivers::interfaces::ClockInterface& DeviceSimulator::getClock() { return simulation_clock; }
+
+void DeviceSimulator::runMainLoopOnce() {
+    protocol_handler.run();
+    link_switcher.run();
+    firmware_updater.run();
+    test_values.test_uint32++;
+
+    // Stand in for the timer interrupts, so the sampling is only as punctual as the loop
+    telemetry_timer_driver.run();
+    capture_timer_driver.run();
+
+    const size_t telemetry_frame_size = telemetry_streamer.takeFrame(telemetry_frame_buffer);
+    if (telemetry_frame_size > 0) {
+        protocol_handler.transmitUnsolicitedFrame(static_cast<uint8_t>(protocol::StreamIds::telemetry),
+                                                  {telemetry_frame_buffer, telemetry_frame_size});
+    }
+
+    if (scheduled_reboot_time_ms.has_value() && simulation_clock.uptimeMilliseconds() >= *scheduled_reboot_time_ms) {
+        boot();
+    }
+}
+
+void DeviceSimulator::reboot() {
+    if (run_mode_ == RunMode::on_master_poll) {
+        boot();
+        return;
+    }
+
+    stopThread();
+    boot();
+    startThread();
+}
+
+uint32_t DeviceSimulator::getBootCount() const { return boot_count_; }
+
+uint32_t DeviceSimulator::getParameterChangeNotificationCount() const { return parameter_change_notification_count; }
+
+drivers::host::RamFlash& DeviceSimulator::getFirmwareSlotFlash(firmware_update::FirmwareSlot slot) {
+    return slot == firmware_update::FirmwareSlot::a ? firmware_slot_a_flash : firmware_slot_b_flash;
+}
+
+void DeviceSimulator::onMasterPoll(void* user_data) { static_cast<DeviceSimulator*>(user_data)->runMainLoopOnce(); }
+
+void DeviceSimulator::boot() {
+    scheduled_reboot_time_ms.reset();
+
+    // Everything in RAM starts over, the flash keeps its contents
+    test_values = {};
+    reconstruct(parameter_database, parameter_registry);
+    reconstruct(parameter_record_store, parameter_storage_flash);
+    reconstruct(telemetry_streamer, parameter_database);
+    reconstruct(telemetry_timer_driver, simulation_clock, telemetrySampleTimerFired, nullptr);
+    reconstruct(signal_capture, parameter_database, simulation_clock, capture_buffer);
+    reconstruct(capture_timer_driver, simulation_clock, captureSampleTimerFired, nullptr);
+    capture_timer_driver.configureInMicroseconds(K_CAPTURE_SAMPLE_PERIOD_US);
+    reconstruct(boot_record_store, boot_record_flash);
+    reconstruct(firmware_updater, firmware_slot_a_flash, firmware_slot_b_flash, boot_record_store);
+    reconstruct(protocol_handler, device_link_end, simulation_clock, K_DEVICE_ID);
+    reconstruct(link_switcher, protocol_handler, device_link_end, simulation_clock);
+    reconstruct(transfer_slave);
+
+    // The UART starts at its default rate
+    (void)device_link_end.setBaudRate(boot_baud_rate_);
+
+    protocol_handler.init();
+    registerHandlers();
+
+    // Same as the firmware's startup, the saved parameters keep their defaults if the storage is blank
+    if (parameter_record_store.mount() == persistent_storage::StorageResult::ok) {
+        (void)persistent_storage::loadParameters(parameter_database, parameter_record_store);
+    }
+    // Same as the firmware's startup, an update is copied over slot A which is the one that boots
+    if (firmware_updater.mount(firmware_update::FirmwareSlot::a) == firmware_update::UpdateResult::ok &&
+        firmware_updater.prepareActivation() == firmware_update::UpdateResult::ok) {
+        (void)firmware_updater.copyActivatedImage();
+    }
+
+    boot_count_++;
+}
+
+void DeviceSimulator::startThread() {
+    stop_requested_ = false;
+    thread_         = std::thread([this] {
+        while (!stop_requested_) {
+            runMainLoopOnce();
+            std::this_thread::yield();
+        }
+    });
+}
+
+void DeviceSimulator::stopThread() {
+    if (!thread_.joinable()) return;
+
+    stop_requested_ = true;
+    thread_.join();
+}
+
+}  // namespace device_simulator
@@ -0,0 +1,310 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "control_api/Context.h"
+#include "control_api/Device.h"
+#include "device_simulator/DeviceSimulator.h"
+#include "protocol/parameters.h"
+
+using device_simulator::DeviceSimulator;
+using serial_communication_framework::ResponseCode;
+
+namespace {
+
+// The master side of the simulated device, the way an application uses it
+class Master {
+public:
+    explicit Master(DeviceSimulator& simulator)
+        : context(simulator.getMasterEnd(), simulator.getClock(), &simulator.getMasterEnd()) {
+        context.open();
+    }
+
+    servo_core_control_api::Device findDevice() {
+        std::optional<servo_core_control_api::Device> device = context.tryFindDeviceById(DeviceSimulator::K_DEVICE_ID);
+        EXPECT_TRUE(device.has_value());
+        return *device;
+    }
+
+    servo_core_control_api::Context context;
+};
+
+std::vector<uint8_t> randomBytes(size_t size) {
+    std::mt19937         random(1234);
+    std::vector<uint8_t> bytes(size);
+    for (uint8_t& byte : bytes) byte = static_cast<uint8_t>(random());
+    return bytes;
+}
+
+}  // namespace
+
+TEST(EndToEnd, reads_and_writes_parameters) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 42);
+    EXPECT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, 7), ResponseCode::ok);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 7);
+
+    const auto [uint16_value, float_value] =
+        device.readParameterValues(protocol::test_params::test_uint16, protocol::test_params::test_float);
+    EXPECT_EQ(uint16_value, 1337);
+    EXPECT_FLOAT_EQ(float_value, 3.1415f);
+}
+
+TEST(EndToEnd, writes_parameter_values_together) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    protocol::commands::WriteParamValuesRequest request;
+    ASSERT_TRUE(request.put(protocol::test_params::test_uint8, 7));
+    ASSERT_TRUE(request.put(protocol::test_params::test_bool, false));
+    ASSERT_EQ(device.writeParameterValues(request), ResponseCode::ok);
+
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 7);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_bool), false);
+    // Both parameters share the callback, it is invoked once after both values have been written
+    EXPECT_EQ(simulator.getParameterChangeNotificationCount(), 1u);
+}
+
+TEST(EndToEnd, a_bad_entry_leaves_every_written_parameter_unchanged) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    constexpr parameter_system::ParameterID K_UNREGISTERED_ID = 0xF0;
+    const uint16_t                          value             = 1;
+    const std::span<const uint8_t>          value_bytes(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+
+    struct BadEntry {
+        protocol::commands::WriteParamValuesRequest::Entry entry;
+        ResponseCode                                       expected_response_code;
+    };
+    const BadEntry bad_entries[] = {
+        {{K_UNREGISTERED_ID, parameter_system::ParameterValueType::uint16}, ResponseCode::invalid_id},
+        {{protocol::test_params::test_uint8.id, parameter_system::ParameterValueType::uint16},
+         ResponseCode::type_mismatch},
+        // A signal, read only
+        {{protocol::test_params::test_uint16.id, parameter_system::ParameterValueType::uint16},
+         ResponseCode::forbidden},
+    };
+
+    for (const BadEntry& bad_entry : bad_entries) {
+        // The bad entry comes last, after the good ones would already have been written
+        protocol::commands::WriteParamValuesRequest request;
+        ASSERT_TRUE(request.put(protocol::test_params::test_uint8, 7));
+        ASSERT_TRUE(request.put(protocol::test_params::test_bool, false));
+        ASSERT_TRUE(request.putRaw(bad_entry.entry.parameter_id, bad_entry.entry.expected_value_type, value_bytes));
+
+        EXPECT_EQ(device.writeParameterValues(request), bad_entry.expected_response_code);
+        EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 42);
+        EXPECT_EQ(device.readParameterValue(protocol::test_params::test_bool), true);
+        EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint16), 1337);
+    }
+    EXPECT_EQ(simulator.getParameterChangeNotificationCount(), 0u);
+}
+
+TEST(EndToEnd, saved_parameters_survive_a_reboot) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, 7), ResponseCode::ok);
+    ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_bool, false), ResponseCode::ok);
+    ASSERT_EQ(device.saveParameters(), ResponseCode::ok);
+
+    ASSERT_EQ(device.reboot(), ResponseCode::ok);
+    const uint64_t start_time_ms = simulator.getClock().uptimeMilliseconds();
+    while (simulator.getBootCount() < 2 && simulator.getClock().uptimeMilliseconds() - start_time_ms < 1'000) {
+        master.context.run();
+    }
+    ASSERT_EQ(simulator.getBootCount(), 2u);
+
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 7);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_bool), true);  // Not a saved parameter
+}
+
+TEST(EndToEnd, updates_the_firmware_and_takes_it_into_use_at_the_reboot) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    const std::vector<uint8_t> image = randomBytes(50'000);
+    ASSERT_EQ(device.updateFirmware(image), ResponseCode::ok);
+
+    firmware_update::FirmwareStatus status;
+    ASSERT_EQ(device.getFirmwareStatus(&status), ResponseCode::ok);
+    EXPECT_EQ(status.running_slot, firmware_update::FirmwareSlot::a);
+    EXPECT_EQ(status.boot_slot, firmware_update::FirmwareSlot::b);
+    EXPECT_EQ(status.update_state, firmware_update::UpdateState::complete);
+
+    drivers::host::RamFlash& slot_b_flash = simulator.getFirmwareSlotFlash(firmware_update::FirmwareSlot::b);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), slot_b_flash.getBytes().begin()));
+
+    // The boot copies the image over slot A, which the boot ROM starts
+    ASSERT_EQ(device.reboot(), ResponseCode::ok);
+    const uint64_t start_time_ms = simulator.getClock().uptimeMilliseconds();
+    while (simulator.getBootCount() < 2 && simulator.getClock().uptimeMilliseconds() - start_time_ms < 1'000) {
+        master.context.run();
+    }
+    ASSERT_EQ(simulator.getBootCount(), 2u);
+
+    ASSERT_EQ(device.getFirmwareStatus(&status), ResponseCode::ok);
+    EXPECT_EQ(status.running_slot, firmware_update::FirmwareSlot::a);
+    EXPECT_EQ(status.boot_slot, firmware_update::FirmwareSlot::a);
+    EXPECT_EQ(status.update_state, firmware_update::UpdateState::idle);
+
+    drivers::host::RamFlash& slot_a_flash = simulator.getFirmwareSlotFlash(firmware_update::FirmwareSlot::a);
+    EXPECT_TRUE(std::equal(image.begin(), image.end(), slot_a_flash.getBytes().begin()));
+}
+
+TEST(EndToEnd, negotiates_a_faster_link_over_a_modelled_wire) {
+    const drivers::host::LinkModel link_model = {
+        .baud_rate = serial_communication_framework::K_DEFAULT_LINK_SETTINGS.baud_rate, .latency_us = 200};
+
+    DeviceSimulator                simulator(link_model);
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    const serial_communication_framework::LinkSettings settings =
+        master.context.negotiateLinkSettings(DeviceSimulator::K_DEVICE_ID, 3'000'000);
+    EXPECT_EQ(settings.baud_rate, 3'000'000u);
+    EXPECT_EQ(settings.framing, serial_communication_framework::Framing::cobs);
+    EXPECT_EQ(simulator.getMasterEnd().getBaudRate(), 3'000'000u);
+
+    EXPECT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, 99), ResponseCode::ok);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 99);
+}
+
+TEST(EndToEnd, both_sides_count_the_same_traffic) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+    device.setValueCachePolicy(servo_core_control_api::K_NO_VALUE_CACHE_POLICY);
+
+    constexpr uint8_t K_READ_OP_CODE = protocol::commands::ReadParamValue::K_OP_CODE;
+    for (int i = 0; i < 10; i++) (void)device.readParameterValue(protocol::test_params::test_uint8);
+
+    serial_communication_framework::OperationStatistics operation;
+    serial_communication_framework::DurationStatistics  handler_time;
+    ASSERT_EQ(device.getOperationStatistics(K_READ_OP_CODE, &operation, &handler_time), ResponseCode::ok);
+    EXPECT_EQ(operation.requests, 10u);
+    EXPECT_EQ(operation.errors, 0u);
+    EXPECT_EQ(handler_time.count, 10u);
+    EXPECT_EQ(master.context.getCommunicationStatistics().operations[K_READ_OP_CODE].requests, 10u);
+    EXPECT_EQ(master.context.getRoundTripLatencyHistogram(K_READ_OP_CODE).getDurationStatistics().count, 10u);
+
+    // The master has sent this request too, but the device answers it before counting its own response
+    serial_communication_framework::CommunicationStatistics device_statistics;
+    ASSERT_EQ(device.getCommunicationStatistics(&device_statistics), ResponseCode::ok);
+    const serial_communication_framework::CommunicationStatistics& master_statistics =
+        master.context.getCommunicationStatistics();
+    EXPECT_EQ(device_statistics.bytes_received, master_statistics.bytes_transmitted);
+    EXPECT_LT(device_statistics.bytes_transmitted, master_statistics.bytes_received);
+    EXPECT_EQ(device_statistics.rx_overflows, 0u);
+}
+
+TEST(EndToEnd, runs_the_device_in_its_own_thread) {
+    DeviceSimulator                simulator({}, DeviceSimulator::RunMode::own_thread);
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    for (uint8_t value = 0; value < 100; value++) {
+        ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, value), ResponseCode::ok);
+        ASSERT_EQ(device.readParameterValue(protocol::test_params::loop_back), value);
+    }
+}
+
+TEST(EndToEnd, serves_parameters_from_the_value_cache) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    constexpr uint8_t K_READ_OP_CODE  = protocol::commands::ReadParamValue::K_OP_CODE;
+    constexpr uint8_t K_READS_OP_CODE = protocol::commands::ReadParamValues::K_OP_CODE;
+
+    const auto requests = [&](uint8_t op_code) {
+        return master.context.getCommunicationStatistics().operations[op_code].requests;
+    };
+
+    for (int i = 0; i < 10; i++) EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 42);
+    EXPECT_EQ(requests(K_READ_OP_CODE), 1u);
+
+    // A written value is served without reading it back
+    ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, 7), ResponseCode::ok);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 7);
+    EXPECT_EQ(requests(K_READ_OP_CODE), 1u);
+
+    // Only the signal is read, its value lands after the cached one
+    const protocol::commands::ReadParamValuesRequest::Entry entries[] = {
+        {protocol::test_params::test_uint8.id, parameter_system::ParameterValueType::uint8},
+        {protocol::test_params::test_uint16.id, parameter_system::ParameterValueType::uint16},
+    };
+    uint8_t values[3] = {};
+    ASSERT_EQ(device.readParameterValuesRaw(entries, values), ResponseCode::ok);
+    EXPECT_EQ(values[0], 7);
+    uint16_t uint16_value = 0;
+    std::memcpy(&uint16_value, &values[1], sizeof(uint16_value));
+    EXPECT_EQ(uint16_value, 1337);
+    EXPECT_EQ(requests(K_READS_OP_CODE), 1u);
+
+    device.invalidateValueCache();
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_uint8), 7);
+    EXPECT_EQ(requests(K_READ_OP_CODE), 2u);
+}
+
+TEST(EndToEnd, serves_signals_from_the_value_cache_until_their_max_age) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+    device.setValueCachePolicy({.signal_max_age_us = 200'000});
+
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::loop_back), 42);
+    ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_uint8, 7), ResponseCode::ok);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::loop_back), 42);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::loop_back), 7);
+}
+
+TEST(EndToEnd, devices_of_the_same_id_share_the_value_cache) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device reader = master.findDevice();
+    servo_core_control_api::Device writer = master.findDevice();
+
+    EXPECT_EQ(reader.readParameterValue(protocol::test_params::test_uint8), 42);
+    ASSERT_EQ(writer.writeParameterValue(protocol::test_params::test_uint8, 7), ResponseCode::ok);
+    EXPECT_EQ(reader.readParameterValue(protocol::test_params::test_uint8), 7);
+
+    writer.setValueCachePolicy(servo_core_control_api::K_NO_VALUE_CACHE_POLICY);
+    EXPECT_EQ(reader.getValueCachePolicy().cache_parameters, false);
+}
+
+TEST(EndToEnd, reboot_invalidates_the_value_cache) {
+    DeviceSimulator                simulator;
+    Master                         master(simulator);
+    servo_core_control_api::Device device = master.findDevice();
+
+    ASSERT_EQ(device.writeParameterValue(protocol::test_params::test_bool, false), ResponseCode::ok);
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_bool), false);
+
+    ASSERT_EQ(device.reboot(), ResponseCode::ok);
+    const uint64_t start_time_ms = simulator.getClock().uptimeMilliseconds();
+    while (simulator.getBootCount() < 2 && simulator.getClock().uptimeMilliseconds() - start_time_ms < 1'000) {
+        master.context.run();
+    }
+    ASSERT_EQ(simulator.getBootCount(), 2u);
+
+    EXPECT_EQ(device.readParameterValue(protocol::test_params::test_bool), true);
+}
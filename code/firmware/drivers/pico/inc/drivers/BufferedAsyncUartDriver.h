@@ -8,6 +8,7 @@
 
 #include "assert/assert.h"
 #include "drivers/interfaces/BufferedSerialCommunicationInterface.h"
+#include "drivers/interfaces/SerialPortConfigurationInterface.h"
 #include "utils/RingBuffer.h"
 
 namespace drivers {
@@ -51,7 +52,8 @@ enum class Parity {
  */
 
 template <size_t tx_buffer_size, size_t rx_buffer_size>
-class BufferedAsyncUartDriver final : public interfaces::BufferedSerialCommunicationInterface {
+class BufferedAsyncUartDriver final : public interfaces::BufferedSerialCommunicationInterface,
+                                      public interfaces::SerialPortConfigurationInterface {
 public:
     BufferedAsyncUartDriver(uart_inst_t* uart_instance, volatile utils::RingBuffer<tx_buffer_size>* tx_buffer,
                             volatile utils::RingBuffer<rx_buffer_size>* rx_buffer, uint32_t baud_rate,
@@ -91,8 +93,19 @@ public:
      */
     void transmitBytes(std::span<uint8_t> bytes) override;
 
+    // public: SerialPortConfigurationInterface
     /** @brief Wait until all buffered TX data is transmitted */
-    void flushTx();
+    void flushTx() override;
+
+    /**
+     * @brief Change the baud rate, keeping the data format.
+     * @param baud_rate target baud rate
+     * @return false if the UART clock can't be divided close enough to the target, the previous rate is kept then
+     */
+    bool setBaudRate(uint32_t baud_rate) override;
+
+    /** @brief Get the target baud rate that was last set */
+    uint32_t getBaudRate() override;
 
     /**
      * @brief Get the number of available bytes in the rx buffer.
@@ -111,6 +124,11 @@ public:
      * @return The number of bytes successfully read from the rx buffer.
      */
     size_t readReceivedBytes(std::span<uint8_t> buffer) override;
+    /**
+     * @brief Get the number of received bytes dropped because the rx buffer was full.
+     * @return The number of dropped bytes since the driver was created.
+     */
+    uint64_t getRxOverflowCount() override;
 
     /** @brief Handle TX interrupt for asynchronous transmission. */
     void handleTxInterrupt();
@@ -139,11 +157,17 @@ private:
     uint32_t target_baud_rate_ = 115200;
     uint32_t output_baud_rate_ = 115200;
 
+    // Incremented in the rx interrupt only, 32 bits so that it is read atomically
+    volatile uint32_t rx_overflow_count_ = 0;
+
+    // The receiver samples in the middle of the bits, so a couple of percent off is still received correctly
+    static constexpr uint32_t K_MAX_BAUD_RATE_ERROR_PERCENT = 2;
+
     struct FormatConfig {
         uart_config::DataBits data_bits;
         uart_config::StopBits stop_bits;
         uart_config::Parity   parity;
-    } constructor_format_config_;
+    } format_config_;
 };
 
 //
@@ -164,7 +188,7 @@ BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::BufferedAsyncUartDriver
       tx_ring_buffer_(tx_buffer),
       rx_ring_buffer_(rx_buffer),
       target_baud_rate_(baud_rate),
-      constructor_format_config_{data_bits, stop_bits, parity} {}
+      format_config_{data_bits, stop_bits, parity} {}
 
 template <size_t tx_buffer_size, size_t rx_buffer_size>
 void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::init() {
@@ -172,9 +196,8 @@ void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::init() {
     // Fifo must be disabled because the tx_needs_data interrupt is never triggered otherwise.
     // Software is handling the buffering byte by byte so the FIFO is not even needed
     uart_set_fifo_enabled(uart_instance_, false);
-    uart_set_format(uart_instance_, (unsigned int)constructor_format_config_.data_bits,
-                    (unsigned int)constructor_format_config_.stop_bits,
-                    (uart_parity_t)constructor_format_config_.parity);
+    uart_set_format(uart_instance_, (unsigned int)format_config_.data_bits, (unsigned int)format_config_.stop_bits,
+                    (uart_parity_t)format_config_.parity);
     // enable TX and RX interrupt
     uart_set_irq_enables(uart_instance_, true, true);
 }
@@ -194,10 +217,29 @@ void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::configure(uint32_t
     target_baud_rate_ = baud_rate;
     output_baud_rate_ = uart_set_baudrate(uart_instance_, target_baud_rate_);
 
-    constructor_format_config_(data_bits, stop_bits, parity);
+    format_config_ = {data_bits, stop_bits, parity};
     uart_set_format(uart_instance_, (unsigned int)data_bits, (unsigned int)stop_bits, (uart_parity_t)parity);
 }
 
+template <size_t tx_buffer_size, size_t rx_buffer_size>
+bool BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::setBaudRate(uint32_t baud_rate) {
+    const uint32_t previous_baud_rate = target_baud_rate_;
+    configure(baud_rate, format_config_.data_bits, format_config_.stop_bits, format_config_.parity);
+
+    const uint64_t error =
+        output_baud_rate_ > baud_rate ? output_baud_rate_ - baud_rate : baud_rate - output_baud_rate_;
+    if (error * 100 > static_cast<uint64_t>(baud_rate) * K_MAX_BAUD_RATE_ERROR_PERCENT) {
+        configure(previous_baud_rate, format_config_.data_bits, format_config_.stop_bits, format_config_.parity);
+        return false;
+    }
+    return true;
+}
+
+template <size_t tx_buffer_size, size_t rx_buffer_size>
+uint32_t BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::getBaudRate() {
+    return target_baud_rate_;
+}
+
 template <size_t tx_buffer_size, size_t rx_buffer_size>
 void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::transmitString(const char* string) {
     const char* string_iterator_pointer = string;
@@ -290,7 +332,7 @@ size_t BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::readReceivedByte
 
     while (i < buffer.size()) {
         // check for trying to read more bytes than available
-        if (i == rx_ring_buffer_->bytesAvailable()) break;
+        if (rx_ring_buffer_->isEmpty()) break;
 
         buffer[i] = rx_ring_buffer_->pop();
         i++;
@@ -300,6 +342,11 @@ size_t BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::readReceivedByte
     return i;
 }
 
+template <size_t tx_buffer_size, size_t rx_buffer_size>
+uint64_t BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::getRxOverflowCount() {
+    return rx_overflow_count_;
+}
+
 template <size_t tx_buffer_size, size_t rx_buffer_size>
 void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::handleTxInterrupt() {
     // Last byte from the buffer was transmitted
@@ -317,9 +364,14 @@ void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::handleTxInterrupt(
 
 template <size_t tx_buffer_size, size_t rx_buffer_size>
 void BufferedAsyncUartDriver<tx_buffer_size, rx_buffer_size>::handleRxInterrupt() {
-    if (rx_ring_buffer_->isFull()) return;
+    // The byte is read out of the UART even when it has to be dropped, otherwise the interrupt stays pending
+    const uint8_t byte = uart_getc(uart_instance_);
+    if (rx_ring_buffer_->isFull()) {
+        rx_overflow_count_ = rx_overflow_count_ + 1;
+        return;
+    }
 
-    rx_ring_buffer_->push(uart_getc(uart_instance_));
+    rx_ring_buffer_->push(byte);
 }
 
 template <size_t tx_buffer_size, size_t rx_buffer_size>
@@ -0,0 +1,44 @@
+#ifndef FIRMWARE_DRIVERS_PICO_FLASHDRIVER_H
+#define FIRMWARE_DRIVERS_PICO_FLASHDRIVER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "drivers/interfaces/FlashInterface.h"
+
+namespace drivers {
+
+/**
+ * @brief Driver class for a region of the on-board QSPI flash the firmware itself is executed from.
+ *
+ * Reads go through the XIP window. Erasing and programming stall the XIP, so interrupts are disabled for their
+ * duration and no code may run from flash on the other core meanwhile. Programming is padded to whole flash pages
+ * with erased bytes, which leaves the rest of the page untouched.
+ */
+class FlashDriver final : public interfaces::FlashInterface {
+public:
+    /**
+     * @param flash_offset Offset of the region from the beginning of the flash, must be sector aligned.
+     * @param sector_count Amount of sectors in the region.
+     */
+     FlashDriver(uint32_t flash_offset, size_t sector_count);
+    ~FlashDriver() override = default;
+
+    [[nodiscard]] size_t getSectorSize() const override;
+    [[nodiscard]] size_t getSectorCount() const override;
+
+    [[nodiscard]] bool read(size_t address, std::span<uint8_t> target) override;
+    [[nodiscard]] bool program(size_t address, std::span<const uint8_t> data) override;
+    [[nodiscard]] bool eraseSector(size_t sector_index) override;
+
+private:
+    const uint32_t flash_offset_;
+    const size_t   sector_count_;
+
+    [[nodiscard]] bool isInRegion(size_t address, size_t size) const;
+};
+
+}  // namespace drivers
+
+#endif  // FIRMWARE_DRIVERS_PICO_FLASHDRIVER_H
@@ -0,0 +1,72 @@
+#include "drivers/FlashDriver.h"
+
+#include <hardware/flash.h>
+#include <hardware/sync.h>
+#include <pico/platform.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "assert/assert.h"
+
+namespace drivers {
+
+FlashDriver::FlashDriver(uint32_t flash_offset, size_t sector_count)
+    : flash_offset_(flash_offset), sector_count_(sector_count) {
+    ASSERT_WITH_MESSAGE(flash_offset % FLASH_SECTOR_SIZE == 0, "Flash region is not sector aligned");
+    ASSERT_WITH_MESSAGE(flash_offset + sector_count * FLASH_SECTOR_SIZE <= PICO_FLASH_SIZE_BYTES,
+                        "Flash region does not fit the flash");
+}
+
+size_t FlashDriver::getSectorSize() const { return FLASH_SECTOR_SIZE; }
+
+size_t FlashDriver::getSectorCount() const { return sector_count_; }
+
+bool FlashDriver::read(size_t address, std::span<uint8_t> target) {
+    if (!isInRegion(address, target.size())) return false;
+
+    const auto* source = reinterpret_cast<const uint8_t*>(XIP_BASE + flash_offset_ + address);
+    std::memcpy(target.data(), source, target.size());
+    return true;
+}
+
+bool FlashDriver::program(size_t address, std::span<const uint8_t> data) {
+    if (!isInRegion(address, data.size())) return false;
+
+    // The flash can only be programmed in whole pages, erased bytes around the data leave the page as it was
+    uint8_t page_buffer[FLASH_PAGE_SIZE];
+    size_t  data_index = 0;
+    while (data_index < data.size()) {
+        const size_t flash_address = flash_offset_ + address + data_index;
+        const size_t page_address  = flash_address - (flash_address % FLASH_PAGE_SIZE);
+        const size_t page_index    = flash_address - page_address;
+        const size_t chunk_size    = std::min(FLASH_PAGE_SIZE - page_index, data.size() - data_index);
+
+        std::memset(page_buffer, K_ERASED_BYTE, sizeof(page_buffer));
+        std::memcpy(&page_buffer[page_index], &data[data_index], chunk_size);
+
+        const uint32_t interrupts = save_and_disable_interrupts();
+        flash_range_program(page_address, page_buffer, FLASH_PAGE_SIZE);
+        restore_interrupts(interrupts);
+
+        data_index += chunk_size;
+    }
+
+    return true;
+}
+
+bool FlashDriver::eraseSector(size_t sector_index) {
+    if (sector_index >= sector_count_) return false;
+
+    const uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_erase(flash_offset_ + sector_index * FLASH_SECTOR_SIZE, FLASH_SECTOR_SIZE);
+    restore_interrupts(interrupts);
+    return true;
+}
+
+bool FlashDriver::isInRegion(size_t address, size_t size) const {
+    const size_t region_size = sector_count_ * FLASH_SECTOR_SIZE;
+    return address <= region_size && size <= region_size - address;
+}
+
+}  // namespace drivers
@@ -0,0 +1,23 @@
+#ifndef FIRMWARE_BOARD_H
+#define FIRMWARE_BOARD_H
+
+#include <cstdint>
+#include <span>
+
+// What the platform independent firmware code needs from the board it runs on. The device simulator of the host
+// build implements these too.
+namespace board {
+
+/**
+ * @brief Get the rates the master can switch the serial communication link to, slowest first.
+ */
+std::span<const uint32_t> getSerialCommunicationBaudRates();
+
+/**
+ * @brief Restart the device once delay_ms has passed. Returns right away.
+ */
+void scheduleReboot(uint32_t delay_ms);
+
+}  // namespace board
+
+#endif  // FIRMWARE_BOARD_H
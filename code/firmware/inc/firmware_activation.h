@@ -0,0 +1,24 @@
+#ifndef FIRMWARE_FIRMWARE_ACTIVATION_H
+#define FIRMWARE_FIRMWARE_ACTIVATION_H
+
+#include <cstdint>
+
+// The boot ROM always starts slot A and the images are linked to run from there, so a firmware update received into
+// slot B is copied over slot A at the next boot.
+namespace firmware_activation {
+
+/**
+ * @brief Copy the image in slot B over slot A and restart the device into it.
+ *
+ * Runs from RAM with the interrupts disabled, since the code in slot A is erased underneath it, and restarts with the
+ * watchdog without returning to the flash. The first sector of slot A is erased first and its second stage boot loader
+ * is programmed last: if the power is lost on the way the boot ROM refuses the slot and starts the USB mass storage
+ * mode, instead of running a mix of the two images. Nothing may run on the other core.
+ *
+ * @param image_size Size of the image, verified with `FirmwareUpdater::prepareActivation()` beforehand.
+ */
+[[noreturn]] void copySlotBToSlotAAndReboot(uint32_t image_size);
+
+}  // namespace firmware_activation
+
+#endif  // FIRMWARE_FIRMWARE_ACTIVATION_H
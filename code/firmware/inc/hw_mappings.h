@@ -2,14 +2,22 @@
 #define HW_MAPPINGS_H
 
 #include <drivers/TimerDriver.h>
+#include <hardware/flash.h>
 #include <hardware/timer.h>
 #include <hardware/uart.h>
 
+#include <array>
+#include <cstdint>
+
 namespace hw_mappings {
 
 const auto     K_SERIAL_COMMUNICATION_UART_INSTANCE = uart0;
 constexpr auto K_SERIAL_COMMUNICATION_UART_TX_PIN   = 0;
 constexpr auto K_SERIAL_COMMUNICATION_UART_RX_PIN   = 1;
+// Rates the master can switch the link to. The UART could go up to clk_peri / 16, but the common USB serial adapters
+// top out at 3 Mbaud
+constexpr std::array<uint32_t, 8> K_SERIAL_COMMUNICATION_BAUD_RATES = {115200,  230400,  460800,  921600,
+                                                                        1000000, 1500000, 2000000, 3000000};
 
 const auto     K_DEBUG_UART_INSTANCE                = uart1;  // Cant be constexpr
 constexpr auto K_DEBUG_UART_TX_PIN                  = 4;
@@ -22,6 +30,28 @@ constexpr unsigned int K_STATUS_LED_BLUE_PIN        = 13;
 const auto     K_PERIODIC_LED_TIMER_INSTANCE        = timer_hw;
 constexpr auto K_PERIODIC_LED_TIMER_ALARM_CHANNEL   = drivers::TimerAlarmChannel::alarm3;
 
+const auto     K_TELEMETRY_TIMER_INSTANCE           = timer_hw;
+constexpr auto K_TELEMETRY_TIMER_ALARM_CHANNEL      = drivers::TimerAlarmChannel::alarm2;
+
+const auto     K_CAPTURE_TIMER_INSTANCE             = timer_hw;
+constexpr auto K_CAPTURE_TIMER_ALARM_CHANNEL        = drivers::TimerAlarmChannel::alarm1;
+
+// The saved parameters live in the last sectors of the flash, after the firmware image
+constexpr size_t   K_PARAMETER_STORAGE_SECTOR_COUNT = 4;
+constexpr uint32_t K_PARAMETER_STORAGE_FLASH_OFFSET =
+    PICO_FLASH_SIZE_BYTES - K_PARAMETER_STORAGE_SECTOR_COUNT * FLASH_SECTOR_SIZE;
+
+// The boot record of the firmware updates, right before the saved parameters
+constexpr size_t   K_BOOT_RECORD_SECTOR_COUNT = 2;
+constexpr uint32_t K_BOOT_RECORD_FLASH_OFFSET =
+    K_PARAMETER_STORAGE_FLASH_OFFSET - K_BOOT_RECORD_SECTOR_COUNT * FLASH_SECTOR_SIZE;
+
+// The rest of the flash is split into two firmware slots. The boot ROM always starts slot A, so an update received
+// into slot B is copied over slot A at the next boot, see firmware_activation.h
+constexpr size_t   K_FIRMWARE_SLOT_SECTOR_COUNT   = K_BOOT_RECORD_FLASH_OFFSET / FLASH_SECTOR_SIZE / 2;
+constexpr uint32_t K_FIRMWARE_SLOT_A_FLASH_OFFSET = 0;
+constexpr uint32_t K_FIRMWARE_SLOT_B_FLASH_OFFSET = K_FIRMWARE_SLOT_SECTOR_COUNT * FLASH_SECTOR_SIZE;
+
 }  // namespace hw_mappings
 
 #endif  // HW_MAPPINGS_H
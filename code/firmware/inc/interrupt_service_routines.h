@@ -13,6 +13,12 @@
 // This isr can be extended to host other periodic general updates too
 ATTRIBUTE_ISR void periodicLedUpdateTimerISR();
 
+// Samples the subscribed telemetry signals, so that the sample timing does not depend on the main loop
+ATTRIBUTE_ISR void telemetrySampleTimerISR();
+
+// Records the armed signal capture at a fixed rate, so that its samples are evenly spaced
+ATTRIBUTE_ISR void captureSampleTimerISR();
+
 ATTRIBUTE_ISR void debugUartCombinedISR();
 
 ATTRIBUTE_ISR void serialCommunicationUartCombinedISR();
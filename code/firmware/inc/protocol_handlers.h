@@ -3,16 +3,60 @@
 
 #include "protocol/commands.h"
 #include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/transfer.h"
 
 namespace protocol_handlers {
 
 protocol::commands::ReadParamValueResponse   readParamValue(const protocol::commands::ReadParamValueRequest& request);
+protocol::commands::ReadParamValuesResponse  readParamValues(
+    const protocol::commands::ReadParamValuesRequest& request);
 protocol::commands::EmptyResponse            writeParamValue(const protocol::commands::WriteParamValueRequest& request);
+protocol::commands::EmptyResponse            writeParamValues(
+    const protocol::commands::WriteParamValuesRequest& request);
 protocol::commands::GetParamMetadataResponse getParamMetaData(
     const protocol::commands::GetParamMetadataRequest& request);
+protocol::commands::EmptyResponse            saveParameters(const protocol::commands::EmptyRequest& request);
+
+protocol::commands::EmptyResponse subscribeTelemetry(const protocol::commands::SubscribeTelemetryRequest& request);
+protocol::commands::EmptyResponse unsubscribeTelemetry(const protocol::commands::EmptyRequest& request);
+
+protocol::commands::EmptyResponse            armCapture(const protocol::commands::ArmCaptureRequest& request);
+protocol::commands::EmptyResponse            triggerCapture(const protocol::commands::EmptyRequest& request);
+protocol::commands::EmptyResponse            disarmCapture(const protocol::commands::EmptyRequest& request);
+protocol::commands::GetCaptureStatusResponse getCaptureStatus(const protocol::commands::EmptyRequest& request);
+protocol::commands::ReadCaptureDataResponse  readCaptureData(
+    const protocol::commands::ReadCaptureDataRequest& request);
+
+protocol::commands::EmptyResponse startTransfer(const serial_communication_framework::TransferStartRequest& request);
+protocol::commands::EmptyResponse writeTransferSegment(
+    const serial_communication_framework::TransferSegmentRequest& request);
+protocol::commands::EmptyResponse finishTransfer(const serial_communication_framework::TransferFinishRequest& request);
+serial_communication_framework::TransferReadResponse readTransferSegment(
+    const serial_communication_framework::TransferReadRequest& request);
+
+// Download source of protocol::TransferIds::capture_data
+serial_communication_framework::ResponseCode captureDataSource(uint32_t offset, std::span<uint8_t> target_buffer,
+                                                               size_t* read_size_out, void* user_data);
+
+protocol::commands::EmptyResponse beginFirmwareUpdate(const protocol::commands::BeginFirmwareUpdateRequest& request);
+protocol::commands::GetFirmwareStatusResponse getFirmwareStatus(const protocol::commands::EmptyRequest& request);
+
+// Upload sink and finish callback of protocol::TransferIds::firmware_image
+serial_communication_framework::ResponseCode firmwareImageSink(uint32_t offset, std::span<const uint8_t> bytes,
+                                                               void* user_data);
+serial_communication_framework::ResponseCode finishFirmwareImage(uint32_t total_size, void* user_data);
 
 protocol::commands::GetRegisteredParamIdsResponse getParamIds(const protocol::commands::EmptyRequest& request);
 protocol::commands::EmptyResponse                 ping(const protocol::commands::EmptyRequest& request);
+protocol::commands::EmptyResponse                 reboot(const protocol::commands::EmptyRequest& request);
+protocol::commands::GetCapabilitiesResponse       getCapabilities(const protocol::commands::EmptyRequest& request);
+protocol::commands::EmptyResponse                 configureLink(
+    const protocol::commands::ConfigureLinkRequest& request);
+
+protocol::commands::GetCommunicationStatisticsResponse getCommunicationStatistics(
+    const protocol::commands::EmptyRequest& request);
+protocol::commands::GetOperationStatisticsResponse     getOperationStatistics(
+    const protocol::commands::GetOperationStatisticsRequest& request);
 
 }  // namespace protocol_handlers
 
@@ -0,0 +1,13 @@
+#include "board.h"
+
+#include <hardware/watchdog.h>
+
+#include "hw_mappings.h"
+
+namespace board {
+
+std::span<const uint32_t> getSerialCommunicationBaudRates() { return hw_mappings::K_SERIAL_COMMUNICATION_BAUD_RATES; }
+
+void scheduleReboot(uint32_t delay_ms) { watchdog_reboot(0, 0, delay_ms); }
+
+}  // namespace board
@@ -0,0 +1,63 @@
+#include "firmware_activation.h"
+
+#include <hardware/flash.h>
+#include <hardware/structs/psm.h>
+#include <hardware/structs/watchdog.h>
+#include <hardware/sync.h>
+#include <pico/platform.h>
+
+#include <cstddef>
+
+#include "firmware_update/FirmwareUpdater.h"
+#include "hw_mappings.h"
+
+namespace firmware_activation {
+
+namespace {
+
+static_assert(FLASH_PAGE_SIZE == firmware_update::FirmwareUpdater::K_BOOT_HEADER_SIZE,
+              "The second stage boot loader is programmed as one page");
+
+// The flash can't be read while it is being programmed, so every page is copied through RAM
+uint32_t page_buffer[FLASH_PAGE_SIZE / sizeof(uint32_t)];
+
+// Everything called once the copy has started must be in RAM, std::min included
+void __no_inline_not_in_flash_func(copyPages)(uint32_t start, uint32_t end) {
+    for (uint32_t offset = start; offset < end; offset += FLASH_PAGE_SIZE) {
+        // Word by word through volatile, so that the loop can't be turned into a memcpy call into the flash
+        const auto* source =
+            reinterpret_cast<const volatile uint32_t*>(XIP_BASE + hw_mappings::K_FIRMWARE_SLOT_B_FLASH_OFFSET + offset);
+        for (size_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); i++) page_buffer[i] = source[i];
+
+        flash_range_program(hw_mappings::K_FIRMWARE_SLOT_A_FLASH_OFFSET + offset,
+                            reinterpret_cast<const uint8_t*>(page_buffer), FLASH_PAGE_SIZE);
+    }
+}
+
+}  // namespace
+
+void __no_inline_not_in_flash_func(copySlotBToSlotAAndReboot)(uint32_t image_size) {
+    (void)save_and_disable_interrupts();
+    // The copy takes seconds, a watchdog left running by the reboot command must not cut it short
+    hw_clear_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_ENABLE_BITS);
+
+    const uint32_t sector_count = (image_size + FLASH_SECTOR_SIZE - 1) / FLASH_SECTOR_SIZE;
+    for (uint32_t sector_index = 0; sector_index < sector_count; sector_index++) {
+        const uint32_t sector_offset = sector_index * FLASH_SECTOR_SIZE;
+        const uint32_t sector_end    = sector_offset + FLASH_SECTOR_SIZE;
+        // The first page holds the second stage boot loader, programmed once the rest is in place
+        const uint32_t copy_start    = sector_index == 0 ? FLASH_PAGE_SIZE : sector_offset;
+        const uint32_t copy_end      = sector_end < image_size ? sector_end : image_size;
+
+        flash_range_erase(hw_mappings::K_FIRMWARE_SLOT_A_FLASH_OFFSET + sector_offset, FLASH_SECTOR_SIZE);
+        copyPages(copy_start, copy_end);
+    }
+    copyPages(0, FLASH_PAGE_SIZE);
+
+    // The same reset as watchdog_reboot(), which is in the flash that now holds the new image
+    hw_set_bits(&psm_hw->wdsel, PSM_WDSEL_BITS & ~(PSM_WDSEL_ROSC_BITS | PSM_WDSEL_XOSC_BITS));
+    hw_set_bits(&watchdog_hw->ctrl, WATCHDOG_CTRL_TRIGGER_BITS);
+    while (true) tight_loop_contents();
+}
+
+}  // namespace firmware_activation
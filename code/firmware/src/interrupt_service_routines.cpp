@@ -6,6 +6,8 @@
 #include "drivers/TimerDriver.h"
 #include "hw_mappings.h"
 #include "led_controller/LedController.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/TelemetryStreamer.h"
 #include "serial_communication_framework/SlaveHandler.h"
 
 extern led_controller::LedController status_led_controller;
@@ -15,6 +17,12 @@ extern drivers::TimerDriver          led_update_timer;
 extern drivers::BufferedAsyncUartDriver<128, 128> debug_uart_driver;
 extern drivers::BufferedAsyncUartDriver<128, 128> communication_uart_driver;
 
+extern parameter_system::TelemetryStreamer telemetry_streamer;
+extern drivers::TimerDriver                telemetry_timer_driver;
+
+extern parameter_system::SignalCapture signal_capture;
+extern drivers::TimerDriver            capture_timer_driver;
+
 extern serial_communication_framework::SlaveHandler protocol_handler;
 extern drivers::TimerDriver                         communication_timeout_timer;
 
@@ -26,6 +34,20 @@ ATTRIBUTE_ISR void periodicLedUpdateTimerISR() {
     led_update_timer.restart();
 }
 
+ATTRIBUTE_ISR void telemetrySampleTimerISR() {
+    telemetry_streamer.sample();
+
+    // Restart instead of start to keep the sampling period free of drift
+    telemetry_timer_driver.restart();
+}
+
+ATTRIBUTE_ISR void captureSampleTimerISR() {
+    signal_capture.sample();
+
+    // Restart instead of start so that the samples are evenly spaced and the measured interval is the period
+    capture_timer_driver.restart();
+}
+
 ATTRIBUTE_ISR void debugUartCombinedISR() {
     // TODO create NVIC driver so that all the interrupts are exposed and no need to do stuff like this?
 
@@ -3,6 +3,7 @@
 #include <hardware/pwm.h>
 #include <hardware/structs/uart.h>
 #include <hardware/uart.h>
+#include <pico/platform.h>
 
 #include <cmath>
 
@@ -10,19 +11,31 @@
 #include "debug_print/debug_print.h"
 #include "drivers/AnalogRgbLedDriver.h"
 #include "drivers/BufferedAsyncUartDriver.h"
+#include "drivers/FlashDriver.h"
 #include "drivers/PwmSliceDriver.h"
 #include "drivers/SysClockDriver.h"
 #include "drivers/TimerDriver.h"
+#include "firmware_activation.h"
+#include "firmware_update/FirmwareUpdater.h"
 #include "hw_mappings.h"
 #include "interrupt_service_routines.h"
 #include "led_controller/LedController.h"
 #include "led_controller/common_colors.h"
 #include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/ParameterRegistry.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/TelemetryStreamer.h"
 #include "parameter_system/definition_helpers.h"
+#include "persistent_storage/RecordStore.h"
+#include "persistent_storage/parameter_storage.h"
 #include "protocol/commands.h"
 #include "protocol/parameters.h"
+#include "protocol/stream_ids.h"
+#include "protocol/transfer_ids.h"
 #include "protocol_handlers.h"
 #include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/SlaveLinkSwitcher.h"
+#include "serial_communication_framework/TransferSlave.h"
 #include "utils/RingBuffer.h"
 
 namespace uart_config = drivers::uart_config;
@@ -32,10 +45,10 @@ drivers::SysClockDriver sys_clock_driver;
 // ---------------------- SERIAL COMMUNICATION UART -----------------------
 utils::RingBuffer<128>           communication_uart_tx_buffer;
 utils::RingBuffer<128>           communication_uart_rx_buffer;
-drivers::BufferedAsyncUartDriver communication_uart_driver(hw_mappings::K_SERIAL_COMMUNICATION_UART_INSTANCE,
-                                                           &communication_uart_tx_buffer, &communication_uart_rx_buffer,
-                                                           115200, uart_config::DataBits::eight,
-                                                           uart_config::StopBits::one, uart_config::Parity::none);
+drivers::BufferedAsyncUartDriver communication_uart_driver(
+    hw_mappings::K_SERIAL_COMMUNICATION_UART_INSTANCE, &communication_uart_tx_buffer, &communication_uart_rx_buffer,
+    serial_communication_framework::K_DEFAULT_LINK_SETTINGS.baud_rate, uart_config::DataBits::eight,
+    uart_config::StopBits::one, uart_config::Parity::none);
 
 // ------------------------------ DEBUG UART ------------------------------
 utils::RingBuffer<128>           debug_uart_tx_buffer;
@@ -58,11 +71,67 @@ led_controller::LedController status_led_controller(&led_driver);
 drivers::TimerDriver led_update_timer(hw_mappings::K_PERIODIC_LED_TIMER_INSTANCE,
                                       hw_mappings::K_PERIODIC_LED_TIMER_ALARM_CHANNEL);
 // ----------------------------- PARAMETER SYSTEM ------------------------------
-parameter_system::ParameterDefinition* parameter_buffer[64] = {nullptr};
-parameter_system::ParameterDatabase    parameter_database({parameter_buffer});
+uint8_t  test_uint8  = 42;
+uint16_t test_uint16 = 1337;
+uint32_t test_uint32 = 123456;
+float    test_float  = 3.1415;
+bool     test_bool   = true;
+uint64_t test_uint64 = 123456;
+
+// Built at compile time and placed in flash, only the variables above live in RAM
+constexpr parameter_system::ParameterRegistry parameter_registry{
+    parameter_system::SavedParameter(protocol::test_params::test_uint8, "Test Uint8", test_uint8),
+    parameter_system::SignalParameter(protocol::test_params::test_uint16, "Test Uint16", test_uint16),
+    parameter_system::SignalParameter(protocol::test_params::test_uint32, "Test Uint32", test_uint32),
+    parameter_system::SignalParameter(protocol::test_params::test_float, "Test Float", test_float),
+    parameter_system::RuntimeParameter(protocol::test_params::test_bool, "Test Bool", test_bool),
+    parameter_system::RuntimeParameter(protocol::test_params::test_test, "Test U64", test_uint64),
+    parameter_system::SignalParameter(protocol::test_params::loop_back, "Loopback of Test Uint8", test_uint8),
+};
+static_assert(parameter_registry.hasUniqueIds(), "Duplicate ParameterID detected");
+
+parameter_system::ParameterDatabase parameter_database(parameter_registry);
+
+drivers::FlashDriver            parameter_storage_flash(hw_mappings::K_PARAMETER_STORAGE_FLASH_OFFSET,
+                                                        hw_mappings::K_PARAMETER_STORAGE_SECTOR_COUNT);
+persistent_storage::RecordStore parameter_record_store(parameter_storage_flash);
+
+parameter_system::TelemetryStreamer telemetry_streamer(parameter_database);
+drivers::TimerDriver                telemetry_timer_driver(hw_mappings::K_TELEMETRY_TIMER_INSTANCE,
+                                                           hw_mappings::K_TELEMETRY_TIMER_ALARM_CHANNEL);
+uint8_t                             telemetry_frame_buffer[parameter_system::TelemetryStreamer::K_FRAME_MAX_SIZE];
+
+// The protocol handlers only need the interface, so that they build for the device simulator too
+drivers::interfaces::TimerInterface& telemetry_timer = telemetry_timer_driver;
+
+// Stands in for the control loop rate until the control loop exists
+constexpr uint32_t K_CAPTURE_SAMPLE_PERIOD_US = 100;
+
+uint8_t                         capture_buffer[32 * 1024];
+parameter_system::SignalCapture signal_capture(parameter_database, sys_clock_driver, capture_buffer);
+drivers::TimerDriver            capture_timer_driver(hw_mappings::K_CAPTURE_TIMER_INSTANCE,
+                                                     hw_mappings::K_CAPTURE_TIMER_ALARM_CHANNEL);
+
+drivers::interfaces::TimerInterface& capture_timer = capture_timer_driver;
+
+// ----------------------------- FIRMWARE UPDATE ------------------------------
+drivers::FlashDriver             firmware_slot_a_flash(hw_mappings::K_FIRMWARE_SLOT_A_FLASH_OFFSET,
+                                                       hw_mappings::K_FIRMWARE_SLOT_SECTOR_COUNT);
+drivers::FlashDriver             firmware_slot_b_flash(hw_mappings::K_FIRMWARE_SLOT_B_FLASH_OFFSET,
+                                                       hw_mappings::K_FIRMWARE_SLOT_SECTOR_COUNT);
+drivers::FlashDriver             boot_record_flash(hw_mappings::K_BOOT_RECORD_FLASH_OFFSET,
+                                                   hw_mappings::K_BOOT_RECORD_SECTOR_COUNT);
+persistent_storage::RecordStore  boot_record_store(boot_record_flash);
+firmware_update::FirmwareUpdater firmware_updater(firmware_slot_a_flash, firmware_slot_b_flash, boot_record_store);
+
+// Provided by the linker script, where this image starts in the flash
+extern char __flash_binary_start;
 
 // ----------------------------- COMM PROTOCOL --------------------------------
-serial_communication_framework::SlaveHandler protocol_handler(communication_uart_driver, sys_clock_driver, 0);
+serial_communication_framework::SlaveHandler      protocol_handler(communication_uart_driver, sys_clock_driver, 0);
+serial_communication_framework::SlaveLinkSwitcher link_switcher(protocol_handler, communication_uart_driver,
+                                                                sys_clock_driver);
+serial_communication_framework::TransferSlave     transfer_slave;
 
 void debugUartPutChar(char c) { debug_uart_driver.transmitByte(c); }
 void DebugUartFlush() { debug_uart_driver.flushTx(); }
@@ -112,6 +181,17 @@ void initHW() {
     irq_set_enabled(led_update_timer.getIrqNumber(), true);
     led_update_timer.start();
 
+    // --------------- INIT TELEMETRY TIMER ---------------
+    // The timer is configured and started when the master subscribes to telemetry
+    irq_set_exclusive_handler(telemetry_timer_driver.getIrqNumber(), telemetrySampleTimerISR);
+    irq_set_enabled(telemetry_timer_driver.getIrqNumber(), true);
+
+    // --------------- INIT CAPTURE TIMER ---------------
+    // The timer is started when the master arms a capture
+    capture_timer_driver.configureInMicroseconds(K_CAPTURE_SAMPLE_PERIOD_US);
+    irq_set_exclusive_handler(capture_timer_driver.getIrqNumber(), captureSampleTimerISR);
+    irq_set_enabled(capture_timer_driver.getIrqNumber(), true);
+
     // --------------- INIT COMMUNICATION ---------------
     protocol_handler.init();
 }
@@ -122,12 +202,66 @@ void initSWLibs() {
     assert::connectAssertionFailedHandler(onAssertionFailed);
 
     protocol_handler.registerCommandHandler<protocol::commands::Ping, protocol_handlers::ping>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetCapabilities, protocol_handlers::getCapabilities>();
+    protocol_handler.registerCommandHandler<protocol::commands::ConfigureLink, protocol_handlers::configureLink>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetCommunicationStatistics,
+                                            protocol_handlers::getCommunicationStatistics>();
+    protocol_handler.registerCommandHandler<protocol::commands::GetOperationStatistics,
+                                            protocol_handlers::getOperationStatistics>();
     protocol_handler
         .registerCommandHandler<protocol::commands::GetRegisteredParamIds, protocol_handlers::getParamIds>();
     protocol_handler
         .registerCommandHandler<protocol::commands::GetParamMetadata, protocol_handlers::getParamMetaData>();
     protocol_handler.registerCommandHandler<protocol::commands::ReadParamValue, protocol_handlers::readParamValue>();
+    protocol_handler.registerCommandHandler<protocol::commands::ReadParamValues, protocol_handlers::readParamValues>();
     protocol_handler.registerCommandHandler<protocol::commands::WriteParamValue, protocol_handlers::writeParamValue>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::WriteParamValues, protocol_handlers::writeParamValues>();
+    protocol_handler.registerCommandHandler<protocol::commands::SaveParameters, protocol_handlers::saveParameters>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::SubscribeTelemetry, protocol_handlers::subscribeTelemetry>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::UnsubscribeTelemetry, protocol_handlers::unsubscribeTelemetry>();
+    protocol_handler.registerCommandHandler<protocol::commands::ArmCapture, protocol_handlers::armCapture>();
+    protocol_handler.registerCommandHandler<protocol::commands::TriggerCapture, protocol_handlers::triggerCapture>();
+    protocol_handler.registerCommandHandler<protocol::commands::DisarmCapture, protocol_handlers::disarmCapture>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetCaptureStatus, protocol_handlers::getCaptureStatus>();
+    protocol_handler.registerCommandHandler<protocol::commands::ReadCaptureData, protocol_handlers::readCaptureData>();
+    protocol_handler.registerCommandHandler<protocol::commands::StartTransfer, protocol_handlers::startTransfer>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::WriteTransferSegment, protocol_handlers::writeTransferSegment>();
+    protocol_handler.registerCommandHandler<protocol::commands::FinishTransfer, protocol_handlers::finishTransfer>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::ReadTransferSegment, protocol_handlers::readTransferSegment>();
+
+    protocol_handler
+        .registerCommandHandler<protocol::commands::BeginFirmwareUpdate, protocol_handlers::beginFirmwareUpdate>();
+    protocol_handler
+        .registerCommandHandler<protocol::commands::GetFirmwareStatus, protocol_handlers::getFirmwareStatus>();
+    protocol_handler.registerCommandHandler<protocol::commands::Reboot, protocol_handlers::reboot>();
+
+    transfer_slave.registerDownloadSource(static_cast<uint8_t>(protocol::TransferIds::capture_data),
+                                          protocol_handlers::captureDataSource, nullptr);
+    transfer_slave.registerUploadSink(static_cast<uint8_t>(protocol::TransferIds::firmware_image),
+                                      hw_mappings::K_FIRMWARE_SLOT_SECTOR_COUNT * FLASH_SECTOR_SIZE,
+                                      protocol_handlers::firmwareImageSink, protocol_handlers::finishFirmwareImage,
+                                      nullptr);
+}
+
+// An update received into slot B is copied over slot A, which the boot ROM starts, before anything else runs
+void activateFirmwareUpdate() {
+    const firmware_update::UpdateResult result = firmware_updater.prepareActivation();
+    if (result == firmware_update::UpdateResult::not_started) return;
+    if (result != firmware_update::UpdateResult::ok) {
+        DEBUG_PRINT("The firmware update failed its verification and was dropped!\n");
+        return;
+    }
+
+    DEBUG_PRINT("Copying the firmware update into use!\n");
+    DebugUartFlush();
+    firmware_activation::copySlotBToSlotAAndReboot(
+        firmware_updater.getSlotInfo(firmware_update::FirmwareSlot::a).image_size);
 }
 
 [[noreturn]] int main() {
@@ -136,39 +270,42 @@ void initSWLibs() {
     initSWLibs();
 
     DEBUG_PRINT("Starting up!\n");
-    status_led_controller.setConstantBaseColor(led_controller::common_colors::K_YELLOW);
 
-    uint8_t  test_uint8  = 42;
-    uint16_t test_uint16 = 1337;
-    uint32_t test_uint32 = 123456;
-    float    test_float  = 3.1415;
-    bool     test_bool   = true;
-    uint64_t test_uint64 = 123456;
-
-    parameter_system::SavedParameter   param1(protocol::test_params::test_uint8, "Test Uint8", test_uint8);
-    parameter_system::SignalParameter  param2(protocol::test_params::test_uint16, "Test Uint16", test_uint16);
-    parameter_system::SignalParameter  param3(protocol::test_params::test_uint32, "Test Uint32", test_uint32);
-    parameter_system::SignalParameter  param4(protocol::test_params::test_float, "Test Float", test_float);
-    parameter_system::RuntimeParameter param5(protocol::test_params::test_bool, "Test Bool", test_bool);
-    parameter_system::RuntimeParameter param6(protocol::test_params::test_test, "Test U64", test_uint64);
-    parameter_system::SignalParameter  loop_back_parm(protocol::test_params::loop_back, "Loopback of Test Uint8",
-                                                      test_uint8);
-
-    parameter_database.registerParameter(&param1);
-    parameter_database.registerParameter(&param2);
-    parameter_database.registerParameter(&param3);
-    parameter_database.registerParameter(&param4);
-    parameter_database.registerParameter(&param5);
-    parameter_database.registerParameter(&param6);
-    parameter_database.registerParameter(&loop_back_parm);
+    // Saved parameters keep their default values if the storage is blank or cannot be mounted
+    if (parameter_record_store.mount() != persistent_storage::StorageResult::ok ||
+        persistent_storage::loadParameters(parameter_database, parameter_record_store) !=
+            persistent_storage::StorageResult::ok) {
+        DEBUG_PRINT("Loading the saved parameters failed!\n");
+    }
+
+    const uintptr_t image_flash_offset = reinterpret_cast<uintptr_t>(&__flash_binary_start) - XIP_BASE;
+    const auto      running_slot       = image_flash_offset >= hw_mappings::K_FIRMWARE_SLOT_B_FLASH_OFFSET
+                                             ? firmware_update::FirmwareSlot::b
+                                             : firmware_update::FirmwareSlot::a;
+    // Without the boot record the firmware runs normally, only the updates are refused
+    if (firmware_updater.mount(running_slot) != firmware_update::UpdateResult::ok) {
+        DEBUG_PRINT("Mounting the firmware boot record failed!\n");
+    } else if (running_slot == firmware_update::FirmwareSlot::a) {
+        activateFirmwareUpdate();
+    }
+    status_led_controller.setConstantBaseColor(led_controller::common_colors::K_YELLOW);
 
     DEBUG_PRINT("Init done, entering main loop!\n");
 
     /// ************************* MAIN LOOP ************************* ///
     while (true) {
         protocol_handler.run();
+        link_switcher.run();
+        firmware_updater.run();
         test_uint32++;
 
+        // Transmitted from the main loop so that a frame never ends up in the middle of a response
+        const size_t telemetry_frame_size = telemetry_streamer.takeFrame(telemetry_frame_buffer);
+        if (telemetry_frame_size > 0) {
+            protocol_handler.transmitUnsolicitedFrame(static_cast<uint8_t>(protocol::StreamIds::telemetry),
+                                                      {telemetry_frame_buffer, telemetry_frame_size});
+        }
+
         /* // Old debugging code that can be removed later
         while (communication_uart_driver.getReceivedBytesAvailableAmount() > 0) {
             status_led_controller.flashOverrideColor(led_controller::common_colors::K_ORANGE);
@@ -1,18 +1,72 @@
 #include "protocol_handlers.h"
 
+#include <algorithm>
 #include <cstring>
 
+#include "board.h"
+#include "drivers/interfaces/TimerInterface.h"
+#include "firmware_update/FirmwareUpdater.h"
 #include "parameter_system/ParameterDatabase.h"
+#include "parameter_system/SignalCapture.h"
+#include "parameter_system/TelemetryStreamer.h"
 #include "parameter_system/common.h"
+#include "persistent_storage/RecordStore.h"
+#include "persistent_storage/parameter_storage.h"
+#include "serial_communication_framework/SlaveHandler.h"
+#include "serial_communication_framework/SlaveLinkSwitcher.h"
+#include "serial_communication_framework/TransferSlave.h"
+#include "utils/StaticList.h"
 
-extern parameter_system::ParameterDatabase parameter_database;
+extern parameter_system::ParameterDatabase  parameter_database;
+extern parameter_system::TelemetryStreamer  telemetry_streamer;
+extern drivers::interfaces::TimerInterface& telemetry_timer;
+extern parameter_system::SignalCapture      signal_capture;
+extern drivers::interfaces::TimerInterface& capture_timer;
+extern persistent_storage::RecordStore      parameter_record_store;
+extern firmware_update::FirmwareUpdater     firmware_updater;
+
+extern serial_communication_framework::SlaveHandler      protocol_handler;
+extern serial_communication_framework::SlaveLinkSwitcher link_switcher;
+extern serial_communication_framework::TransferSlave     transfer_slave;
 
 namespace protocol_handlers {
 
+namespace {
+
+// Backing storage for the responses that carry their bytes as a view. Handlers are run one at a time and the
+// response is serialized before the next one runs, so one buffer is enough.
+uint8_t response_bytes_buffer[serial_communication_framework::ResponsePacket::K_PAYLOAD_MAX_SIZE];
+
+// Long enough for the response to the reboot command to be transmitted at the slowest baud rate
+constexpr uint32_t K_REBOOT_DELAY_MS = 50;
+
+serial_communication_framework::ResponseCode mapUpdateResult(firmware_update::UpdateResult result) {
+    using firmware_update::UpdateResult;
+    using serial_communication_framework::ResponseCode;
+
+    switch (result) {
+        case UpdateResult::ok:
+            return ResponseCode::ok;
+        case UpdateResult::image_too_large:
+        case UpdateResult::out_of_order:
+            return ResponseCode::out_of_bounds;
+        case UpdateResult::not_mounted:  // The boot record could not be mounted at boot
+        case UpdateResult::not_started:
+        case UpdateResult::incomplete:
+        case UpdateResult::crc_mismatch:
+            return ResponseCode::forbidden;
+        default:
+            return ResponseCode::unexpected_local_error;
+    }
+}
+
+}  // namespace
+
 protocol::commands::ReadParamValueResponse readParamValue(const protocol::commands::ReadParamValueRequest& request) {
     protocol::commands::ReadParamValueResponse response;
 
-    parameter_system::ParameterDefinition* param = parameter_database.getParameterDefinitionById(request.parameter_id);
+    const parameter_system::ParameterDefinition* param =
+        parameter_database.getParameterDefinitionById(request.parameter_id);
     // Parameter not found
     if (param == nullptr) {
         response.response_code = serial_communication_framework::ResponseCode::invalid_id;
@@ -21,7 +75,7 @@ protocol::commands::ReadParamValueResponse readParamValue(const protocol::comman
 
     // Sanity check that type master and firmware has for the parameter is the same. Could drift if master has a stale
     // build of control_api for example
-    if (param->getMetaData().value_type != request.expected_value_type) {
+    if (param->getValueType() != request.expected_value_type) {
         response.response_code = serial_communication_framework::ResponseCode::type_mismatch;
         return response;
     }
@@ -38,10 +92,52 @@ protocol::commands::ReadParamValueResponse readParamValue(const protocol::comman
     return response;
 }
 
+protocol::commands::ReadParamValuesResponse readParamValues(
+    const protocol::commands::ReadParamValuesRequest& request) {
+    protocol::commands::ReadParamValuesResponse response;
+    size_t                                      values_size = 0;
+
+    for (const protocol::commands::ReadParamValuesRequest::Entry& entry : request.entries) {
+        const parameter_system::ParameterDefinition* param =
+            parameter_database.getParameterDefinitionById(entry.parameter_id);
+        // Parameter not found
+        if (param == nullptr) {
+            response.response_code = serial_communication_framework::ResponseCode::invalid_id;
+            return response;
+        }
+
+        // Same sanity check as for the single value read
+        if (param->getValueType() != entry.expected_value_type) {
+            response.response_code = serial_communication_framework::ResponseCode::type_mismatch;
+            return response;
+        }
+
+        size_t                            written_bytes = 0;
+        parameter_system::ReadWriteResult reading_result =
+            param->getValueRaw(std::span(response_bytes_buffer).subspan(values_size), &written_bytes);
+        // Values of all the requested parameters don't fit into one response
+        if (reading_result == parameter_system::ReadWriteResult::buffer_size_mismatch) {
+            response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+            return response;
+        }
+        if (reading_result != parameter_system::ReadWriteResult::ok) {
+            response.response_code = serial_communication_framework::ResponseCode::unexpected_local_error;
+            return response;
+        }
+
+        values_size += written_bytes;
+    }
+
+    response.raw_bytes     = {response_bytes_buffer, values_size};
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
 protocol::commands::EmptyResponse writeParamValue(const protocol::commands::WriteParamValueRequest& request) {
     protocol::commands::EmptyResponse response;
 
-    parameter_system::ParameterDefinition* param = parameter_database.getParameterDefinitionById(request.parameter_id);
+    const parameter_system::ParameterDefinition* param =
+        parameter_database.getParameterDefinitionById(request.parameter_id);
     // Parameter not found
     if (param == nullptr) {
         response.response_code = serial_communication_framework::ResponseCode::invalid_id;
@@ -50,7 +146,7 @@ protocol::commands::EmptyResponse writeParamValue(const protocol::commands::Writ
 
     // Sanity check that type master and firmware has for the parameter is the same. Could drift if master has a stale
     // build of control_api for example
-    if (param->getMetaData().value_type != request.expected_value_type) {
+    if (param->getValueType() != request.expected_value_type) {
         response.response_code = serial_communication_framework::ResponseCode::type_mismatch;
         return response;
     }
@@ -72,11 +168,92 @@ protocol::commands::EmptyResponse writeParamValue(const protocol::commands::Writ
     return response;
 }
 
+protocol::commands::EmptyResponse writeParamValues(const protocol::commands::WriteParamValuesRequest& request) {
+    protocol::commands::EmptyResponse response;
+
+    // Validate all the entries before writing anything so that a failing request doesn't leave the parameters into a
+    // half written state
+    for (const protocol::commands::WriteParamValuesRequest::Entry& entry : request.entries) {
+        const parameter_system::ParameterDefinition* param =
+            parameter_database.getParameterDefinitionById(entry.parameter_id);
+        // Parameter not found
+        if (param == nullptr) {
+            response.response_code = serial_communication_framework::ResponseCode::invalid_id;
+            return response;
+        }
+
+        // Same sanity check as for the single value write
+        if (param->getValueType() != entry.expected_value_type) {
+            response.response_code = serial_communication_framework::ResponseCode::type_mismatch;
+            return response;
+        }
+
+        if (!param->valueIsWritable()) {
+            response.response_code = serial_communication_framework::ResponseCode::forbidden;
+            return response;
+        }
+    }
+
+    // Write all the values first and collect the callbacks, each callback is invoked only once even if it is shared
+    // by multiple written parameters
+    utils::StaticList<parameter_system::ParameterOnChangeCallback,
+                      protocol::commands::WriteParamValuesRequest::K_MAX_ENTRIES>
+        callbacks_to_invoke;
+    for (const protocol::commands::WriteParamValuesRequest::Entry& entry : request.entries) {
+        const parameter_system::ParameterDefinition* param =
+            parameter_database.getParameterDefinitionById(entry.parameter_id);
+
+        parameter_system::ReadWriteResult writing_result =
+            param->setValueRawWithoutNotifying(request.getValueBytes(entry));
+        ASSERT_WITH_MESSAGE(writing_result == parameter_system::ReadWriteResult::ok,
+                            "Validated parameter write failed");
+
+        parameter_system::ParameterOnChangeCallback callback = param->getOnChangeCallback();
+        if (callback == nullptr) continue;
+
+        bool already_collected = false;
+        for (parameter_system::ParameterOnChangeCallback collected : callbacks_to_invoke) {
+            if (collected == callback) {
+                already_collected = true;
+                break;
+            }
+        }
+        if (!already_collected) callbacks_to_invoke.pushBack(callback);
+    }
+
+    for (parameter_system::ParameterOnChangeCallback callback : callbacks_to_invoke) {
+        callback();
+    }
+
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::EmptyResponse saveParameters(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    protocol::commands::EmptyResponse response;
+    switch (persistent_storage::saveParameters(parameter_database, parameter_record_store)) {
+        case persistent_storage::StorageResult::ok:
+            response.response_code = serial_communication_framework::ResponseCode::ok;
+            break;
+        case persistent_storage::StorageResult::not_mounted:
+            // The storage could not be mounted at boot
+            response.response_code = serial_communication_framework::ResponseCode::forbidden;
+            break;
+        default:
+            response.response_code = serial_communication_framework::ResponseCode::unexpected_local_error;
+            break;
+    }
+    return response;
+}
+
 protocol::commands::GetParamMetadataResponse getParamMetaData(
     const protocol::commands::GetParamMetadataRequest& request) {
     protocol::commands::GetParamMetadataResponse response;
 
-    parameter_system::ParameterDefinition* param = parameter_database.getParameterDefinitionById(request.parameter_id);
+    const parameter_system::ParameterDefinition* param =
+        parameter_database.getParameterDefinitionById(request.parameter_id);
     // Parameter not found
     if (param == nullptr) {
         response.response_code = serial_communication_framework::ResponseCode::invalid_id;
@@ -97,15 +274,235 @@ protocol::commands::GetRegisteredParamIdsResponse getParamIds(const protocol::co
     for (size_t i = 0; i < parameter_database.getAmountOfRegisteredParameters(); i++) {
         ASSERT_WITH_MESSAGE(!response.ids.full(), "Too many registered parameters for response buffer");
 
-        parameter_system::ParameterDefinition* param = parameter_database.getParameterDefinitionByIndex(i);
-        response.ids.pushBack(param->getMetaData().id);
+        const parameter_system::ParameterDefinition* param = parameter_database.getParameterDefinitionByIndex(i);
+        response.ids.pushBack(param->getId());
+    }
+
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+
+    return response;
+}
+
+protocol::commands::EmptyResponse subscribeTelemetry(const protocol::commands::SubscribeTelemetryRequest& request) {
+    protocol::commands::EmptyResponse response;
+
+    if (request.period_us < protocol::commands::SubscribeTelemetryRequest::K_MIN_PERIOD_US) {
+        response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+        return response;
+    }
+
+    // The sampling interrupt must not run while the subscription is changed
+    const bool was_streaming = telemetry_timer.isRunning();
+    telemetry_timer.stop();
+
+    const parameter_system::TelemetrySubscribeResult subscribe_result = telemetry_streamer.subscribe(
+        {request.parameter_ids.begin(), request.parameter_ids.size()});
+
+    switch (subscribe_result) {
+        case parameter_system::TelemetrySubscribeResult::ok:
+            response.response_code = serial_communication_framework::ResponseCode::ok;
+            break;
+        case parameter_system::TelemetrySubscribeResult::invalid_id:
+            response.response_code = serial_communication_framework::ResponseCode::invalid_id;
+            break;
+        case parameter_system::TelemetrySubscribeResult::not_a_signal:
+            response.response_code = serial_communication_framework::ResponseCode::forbidden;
+            break;
+        case parameter_system::TelemetrySubscribeResult::too_many_signals:
+        case parameter_system::TelemetrySubscribeResult::frame_too_large:
+            response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+            break;
+    }
+
+    // The earlier subscription is kept if the new one was rejected
+    if (response.response_code != serial_communication_framework::ResponseCode::ok) {
+        if (was_streaming) telemetry_timer.start();
+        return response;
+    }
+
+    if (telemetry_streamer.isSubscribed()) {
+        telemetry_timer.configureInMicroseconds(request.period_us);
+        telemetry_timer.start();
     }
 
+    return response;
+}
+
+protocol::commands::EmptyResponse unsubscribeTelemetry(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    telemetry_timer.stop();
+    telemetry_streamer.unsubscribe();
+
+    protocol::commands::EmptyResponse response;
     response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::EmptyResponse armCapture(const protocol::commands::ArmCaptureRequest& request) {
+    protocol::commands::EmptyResponse response;
+
+    // The sampling interrupt must not run while the capture is configured
+    const bool was_sampling = capture_timer.isRunning();
+    capture_timer.stop();
+
+    const parameter_system::CaptureConfigureResult arm_result =
+        signal_capture.arm({request.parameter_ids.begin(), request.parameter_ids.size()}, request.config);
+
+    switch (arm_result) {
+        case parameter_system::CaptureConfigureResult::ok:
+            response.response_code = serial_communication_framework::ResponseCode::ok;
+            break;
+        case parameter_system::CaptureConfigureResult::invalid_id:
+            response.response_code = serial_communication_framework::ResponseCode::invalid_id;
+            break;
+        case parameter_system::CaptureConfigureResult::not_a_signal:
+            response.response_code = serial_communication_framework::ResponseCode::forbidden;
+            break;
+        case parameter_system::CaptureConfigureResult::invalid_trigger:
+        case parameter_system::CaptureConfigureResult::too_many_signals:
+        case parameter_system::CaptureConfigureResult::buffer_too_small:
+        case parameter_system::CaptureConfigureResult::invalid_pre_trigger:
+        case parameter_system::CaptureConfigureResult::invalid_decimation:
+            response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+            break;
+    }
+
+    // The earlier capture is kept if the new one was rejected
+    if (response.response_code == serial_communication_framework::ResponseCode::ok || was_sampling) {
+        capture_timer.start();
+    }
+
+    return response;
+}
+
+protocol::commands::EmptyResponse triggerCapture(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
 
+    protocol::commands::EmptyResponse response;
+
+    if (signal_capture.getStatus().state != parameter_system::CaptureState::armed) {
+        response.response_code = serial_communication_framework::ResponseCode::forbidden;
+        return response;
+    }
+
+    signal_capture.trigger();
+    response.response_code = serial_communication_framework::ResponseCode::ok;
     return response;
 }
 
+protocol::commands::EmptyResponse disarmCapture(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    capture_timer.stop();
+    signal_capture.disarm();
+
+    protocol::commands::EmptyResponse response;
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::GetCaptureStatusResponse getCaptureStatus(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    protocol::commands::GetCaptureStatusResponse response;
+    response.status        = signal_capture.getStatus();
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::ReadCaptureDataResponse readCaptureData(const protocol::commands::ReadCaptureDataRequest& request) {
+    protocol::commands::ReadCaptureDataResponse response;
+
+    const parameter_system::CaptureStatus status = signal_capture.getStatus();
+    if (status.state != parameter_system::CaptureState::complete) {
+        response.response_code = serial_communication_framework::ResponseCode::forbidden;
+        return response;
+    }
+
+    const size_t captured_byte_count = static_cast<size_t>(status.sample_count) * status.sample_size;
+    if (request.byte_offset >= captured_byte_count) {
+        response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+        return response;
+    }
+
+    const size_t chunk_size = std::min<size_t>(request.byte_count, response.K_MAX_CHUNK_SIZE);
+    const size_t read_size =
+        signal_capture.readCapturedBytes(request.byte_offset, std::span(response_bytes_buffer).first(chunk_size));
+
+    response.byte_offset   = request.byte_offset;
+    response.raw_bytes     = {response_bytes_buffer, read_size};
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::EmptyResponse startTransfer(const serial_communication_framework::TransferStartRequest& request) {
+    protocol::commands::EmptyResponse response;
+    response.response_code = transfer_slave.startUpload(request);
+    return response;
+}
+
+protocol::commands::EmptyResponse writeTransferSegment(
+    const serial_communication_framework::TransferSegmentRequest& request) {
+    protocol::commands::EmptyResponse response;
+    response.response_code = transfer_slave.receiveSegment(request);
+    return response;
+}
+
+protocol::commands::EmptyResponse finishTransfer(const serial_communication_framework::TransferFinishRequest& request) {
+    protocol::commands::EmptyResponse response;
+    response.response_code = transfer_slave.finishUpload(request);
+    return response;
+}
+
+serial_communication_framework::TransferReadResponse readTransferSegment(
+    const serial_communication_framework::TransferReadRequest& request) {
+    return transfer_slave.readSegment(request);
+}
+
+serial_communication_framework::ResponseCode captureDataSource(uint32_t offset, std::span<uint8_t> target_buffer,
+                                                               size_t* read_size_out, void* user_data) {
+    (void)user_data;  // unused
+
+    const parameter_system::CaptureStatus status = signal_capture.getStatus();
+    if (status.state != parameter_system::CaptureState::complete) {
+        return serial_communication_framework::ResponseCode::forbidden;
+    }
+
+    const size_t captured_byte_count = static_cast<size_t>(status.sample_count) * status.sample_size;
+    if (offset >= captured_byte_count) return serial_communication_framework::ResponseCode::out_of_bounds;
+
+    *read_size_out = signal_capture.readCapturedBytes(offset, target_buffer);
+    return serial_communication_framework::ResponseCode::ok;
+}
+
+protocol::commands::EmptyResponse beginFirmwareUpdate(const protocol::commands::BeginFirmwareUpdateRequest& request) {
+    protocol::commands::EmptyResponse response;
+    response.response_code = mapUpdateResult(firmware_updater.beginUpdate(request.image_size, request.image_crc));
+    return response;
+}
+
+protocol::commands::GetFirmwareStatusResponse getFirmwareStatus(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    protocol::commands::GetFirmwareStatusResponse response;
+    response.status        = firmware_updater.getStatus();
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+serial_communication_framework::ResponseCode firmwareImageSink(uint32_t offset, std::span<const uint8_t> bytes,
+                                                               void* user_data) {
+    (void)user_data;  // unused
+    return mapUpdateResult(firmware_updater.write(offset, bytes));
+}
+
+serial_communication_framework::ResponseCode finishFirmwareImage(uint32_t total_size, void* user_data) {
+    (void)total_size;  // Checked against the size given when the update began
+    (void)user_data;   // unused
+    return mapUpdateResult(firmware_updater.finishUpdate());
+}
+
 protocol::commands::EmptyResponse ping(const protocol::commands::EmptyRequest& request) {
     (void)request;  // unused
 
@@ -114,4 +511,74 @@ protocol::commands::EmptyResponse ping(const protocol::commands::EmptyRequest& r
     return response;
 }
 
+protocol::commands::EmptyResponse reboot(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    // Restarts once the response has had time to go out
+    board::scheduleReboot(K_REBOOT_DELAY_MS);
+
+    protocol::commands::EmptyResponse response;
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::GetCommunicationStatisticsResponse getCommunicationStatistics(
+    const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    protocol::commands::GetCommunicationStatisticsResponse response;
+    response.statistics    = protocol_handler.getCommunicationStatistics();
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::GetOperationStatisticsResponse getOperationStatistics(
+    const protocol::commands::GetOperationStatisticsRequest& request) {
+    protocol::commands::GetOperationStatisticsResponse response;
+    response.operation     = protocol_handler.getCommunicationStatistics().operations[request.operation_code];
+    response.handler_time  = protocol_handler.getHandlerTimeStatistics(request.operation_code);
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::GetCapabilitiesResponse getCapabilities(const protocol::commands::EmptyRequest& request) {
+    (void)request;  // unused
+
+    protocol::commands::GetCapabilitiesResponse response;
+    response.protocol_version          = protocol::commands::K_PROTOCOL_VERSION;
+    response.max_request_payload_size  = serial_communication_framework::RequestPacket::K_PAYLOAD_MAX_SIZE;
+    response.max_response_payload_size = serial_communication_framework::ResponsePacket::K_PAYLOAD_MAX_SIZE;
+    response.features                  = static_cast<uint32_t>(protocol::commands::ProtocolFeature::cobs_framing);
+    for (const uint32_t baud_rate : board::getSerialCommunicationBaudRates()) {
+        response.baud_rates.pushBack(baud_rate);
+    }
+
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
+protocol::commands::EmptyResponse configureLink(const protocol::commands::ConfigureLinkRequest& request) {
+    using serial_communication_framework::Framing;
+    protocol::commands::EmptyResponse response;
+
+    const std::span<const uint32_t> baud_rates = board::getSerialCommunicationBaudRates();
+    const bool                      baud_rate_is_supported =
+        std::ranges::find(baud_rates, request.settings.baud_rate) != baud_rates.end();
+    const bool framing_is_supported =
+        request.settings.framing == Framing::none || request.settings.framing == Framing::cobs;
+    if (!baud_rate_is_supported || !framing_is_supported) {
+        response.response_code = serial_communication_framework::ResponseCode::out_of_bounds;
+        return response;
+    }
+
+    // The switch happens after this response has been sent
+    if (!link_switcher.requestSwitch(request.settings)) {
+        response.response_code = serial_communication_framework::ResponseCode::forbidden;
+        return response;
+    }
+
+    response.response_code = serial_communication_framework::ResponseCode::ok;
+    return response;
+}
+
 }  // namespace protocol_handlers